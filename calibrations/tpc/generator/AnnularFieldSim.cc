@@ -18,14 +18,141 @@
 
 #include <algorithm>
 #include <cassert>  // for assert
+#include <chrono>
 #include <cmath>
+#include <complex>
 #include <cstdint>
 #include <cstdlib>
 #include <format>
 #include <iostream>
+#include <vector>
 
 #define ALMOST_ZERO 0.00001
 
+namespace
+{
+  // mixed-radix fast fourier transform of fixed length n, used to perform the sum over phi as a circular convolution.
+  // transform(in,out) computes out[m] = sum_k in[k]*exp(-+2*pi*i*m*k/n), unnormalized in both directions.
+  class PhiFourier
+  {
+   public:
+    explicit PhiFourier(int n)
+      : nbins(n)
+    {
+      twiddle.resize(n);
+      for (int k = 0; k < n; k++)
+      {
+        twiddle[k] = std::polar(1.0, -2 * M_PI * k / n);
+      }
+      int rest = n;
+      for (int p = 2; p * p <= rest; p++)
+      {
+        while (rest % p == 0)
+        {
+          factors.push_back(p);
+          rest /= p;
+        }
+      }
+      if (rest > 1)
+      {
+        factors.push_back(rest);
+      }
+    }
+
+    // size of the scratch buffer needed by transform
+    int ScratchSize() const
+    {
+      return factors.empty() ? 1 : *std::max_element(factors.begin(), factors.end());
+    }
+
+    // in and out must not overlap.
+    void transform(const std::complex<double> *in, std::complex<double> *out, std::complex<double> *scratch, bool inverse) const
+    {
+      recurse(in, out, nbins, 1, 0, scratch, inverse);
+    }
+
+   private:
+    // decimation in time:  split into p interleaved sub-sequences, transform each, then combine with radix-p butterflies
+    void recurse(const std::complex<double> *in, std::complex<double> *out, int n, int stride, unsigned int ifactor, std::complex<double> *scratch, bool inverse) const
+    {
+      if (n == 1)
+      {
+        out[0] = in[0];
+        return;
+      }
+      const int p = factors[ifactor];
+      const int m = n / p;
+      for (int j = 0; j < p; j++)
+      {
+        recurse(in + j * stride, out + j * m, m, stride * p, ifactor + 1, scratch, inverse);
+      }
+      for (int sub = 0; sub < m; sub++)
+      {
+        for (int j = 0; j < p; j++)
+        {
+          scratch[j] = out[j * m + sub];
+        }
+        for (int b = 0; b < p; b++)
+        {
+          const int k = b * m + sub;
+          std::complex<double> sum = scratch[0];
+          for (int j = 1; j < p; j++)
+          {
+            const std::complex<double> &w = twiddle[(static_cast<long>(j) * k * stride) % nbins];
+            sum += scratch[j] * (inverse ? std::conj(w) : w);
+          }
+          out[k] = sum;
+        }
+      }
+    }
+
+    int nbins;
+    std::vector<int> factors;
+    std::vector<std::complex<double>> twiddle;
+  };
+
+  // plain three-component accumulator for the field integrals, so the inner z loop does not build TVector3 temporaries.
+  struct PlainVec3
+  {
+    double x = 0;
+    double y = 0;
+    double z = 0;
+
+    void addScaled(const TVector3 &v, double w)
+    {
+      x += v.X() * w;
+      y += v.Y() * w;
+      z += v.Z() * w;
+    }
+  };
+
+  // distortion of one start point of a distortion map, already in the float form the histograms are filled with.
+  struct DriftResult
+  {
+    float x = 0;  // cartesian components, before rotating to the start point
+    float y = 0;
+    float r = 0;  // radial and r*phi components at the start point
+    float rphi = 0;
+    float z = 0;
+    int validToStep = 0;
+    int success = 0;
+  };
+
+  DriftResult MakeDriftResult(TVector3 distort, double phi, int validToStep, int success)
+  {
+    DriftResult res;
+    res.x = distort.X();
+    res.y = distort.Y();
+    distort.RotateZ(-phi);  // rotate so that distortion components are wrt the x axis
+    res.rphi = distort.Y();  // the phi component is now the y component.
+    res.r = distort.X();     // and the r component is the x component
+    res.z = distort.Z();
+    res.validToStep = validToStep;
+    res.success = success;
+    return res;
+  }
+}  // namespace
+
 AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, float in_outerZ,
                                  int r, int roi_r0, int roi_r1, int /*in_rLowSpacing*/, int /*in_rHighSize*/,
                                  int phi, int roi_phi0, int roi_phi1, int /*in_phiLowSpacing*/, int /*in_phiHighSize*/,
@@ -878,8 +1005,9 @@ TVector3 AnnularFieldSim::interpolatedFieldIntegral(float zdest, const TVector3
     }
   }
 
-  TVector3 fieldInt(0, 0, 0);
-  TVector3 partialInt;  // where we'll store integrals as we generate them.
+  // the column sums are done on plain doubles, reading the field in place, in the same order as the TVector3 arithmetic they replace.
+  PlainVec3 fieldInt;
+  const double stepz = step.Z();
 
   for (int i = 0; i < 4; i++)
   {
@@ -888,28 +1016,31 @@ TVector3 AnnularFieldSim::interpolatedFieldIntegral(float zdest, const TVector3
       // print_need_cout("skipping element r=%d,phi=%d\n",ri[i],pi[i]);
       continue;  // we invalidated this one for some reason.
     }
-    partialInt.SetXYZ(0, 0, 0);
+    PlainVec3 partialInt;  // where we'll store integrals as we generate them.
     for (int j = zi; j < zf; j++)
     {  // count the whole cell of the lower end, and skip the whole cell of the high end.
 
-      partialInt += field->Get(ri[i] - rmin_roi, pi[i] - phimin_roi, j - zmin_roi) * step.Z();
+      partialInt.addScaled(*field->GetPtr(ri[i] - rmin_roi, pi[i] - phimin_roi, j - zmin_roi), stepz);
     }
     if (startBound != OnLowEdge)
     {
-      partialInt -= field->Get(ri[i] - rmin_roi, pi[i] - phimin_roi, zi - zmin_roi) * (startz - (zi * step.Z() + zmin));  // remove the part of the low end cell we didn't travel through
+      partialInt.addScaled(*field->GetPtr(ri[i] - rmin_roi, pi[i] - phimin_roi, zi - zmin_roi), -(startz - (zi * stepz + zmin)));  // remove the part of the low end cell we didn't travel through
       // print_need_cout("removing low end of cell we didn't travel through (zi-zmin_roi=%d, length=%f)\n",zi-zmin_roi, startz-(zi*step.Z()+zmin));
     }
-    if ((endz - zmin) / step.Z() - zf > ALMOST_ZERO)
+    if ((endz - zmin) / stepz - zf > ALMOST_ZERO)
     {
-      partialInt += field->Get(ri[i] - rmin_roi, pi[i] - phimin_roi, zf - zmin_roi) * (endz - (zf * step.Z() + zmin));  // add the part of the high end cell we did travel through
+      partialInt.addScaled(*field->GetPtr(ri[i] - rmin_roi, pi[i] - phimin_roi, zf - zmin_roi), endz - (zf * stepz + zmin));  // add the part of the high end cell we did travel through
       // print_need_cout("adding low end of cell we did travel through (zf-zmin_roi=%d, length=%f)\n",zf-zmin_roi, endz-(zf*step.Z()+zmin));
     }
     // print_need_cout("element r=%d,phi=%d, w=%f partialInt=(%2.2E,%2.2E,%2.2E)\n",ri[i],pi[i],rw[i]*pw[i],partialInt.X(),partialInt.Y(),partialInt.Z());
 
-    fieldInt += rw[i] * pw[i] * partialInt;
+    const double w = rw[i] * pw[i];
+    fieldInt.x += w * partialInt.x;
+    fieldInt.y += w * partialInt.y;
+    fieldInt.z += w * partialInt.z;
   }
 
-  return dir * fieldInt;
+  return TVector3(dir * fieldInt.x, dir * fieldInt.y, dir * fieldInt.z);
 }
 
 void AnnularFieldSim::load_analytic_spacecharge(float scalefactor = 1)
@@ -1339,6 +1470,31 @@ void AnnularFieldSim::loadField(MultiArray<TVector3> **field, TTree *source, con
   return;
 }
 
+void AnnularFieldSim::load_rossegger(double epsilon)
+{
+  green = new Rossegger(rmin, rmax, zmax, epsilon);
+
+  // the green's functions are only ever asked for at cell centers (and l-bin centers for the hybrid lookup),
+  // so tabulate their radial factors there once.
+  std::vector<double> radii;
+  for (int ir = 0; ir < nr; ir++)
+  {
+    radii.push_back((ir + 0.5) * step.Perp() + rmin);
+  }
+  if (lookupCase == HybridRes)
+  {
+    for (int il = 0; il < nr_low; il++)
+    {
+      int r_low = il * r_spacing;
+      int r_high = std::min(r_low + r_spacing - 1, nr - 1);
+      float ravg = (r_low + r_high) / 2.0 + 0.5;
+      radii.push_back((ravg) *step.Perp() + rmin);
+    }
+  }
+  green->PrecalcRadialTables(radii);
+  return;
+}
+
 void AnnularFieldSim::load_spacecharge(const std::string &filename, const std::string &histname, float zoffset, float chargescale, float cmscale, bool isChargeDensity)
 {
   TFile *f = TFile::Open(filename.c_str());
@@ -1572,6 +1728,15 @@ void AnnularFieldSim::populate_fieldmap()
 
   std::cout << std::format("populating fieldmap for ({}x{}x{}) grid with ({}x{}x{}) source ", nr_roi, nphi_roi, nz_roi, nr, nphi, nz) << std::endl;
 
+  const auto start = std::chrono::steady_clock::now();
+  if (lookupCase == PhiSlice && useFourierPhiSum)
+  {
+    populate_fourier_fieldmap();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::format("populate_fieldmap (fourier phi sum, {} threads) took {:.2f} s", nThreads, elapsed.count()) << std::endl;
+    return;
+  }
+
   if (truncation_length > 0)
   {
     std::cout << std::format(" ==> truncating anything more than {} cells away", truncation_length) << std::endl;
@@ -1582,23 +1747,24 @@ void AnnularFieldSim::populate_fieldmap()
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements * nr * nphi * nz) << std::endl;
 
-  int el = 0;
+  // the lookup-table sums only read shared state, so the cells can be filled in parallel.
+  // the analytic and hybrid cases stay serial.
+  const int nthreads = (lookupCase == PhiSlice || lookupCase == Full3D) ? nThreads : 1;
 
-  TVector3 localF;  // holder for the summed field at the current position.
+#pragma omp parallel for collapse(3) schedule(dynamic) num_threads(nthreads)
   for (int ir = rmin_roi; ir < rmax_roi; ir++)
   {
     for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
     {
       for (int iz = zmin_roi; iz < zmax_roi; iz++)
       {
-        localF = sum_field_at(ir, iphi, iz);  // asks in global coordinates
+        const TVector3 localF = sum_field_at(ir, iphi, iz);  // asks in global coordinates
+        const unsigned long long el = ((static_cast<unsigned long long>(ir - rmin_roi) * nphi_roi) + (iphi - phimin_roi)) * nz_roi + (iz - zmin_roi);
         if (!(el % percent))
         {
-          std::cout << std::format("populate_fieldmap {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent);
-
-          std::cout << std::format("sum_field_at (ir={}, iphi={}, iz={}) gives ({:E},{:E},{:E})", ir, iphi, iz, localF.X(), localF.Y(), localF.Z()) << std::endl;
+          std::cout << std::format("populate_fieldmap {}%:  ", static_cast<uint64_t>(debug_npercent) * el / percent)
+                    << std::format("sum_field_at (ir={}, iphi={}, iz={}) gives ({:E},{:E},{:E})", ir, iphi, iz, localF.X(), localF.Y(), localF.Z()) << std::endl;
         }
-        el++;
 
         Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
                                                                                // if (localF.Mag()>1e-9)
@@ -1606,6 +1772,136 @@ void AnnularFieldSim::populate_fieldmap()
       }
     }
   }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << std::format("populate_fieldmap ({} threads) took {:.2f} s", nthreads, elapsed.count()) << std::endl;
+  return;
+}
+
+void AnnularFieldSim::populate_fourier_fieldmap()
+{
+  // same result as summing sum_phislice_field_at over the roi.
+  // the phislice lookup only depends on the phi distance between source and field cell, so for a given
+  // (r,z) of the field and (r,z) of the source, the sum over source phi is a circular correlation in phi:
+  //   E(phi) = sum_iphi G(iphi-phi) q(iphi)   ==>   Ehat(m) = conj(Ghat(m)) qhat(m)
+  // which costs nphi*log(nphi) per (r,z) pair instead of nphi_roi*nphi.
+  std::cout << std::format("populating fieldmap with fourier sum in phi, {} threads", nThreads) << std::endl;
+
+  using cplx = std::complex<double>;
+  const PhiFourier fourier(nphi);
+  const int nfreq = nphi / 2 + 1;  // inputs are real, so the spectra are hermitian
+
+  // spectrum of the charge along phi, for every (r,z) source ring
+  std::vector<cplx> qhat(static_cast<size_t>(nr) * nz * nfreq);
+#pragma omp parallel for collapse(2) schedule(static) num_threads(nThreads)
+  for (int ior = 0; ior < nr; ior++)
+  {
+    for (int ioz = 0; ioz < nz; ioz++)
+    {
+      std::vector<cplx> in(nphi);
+      std::vector<cplx> out(nphi);
+      std::vector<cplx> scratch(fourier.ScratchSize());
+      for (int iophi = 0; iophi < nphi; iophi++)
+      {
+        in[iophi] = q->GetChargeInBin(ior, iophi, ioz);
+      }
+      fourier.transform(in.data(), out.data(), scratch.data(), false);
+      std::copy(out.begin(), out.begin() + nfreq, qhat.begin() + (static_cast<size_t>(ior) * nz + ioz) * nfreq);
+    }
+  }
+
+  const int nrings = nr_roi * nz_roi;
+  const int print_every = std::max(1, nrings * debug_npercent / 100);
+
+#pragma omp parallel for collapse(2) schedule(dynamic) num_threads(nThreads)
+  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
+  {
+    for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+    {
+      std::vector<cplx> in(nphi);
+      std::vector<cplx> out(nphi);
+      std::vector<cplx> scratch(fourier.ScratchSize());
+
+      // accumulated spectra of the x, y and z components of the (unrotated) field
+      std::vector<cplx> sum(3 * nfreq, cplx(0, 0));
+      cplx *sumx = sum.data();
+      cplx *sumy = sumx + nfreq;
+      cplx *sumz = sumy + nfreq;
+
+      for (int ior = 0; ior < nr; ior++)
+      {
+        for (int ioz = 0; ioz < nz; ioz++)
+        {
+          // Epartial_phislice is (r,phi=0,z) x (r,phi,z), source phi stride is nz.
+          const TVector3 *g = Epartial_phislice->GetPtr(ifr - rmin_roi, 0, ifz - zmin_roi, ior, 0, ioz);
+          const cplx *qring = &qhat[(static_cast<size_t>(ior) * nz + ioz) * nfreq];
+
+          // transform x and y together as x+iy, then z on its own
+          for (int iophi = 0; iophi < nphi; iophi++)
+          {
+            const TVector3 &unit = g[static_cast<size_t>(iophi) * nz];
+            in[iophi] = cplx(unit.X(), unit.Y());
+          }
+          fourier.transform(in.data(), out.data(), scratch.data(), false);
+          for (int ifreq = 0; ifreq < nfreq; ifreq++)
+          {
+            const cplx a = out[ifreq];
+            const cplx b = std::conj(out[(nphi - ifreq) % nphi]);
+            const cplx gx = (a + b) * 0.5;
+            const cplx gy = (a - b) * cplx(0, -0.5);
+            sumx[ifreq] += std::conj(gx) * qring[ifreq];
+            sumy[ifreq] += std::conj(gy) * qring[ifreq];
+          }
+
+          for (int iophi = 0; iophi < nphi; iophi++)
+          {
+            in[iophi] = g[static_cast<size_t>(iophi) * nz].Z();
+          }
+          fourier.transform(in.data(), out.data(), scratch.data(), false);
+          for (int ifreq = 0; ifreq < nfreq; ifreq++)
+          {
+            sumz[ifreq] += std::conj(out[ifreq]) * qring[ifreq];
+          }
+        }
+      }
+
+      // back to phi space.  x and y again share one transform, with the hermitian halves filled in.
+      std::vector<cplx> specxy(nphi);
+      std::vector<cplx> fieldxy(nphi);
+      for (int ifreq = 0; ifreq < nphi; ifreq++)
+      {
+        const bool low = (ifreq < nfreq);
+        const cplx x = low ? sumx[ifreq] : std::conj(sumx[nphi - ifreq]);
+        const cplx y = low ? sumy[ifreq] : std::conj(sumy[nphi - ifreq]);
+        specxy[ifreq] = x + cplx(0, 1) * y;
+        in[ifreq] = low ? sumz[ifreq] : std::conj(sumz[nphi - ifreq]);
+      }
+      fourier.transform(specxy.data(), fieldxy.data(), scratch.data(), true);
+      fourier.transform(in.data(), out.data(), scratch.data(), true);
+
+      // sum_phislice_field_at skips the self-to-self term.  The lookup stores zero there, but remove it explicitly anyway.
+      const TVector3 self = Epartial_phislice->Get(ifr - rmin_roi, 0, ifz - zmin_roi, ifr, 0, ifz);
+      const TVector3 slicepos = GetRoiCellCenter(ifr - rmin_roi, 0, ifz - zmin_roi);
+      for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
+      {
+        TVector3 localF(fieldxy[iphi].real() / nphi, fieldxy[iphi].imag() / nphi, out[iphi].real() / nphi);
+        localF -= self * q->GetChargeInBin(ifr, iphi, ifz);
+
+        // rotate from the phi=0 slice to this cell, as in sum_phislice_field_at
+        const TVector3 pos = GetRoiCellCenter(ifr - rmin_roi, iphi - phimin_roi, ifz - zmin_roi);
+        float rotphi = pos.Phi() - slicepos.Phi();
+        localF.RotateZ(rotphi);
+
+        localF += Eexternal->Get(ifr - rmin_roi, iphi - phimin_roi, ifz - zmin_roi);
+        Efield->Set(ifr - rmin_roi, iphi - phimin_roi, ifz - zmin_roi, localF);  // sets in roi coordinates.
+      }
+
+      const int ring = (ifr - rmin_roi) * nz_roi + (ifz - zmin_roi);
+      if (!(ring % print_every))
+      {
+        std::cout << std::format("populate_fourier_fieldmap {}%:  (ir={}, iz={}) done", 100 * ring / nrings, ifr, ifz) << std::endl;
+      }
+    }
+  }
   return;
 }
 
@@ -1664,30 +1960,31 @@ void AnnularFieldSim::populate_full3d_lookup()
   totalelements *= nz;  // breaking up this multiplication prevents a 32bit math overflow
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
-  TVector3 zero(0, 0, 0);
+  const TVector3 zero(0, 0, 0);
+  const unsigned long long nsource = static_cast<unsigned long long>(nr) * nphi * nz;
 
-  int el = 0;
+  // each field cell writes only its own slice of the table, so the cells can be filled in parallel.
+#pragma omp parallel for collapse(3) schedule(dynamic) num_threads(nThreads)
   for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
   {
     for (int ifphi = phimin_roi; ifphi < phimax_roi; ifphi++)
     {
       for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
       {
-        at = GetCellCenter(ifr, ifphi, ifz);
+        const TVector3 at = GetCellCenter(ifr, ifphi, ifz);
+        const unsigned long long fcell = ((static_cast<unsigned long long>(ifr - rmin_roi) * (phimax_roi - phimin_roi)) + (ifphi - phimin_roi)) * (zmax_roi - zmin_roi) + (ifz - zmin_roi);
         for (int ior = 0; ior < nr; ior++)
         {
           for (int iophi = 0; iophi < nphi; iophi++)
           {
             for (int ioz = 0; ioz < nz; ioz++)
             {
-              el++;
+              const unsigned long long el = fcell * nsource + ((static_cast<unsigned long long>(ior) * nphi) + iophi) * nz + ioz + 1;
               if (!(el % percent))
               {
                 std::cout << std::format("populate_full3d_lookup {}%", static_cast<uint64_t>(debug_npercent) * el / percent) << std::endl;
               }
-              from = GetCellCenter(ior, iophi, ioz);
+              const TVector3 from = GetCellCenter(ior, iophi, ioz);
 
               //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
               // print_need_cout("calc_unit_field...\n");
@@ -1733,6 +2030,7 @@ void AnnularFieldSim::populate_highres_lookup()
   }
 
   // todo: if this runs too slowly, I can do geometry instead of looping over all the cells that are possibly in range
+  // note this stays serial: the running averages share the nfbinsin counts across all f-bins, so the result depends on the loop order.
 
   // loop over all the f-bins in the roi:
   TVector3 currentf;
@@ -1886,53 +2184,43 @@ void AnnularFieldSim::populate_highres_lookup()
 
 void AnnularFieldSim::populate_lowres_lookup()
 {
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
-  TVector3 zero(0, 0, 0);
-  int fphi_low;
-  int fphi_high;
-  int fz_low;
-  int fz_high;  // edges of the outer l-bin
-  int r_low;
-  int r_high;
-  int phi_low;
-  int phi_high;
-  int z_low;
-  int z_high;  // edges of the inner l-bin
+  const TVector3 zero(0, 0, 0);
 
+  // each l-bin writes only its own slice of the table, so they can be filled in parallel.
   // todo:  add in handling if roi_low is wrap-around in phi
+#pragma omp parallel for collapse(3) schedule(dynamic) num_threads(nThreads)
   for (int ifr = rmin_roi_low; ifr < rmax_roi_low; ifr++)
   {
-    int fr_low = ifr * r_spacing;
-    int fr_high = fr_low + r_spacing - 1;
-    if (fr_high >= nr)
-    {
-      fr_high = nr - 1;
-    }
     for (int ifphi = phimin_roi_low; ifphi < phimax_roi_low; ifphi++)
     {
-      fphi_low = ifphi * phi_spacing;
-      fphi_high = fphi_low + phi_spacing - 1;
-      if (fphi_high >= nphi)
-      {
-        fphi_high = nphi - 1;  // if our phi l-bins aren't evenly spaced, we need to catch that here.
-      }
       for (int ifz = zmin_roi_low; ifz < zmax_roi_low; ifz++)
       {
-        fz_low = ifz * z_spacing;
-        fz_high = fz_low + z_spacing - 1;
+        int fr_low = ifr * r_spacing;
+        int fr_high = fr_low + r_spacing - 1;
+        if (fr_high >= nr)
+        {
+          fr_high = nr - 1;
+        }
+        int fphi_low = ifphi * phi_spacing;
+        int fphi_high = fphi_low + phi_spacing - 1;
+        if (fphi_high >= nphi)
+        {
+          fphi_high = nphi - 1;  // if our phi l-bins aren't evenly spaced, we need to catch that here.
+        }
+        int fz_low = ifz * z_spacing;
+        int fz_high = fz_low + z_spacing - 1;  // edges of the outer l-bin
         if (fz_high >= nz)
         {
           fz_high = nz - 1;
         }
-        at = GetGroupCellCenter(fr_low, fr_high, fphi_low, fphi_high, fz_low, fz_high);
+        const TVector3 at = GetGroupCellCenter(fr_low, fr_high, fphi_low, fphi_high, fz_low, fz_high);
         // print_need_cout("ifr=%d, rlow=%d,rhigh=%d,r_spacing=%d\n",ifr,r_low,r_high,r_spacing);
         // if(debugFlag())	  print_need_cout("%d: AnnularFieldSim::populate_lowres_lookup icell=(%d,%d,%d)\n",__LINE__,ifr,ifphi,ifz);
 
         for (int ior = 0; ior < nr_low; ior++)
         {
-          r_low = ior * r_spacing;
-          r_high = r_low + r_spacing - 1;
+          int r_low = ior * r_spacing;
+          int r_high = r_low + r_spacing - 1;
           int ir_rel = ifr - rmin_roi_low;
 
           if (r_high >= nr)
@@ -1941,8 +2229,8 @@ void AnnularFieldSim::populate_lowres_lookup()
           }
           for (int iophi = 0; iophi < nphi_low; iophi++)
           {
-            phi_low = iophi * phi_spacing;
-            phi_high = phi_low + phi_spacing - 1;
+            int phi_low = iophi * phi_spacing;
+            int phi_high = phi_low + phi_spacing - 1;
             if (phi_high >= nphi)
             {
               phi_high = nphi - 1;
@@ -1950,14 +2238,14 @@ void AnnularFieldSim::populate_lowres_lookup()
             int iphi_rel = ifphi - phimin_roi_low;
             for (int ioz = 0; ioz < nz_low; ioz++)
             {
-              z_low = ioz * z_spacing;
-              z_high = z_low + z_spacing - 1;
+              int z_low = ioz * z_spacing;
+              int z_high = z_low + z_spacing - 1;  // edges of the inner l-bin
               if (z_high >= nz)
               {
                 z_high = nz - 1;
               }
               int iz_rel = ifz - zmin_roi_low;
-              from = GetGroupCellCenter(r_low, r_high, phi_low, phi_high, z_low, z_high);
+              const TVector3 from = GetGroupCellCenter(r_low, r_high, phi_low, phi_high, z_low, z_high);
 
               if (ifr == ior && ifphi == iophi && ifz == ioz)
               {
@@ -1993,24 +2281,25 @@ void AnnularFieldSim::populate_phislice_lookup()
   totalelements *= nz_roi;  // breaking up this multiplication prevents a 32bit math overflow
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << std::format("total elements = {}", totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
-  TVector3 zero(0, 0, 0);
+  const TVector3 zero(0, 0, 0);
+  const unsigned long long nsource = static_cast<unsigned long long>(nr) * nphi * nz;
 
-  int el = 0;
+  // each field cell writes only its own slice of the table, so the cells can be filled in parallel.
+#pragma omp parallel for collapse(2) schedule(dynamic) num_threads(nThreads)
   for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
   {
     for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
     {
-      at = GetCellCenter(ifr, 0, ifz);
+      const TVector3 at = GetCellCenter(ifr, 0, ifz);
+      const unsigned long long fcell = (static_cast<unsigned long long>(ifr - rmin_roi) * nz_roi) + (ifz - zmin_roi);
       for (int ior = 0; ior < nr; ior++)
       {
         for (int iophi = 0; iophi < nphi; iophi++)
         {
           for (int ioz = 0; ioz < nz; ioz++)
           {
-            el++;
-            from = GetCellCenter(ior, iophi, ioz);
+            const unsigned long long el = fcell * nsource + ((static_cast<unsigned long long>(ior) * nphi) + iophi) * nz + ioz + 1;
+            const TVector3 from = GetCellCenter(ior, iophi, ioz);
             //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
             // print_need_cout("calc_unit_field...\n");
             if (ifr == ior && 0 == iophi && ifz == ioz)
@@ -3287,10 +3576,6 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
                                 axn[0], axbot[0], axtop[0]);
   }
 
-  TVector3 inpart;
-  TVector3 outpart;
-  TVector3 diffdistort;
-  TVector3 distort;
   int validToStep;
   int successCheck;
 
@@ -3341,72 +3626,104 @@ void AnnularFieldSim::GenerateSeparateDistortionMaps(const std::string &filebase
   // to avoid sampling nonphysical regions in r and z.  the phi case is free to wrap as
   //  normal.
 
-  // note that we apply the adjustment to the particle position (inpart) and not the plotted position (partR etc)
-  inpart.SetXYZ(1, 0, 0);
-  for (ir = 0; ir < nrh; ir++)
+  // note that we apply the adjustment to the particle position (the drift start) and not the plotted position (partR etc)
+  auto driftStart = [&](int jr, int jp, int jz)
   {
-    partR = (ir + 0.5) * deltar + rih;
-    if (ir == 0)
+    TVector3 start(1, 0, 0);
+    float startR = (jr + 0.5) * deltar + rih;
+    if (jr == 0)
     {
-      inpart.SetPerp(partR + deltar);
+      startR += deltar;
     }
-    else if (ir == nrh - 1)
+    else if (jr == nrh - 1)
     {
-      inpart.SetPerp(partR - deltar);
+      startR -= deltar;
     }
-    else
+    start.SetPerp(startR);
+    float startP = (jp + 0.5) * deltap + pih;
+    start.SetPhi(startP);               // since phi loops, there's no need to adjust phis that are out of bounds.
+    float startZ = (jz) *deltaz + zih;  // start us at the EDGE of the bin,
+    if (jz == 0)
     {
-      inpart.SetPerp(partR);
+      startZ += deltaz;
     }
-    for (ip = 0; ip < nph; ip++)
+    else if (jz == nzh - 1)
     {
-      partP = (ip + 0.5) * deltap + pih;
-      inpart.SetPhi(partP);
-      // since phi loops, there's no need to adjust phis that are out of bounds.
-      for (iz = 0; iz < nzh; iz++)
+      startZ -= deltaz;
+    }
+    start.SetZ(startZ);
+    return start;
+  };
+
+  // the drifts from each start point are independent and only read the fields, so they are computed up front across threads.
+  // the maps are still filled serially in grid order below, so the output does not depend on the number of threads.
+  // the R-deltaR monitor is filled during the drift itself, so that mode stays single-threaded.
+  const int driftThreads = (rdrswitch || (hasTwin && twin->RdeltaRswitch)) ? 1 : nThreads;
+  std::vector<DriftResult> drifts(totalelements);
+  const auto driftClock = std::chrono::steady_clock::now();
+#pragma omp parallel for collapse(3) schedule(dynamic) num_threads(driftThreads)
+  for (int jr = 0; jr < nrh; jr++)
+  {
+    for (int jp = 0; jp < nph; jp++)
+    {
+      for (int jz = 0; jz < nzh; jz++)
       {
-        partZ = (iz) *deltaz + zih;  // start us at the EDGE of the bin,
-        if (iz == 0)
-        {
-          inpart.SetZ(partZ + deltaz);
-        }
-        else if (iz == nzh - 1)
-        {
-          inpart.SetZ(partZ - deltaz);
-        }
-        else
-        {
-          inpart.SetZ(partZ);
-        }
-        partZ += 0.5 * deltaz;  // move to center of histogram bin.
+        TVector3 start = driftStart(jr, jp, jz);
+        const unsigned long long cell = ((static_cast<unsigned long long>(jr) * nph + jp) * nzh + jz) * nSides;
         for (int localside = 0; localside < nSides; localside++)
         {
+          int cellValidToStep = 0;
+          int cellSuccess = 0;
+          TVector3 cellDistort;
           if (localside == 0)
           {
-            diffdistort = zero_vector;  // GetTotalDistortion(inpart.Z() + deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
+            cellDistort = GetTotalDistortion(z_readout, start, nSteps, true, &cellValidToStep, &cellSuccess);
           }
           else
           {
             // if we have more than one side,
             // flip z coords and do the twin instead:
-            partZ *= -1;                   // position to place in histogram
-            inpart.SetZ(-1 * inpart.Z());  // position to seek in sim
-            diffdistort = zero_vector;     // twin->GetTotalDistortion(inpart.Z() - deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-            distort = twin->GetTotalDistortion(-z_readout, inpart, nSteps, true, &validToStep, &successCheck);
+            start.SetZ(-1 * start.Z());  // position to seek in sim
+            cellDistort = twin->GetTotalDistortion(-z_readout, start, nSteps, true, &cellValidToStep, &cellSuccess);
           }
+          drifts[cell + localside] = MakeDriftResult(cellDistort, start.Phi(), cellValidToStep, cellSuccess);
+        }
+      }
+    }
+  }
+  const std::chrono::duration<double> driftElapsed = std::chrono::steady_clock::now() - driftClock;
+  std::cout << std::format("drifted {} start points ({} threads) in {:.2f} s", totalelements, driftThreads, driftElapsed.count()) << std::endl;
 
-          diffdistort.RotateZ(-inpart.Phi());  // rotate so that distortion components are wrt the x axis
-          diffdistP = diffdistort.Y();         // the phi component is now the y component.
-          diffdistR = diffdistort.X();         // and the r component is the x component
-          diffdistZ = diffdistort.Z();
+  for (ir = 0; ir < nrh; ir++)
+  {
+    partR = (ir + 0.5) * deltar + rih;
+    for (ip = 0; ip < nph; ip++)
+    {
+      partP = (ip + 0.5) * deltap + pih;
+      for (iz = 0; iz < nzh; iz++)
+      {
+        partZ = (iz) *deltaz + zih;
+        partZ += 0.5 * deltaz;  // move to center of histogram bin.
+        for (int localside = 0; localside < nSides; localside++)
+        {
+          if (localside == 1)
+          {
+            partZ *= -1;  // position to place in histogram
+          }
+          const DriftResult &drift = drifts[(((static_cast<unsigned long long>(ir) * nph + ip) * nzh + iz) * nSides) + localside];
+          validToStep = drift.validToStep;
+          successCheck = drift.success;
+
+          // the differential distortion is not computed for the separated maps.
+          diffdistP = 0;
+          diffdistR = 0;
+          diffdistZ = 0;
 
-          distortX = distort.X();
-          distortY = distort.Y();
-          distort.RotateZ(-inpart.Phi());  // rotate so that distortion components are wrt the x axis
-          distortP = distort.Y();          // the phi component is now the y component.
-          distortR = distort.X();          // and the r component is the x component
-          distortZ = distort.Z();
+          distortX = drift.x;
+          distortY = drift.y;
+          distortP = drift.rphi;
+          distortR = drift.r;
+          distortZ = drift.z;
 
           float distComp[nMapComponents];  // by components
           distComp[0] = distortX;
@@ -3730,7 +4047,6 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
   int nph = nphi * p_subsamples + 2;  // nuber of phibins in the histogram
   int nrh = nr * r_subsamples + 2;    // number of r bins in the histogram
   int nzh = nz * z_subsamples + 2;    // number of z you get the idea.
-  int successCheck;
 
   if (hasTwin && makeUnifiedMap)
   {  // double the z range if we have a twin.  r and phi are the same, unless we had a phi roi...
@@ -3837,10 +4153,6 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
                                 axn[0], axbot[0], axtop[0]);
   }
 
-  TVector3 inpart;
-  TVector3 outpart;
-  TVector3 distort;
-  int validToStep;
 
   // TTree version:
   float partR;
@@ -3883,81 +4195,112 @@ void AnnularFieldSim::GenerateDistortionMaps(const std::string &filebase, int r_
   // to avoid sampling nonphysical regions in r and z.  the phi case is free to wrap as
   //  normal.
 
-  // note that we apply the adjustment to the particle position (inpart) and not the plotted position (partR etc)
-  inpart.SetXYZ(1, 0, 0);
-  for (ir = 0; ir < nrh; ir++)
+  // note that we apply the adjustment to the particle position (the drift start) and not the plotted position (partR etc)
+  auto driftStart = [&](int jr, int jp, int jz)
   {
-    partR = (ir + 0.5) * deltar + rih;
-    if (ir == 0)
+    TVector3 start(1, 0, 0);
+    float startR = (jr + 0.5) * deltar + rih;
+    if (jr == 0)
     {
-      inpart.SetPerp(partR + deltar);
+      startR += deltar;
     }
-    else if (ir == nrh - 1)
+    else if (jr == nrh - 1)
     {
-      inpart.SetPerp(partR - deltar);
+      startR -= deltar;
     }
-    else
+    start.SetPerp(startR);
+    float startP = (jp + 0.5) * deltap + pih;
+    start.SetPhi(startP);               // since phi loops, there's no need to adjust phis that are out of bounds.
+    float startZ = (jz) *deltaz + zih;  // start us at the EDGE of the bin, maybe has problems at the CM when twinned.
+    if (jz == 0)
     {
-      inpart.SetPerp(partR);
+      startZ += deltaz;
     }
-    for (ip = 0; ip < nph; ip++)
+    else if (jz == nzh - 1)
     {
-      partP = (ip + 0.5) * deltap + pih;
-      inpart.SetPhi(partP);
-      // since phi loops, there's no need to adjust phis that are out of bounds.
-      for (iz = 0; iz < nzh; iz++)
+      startZ -= deltaz;
+    }
+    start.SetZ(startZ);
+    return start;
+  };
+
+  // the drifts from each start point are independent and only read the fields, so they are computed up front across threads.
+  // the maps are still filled serially in grid order below, so the output does not depend on the number of threads.
+  // the R-deltaR monitor is filled during the drift itself, so that mode stays single-threaded.
+  const int driftThreads = (RdeltaRswitch || (hasTwin && twin->RdeltaRswitch)) ? 1 : nThreads;
+  std::vector<DriftResult> diffDrifts(totalelements);
+  std::vector<DriftResult> intDrifts(totalelements);
+  const auto driftClock = std::chrono::steady_clock::now();
+#pragma omp parallel for collapse(3) schedule(dynamic) num_threads(driftThreads)
+  for (int jr = 0; jr < nrh; jr++)
+  {
+    for (int jp = 0; jp < nph; jp++)
+    {
+      for (int jz = 0; jz < nzh; jz++)
       {
-        partZ = (iz) *deltaz + zih;  // start us at the EDGE of the bin, maybe has problems at the CM when twinned.
-        if (iz == 0)
+        const TVector3 start = driftStart(jr, jp, jz);
+        const unsigned long long cell = (static_cast<unsigned long long>(jr) * nph + jp) * nzh + jz;
+        int cellValidToStep = 0;
+        int cellSuccess = 0;
+        TVector3 cellDistort;
+
+        // differential distortion:
+        // be careful with the math of a distortion.  The R distortion is NOT the perp() component of outpart-inpart -- that's the transverse magnitude of the distortion!
+        if (hasTwin && start.Z() < 0)
         {
-          inpart.SetZ(partZ + deltaz);
+          cellDistort = twin->GetTotalDistortion(start.Z(), start + stepzvec, nSteps, true, &cellValidToStep, &cellSuccess);  // step across the cell in the opposite direction, starting at the high side and going to the low side..
         }
-        else if (iz == nzh - 1)
+        else
         {
-          inpart.SetZ(partZ - deltaz);
+          cellDistort = GetTotalDistortion(start.Z() + deltaz, start, nSteps, true, &cellValidToStep, &cellSuccess);
+        }
+        diffDrifts[cell] = MakeDriftResult(cellDistort, start.Phi(), cellValidToStep, cellSuccess);
+
+        // integral distortion:
+        if (hasTwin && makeUnifiedMap && start.Z() < 0)
+        {
+          cellDistort = twin->GetTotalDistortion(-z_readout, start + stepzvec, nSteps, true, &cellValidToStep, &cellSuccess);
         }
         else
         {
-          inpart.SetZ(partZ);
+          cellDistort = GetTotalDistortion(z_readout, start, nSteps, true, &cellValidToStep, &cellSuccess);
         }
+        intDrifts[cell] = MakeDriftResult(cellDistort, start.Phi(), cellValidToStep, cellSuccess);
+      }
+    }
+  }
+  const std::chrono::duration<double> driftElapsed = std::chrono::steady_clock::now() - driftClock;
+  std::cout << std::format("drifted {} start points ({} threads) in {:.2f} s", totalelements, driftThreads, driftElapsed.count()) << std::endl;
+
+  for (ir = 0; ir < nrh; ir++)
+  {
+    partR = (ir + 0.5) * deltar + rih;
+    for (ip = 0; ip < nph; ip++)
+    {
+      partP = (ip + 0.5) * deltap + pih;
+      for (iz = 0; iz < nzh; iz++)
+      {
+        partZ = (iz) *deltaz + zih;
         partZ += 0.5 * deltaz;  // move to center of histogram bin.
 
         // print_need_cout("iz=%d, zcoord=%2.2f, bin=%d\n",iz,partZ,  hIntDist[0][0]->GetYaxis()->FindBin(partZ));
+        const unsigned long long cell = (static_cast<unsigned long long>(ir) * nph + ip) * nzh + iz;
 
         // differential distortion:
-        // be careful with the math of a distortion.  The R distortion is NOT the perp() component of outpart-inpart -- that's the transverse magnitude of the distortion!
-        if (hasTwin && inpart.Z() < 0)
-        {
-          distort = twin->GetTotalDistortion(inpart.Z(), inpart + stepzvec, nSteps, true, &validToStep, &successCheck);  // step across the cell in the opposite direction, starting at the high side and going to the low side..
-        }
-        else
-        {
-          distort = GetTotalDistortion(inpart.Z() + deltaz, inpart, nSteps, true, &validToStep, &successCheck);
-        }
-        distort.RotateZ(-inpart.Phi());  // rotate so that that is on the x axis
-        diffdistP = distort.Y();         // the phi component is now the y component.
-        diffdistR = distort.X();         // and the r component is the x component
-        diffdistZ = distort.Z();
+        diffdistP = diffDrifts[cell].rphi;
+        diffdistR = diffDrifts[cell].r;
+        diffdistZ = diffDrifts[cell].z;
         hDistortionR->Fill(partP, partR, partZ, diffdistR);
         hDistortionP->Fill(partP, partR, partZ, diffdistP);
         hDistortionZ->Fill(partP, partR, partZ, diffdistZ);
         dTree->Fill();
 
         // integral distortion:
-        if (hasTwin && makeUnifiedMap && inpart.Z() < 0)
-        {
-          distort = twin->GetTotalDistortion(-z_readout, inpart + stepzvec, nSteps, true, &validToStep, &successCheck);
-        }
-        else
-        {
-          distort = GetTotalDistortion(z_readout, inpart, nSteps, true, &validToStep, &successCheck);
-        }
-        distortX = distort.X();
-        distortY = distort.Y();
-        distort.RotateZ(-inpart.Phi());  // rotate so that that is on the x axis
-        distortP = distort.Y();          // the phi component is now the y component.
-        distortR = distort.X();          // and the r component is the x component
-        distortZ = distort.Z();
+        distortX = intDrifts[cell].x;
+        distortY = intDrifts[cell].y;
+        distortP = intDrifts[cell].rphi;
+        distortR = intDrifts[cell].r;
+        distortZ = intDrifts[cell].z;
 
         // recursive integral distortion:
         // get others working first!
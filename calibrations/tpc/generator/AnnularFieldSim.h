@@ -2,6 +2,7 @@
 
 #include <TVector3.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <string>
@@ -94,6 +95,16 @@ class AnnularFieldSim
     truncation_length = x;
     return;
   }
+  void SetFourierPhiSum(bool b)
+  {
+    useFourierPhiSum = b;
+    return;
+  }  // with PhiSlice lookup, do the sum over phi as a convolution in fourier space.
+  void SetNumThreads(int n)
+  {
+    nThreads = std::max(1, n);
+    return;
+  }  // threads used to fill the lookup tables, the field map and the distortion maps
 
   // getters for internal states:
   std::string GetLookupString();
@@ -151,11 +162,7 @@ class AnnularFieldSim
 
   void loadField(MultiArray<TVector3> **field, TTree *source, const float *rptr, const float *phiptr, const float *zptr, const float *frptr, const float *fphiptr, const float *fzptr, float fieldunit, int zsign, float xshift = 0, float yshift = 0, float zshift = 0);
 
-  void load_rossegger(double epsilon = 1E-4)
-  {
-    green = new Rossegger(rmin, rmax, zmax, epsilon);
-    return;
-  };
+  void load_rossegger(double epsilon = 1E-4);  // build the green's functions, with their radial factors tabulated on our grid
   void borrow_rossegger(Rossegger *ross, float zshift)
   {
     green = ross;
@@ -192,6 +199,7 @@ class AnnularFieldSim
   TVector3 GetWeightedCellCenter(int r, int phi, int z);
   TVector3 fieldIntegral(float zdest, const TVector3 &start, MultiArray<TVector3> *field);
   void populate_fieldmap();
+  void populate_fourier_fieldmap();
   // now handled by setting 'analytic' lookup:  void populate_analytic_fieldmap();
   void populate_lookup();
   void populate_full3d_lookup();
@@ -303,6 +311,8 @@ class AnnularFieldSim
   LookupCase lookupCase;  // which lookup system to instantiate and use.
   ChargeCase chargeCase;  // which charge model to use
   int truncation_length;  // distance in cells (full 3D metric in units of bins)
+  bool useFourierPhiSum = false;  // sum phislice contributions in fourier space rather than cell by cell
+  int nThreads = 1;               // number of threads used to fill the lookup tables, field map and distortion maps
 
   // variables related to the region of interest:
   //
@@ -7,7 +7,9 @@
 #include <boost/math/special_functions.hpp>  //covers all the special functions.
 
 #include <algorithm>  // for max
+#include <bit>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>  // for exit, abs
 #include <format>
 #include <fstream>
@@ -34,6 +36,13 @@ extern "C"
 #define limu(im_order, x) Rossegger::Limu(im_order, x)
 #define kimu(im_order, x) Rossegger::Kimu(im_order, x)
 
+namespace
+{
+  // radii closer than this (in cm) share one entry of the radial tables.  It only needs to absorb the rounding of
+  // TVector3::Perp() on the cell centers.
+  const double radialTableTolerance = 1e-9;
+}  // namespace
+
 /*
   This is a modified/renamed copy of Carlos and Tom's "Spacecharge" class, modified to use boost instead of fortran routines, and with phi terms added.
  */
@@ -350,6 +359,8 @@ double Rossegger::Limu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+  // the fortran routines keep their work space in common blocks, so only one thread may be inside them at a time.
+#pragma omp critical(rossegger_fortran)
   dlia_(&IFAC, &X, &A, &DLI, &DERR, &IERRO);
   return DLI;
 }
@@ -362,6 +373,7 @@ double Rossegger::Kimu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+#pragma omp critical(rossegger_fortran)
   dkia_(&IFAC, &X, &A, &DKI, &DERR, &IERRO);
   return DKI;
 }
@@ -800,6 +812,9 @@ double Rossegger::Ez(double r, double phi, double z, double r1, double phi1, dou
     ;
     return 0;
   }
+  const int ir = RadialIndex(r);  // use the tabulated radial factors where we have them
+  const int ir1 = RadialIndex(r1);
+
   // Rossegger Equation 5.64
   double G = 0;
   for (int m = 0; m < NumberOfOrders; m++)
@@ -825,7 +840,7 @@ double Rossegger::Ez(double r, double phi, double z, double r1, double phi1, dou
       {
         std::cout << " " << term;
       }
-      term *= Rmn(m, n, r) * Rmn(m, n, r1) / N2mn[m][n];  // units of 1/[L]^2
+      term *= (ir >= 0 ? tabRmn[TableSlot(ir, m, n)] : Rmn(m, n, r)) * (ir1 >= 0 ? tabRmn[TableSlot(ir1, m, n)] : Rmn(m, n, r1)) / N2mn[m][n];  // units of 1/[L]^2
       if (verbosity > 10)
       {
         std::cout << " " << term;
@@ -1006,6 +1021,9 @@ double Rossegger::Er(double r, double phi, double z, double r1, double phi1, dou
     return 0;
   }
 
+  const int ir = RadialIndex(r);  // use the tabulated radial factors where we have them
+  const int ir1 = RadialIndex(r1);
+
   double part = 0;
   double G = 0;
   for (int m = 0; m < NumberOfOrders; m++)
@@ -1028,11 +1046,11 @@ double Rossegger::Er(double r, double phi, double z, double r1, double phi1, dou
 
       if (r < r1)
       {
-        term *= RPrime(m, n, a, r) * Rmn2(m, n, r1);  // units of 1/[L]
+        term *= (ir >= 0 ? tabRPrimeA[TableSlot(ir, m, n)] : RPrime(m, n, a, r)) * (ir1 >= 0 ? tabRmn2[TableSlot(ir1, m, n)] : Rmn2(m, n, r1));  // units of 1/[L]
       }
       else
       {
-        term *= Rmn1(m, n, r1) * RPrime(m, n, b, r);  // units of 1/[L]
+        term *= (ir1 >= 0 ? tabRmn1[TableSlot(ir1, m, n)] : Rmn1(m, n, r1)) * (ir >= 0 ? tabRPrimeB[TableSlot(ir, m, n)] : RPrime(m, n, b, r));  // units of 1/[L]
       }
       term /= bessel_denominator[m][n];  // unitless
       G += term;
@@ -1170,6 +1188,9 @@ double Rossegger::Ephi(double r, double phi, double z, double r1, double phi1, d
     return 0;
   }
 
+  const int ir = RadialIndex(r);  // use the tabulated radial factors where we have them
+  const int ir1 = RadialIndex(r1);
+
   double G = 0;
   // Rossegger Eqn. 5.66:
   for (int k = 0; k < NumberOfOrders; k++)
@@ -1178,7 +1199,7 @@ double Rossegger::Ephi(double r, double phi, double z, double r1, double phi1, d
     {
       double term = 1;
       term *= sin(BetaN[n] * z) * sin(BetaN[n] * z1);     // unitless
-      term *= Rnk(n, k, r) * Rnk(n, k, r1) / N2nk[n][k];  // unitless?
+      term *= (ir >= 0 ? tabRnk[TableSlot(ir, n, k)] : Rnk(n, k, r)) * (ir1 >= 0 ? tabRnk[TableSlot(ir1, n, k)] : Rnk(n, k, r1)) / N2nk[n][k];  // unitless?
 
       // the derivative of cosh(munk(pi-|phi-phi1|)
       if (phi > phi1)
@@ -1420,3 +1441,210 @@ void Rossegger::LoadZeroes(const std::string &destfile)
   f->Close();
   return;
 }
+
+void Rossegger::PrecalcRadialTables(const std::vector<double> &radii)
+{
+  tabRadii.clear();
+  for (double r : radii)
+  {
+    if (r >= a && r <= b)
+    {
+      tabRadii.push_back(r);
+    }
+  }
+  std::sort(tabRadii.begin(), tabRadii.end());
+  tabRadii.erase(std::unique(tabRadii.begin(), tabRadii.end(), [](double x, double y)
+                             { return std::abs(x - y) <= radialTableTolerance; }),
+                 tabRadii.end());
+
+  // key the cache on the radii themselves (fnv-1a over their bit patterns), as well as the geometry and precision:
+  uint64_t key = 14695981039346656037ULL;
+  for (double r : tabRadii)
+  {
+    uint64_t bits = std::bit_cast<uint64_t>(r);
+    for (int i = 0; i < 8; i++)
+    {
+      key ^= (bits >> (8 * i)) & 0xff;
+      key *= 1099511628211ULL;
+    }
+  }
+  std::string tablefilename = std::format("rossegger_radial_eps{:.0E}_a{:.2f}_b{:.2f}_L{:.2f}_nr{}_{:016x}.root", epsilon, a, b, L, tabRadii.size(), key);
+
+  bool loaded = false;
+  TFile *fileptr = TFile::Open(tablefilename.c_str(), "READ");
+  if (fileptr)
+  {
+    fileptr->Close();
+    loaded = LoadRadialTables(tablefilename);
+  }
+  if (!loaded)
+  {
+    ComputeRadialTables();
+    SaveRadialTables(tablefilename);
+  }
+  std::cout << std::format("Rossegger radial tables {} for {} radii ({})", loaded ? "read" : "computed", tabRadii.size(), tablefilename) << std::endl;
+  return;
+}
+
+int Rossegger::RadialIndex(double r) const
+{
+  auto it = std::lower_bound(tabRadii.begin(), tabRadii.end(), r - radialTableTolerance);
+  if (it == tabRadii.end() || std::abs(*it - r) > radialTableTolerance)
+  {
+    return -1;
+  }
+  return static_cast<int>(it - tabRadii.begin());
+}
+
+void Rossegger::ComputeRadialTables()
+{
+  const size_t nslots = tabRadii.size() * NumberOfOrders * NumberOfOrders;
+  tabRmn.assign(nslots, 0);
+  tabRmn1.assign(nslots, 0);
+  tabRmn2.assign(nslots, 0);
+  tabRPrimeA.assign(nslots, 0);
+  tabRPrimeB.assign(nslots, 0);
+  tabRnk.assign(nslots, 0);
+  for (int ir = 0; ir < (int) tabRadii.size(); ir++)
+  {
+    double r = tabRadii[ir];
+    for (int i = 0; i < NumberOfOrders; i++)
+    {
+      for (int j = 0; j < NumberOfOrders; j++)
+      {
+        int slot = TableSlot(ir, i, j);
+        tabRmn[slot] = Rmn(i, j, r);
+        tabRmn1[slot] = Rmn1(i, j, r);
+        tabRmn2[slot] = Rmn2(i, j, r);
+        tabRPrimeA[slot] = RPrime(i, j, a, r);
+        tabRPrimeB[slot] = RPrime(i, j, b, r);
+        tabRnk[slot] = Rnk(i, j, r);
+      }
+    }
+  }
+  return;
+}
+
+void Rossegger::SaveRadialTables(const std::string &destfile)
+{
+  TFile *output = TFile::Open(destfile.c_str(), "RECREATE");
+  output->cd();
+
+  TTree *tInfo = new TTree("info", "radial table geometry");
+  int ord = NumberOfOrders;
+  tInfo->Branch("order", &ord);
+  tInfo->Branch("epsilon", &epsilon);
+  tInfo->Branch("a", &a);
+  tInfo->Branch("b", &b);
+  tInfo->Branch("L", &L);
+  tInfo->Fill();
+
+  const int nper = NumberOfOrders * NumberOfOrders;
+  double r;
+  std::vector<double> rmn(nper);
+  std::vector<double> rmn1(nper);
+  std::vector<double> rmn2(nper);
+  std::vector<double> rprimea(nper);
+  std::vector<double> rprimeb(nper);
+  std::vector<double> rnk(nper);
+  TTree *tRadial = new TTree("radial", "radial factors per radius");
+  tRadial->Branch("r", &r);
+  tRadial->Branch("rmn", rmn.data(), std::format("rmn[{}]/D", nper).c_str());
+  tRadial->Branch("rmn1", rmn1.data(), std::format("rmn1[{}]/D", nper).c_str());
+  tRadial->Branch("rmn2", rmn2.data(), std::format("rmn2[{}]/D", nper).c_str());
+  tRadial->Branch("rprimea", rprimea.data(), std::format("rprimea[{}]/D", nper).c_str());
+  tRadial->Branch("rprimeb", rprimeb.data(), std::format("rprimeb[{}]/D", nper).c_str());
+  tRadial->Branch("rnk", rnk.data(), std::format("rnk[{}]/D", nper).c_str());
+  for (int ir = 0; ir < (int) tabRadii.size(); ir++)
+  {
+    r = tabRadii[ir];
+    const int offset = TableSlot(ir, 0, 0);
+    std::copy_n(tabRmn.begin() + offset, nper, rmn.begin());
+    std::copy_n(tabRmn1.begin() + offset, nper, rmn1.begin());
+    std::copy_n(tabRmn2.begin() + offset, nper, rmn2.begin());
+    std::copy_n(tabRPrimeA.begin() + offset, nper, rprimea.begin());
+    std::copy_n(tabRPrimeB.begin() + offset, nper, rprimeb.begin());
+    std::copy_n(tabRnk.begin() + offset, nper, rnk.begin());
+    tRadial->Fill();
+  }
+
+  tInfo->Write();
+  tRadial->Write();
+  output->Close();
+  return;
+}
+
+bool Rossegger::LoadRadialTables(const std::string &sourcefile)
+{
+  TFile *f = TFile::Open(sourcefile.c_str(), "READ");
+  std::cout << "reading rossegger radial tables from " << sourcefile << std::endl;
+  TTree *tInfo = (TTree *) (f->Get("info"));
+  TTree *tRadial = (TTree *) (f->Get("radial"));
+  if (!tInfo || !tRadial || tRadial->GetEntries() != (long long) tabRadii.size())
+  {
+    std::cout << "radial table file does not match this grid.  Recomputing." << std::endl;
+    f->Close();
+    return false;
+  }
+  int ord;
+  double fileEpsilon;
+  double fileA;
+  double fileB;
+  double fileL;
+  tInfo->SetBranchAddress("order", &ord);
+  tInfo->SetBranchAddress("epsilon", &fileEpsilon);
+  tInfo->SetBranchAddress("a", &fileA);
+  tInfo->SetBranchAddress("b", &fileB);
+  tInfo->SetBranchAddress("L", &fileL);
+  tInfo->GetEntry(0);
+  if (ord != NumberOfOrders || fileEpsilon != epsilon || fileA != a || fileB != b || fileL != L)
+  {
+    std::cout << std::format("radial table file was made for order={} eps={} a={} b={} L={}.  Recomputing.", ord, fileEpsilon, fileA, fileB, fileL) << std::endl;
+    f->Close();
+    return false;
+  }
+
+  const int nper = NumberOfOrders * NumberOfOrders;
+  const size_t nslots = tabRadii.size() * nper;
+  tabRmn.assign(nslots, 0);
+  tabRmn1.assign(nslots, 0);
+  tabRmn2.assign(nslots, 0);
+  tabRPrimeA.assign(nslots, 0);
+  tabRPrimeB.assign(nslots, 0);
+  tabRnk.assign(nslots, 0);
+
+  double r;
+  std::vector<double> rmn(nper);
+  std::vector<double> rmn1(nper);
+  std::vector<double> rmn2(nper);
+  std::vector<double> rprimea(nper);
+  std::vector<double> rprimeb(nper);
+  std::vector<double> rnk(nper);
+  tRadial->SetBranchAddress("r", &r);
+  tRadial->SetBranchAddress("rmn", rmn.data());
+  tRadial->SetBranchAddress("rmn1", rmn1.data());
+  tRadial->SetBranchAddress("rmn2", rmn2.data());
+  tRadial->SetBranchAddress("rprimea", rprimea.data());
+  tRadial->SetBranchAddress("rprimeb", rprimeb.data());
+  tRadial->SetBranchAddress("rnk", rnk.data());
+  for (int ir = 0; ir < (int) tabRadii.size(); ir++)
+  {
+    tRadial->GetEntry(ir);
+    if (std::abs(r - tabRadii[ir]) > radialTableTolerance)
+    {
+      std::cout << std::format("radial table file has r={} where r={} was expected.  Recomputing.", r, tabRadii[ir]) << std::endl;
+      f->Close();
+      return false;
+    }
+    const int offset = TableSlot(ir, 0, 0);
+    std::copy_n(rmn.begin(), nper, tabRmn.begin() + offset);
+    std::copy_n(rmn1.begin(), nper, tabRmn1.begin() + offset);
+    std::copy_n(rmn2.begin(), nper, tabRmn2.begin() + offset);
+    std::copy_n(rprimea.begin(), nper, tabRPrimeA.begin() + offset);
+    std::copy_n(rprimeb.begin(), nper, tabRPrimeB.begin() + offset);
+    std::copy_n(rnk.begin(), nper, tabRnk.begin() + offset);
+  }
+
+  f->Close();
+  return true;
+}
@@ -23,6 +23,7 @@
 #include <limits>
 #include <map>
 #include <string>
+#include <vector>
 
 class TH2;
 class TH3;
@@ -58,6 +59,12 @@ class Rossegger
   double Er(double r, double phi, double z, double r1, double phi1, double z1);
   double Ephi(double r, double phi, double z, double r1, double phi1, double z1);
 
+  // tabulate the radial factors of the series (Rmn, Rmn1, Rmn2, RPrime, Rnk) at a fixed set of radii, typically the
+  // cell centers of a field grid.  Er, Ephi and Ez then read them from the tables instead of evaluating the bessel
+  // functions whenever r or r1 is one of those radii.  The tables are cached in the current directory, keyed by
+  // geometry, precision and radii, so later jobs on the same grid only need to read them back.
+  void PrecalcRadialTables(const std::vector<double> &radii);
+
   // alternate versions that don't use precalc constants.
   double Rmn_(int m, int n, double r);  // Rmn function from Rossegger
   // Rmn_for_zeroes doesn't have a way to speed it up with precalcs.
@@ -117,6 +124,20 @@ class Rossegger
   double sinh_Betamn_L[NumberOfOrders][NumberOfOrders]{};   // sinh(Betamn[m][n]*L)  as in Rossegger 5.64
   double sinh_pi_Munk[NumberOfOrders][NumberOfOrders]{};    // sinh(pi*Munk[n][k]) as in Rossegger 5.66
 
+  int RadialIndex(double r) const;  // position of r in the radial tables, or -1 if it is not tabulated.
+  static int TableSlot(int ir, int i, int j) { return (ir * NumberOfOrders + i) * NumberOfOrders + j; }
+  void ComputeRadialTables();
+  bool LoadRadialTables(const std::string &sourcefile);
+  void SaveRadialTables(const std::string &destfile);
+
+  std::vector<double> tabRadii;    // radii at which the radial factors are tabulated, ascending
+  std::vector<double> tabRmn;      // Rmn(m,n,r) at TableSlot(ir,m,n)
+  std::vector<double> tabRmn1;     // Rmn1(m,n,r) at TableSlot(ir,m,n)
+  std::vector<double> tabRmn2;     // Rmn2(m,n,r) at TableSlot(ir,m,n)
+  std::vector<double> tabRPrimeA;  // RPrime(m,n,a,r) at TableSlot(ir,m,n)
+  std::vector<double> tabRPrimeB;  // RPrime(m,n,b,r) at TableSlot(ir,m,n)
+  std::vector<double> tabRnk;      // Rnk(n,k,r) at TableSlot(ir,n,k)
+
   TH2 *Tags {nullptr};
   std::map<std::string, TH3 *> Grid;
 };
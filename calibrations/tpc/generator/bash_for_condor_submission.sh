@@ -1,4 +1,9 @@
 #!/usr/bin/bash
+nthreads=1
+if [ "$1" == "--threads" ]; then
+    nthreads=${2?Error: --threads needs a count}
+    shift 2
+fi
 if [ "$1" == "no" ]; then
 echo "Running in quick test mode"
 inputname=/sphenix/user/shulga/Work/IBF/DistortionMap/Files/Summary_hist_mdc2_UseFieldMaps_AA_event_0_bX10556072.root
@@ -7,8 +12,8 @@ gainname="not_using_gain"
 nmax=1;
 else
 if [ "$1" == "" ] || [ "$2" == "" ]; then
-    echo "Usage: bash_for_condor_submission.sh <inputfile> <outputbasename>"
-    echo "or bash_for_condor_submission.sh no"
+    echo "Usage: bash_for_condor_submission.sh [--threads N] <inputfile> <outputbasename>"
+    echo "or bash_for_condor_submission.sh [--threads N] no"
     exit 1
 fi
 inputname=${1?Error: no input file given}
@@ -26,7 +31,7 @@ do
     outputname=${outputbase}_${n} ;
     echo Processing $inputname index $n to output: $outputname;
     echo $foutputname ;
-    root -b -q ./generate_distortion_map.C\(\"${inputname}\",\"$gainname\",\"$outputname\",\"_h_SC_ibf_${n}\",\"_h_SC_prim_${n}\",1\)
+    root -b -q ./generate_distortion_map.C\(\"${inputname}\",\"$gainname\",\"$outputname\",\"_h_SC_ibf_${n}\",\"_h_SC_prim_${n}\",1,0,500,0,0,0,0,${nthreads}\)
 done
 
 echo all done
@@ -19,6 +19,9 @@ class PHPy8GenTrigger
  public:
   virtual ~PHPy8GenTrigger() {}
 
+  //! With PHPythia8::set_worker_threads the worker threads call Apply of the same
+  //! trigger object concurrently. Apply must then not change the trigger and must
+  //! not print, PHPythia8 sets the verbosity of the registered triggers to 0 in this mode
   virtual bool Apply(Pythia8::Pythia * /*pythia*/)
   {
     std::cout << "PHPy8GenTrigger::Apply - in virtual function" << std::endl;
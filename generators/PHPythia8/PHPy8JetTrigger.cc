@@ -24,6 +24,8 @@ PHPy8JetTrigger::PHPy8JetTrigger(const std::string &name)
   , _R(1.0)
   , _nconst(0)
 {
+  // fastjet prints its banner on first use, do it here and not from a PHPythia8 worker thread
+  fastjet::ClusterSequence::print_banner();
 }
 
 PHPy8JetTrigger::~PHPy8JetTrigger()
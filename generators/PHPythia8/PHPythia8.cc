@@ -27,11 +27,63 @@
 #include <Pythia8/Pythia.h>
 #include <Pythia8Plugins/HepMC2.h>
 
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
 #include <format>
 #include <fstream>
 #include <iostream>  // for operator<<, endl
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  // PYTHIA8 has very specific requires for its random number range
+  // I map the designated unique seed from recoconst into something
+  // acceptable for PYTHIA8
+  unsigned int pythia_seed()
+  {
+    unsigned int seed = PHRandomSeed();
+
+    if (seed > 900000000)
+    {
+      seed = seed % 900000000;
+    }
+
+    if ((seed == 0) || (seed > 900000000))
+    {
+      std::cout << PHWHERE << " ERROR: seed " << seed << " is not valid" << std::endl;
+      exit(1);
+    }
+    return seed;
+  }
+}  // namespace
+
+//! one Pythia8 instance generating triggered events ahead on its own thread
+struct PHPythia8::PoolWorker
+{
+  struct Event
+  {
+    HepMC::GenEvent *genevent{nullptr};
+    // generator statistics of this instance after this event
+    long nAccepted{0};
+    double weightSum{0};
+    double sigmaGen{0};
+  };
+
+  Pythia8::Pythia *pythia{nullptr};
+  std::unique_ptr<Pythia8::Pythia> owned_pythia;
+  HepMC::Pythia8ToHepMC tohepmc;
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<Event> queue;
+  std::atomic<bool> stop{false};
+  //! last event handed to process_event, used for the integrated luminosity
+  Event last;
+};
 
 /**
  * @brief Construct a PHPythia8 generator instance and configure HepMC conversion.
@@ -59,6 +111,7 @@ PHPythia8::PHPythia8(const std::string &name)
 
   std::string thePath(charPath);
   thePath += "/xmldoc/";
+  m_XmlDocPath = thePath;
   // the pythia8 ctor messes with the formatting, so we save the cout state here
   // and restore it later
   std::ios old_state(nullptr);
@@ -73,6 +126,11 @@ PHPythia8::PHPythia8(const std::string &name)
   PHHepMCGenHelper::set_embedding_id(1);  // default embedding ID to 1
 }
 
+PHPythia8::~PHPythia8()
+{
+  stop_workers();
+}
+
 /**
  * @brief Initialize the Pythia8 generator, configure nodes, and seed the RNG.
  *
@@ -98,27 +156,9 @@ int PHPythia8::Init(PHCompositeNode *topNode)
 
   create_node_tree(topNode);
 
-  // PYTHIA8 has very specific requires for its random number range
-  // I map the designated unique seed from recoconst into something
-  // acceptable for PYTHIA8
-
-  unsigned int seed = PHRandomSeed();
-
-  if (seed > 900000000)
-  {
-    seed = seed % 900000000;
-  }
-
-  if ((seed > 0) && (seed <= 900000000))
-  {
-    m_Pythia8->readString("Random:setSeed = on");
-    m_Pythia8->readString(std::format("Random:seed = {}", seed));
-  }
-  else
-  {
-    std::cout << PHWHERE << " ERROR: seed " << seed << " is not valid" << std::endl;
-    exit(1);
-  }
+  unsigned int seed = pythia_seed();
+  m_Pythia8->readString("Random:setSeed = on");
+  m_Pythia8->readString(std::format("Random:seed = {}", seed));
   // print out seed so we can make this is reproducible
   std::cout << "PHPythia8 random seed: " << seed << std::endl;
 
@@ -131,6 +171,11 @@ int PHPythia8::Init(PHCompositeNode *topNode)
 
   std::cout.copyfmt(old_state); // restore state to saved state
 
+  if (m_NumWorkers > 0)
+  {
+    start_workers();
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -141,10 +186,25 @@ int PHPythia8::End(PHCompositeNode * /*topNode*/)
     std::cout << "PHPythia8::End - I'm here!" << std::endl;
   }
 
+  stop_workers();
+
   if (Verbosity() >= VERBOSITY_SOME)
   {
     //-* dump out closing info (cross-sections, etc)
-    m_Pythia8->stat();
+    long nAccepted = m_Pythia8->info.nAccepted();
+    if (m_Pool.empty())
+    {
+      m_Pythia8->stat();
+    }
+    else
+    {
+      nAccepted = 0;
+      for (auto &worker : m_Pool)
+      {
+        worker->pythia->stat();
+        nAccepted += worker->last.nAccepted;
+      }
+    }
 
     // match pythia printout
     std::cout << " |                                                                "
@@ -152,8 +212,8 @@ int PHPythia8::End(PHCompositeNode * /*topNode*/)
     std::cout << "                         PHPythia8::End - " << m_EventCount
               << " events passed trigger" << std::endl;
     std::cout << "                         Fraction passed: " << m_EventCount
-              << "/" << m_Pythia8->info.nAccepted()
-              << " = " << m_EventCount / float(m_Pythia8->info.nAccepted()) << std::endl;
+              << "/" << nAccepted
+              << " = " << m_EventCount / float(nAccepted) << std::endl;
     std::cout << " *-------  End PYTHIA Trigger Statistics  ------------------------"
               << "-------------------------------------------------* " << std::endl;
 
@@ -204,6 +264,11 @@ int PHPythia8::process_event(PHCompositeNode * /*topNode*/)
     std::cout << Name() << " PHPythia8::process_event - event: " << m_EventCount << std::endl;
   }
 
+  if (!m_Pool.empty())
+  {
+    return process_event_from_pool();
+  }
+
   bool passedGen = false;
   bool passedTrigger = false;
   //  int genCounter = 0;
@@ -221,45 +286,7 @@ int PHPythia8::process_event(PHCompositeNode * /*topNode*/)
       passedGen = m_Pythia8->next();
     }
 
-    // test trigger logic
-    bool andScoreKeeper = true;
-    if (Verbosity() >= VERBOSITY_EVEN_MORE)
-    {
-      std::cout << "PHPythia8::process_event - triggersize: " << m_RegisteredTriggers.size() << std::endl;
-    }
-
-    for (auto &m_RegisteredTrigger : m_RegisteredTriggers)
-    {
-      bool trigResult = m_RegisteredTrigger->Apply(m_Pythia8.get());
-
-      if (Verbosity() >= VERBOSITY_EVEN_MORE)
-      {
-        std::cout << "PHPythia8::process_event trigger: "
-                  << m_RegisteredTrigger->GetName() << "  " << trigResult << std::endl;
-      }
-
-      if (m_TriggersOR && trigResult)
-      {
-        passedTrigger = true;
-        break;
-      }
-      if (m_TriggersAND)
-      {
-        andScoreKeeper &= trigResult;
-      }
-
-      if (Verbosity() >= VERBOSITY_EVEN_MORE && !passedTrigger && !andScoreKeeper)
-      {
-        std::cout << "PHPythia8::process_event - failed trigger: "
-                  << m_RegisteredTrigger->GetName() << std::endl;
-      }
-    }
-
-    if ((andScoreKeeper && m_TriggersAND) || (m_RegisteredTriggers.empty()))
-    {
-      passedTrigger = true;
-      //      genCounter = 0;
-    }
+    passedTrigger = passes_triggers(m_Pythia8.get());
 
     passedGen = false;
   }
@@ -365,3 +392,227 @@ void PHPythia8::register_trigger(PHPy8GenTrigger *theTrigger)
   }
   m_RegisteredTriggers.push_back(theTrigger);
 }
+
+bool PHPythia8::passes_triggers(Pythia8::Pythia *pythia)
+{
+  // test trigger logic
+  bool passedTrigger = false;
+  bool andScoreKeeper = true;
+  // called from the worker threads in pool mode, only print when generating on the main thread
+  const bool verbose = (Verbosity() >= VERBOSITY_EVEN_MORE && m_NumWorkers == 0);
+  if (verbose)
+  {
+    std::cout << "PHPythia8::process_event - triggersize: " << m_RegisteredTriggers.size() << std::endl;
+  }
+
+  for (auto &m_RegisteredTrigger : m_RegisteredTriggers)
+  {
+    bool trigResult = m_RegisteredTrigger->Apply(pythia);
+
+    if (verbose)
+    {
+      std::cout << "PHPythia8::process_event trigger: "
+                << m_RegisteredTrigger->GetName() << "  " << trigResult << std::endl;
+    }
+
+    if (m_TriggersOR && trigResult)
+    {
+      passedTrigger = true;
+      break;
+    }
+    if (m_TriggersAND)
+    {
+      andScoreKeeper &= trigResult;
+    }
+
+    if (verbose && !passedTrigger && !andScoreKeeper)
+    {
+      std::cout << "PHPythia8::process_event - failed trigger: "
+                << m_RegisteredTrigger->GetName() << std::endl;
+    }
+  }
+
+  if ((andScoreKeeper && m_TriggersAND) || (m_RegisteredTriggers.empty()))
+  {
+    passedTrigger = true;
+  }
+  return passedTrigger;
+}
+
+void PHPythia8::start_workers()
+{
+  // the workers apply the same trigger objects concurrently, they must not print
+  for (auto &trigger : m_RegisteredTriggers)
+  {
+    if (trigger->Verbosity() > 0)
+    {
+      std::cout << "PHPythia8::start_workers - trigger " << trigger->GetName()
+                << " is applied on worker threads, setting its verbosity to 0" << std::endl;
+      trigger->Verbosity(0);
+    }
+  }
+
+  std::ios old_state(nullptr);
+  old_state.copyfmt(std::cout);  // save current state
+
+  for (unsigned int i = 0; i < m_NumWorkers; ++i)
+  {
+    auto worker = std::make_unique<PoolWorker>();
+    worker->owned_pythia = std::make_unique<Pythia8::Pythia>(m_XmlDocPath, false);
+    worker->pythia = worker->owned_pythia.get();
+    if (!m_ConfigFileName.empty())
+    {
+      worker->pythia->readFile(m_ConfigFileName);
+    }
+    for (auto &m_Command : m_Commands)
+    {
+      worker->pythia->readString(m_Command);
+    }
+    // the workers run concurrently, they must not write to std::cout.
+    // These are picked up by init(), so they come after the user settings
+    worker->pythia->readString("Print:quiet = on");
+    worker->pythia->readString("Init:showChangedSettings = off");
+    worker->pythia->readString("Init:showProcesses = off");
+    worker->pythia->readString("Init:showChangedParticleData = off");
+    worker->pythia->readString("Next:numberCount = 0");
+    worker->pythia->readString("Next:numberShowEvent = 0");
+    worker->pythia->readString("Next:numberShowInfo = 0");
+    worker->pythia->readString("Next:numberShowProcess = 0");
+    worker->pythia->readString("Next:numberShowLHA = 0");
+    unsigned int seed = pythia_seed();
+    worker->pythia->readString("Random:setSeed = on");
+    worker->pythia->readString(std::format("Random:seed = {}", seed));
+    std::cout << "PHPythia8 worker " << i << " random seed: " << seed << std::endl;
+    worker->pythia->init();
+    worker->tohepmc.set_store_proc(true);
+    worker->tohepmc.set_store_pdf(true);
+    worker->tohepmc.set_store_xsec(true);
+    m_Pool.push_back(std::move(worker));
+  }
+  std::cout.copyfmt(old_state);  // restore state to saved state
+
+  for (auto &worker : m_Pool)
+  {
+    worker->thread = std::thread(&PHPythia8::worker_loop, this, worker.get());
+  }
+}
+
+void PHPythia8::stop_workers()
+{
+  for (auto &worker : m_Pool)
+  {
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->stop = true;
+    }
+    worker->condition.notify_all();
+    if (worker->thread.joinable())
+    {
+      worker->thread.join();
+    }
+    // events generated ahead which were not used
+    for (auto &poolevent : worker->queue)
+    {
+      delete poolevent.genevent;
+    }
+    worker->queue.clear();
+  }
+}
+
+void PHPythia8::worker_loop(PoolWorker *worker)
+{
+  int ievent = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(worker->mutex);
+      worker->condition.wait(lock, [this, worker]
+                             { return worker->stop || worker->queue.size() < m_WorkerQueueDepth; });
+      if (worker->stop)
+      {
+        return;
+      }
+    }
+
+    // generate and trigger outside of the lock, low acceptance triggers can take a while
+    bool passedTrigger = false;
+    while (!passedTrigger)
+    {
+      if (worker->stop)
+      {
+        return;
+      }
+      if (worker->pythia->next())
+      {
+        passedTrigger = passes_triggers(worker->pythia);
+      }
+    }
+
+    PoolWorker::Event poolevent;
+    poolevent.genevent = new HepMC::GenEvent(HepMC::Units::GEV, HepMC::Units::MM);
+    worker->tohepmc.fill_next_event(*worker->pythia, poolevent.genevent, ievent++);
+    if (m_SaveEventWeightFlag)
+    {
+      poolevent.genevent->weights().push_back(worker->pythia->info.weight());
+    }
+    poolevent.nAccepted = worker->pythia->info.nAccepted();
+    poolevent.weightSum = worker->pythia->info.weightSum();
+    poolevent.sigmaGen = worker->pythia->info.sigmaGen();
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->queue.push_back(poolevent);
+    }
+    worker->condition.notify_all();
+  }
+}
+
+int PHPythia8::process_event_from_pool()
+{
+  // round robin over the workers keeps the event sequence independent of thread timing
+  PoolWorker *worker = m_Pool[m_EventCount % m_Pool.size()].get();
+  PoolWorker::Event poolevent;
+  {
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    worker->condition.wait(lock, [worker]
+                           { return !worker->queue.empty(); });
+    poolevent = worker->queue.front();
+    worker->queue.pop_front();
+  }
+  worker->condition.notify_all();
+  worker->last = poolevent;
+
+  poolevent.genevent->set_event_number(m_EventCount);
+  auto *success = PHHepMCGenHelper::insert_event(poolevent.genevent);
+  if (!success)
+  {
+    std::cout << "PHPythia8::process_event - Failed to add event to HepMC record!" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  if (Verbosity() >= VERBOSITY_A_LOT)
+  {
+    poolevent.genevent->print();
+  }
+
+  ++m_EventCount;
+
+  // save statistics summed over all instances, the cross section is averaged
+  // with the number of accepted events of each instance
+  if (m_IntegralNode)
+  {
+    long nAccepted = 0;
+    double weightSum = 0;
+    double sigmaSum = 0;
+    for (auto &poolworker : m_Pool)
+    {
+      nAccepted += poolworker->last.nAccepted;
+      weightSum += poolworker->last.weightSum;
+      sigmaSum += poolworker->last.sigmaGen * poolworker->last.nAccepted;
+    }
+    m_IntegralNode->set_N_Generator_Accepted_Event(nAccepted);
+    m_IntegralNode->set_N_Processed_Event(m_EventCount);
+    m_IntegralNode->set_Sum_Of_Weight(weightSum);
+    m_IntegralNode->set_Integrated_Lumi(nAccepted * nAccepted / (sigmaSum * 1e9));
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
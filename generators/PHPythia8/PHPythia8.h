@@ -31,7 +31,7 @@ class PHPythia8 : public SubsysReco, public PHHepMCGenHelper
   explicit PHPythia8(const std::string &name = "PHPythia8");
 
   //! destructor
-  ~PHPythia8() override = default;
+  ~PHPythia8() override;
 
   int Init(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -73,8 +73,27 @@ class PHPythia8 : public SubsysReco, public PHHepMCGenHelper
   void save_event_weight(const bool b) { m_SaveEventWeightFlag = b; }
   void save_integrated_luminosity(const bool b) { m_SaveIntegratedLuminosityFlag = b; }
 
+  //! generate events (including the trigger selection) on n worker threads, each with its own
+  //! Pythia8 instance seeded from PHRandomSeed(). Every worker keeps up to queue_depth events
+  //! ready, process_event takes them round robin so the event sequence is reproducible.
+  //! The worker instances print nothing (Print:quiet), the main instance is only
+  //! initialized for the printout. The registered triggers are applied concurrently by the
+  //! workers and are made quiet, see PHPy8GenTrigger::Apply. n = 0 (default) generates on the main thread
+  void set_worker_threads(const unsigned int n, const unsigned int queue_depth = 4)
+  {
+    m_NumWorkers = n;
+    m_WorkerQueueDepth = queue_depth > 0 ? queue_depth : 1;
+  }
+
  private:
+  struct PoolWorker;
+
   int read_config(const std::string &cfg_file);
+  bool passes_triggers(Pythia8::Pythia *pythia);
+  void start_workers();
+  void stop_workers();
+  void worker_loop(PoolWorker *worker);
+  int process_event_from_pool();
   int create_node_tree(PHCompositeNode *topNode) final;
   double percent_diff(const double a, const double b) { return std::fabs((a - b) / a); }
   int m_EventCount = 0;
@@ -86,6 +105,12 @@ class PHPythia8 : public SubsysReco, public PHHepMCGenHelper
 
   // PYTHIA
   std::unique_ptr<Pythia8::Pythia> m_Pythia8;
+  std::string m_XmlDocPath;
+
+  // worker pool, every worker has its own quiet Pythia8 instance
+  unsigned int m_NumWorkers{0};
+  unsigned int m_WorkerQueueDepth{4};
+  std::vector<std::unique_ptr<PoolWorker>> m_Pool;
 
   std::string m_ConfigFileName{"phpythia8.cfg"};
   std::vector<std::string> m_Commands;
@@ -45,6 +45,12 @@ namespace CLHEP
   class HepRandomEngine;
 }
 
+namespace
+{
+  // relative tolerance of the phi solution, the stopping rule of the Brent solver
+  const double root_tolerance = 1e-5;
+}  // namespace
+
 Afterburner::Afterburner( const std::string &algorithmName,
                           CLHEP::HepRandomEngine *engine,
                           float mineta, float maxeta,
@@ -91,6 +97,7 @@ Afterburner::Afterburner(Afterburner&& o) noexcept
   , m_minpt(o.m_minpt)
   , m_maxpt(o.m_maxpt)
   , m_phishift(o.m_phishift)
+  , m_batchMode(o.m_batchMode)
 {
   std::copy(std::begin(o.m_psi_n), std::end(o.m_psi_n), std::begin(m_psi_n));
   o.m_algo = nullptr;  
@@ -124,6 +131,7 @@ Afterburner& Afterburner::operator=(Afterburner&& o) noexcept
     m_minpt  = o.m_minpt;  
     m_maxpt  = o.m_maxpt;
     m_phishift = o.m_phishift;
+    m_batchMode = o.m_batchMode;
     std::copy(std::begin(o.m_psi_n), std::end(o.m_psi_n), std::begin(m_psi_n));
   }
   return *this;
@@ -261,10 +269,6 @@ void Afterburner::AddFlowToParentAndMoveDescendants(HepMC::GenEvent *event, HepM
   m_algo->set_impact_parameter(hi->impact_parameter());
   m_algo->calc_flow(eta, pt, m_engine); // add engine for fluctuations (if enabled)
 
-  const gsl_root_fsolver_type *T = gsl_root_fsolver_brent;
-  gsl_root_fsolver *s = gsl_root_fsolver_alloc(T);
-  double x_lo = -2 * M_PI;
-  double x_hi = 2 * M_PI;
   float params[13] = {};
   params[0]  = static_cast<float>(phi_0);
   for (int i = 0; i < 6; ++i) 
@@ -273,6 +277,26 @@ void Afterburner::AddFlowToParentAndMoveDescendants(HepMC::GenEvent *event, HepM
     params[7 + i] = getPsiN(i+1);
   }
 
+  double phi = 0;
+  if (!solve_phi(params, phi))
+  {
+    m_phishift = 0.0;
+    return; // do not rotate anything on failure
+  }
+
+  m_phishift = phi - phi_0;
+  RotateParentAndDescendants(parent, m_phishift);
+
+  return ;
+}
+
+bool Afterburner::solve_phi(float *params, double &phi)
+{
+  const gsl_root_fsolver_type *T = gsl_root_fsolver_brent;
+  gsl_root_fsolver *s = gsl_root_fsolver_alloc(T);
+  double x_lo = -2 * M_PI;
+  double x_hi = 2 * M_PI;
+
   gsl_function F;
   F.function = &Afterburner::vn_func;
   F.params = params;
@@ -280,7 +304,6 @@ void Afterburner::AddFlowToParentAndMoveDescendants(HepMC::GenEvent *event, HepM
 
   int status;
   int iter = 0;
-  double phi = 0;
   do
   {
     ++iter;
@@ -288,21 +311,22 @@ void Afterburner::AddFlowToParentAndMoveDescendants(HepMC::GenEvent *event, HepM
     phi  = gsl_root_fsolver_root(s);
     x_lo = gsl_root_fsolver_x_lower(s);
     x_hi = gsl_root_fsolver_x_upper(s);
-    status = gsl_root_test_interval(x_lo, x_hi, 0, 1e-5);
+    status = gsl_root_test_interval(x_lo, x_hi, 0, root_tolerance);
   } while (status == GSL_CONTINUE && iter < 1000);
 
-  if (iter >= 1000) {
-    gsl_root_fsolver_free(s);
-    m_phishift = 0.0;
-    return; // do not rotate anything on failure
-  }
-
   gsl_root_fsolver_free(s);
+  return iter < 1000;
+}
 
-  m_phishift = phi - phi_0;
-  if (fabs(m_phishift) > 1e-7)
+void Afterburner::RotateParentAndDescendants(HepMC::GenParticle *parent, double phishift)
+{
+  if (fabs(phishift) > 1e-7)
   {
-    momentum.rotateZ(m_phishift);  // DPM check units * Gaudi::Units::rad);
+    CLHEP::HepLorentzVector momentum(parent->momentum().px(),
+                                     parent->momentum().py(),
+                                     parent->momentum().pz(),
+                                     parent->momentum().e());
+    momentum.rotateZ(phishift);  // DPM check units * Gaudi::Units::rad);
     parent->set_momentum(momentum);
   }
 
@@ -317,13 +341,13 @@ void Afterburner::AddFlowToParentAndMoveDescendants(HepMC::GenEvent *event, HepM
       HepMC::GenVertex *descvtx = (*descvtxit);
 
       // rotate vertex (magic number?)
-      if (fabs(m_phishift) > 1e-7)
+      if (fabs(phishift) > 1e-7)
       {
         CLHEP::HepLorentzVector position(descvtx->position().x(),
                                           descvtx->position().y(),
                                           descvtx->position().z(),
                                           descvtx->position().t());
-        position.rotateZ(m_phishift);  // DPM check units
+        position.rotateZ(phishift);  // DPM check units
         descvtx->set_position(position);
       }
 
@@ -338,17 +362,142 @@ void Afterburner::AddFlowToParentAndMoveDescendants(HepMC::GenEvent *event, HepM
                                           descpart->momentum().pz(),
                                           descpart->momentum().e());
         // Rotate particle
-        if (fabs(m_phishift) > 1e-7)
+        if (fabs(phishift) > 1e-7)
         {
-          desmomentum.rotateZ(m_phishift);  // DPM check units * Gaudi::Units::rad);
+          desmomentum.rotateZ(phishift);  // DPM check units * Gaudi::Units::rad);
           descpart->set_momentum(desmomentum);
         }
       } // end of particles loop
     } // end of vertices loop
   } // end of if (endvtx)
+}
 
+int Afterburner::flowAfterburnerBatch(HepMC::GenEvent *event, HepMC::GenVertex *mainvtx)
+{
+  HepMC::HeavyIon* hi = event->heavy_ion();
+  if (!hi)
+  {
+    std::cout << PHWHERE << ": HeavyIon info missing in GenEvent. Cannot apply flow." << std::endl;
+    std::exit(1);
+  }
+  m_algo->set_impact_parameter(hi->impact_parameter());
 
-  return ;
+  // gather the selected particles. calc_flow is called in the same order as in the
+  // per particle loop, so fluctuations see the same random numbers
+  m_batchParticles.clear();
+  m_batchPhi0.clear();
+  m_batchVn.clear();
+  HepMC::GenVertexParticleRange r(*mainvtx, HepMC::children);
+  for (HepMC::GenVertex::particle_iterator it = r.begin(); it != r.end(); it++)
+  {
+    HepMC::GenParticle *parent = (*it);
+    CLHEP::HepLorentzVector momentum(parent->momentum().px(),
+                                     parent->momentum().py(),
+                                     parent->momentum().pz(),
+                                     parent->momentum().e());
+    float eta = momentum.pseudoRapidity();
+    if (eta < m_mineta || eta > m_maxeta)
+    {
+      continue;
+    }
+    float pT = momentum.perp();
+    if (pT < m_minpt || pT > m_maxpt)
+    {
+      continue;
+    }
+    m_algo->calc_flow(momentum.pseudoRapidity(), momentum.perp(), m_engine);
+    m_batchParticles.push_back(parent);
+    m_batchPhi0.push_back(momentum.phi());
+    for (int n = 1; n <= 6; ++n)
+    {
+      m_batchVn.push_back(m_algo->get_vn(n));
+    }
+  }
+  const size_t nparticles = m_batchParticles.size();
+  float psi[6];
+  for (int n = 0; n < 6; ++n)
+  {
+    psi[n] = getPsiN(n + 1);
+  }
+
+  // Newton iteration on x + 2 sum_n vn/n sin(n (x - psi_n)) = phi0 for all particles,
+  // phi0 is rounded to float like in vn_func. The iterates are kept inside the bracket
+  // [-2 pi, 2 pi] of solve_phi. For sum_n |vn| < 0.5 the function is monotonic, the root
+  // in the bracket is unique and both solvers find the same one
+  m_batchPhi.resize(nparticles);
+  m_batchNewton.assign(nparticles, 1);
+  for (size_t i = 0; i < nparticles; ++i)
+  {
+    m_batchPhi[i] = static_cast<float>(m_batchPhi0[i]);
+    double sumvn = 0;
+    for (int n = 0; n < 6; ++n)
+    {
+      sumvn += std::fabs(m_batchVn[6 * i + n]);
+    }
+    if (sumvn >= 0.5)
+    {
+      m_batchNewton[i] = 0;
+    }
+  }
+  const float *vnflat = m_batchVn.data();
+  double *phiflat = m_batchPhi.data();
+  for (int iter = 0; iter < 50; ++iter)
+  {
+    double maxstep = 0;
+    for (size_t i = 0; i < nparticles; ++i)
+    {
+      const double x = phiflat[i];
+      double f = x - static_cast<float>(m_batchPhi0[i]);
+      double fprime = 1.0;
+      for (int n = 1; n <= 6; ++n)
+      {
+        const double arg = n * (x - psi[n - 1]);
+        const double v = vnflat[6 * i + n - 1];
+        f += 2.0 * v * std::sin(arg) / n;
+        fprime += 2.0 * v * std::cos(arg);
+      }
+      const double step = f / fprime;
+      phiflat[i] = std::clamp(x - step, -2 * M_PI, 2 * M_PI);
+      maxstep = std::max(maxstep, std::fabs(step) * m_batchNewton[i]);
+    }
+    if (maxstep < 1e-12)
+    {
+      break;
+    }
+  }
+
+  // a Newton root is only taken if it passes the stopping rule of solve_phi: the
+  // interval around it containing the sign change of vn_func must pass
+  // gsl_root_test_interval(0, 1e-5). Brent returns a point of its final interval,
+  // so both agree to this tolerance. Everything else goes through solve_phi
+  for (size_t i = 0; i < nparticles; ++i)
+  {
+    double phi = m_batchPhi[i];
+    float params[13] = {};
+    params[0] = static_cast<float>(m_batchPhi0[i]);
+    for (int n = 0; n < 6; ++n)
+    {
+      params[1 + n] = m_batchVn[6 * i + n];
+      params[7 + n] = psi[n];
+    }
+    bool converged = m_batchNewton[i] && std::isfinite(phi);
+    if (converged)
+    {
+      const double delta = 0.25 * root_tolerance * std::fabs(phi);
+      const double x_lo = phi - delta;
+      const double x_hi = phi + delta;
+      converged = (gsl_root_test_interval(x_lo, x_hi, 0, root_tolerance) == GSL_SUCCESS) &&
+                  (vn_func(x_lo, params) <= 0) && (vn_func(x_hi, params) >= 0);
+    }
+    if (!converged && !solve_phi(params, phi))
+    {
+      m_phishift = 0.0;
+      continue;
+    }
+    m_phishift = phi - m_batchPhi0[i];
+    RotateParentAndDescendants(m_batchParticles[i], m_phishift);
+  }
+  return 0;
 }
 
 void Afterburner::readLegacyArguments(
@@ -395,6 +544,11 @@ int Afterburner::flowAfterburner(HepMC::GenEvent *event,
     return -1;
   }
 
+  if (m_batchMode)
+  {
+    return flowAfterburnerBatch(event, mainvtx);
+  }
+
   // Loop over all children of this vertex
   HepMC::GenVertexParticleRange r(*mainvtx, HepMC::children);
 
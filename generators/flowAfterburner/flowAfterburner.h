@@ -3,6 +3,7 @@
 
 #include <string>
 #include <array>
+#include <vector>
 
 #include "AfterburnerAlgo.h"
 
@@ -14,6 +15,7 @@ namespace HepMC
 {
   class GenEvent;
   class GenParticle;
+  class GenVertex;
 }
 
 class Afterburner
@@ -48,6 +50,13 @@ class Afterburner
   void setPtRange(float minpt, float maxpt);
 
   float getPsiN(unsigned int n) const;
+
+  // solve the phi shifts of all particles of an event at once with a Newton
+  // iteration over flat arrays instead of one gsl root finder per particle.
+  // Same random number sequence, every Newton root passes the stopping rule of
+  // the Brent solver, otherwise the particle is solved with Brent
+  void setBatchMode(bool batch = true) { m_batchMode = batch; }
+  bool getBatchMode() const { return m_batchMode; }
  
   static double vn_func(double x, void *params);
   void throw_psi_n(HepMC::GenEvent *event);
@@ -72,6 +81,19 @@ class Afterburner
   float m_minpt = 0.0f;
   float m_maxpt = 100.0f;
   double m_phishift = 0.0; // shift of the reaction plane angle in phi, used to align with the impact parameter
+  bool m_batchMode = false;
+
+  // per particle root finding, params as in vn_func. false if it does not converge
+  static bool solve_phi(float *params, double &phi);
+  void RotateParentAndDescendants(HepMC::GenParticle *parent, double phishift);
+  int flowAfterburnerBatch(HepMC::GenEvent *event, HepMC::GenVertex *mainvtx);
+
+  // work arrays of the batch mode, kept between events to avoid reallocation
+  std::vector<HepMC::GenParticle *> m_batchParticles;
+  std::vector<double> m_batchPhi0;
+  std::vector<float> m_batchVn; // [particle][harmonic]
+  std::vector<double> m_batchPhi;
+  std::vector<char> m_batchNewton; // 0 for particles left to the per particle solver
 
   void setPsiN(unsigned int n, float psi);
   float m_psi_n[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}; // reaction plane angles
@@ -0,0 +1,94 @@
+// applies the afterburner to copies of the same events with the per particle
+// solver and in batch mode and checks that the particles end up at the same phi
+
+#include "flowAfterburner.h"
+
+#include <HepMC/GenEvent.h>
+#include <HepMC/GenParticle.h>
+#include <HepMC/GenVertex.h>
+#include <HepMC/HeavyIon.h>
+#include <HepMC/SimpleVector.h>
+
+#include <CLHEP/Random/MTwistEngine.h>
+#include <CLHEP/Random/RandFlat.h>
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+  HepMC::GenEvent *make_event(CLHEP::HepRandomEngine *engine, const int nparticles)
+  {
+    HepMC::GenEvent *evt = new HepMC::GenEvent();
+    HepMC::HeavyIon hi(0, 0, 0, 0, 0, 0, 0, 0, 0,
+                       CLHEP::RandFlat::shoot(engine, 0., 12.),
+                       CLHEP::RandFlat::shoot(engine, -M_PI, M_PI), 0, 0);
+    evt->set_heavy_ion(hi);
+    HepMC::GenVertex *vtx = new HepMC::GenVertex();
+    evt->add_vertex(vtx);  // barcode -1, the main vertex of the afterburner
+    for (int i = 0; i < nparticles; ++i)
+    {
+      const double pt = CLHEP::RandFlat::shoot(engine, 0.1, 5.);
+      const double eta = CLHEP::RandFlat::shoot(engine, -4., 4.);
+      const double phi = CLHEP::RandFlat::shoot(engine, -M_PI, M_PI);
+      const double pz = pt * std::sinh(eta);
+      const double e = std::sqrt(pt * pt + pz * pz + 0.14 * 0.14);
+      vtx->add_particle_out(new HepMC::GenParticle(HepMC::FourVector(pt * std::cos(phi), pt * std::sin(phi), pz, e), 211, 1));
+    }
+    return evt;
+  }
+
+  // largest phi difference of the same particles in both events
+  double max_phi_difference(const HepMC::GenEvent &a, const HepMC::GenEvent &b)
+  {
+    double maxdiff = 0;
+    for (HepMC::GenEvent::particle_const_iterator it = a.particles_begin(); it != a.particles_end(); ++it)
+    {
+      const HepMC::GenParticle *pb = b.barcode_to_particle((*it)->barcode());
+      if (!pb)
+      {
+        return M_PI;
+      }
+      const double dphi = std::remainder((*it)->momentum().phi() - pb->momentum().phi(), 2 * M_PI);
+      maxdiff = std::max(maxdiff, std::fabs(dphi));
+    }
+    return maxdiff;
+  }
+}  // namespace
+
+int main()
+{
+  CLHEP::MTwistEngine eventengine(12345);
+  bool ok = true;
+  for (int ievent = 0; ievent < 20; ++ievent)
+  {
+    HepMC::GenEvent *perparticle = make_event(&eventengine, 2000);
+    HepMC::GenEvent *batch = new HepMC::GenEvent(*perparticle);
+
+    // same seed, so both see the same reaction planes and fluctuations
+    CLHEP::MTwistEngine engine1(1000 + ievent);
+    CLHEP::MTwistEngine engine2(1000 + ievent);
+    Afterburner afterburner1("MINBIAS", &engine1);
+    Afterburner afterburner2("MINBIAS", &engine2);
+    afterburner2.setBatchMode(true);
+    afterburner1.flowAfterburner(perparticle);
+    afterburner2.flowAfterburner(batch);
+
+    // both solutions are within the Brent stopping rule (1e-5 relative) of the root, |phi| < 2 pi
+    const double maxdiff = max_phi_difference(*perparticle, *batch);
+    if (maxdiff > 2 * 1e-5 * 2 * M_PI)
+    {
+      std::cout << "event " << ievent << ": batch and per particle phi differ by " << maxdiff << std::endl;
+      ok = false;
+    }
+    delete perparticle;
+    delete batch;
+  }
+  if (!ok)
+  {
+    std::cout << "flow afterburner batch test failed" << std::endl;
+    return 1;
+  }
+  std::cout << "flow afterburner batch test passed" << std::endl;
+  return 0;
+}
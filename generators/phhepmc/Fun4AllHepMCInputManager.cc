@@ -1,5 +1,6 @@
 #include "Fun4AllHepMCInputManager.h"
 
+#include "PHHepMCBinaryIO.h"
 #include "PHHepMCGenEvent.h"
 #include "PHHepMCGenEventMap.h"
 
@@ -66,12 +67,14 @@ Fun4AllHepMCInputManager::Fun4AllHepMCInputManager(const std::string &name, cons
 Fun4AllHepMCInputManager::~Fun4AllHepMCInputManager()
 {
   fileclose();
+  StopReadAhead();
   if (!m_HepMCTmpFile.empty())
   {
     // okay if the file does not exist
     remove(m_HepMCTmpFile.c_str());
   }
   delete ascii_in;
+  delete binary_in;
   delete filestream;
   delete unzipstream;
 }
@@ -106,7 +109,19 @@ int Fun4AllHepMCInputManager::fileopen(const std::string &filenam)
     TString tstr(fname);
     TPRegexp bzip_ext(".bz2$");
     TPRegexp gzip_ext(".gz$");
-    if (tstr.Contains(bzip_ext))
+    if (PHHepMCBinaryIO::is_binary_file(fname))
+    {
+      // binary cache written by Fun4AllHepMCOutputManager, no parsing needed
+      binary_in = new PHHepMCBinaryIO(fname, std::ios::in);
+      if (!binary_in->is_good())
+      {
+        std::cout << PHWHERE << " " << Name() << ": could not open binary HepMC file " << fname << std::endl;
+        delete binary_in;
+        binary_in = nullptr;
+        return -1;
+      }
+    }
+    else if (tstr.Contains(bzip_ext))
     {
       // use boost iosteam library to decompress bz2 on the fly
       filestream = new std::ifstream(fname, std::ios::in | std::ios::binary);
@@ -129,6 +144,11 @@ int Fun4AllHepMCInputManager::fileopen(const std::string &filenam)
       // expects normal ascii hepmc file
       ascii_in = new HepMC::IO_GenEvent(fname, std::ios::in);
     }
+    if (m_ReadAheadDepth > 0)
+    {
+      m_ReadAheadStop = false;
+      m_ReadAheadThread = std::thread(&Fun4AllHepMCInputManager::ReadAheadLoop, this);
+    }
   }
 
   recoConsts *rc = recoConsts::instance();
@@ -186,13 +206,13 @@ int Fun4AllHepMCInputManager::run(const int /*nevents*/)
       }
       else
       {
-        evt = ascii_in->read_next_event();
+        evt = ReadNextEvent();
       }
     }
 
     if (!evt)
     {
-      if (Verbosity() > 1)
+      if (Verbosity() > 1 && ascii_in)
       {
         std::cout << "Fun4AllHepMCInputManager::run::" << Name()
                   << ": error type: " << ascii_in->error_type()
@@ -252,8 +272,12 @@ int Fun4AllHepMCInputManager::fileclose()
   }
   else
   {
+    // the read ahead thread uses the input stream
+    StopReadAhead();
     delete ascii_in;
     ascii_in = nullptr;
+    delete binary_in;
+    binary_in = nullptr;
   }
   IsOpen(0);
   // if we have a file list, move next entry to top of the list
@@ -318,12 +342,15 @@ int Fun4AllHepMCInputManager::PushBackEvents(const int i)
   int errorflag = 0;
   while (nevents > 0 && !errorflag)
   {
-    evt = ascii_in->read_next_event();
+    evt = ReadNextEvent();
     if (!evt)
     {
       std::cout << "Error after skipping " << i - nevents << std::endl;
-      std::cout << "error type: " << ascii_in->error_type()
-                << ", rdstate: " << ascii_in->rdstate() << std::endl;
+      if (ascii_in)
+      {
+        std::cout << "error type: " << ascii_in->error_type()
+                  << ", rdstate: " << ascii_in->rdstate() << std::endl;
+      }
       errorflag = -1;
       fileclose();
     }
@@ -433,3 +460,78 @@ int Fun4AllHepMCInputManager::MyCurrentEvent(const unsigned int index) const
   }
   return m_MyEvent.at(index);
 }
+
+HepMC::GenEvent *Fun4AllHepMCInputManager::ReadFromFile()
+{
+  if (binary_in)
+  {
+    return binary_in->read_next_event();
+  }
+  return ascii_in->read_next_event();
+}
+
+HepMC::GenEvent *Fun4AllHepMCInputManager::ReadNextEvent()
+{
+  if (!m_ReadAheadThread.joinable())
+  {
+    return ReadFromFile();
+  }
+  std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+  m_ReadAheadCondition.wait(lock, [this]
+                            { return !m_ReadAheadQueue.empty(); });
+  HepMC::GenEvent *nextevt = m_ReadAheadQueue.front();
+  // the end of file marker stays in the queue
+  if (nextevt)
+  {
+    m_ReadAheadQueue.pop_front();
+  }
+  m_ReadAheadCondition.notify_all();
+  return nextevt;
+}
+
+void Fun4AllHepMCInputManager::ReadAheadLoop()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+      m_ReadAheadCondition.wait(lock, [this]
+                                { return m_ReadAheadStop || m_ReadAheadQueue.size() < m_ReadAheadDepth; });
+      if (m_ReadAheadStop)
+      {
+        return;
+      }
+    }
+    // decompressing and parsing happens outside of the lock
+    HepMC::GenEvent *nextevt = ReadFromFile();
+    {
+      std::lock_guard<std::mutex> lock(m_ReadAheadMutex);
+      m_ReadAheadQueue.push_back(nextevt);
+    }
+    m_ReadAheadCondition.notify_all();
+    if (!nextevt)
+    {
+      return;
+    }
+  }
+}
+
+void Fun4AllHepMCInputManager::StopReadAhead()
+{
+  if (!m_ReadAheadThread.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_ReadAheadMutex);
+    m_ReadAheadStop = true;
+  }
+  m_ReadAheadCondition.notify_all();
+  m_ReadAheadThread.join();
+  // events which were read ahead but not used
+  for (HepMC::GenEvent *unused : m_ReadAheadQueue)
+  {
+    delete unused;
+  }
+  m_ReadAheadQueue.clear();
+}
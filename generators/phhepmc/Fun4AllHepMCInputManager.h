@@ -8,11 +8,16 @@
 
 #include <boost/iostreams/filtering_streambuf.hpp>
 
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 class PHCompositeNode;
+class PHHepMCBinaryIO;
 class SyncObject;
 
 // forward declaration of classes in namespace
@@ -47,7 +52,13 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager, public PHHepMCGenHe
   int SkipForThisManager(const int nevents) override { return PushBackEvents(-nevents); }
   int MyCurrentEvent(const unsigned int index = 0) const;
 
+  //! decompress and parse up to n events ahead in a separate thread, 0 (default) reads in the event loop
+  void set_read_ahead(const unsigned int n) { m_ReadAheadDepth = n; }
+
  protected:
+  //! next event from the open HepMC file (ascii or .hepmcbin), nullptr at the end of the file
+  HepMC::GenEvent *ReadNextEvent();
+
   HepMC::GenEvent *evt = nullptr;
 
   int events_total = 0;
@@ -55,6 +66,7 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager, public PHHepMCGenHe
   int m_EventPushedBackFlag = 0;
 
   HepMC::IO_GenEvent *ascii_in = nullptr;
+  PHHepMCBinaryIO *binary_in = nullptr;
 
   std::string m_HepMCTmpFile;
 
@@ -75,6 +87,18 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager, public PHHepMCGenHe
 
   std::string filename;
   std::string topNodeName;
+
+  HepMC::GenEvent *ReadFromFile();
+  void ReadAheadLoop();
+  void StopReadAhead();
+
+  unsigned int m_ReadAheadDepth = 0;
+  bool m_ReadAheadStop = false;
+  std::thread m_ReadAheadThread;
+  std::mutex m_ReadAheadMutex;
+  std::condition_variable m_ReadAheadCondition;
+  //! parsed events, a nullptr marks the end of the file
+  std::deque<HepMC::GenEvent *> m_ReadAheadQueue;
 };
 
 #endif /* PHHEPMC_FUN4ALLHEPMCINPUTMANAGER_H */
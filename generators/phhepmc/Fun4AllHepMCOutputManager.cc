@@ -1,5 +1,6 @@
 #include "Fun4AllHepMCOutputManager.h"
 
+#include "PHHepMCBinaryIO.h"
 #include "PHHepMCGenEvent.h"
 #include "PHHepMCGenEventMap.h"
 
@@ -40,6 +41,7 @@ Fun4AllHepMCOutputManager::Fun4AllHepMCOutputManager(const std::string &myname,
                                                      const std::string &filename)
   : Fun4AllOutputManager(myname)
   , outfilename(filename)
+  , ascii_out(nullptr)
   , comment_written(0)
   , filestream(nullptr)
   , zipstream(nullptr)
@@ -49,6 +51,17 @@ Fun4AllHepMCOutputManager::Fun4AllHepMCOutputManager(const std::string &myname,
   TPRegexp bzip_ext(".bz2$");
   TPRegexp gzip_ext(".gz$");
 
+  if (PHHepMCBinaryIO::is_binary_file(filename))
+  {
+    // binary cache for fast re-reading with Fun4AllHepMCInputManager
+    binary_out = new PHHepMCBinaryIO(filename, std::ios::out);
+    if (!binary_out->is_good())
+    {
+      std::cout << "error opening " << outfilename << " exiting " << std::endl;
+      exit(1);
+    }
+    return;
+  }
   if (tstr.Contains(bzip_ext))
   {
     // use boost iosteam library to compress to bz2 file on the fly
@@ -95,6 +108,8 @@ Fun4AllHepMCOutputManager::~Fun4AllHepMCOutputManager()
       delete ascii_out;
       ascii_out = nullptr;
     }
+    delete binary_out;
+    binary_out = nullptr;
 
     if (!zoutbuffer.empty())
     {
@@ -138,7 +153,8 @@ int Fun4AllHepMCOutputManager::Write(PHCompositeNode *topNode)
 {
   if (!comment_written)
   {
-    if (!comment.empty())
+    // the binary format has no comments
+    if (!comment.empty() && ascii_out)
     {
       ascii_out->write_comment(comment);
     }
@@ -171,7 +187,14 @@ int Fun4AllHepMCOutputManager::Write(PHCompositeNode *topNode)
   assert(evt);
 
   IncrementEvents(1);
-  ascii_out->write_event(evt);
+  if (binary_out)
+  {
+    binary_out->write_event(evt);
+  }
+  else
+  {
+    ascii_out->write_event(evt);
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
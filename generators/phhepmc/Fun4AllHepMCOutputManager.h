@@ -12,6 +12,7 @@ namespace HepMC
 }
 
 class PHCompositeNode;
+class PHHepMCBinaryIO;
 
 class Fun4AllHepMCOutputManager : public Fun4AllOutputManager
 {
@@ -44,6 +45,8 @@ class Fun4AllHepMCOutputManager : public Fun4AllOutputManager
  protected:
   std::string outfilename;
   HepMC::IO_GenEvent *ascii_out;
+  //! used instead of ascii_out for .hepmcbin files
+  PHHepMCBinaryIO *binary_out = nullptr;
   std::string comment;
   int comment_written;
 
@@ -150,18 +150,18 @@ int Fun4AllHepMCPileupInputManager::run(const int /*nevents*/, const bool skip)
           }
           else
           {
-            evt = ascii_in->read_next_event();
+            evt = ReadNextEvent();
             if (evt && m_SignalEventNumber == evt->event_number())
             {
               delete evt;
-              evt = ascii_in->read_next_event();
+              evt = ReadNextEvent();
             }
           }
         }
 
         if (!evt)
         {
-          if (Verbosity() > 1)
+          if (Verbosity() > 1 && ascii_in)
           {
             std::cout << "error type: " << ascii_in->error_type()
                       << ", rdstate: " << ascii_in->rdstate() << std::endl;
@@ -54,6 +54,7 @@ int HepMCFlowAfterBurner::Init(PHCompositeNode * /*topNode*/)
   m_engine = new CLHEP::MTwistEngine(randomSeed);
   m_afterburner = new Afterburner(algorithmName, m_engine, mineta, maxeta, minpt, maxpt);
   m_flowalgo = m_afterburner->getAlgo();
+  m_afterburner->setBatchMode(m_batchMode);
   // you can set other algo parameters here if needed
   if (enableFlucuations)
   {
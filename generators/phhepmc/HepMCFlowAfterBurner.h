@@ -58,6 +58,9 @@ class HepMCFlowAfterBurner : public SubsysReco
 
   void scaleFlow(const float scale, const unsigned int n = 0);
 
+  //! solve the flow phi shifts for all particles of an event together (Afterburner::setBatchMode)
+  void setBatchMode(const bool batch) { m_batchMode = batch; }
+
   void SaveRandomState(const std::string &savefile = "HepMCFlowAfterBurner.ransave");
   void RestoreRandomState(const std::string &savefile = "HepMCFlowAfterBurner.ransave");
 
@@ -76,6 +79,7 @@ class HepMCFlowAfterBurner : public SubsysReco
   long seed = 0;
   long randomSeed = 11793;
 
+  bool m_batchMode = false;
   bool enableFlucuations = true;                                           //  turns on/off the fluctuations in the afterburner
   std::array<float, 6> flowScales = {1.0F, 1.0F, 1.0F, 1.0F, 1.0F, 1.0F};  // scales for the flow harmonics
 
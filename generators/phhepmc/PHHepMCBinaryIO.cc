@@ -0,0 +1,393 @@
+#include "PHHepMCBinaryIO.h"
+
+#include <HepMC/GenCrossSection.h>
+#include <HepMC/GenEvent.h>
+#include <HepMC/GenParticle.h>
+#include <HepMC/GenVertex.h>
+#include <HepMC/HeavyIon.h>
+#include <HepMC/PdfInfo.h>
+#include <HepMC/SimpleVector.h>  // for FourVector
+#include <HepMC/Units.h>
+#include <HepMC/WeightContainer.h>
+
+#include <TPRegexp.h>
+#include <TString.h>
+
+#include <algorithm>  // for equal
+#include <cstdint>
+#include <iostream>
+#include <utility>  // for pair
+#include <vector>
+
+namespace
+{
+  const char file_magic[8] = {'P', 'H', 'H', 'E', 'P', 'M', 'C', 'B'};
+  const uint32_t file_version = 1;
+  const uint32_t event_tag = 0x45564e54;  // "EVNT"
+
+  template <typename T>
+  void put(std::ostream &out, const T &value)
+  {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  T get(std::istream &in)
+  {
+    T value{};
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return value;
+  }
+
+  void put_fourvector(std::ostream &out, const HepMC::FourVector &v)
+  {
+    put(out, v.x());
+    put(out, v.y());
+    put(out, v.z());
+    put(out, v.t());
+  }
+
+  // upper limits for the counts read from a file, anything above means the file is corrupt
+  const uint32_t max_weights = 1U << 16U;
+  const uint32_t max_random_states = 1U << 16U;
+  const uint32_t max_vertices = 1U << 24U;
+  const uint32_t max_particles_per_vertex = 1U << 24U;
+
+  // count of the following entries, false if the stream is bad or the count exceeds maxcount
+  bool get_count(std::istream &in, uint32_t maxcount, uint32_t &count)
+  {
+    count = get<uint32_t>(in);
+    return in.good() && count <= maxcount;
+  }
+
+  HepMC::FourVector get_fourvector(std::istream &in)
+  {
+    const double x = get<double>(in);
+    const double y = get<double>(in);
+    const double z = get<double>(in);
+    const double t = get<double>(in);
+    return HepMC::FourVector(x, y, z, t);
+  }
+
+  void put_particle(std::ostream &out, const HepMC::GenParticle *p)
+  {
+    put(out, static_cast<int32_t>(p->barcode()));
+    put(out, static_cast<int32_t>(p->pdg_id()));
+    put(out, static_cast<int32_t>(p->status()));
+    put_fourvector(out, p->momentum());
+    put(out, p->generated_mass());
+    put(out, static_cast<int32_t>(p->end_vertex() ? p->end_vertex()->barcode() : 0));
+  }
+}  // namespace
+
+PHHepMCBinaryIO::PHHepMCBinaryIO(const std::string &filename, std::ios::openmode mode)
+{
+  if (mode & std::ios::out)
+  {
+    m_File.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    m_File.write(file_magic, sizeof(file_magic));
+    put(m_File, file_version);
+    m_Good = m_File.good();
+  }
+  else
+  {
+    m_File.open(filename, std::ios::in | std::ios::binary);
+    char magic[sizeof(file_magic)] = {0};
+    m_File.read(magic, sizeof(magic));
+    const uint32_t version = get<uint32_t>(m_File);
+    m_Good = m_File.good() && std::equal(magic, magic + sizeof(magic), file_magic) && version == file_version;
+  }
+  if (!m_Good)
+  {
+    std::cout << "PHHepMCBinaryIO: " << filename << " could not be opened as binary HepMC file (version "
+              << file_version << ")" << std::endl;
+  }
+}
+
+bool PHHepMCBinaryIO::is_binary_file(const std::string &filename)
+{
+  TString tstr(filename);
+  TPRegexp binary_ext(".hepmcbin$");
+  return tstr.Contains(binary_ext);
+}
+
+bool PHHepMCBinaryIO::write_event(const HepMC::GenEvent *evt)
+{
+  if (!m_Good || !evt)
+  {
+    return false;
+  }
+  put(m_File, event_tag);
+  put(m_File, static_cast<int32_t>(evt->event_number()));
+  put(m_File, static_cast<int32_t>(evt->signal_process_id()));
+  put(m_File, static_cast<int32_t>(evt->mpi()));
+  put(m_File, evt->event_scale());
+  put(m_File, evt->alphaQCD());
+  put(m_File, evt->alphaQED());
+  put(m_File, static_cast<int32_t>(evt->momentum_unit()));
+  put(m_File, static_cast<int32_t>(evt->length_unit()));
+  put(m_File, static_cast<int32_t>(evt->signal_process_vertex() ? evt->signal_process_vertex()->barcode() : 0));
+  const std::pair<HepMC::GenParticle *, HepMC::GenParticle *> beams = evt->beam_particles();
+  put(m_File, static_cast<int32_t>(beams.first ? beams.first->barcode() : 0));
+  put(m_File, static_cast<int32_t>(beams.second ? beams.second->barcode() : 0));
+
+  const HepMC::WeightContainer &weights = evt->weights();
+  put(m_File, static_cast<uint32_t>(weights.size()));
+  for (size_t i = 0; i < weights.size(); i++)
+  {
+    put(m_File, weights[i]);
+  }
+  const std::vector<long> &random_states = evt->random_states();
+  put(m_File, static_cast<uint32_t>(random_states.size()));
+  for (long state : random_states)
+  {
+    put(m_File, static_cast<int64_t>(state));
+  }
+
+  const HepMC::GenCrossSection *xsec = evt->cross_section();
+  put(m_File, static_cast<uint8_t>(xsec != nullptr));
+  if (xsec)
+  {
+    put(m_File, xsec->cross_section());
+    put(m_File, xsec->cross_section_error());
+  }
+  const HepMC::HeavyIon *hi = evt->heavy_ion();
+  put(m_File, static_cast<uint8_t>(hi != nullptr));
+  if (hi)
+  {
+    put(m_File, static_cast<int32_t>(hi->Ncoll_hard()));
+    put(m_File, static_cast<int32_t>(hi->Npart_proj()));
+    put(m_File, static_cast<int32_t>(hi->Npart_targ()));
+    put(m_File, static_cast<int32_t>(hi->Ncoll()));
+    put(m_File, static_cast<int32_t>(hi->spectator_neutrons()));
+    put(m_File, static_cast<int32_t>(hi->spectator_protons()));
+    put(m_File, static_cast<int32_t>(hi->N_Nwounded_collisions()));
+    put(m_File, static_cast<int32_t>(hi->Nwounded_N_collisions()));
+    put(m_File, static_cast<int32_t>(hi->Nwounded_Nwounded_collisions()));
+    put(m_File, static_cast<float>(hi->impact_parameter()));
+    put(m_File, static_cast<float>(hi->event_plane_angle()));
+    put(m_File, static_cast<float>(hi->eccentricity()));
+    put(m_File, static_cast<float>(hi->sigma_inel_NN()));
+  }
+  const HepMC::PdfInfo *pdf = evt->pdf_info();
+  put(m_File, static_cast<uint8_t>(pdf != nullptr));
+  if (pdf)
+  {
+    put(m_File, static_cast<int32_t>(pdf->id1()));
+    put(m_File, static_cast<int32_t>(pdf->id2()));
+    put(m_File, pdf->x1());
+    put(m_File, pdf->x2());
+    put(m_File, pdf->scalePDF());
+    put(m_File, pdf->pdf1());
+    put(m_File, pdf->pdf2());
+    put(m_File, static_cast<int32_t>(pdf->pdf_id1()));
+    put(m_File, static_cast<int32_t>(pdf->pdf_id2()));
+  }
+
+  // same layout as IO_GenEvent: every vertex followed by its incoming particles
+  // without production vertex and its outgoing particles
+  put(m_File, static_cast<uint32_t>(evt->vertices_size()));
+  for (HepMC::GenEvent::vertex_const_iterator v = evt->vertices_begin(); v != evt->vertices_end(); ++v)
+  {
+    std::vector<const HepMC::GenParticle *> orphans;
+    for (HepMC::GenVertex::particles_in_const_iterator p = (*v)->particles_in_const_begin(); p != (*v)->particles_in_const_end(); ++p)
+    {
+      if (!(*p)->production_vertex())
+      {
+        orphans.push_back(*p);
+      }
+    }
+    put(m_File, static_cast<int32_t>((*v)->barcode()));
+    put(m_File, static_cast<int32_t>((*v)->id()));
+    put_fourvector(m_File, (*v)->position());
+    put(m_File, static_cast<uint32_t>(orphans.size()));
+    put(m_File, static_cast<uint32_t>((*v)->particles_out_size()));
+    for (const HepMC::GenParticle *p : orphans)
+    {
+      put_particle(m_File, p);
+    }
+    for (HepMC::GenVertex::particles_out_const_iterator p = (*v)->particles_out_const_begin(); p != (*v)->particles_out_const_end(); ++p)
+    {
+      put_particle(m_File, *p);
+    }
+  }
+  return m_File.good();
+}
+
+HepMC::GenEvent *PHHepMCBinaryIO::read_next_event()
+{
+  if (!m_Good)
+  {
+    return nullptr;
+  }
+  const uint32_t tag = get<uint32_t>(m_File);
+  if (!m_File.good())
+  {
+    // regular end of file
+    m_Good = false;
+    return nullptr;
+  }
+  if (tag != event_tag)
+  {
+    std::cout << "PHHepMCBinaryIO::read_next_event - corrupt file, bad event tag " << tag << std::endl;
+    m_Good = false;
+    return nullptr;
+  }
+
+  const int32_t event_number = get<int32_t>(m_File);
+  const int32_t signal_process_id = get<int32_t>(m_File);
+  const int32_t mpi = get<int32_t>(m_File);
+  const double event_scale = get<double>(m_File);
+  const double alpha_qcd = get<double>(m_File);
+  const double alpha_qed = get<double>(m_File);
+  const int32_t momentum_unit = get<int32_t>(m_File);
+  const int32_t length_unit = get<int32_t>(m_File);
+  const int32_t signal_vertex = get<int32_t>(m_File);
+  const int32_t beam1 = get<int32_t>(m_File);
+  const int32_t beam2 = get<int32_t>(m_File);
+
+  HepMC::GenEvent *evt = new HepMC::GenEvent(static_cast<HepMC::Units::MomentumUnit>(momentum_unit),
+                                             static_cast<HepMC::Units::LengthUnit>(length_unit));
+  evt->set_event_number(event_number);
+  evt->set_signal_process_id(signal_process_id);
+  evt->set_mpi(mpi);
+  evt->set_event_scale(event_scale);
+  evt->set_alphaQCD(alpha_qcd);
+  evt->set_alphaQED(alpha_qed);
+
+  uint32_t nweights = 0;
+  if (!get_count(m_File, max_weights, nweights))
+  {
+    return corrupt_event(evt, event_number, "number of weights");
+  }
+  for (uint32_t i = 0; i < nweights; i++)
+  {
+    evt->weights().push_back(get<double>(m_File));
+  }
+  uint32_t nrandom = 0;
+  if (!get_count(m_File, max_random_states, nrandom))
+  {
+    return corrupt_event(evt, event_number, "number of random states");
+  }
+  std::vector<long> random_states(nrandom);
+  for (long &state : random_states)
+  {
+    state = get<int64_t>(m_File);
+  }
+  evt->set_random_states(random_states);
+
+  if (get<uint8_t>(m_File))
+  {
+    const double xs = get<double>(m_File);
+    const double xs_err = get<double>(m_File);
+    HepMC::GenCrossSection xsec;
+    xsec.set_cross_section(xs, xs_err);
+    evt->set_cross_section(xsec);
+  }
+  if (get<uint8_t>(m_File))
+  {
+    int32_t hi_int[9];
+    for (int32_t &val : hi_int)
+    {
+      val = get<int32_t>(m_File);
+    }
+    float hi_float[4];
+    for (float &val : hi_float)
+    {
+      val = get<float>(m_File);
+    }
+    HepMC::HeavyIon hi(hi_int[0], hi_int[1], hi_int[2], hi_int[3], hi_int[4], hi_int[5], hi_int[6], hi_int[7], hi_int[8],
+                       hi_float[0], hi_float[1], hi_float[2], hi_float[3]);
+    evt->set_heavy_ion(hi);
+  }
+  if (get<uint8_t>(m_File))
+  {
+    const int32_t id1 = get<int32_t>(m_File);
+    const int32_t id2 = get<int32_t>(m_File);
+    const double x1 = get<double>(m_File);
+    const double x2 = get<double>(m_File);
+    const double scale = get<double>(m_File);
+    const double pdf1 = get<double>(m_File);
+    const double pdf2 = get<double>(m_File);
+    const int32_t pdf_id1 = get<int32_t>(m_File);
+    const int32_t pdf_id2 = get<int32_t>(m_File);
+    evt->set_pdf_info(HepMC::PdfInfo(id1, id2, x1, x2, scale, pdf1, pdf2, pdf_id1, pdf_id2));
+  }
+
+  // particles are connected to their end vertices once all vertices exist
+  std::vector<std::pair<HepMC::GenParticle *, int>> end_vertices;
+  uint32_t nvertices = 0;
+  if (!get_count(m_File, max_vertices, nvertices))
+  {
+    return corrupt_event(evt, event_number, "number of vertices");
+  }
+  for (uint32_t iv = 0; iv < nvertices && m_File.good(); iv++)
+  {
+    const int32_t vertex_barcode = get<int32_t>(m_File);
+    const int32_t id = get<int32_t>(m_File);
+    const HepMC::FourVector position = get_fourvector(m_File);
+    uint32_t norphans = 0;
+    uint32_t nout = 0;
+    if (!get_count(m_File, max_particles_per_vertex, norphans) ||
+        !get_count(m_File, max_particles_per_vertex, nout))
+    {
+      return corrupt_event(evt, event_number, "number of particles");
+    }
+    HepMC::GenVertex *v = new HepMC::GenVertex(position, id);
+    v->suggest_barcode(vertex_barcode);
+    evt->add_vertex(v);
+    for (uint32_t ip = 0; ip < norphans + nout && m_File.good(); ip++)
+    {
+      const int32_t barcode = get<int32_t>(m_File);
+      const int32_t pdg_id = get<int32_t>(m_File);
+      const int32_t status = get<int32_t>(m_File);
+      const HepMC::FourVector momentum = get_fourvector(m_File);
+      const double generated_mass = get<double>(m_File);
+      const int32_t end_vertex = get<int32_t>(m_File);
+      HepMC::GenParticle *p = new HepMC::GenParticle(momentum, pdg_id, status);
+      p->set_generated_mass(generated_mass);
+      p->suggest_barcode(barcode);
+      if (ip < norphans)
+      {
+        v->add_particle_in(p);
+      }
+      else
+      {
+        v->add_particle_out(p);
+        if (end_vertex != 0)
+        {
+          end_vertices.emplace_back(p, end_vertex);
+        }
+      }
+    }
+  }
+  if (!m_File.good())
+  {
+    return corrupt_event(evt, event_number, "event content");
+  }
+  for (const auto &p_vtx : end_vertices)
+  {
+    if (HepMC::GenVertex *v = evt->barcode_to_vertex(p_vtx.second))
+    {
+      v->add_particle_in(p_vtx.first);
+    }
+  }
+  if (signal_vertex != 0)
+  {
+    evt->set_signal_process_vertex(evt->barcode_to_vertex(signal_vertex));
+  }
+  if (beam1 != 0 && beam2 != 0)
+  {
+    evt->set_beam_particles(evt->barcode_to_particle(beam1), evt->barcode_to_particle(beam2));
+  }
+  return evt;
+}
+
+HepMC::GenEvent *PHHepMCBinaryIO::corrupt_event(HepMC::GenEvent *evt, int event_number, const std::string &what)
+{
+  std::cout << "PHHepMCBinaryIO::read_next_event - truncated or corrupt " << what
+            << " in event " << event_number << std::endl;
+  m_Good = false;
+  delete evt;
+  return nullptr;
+}
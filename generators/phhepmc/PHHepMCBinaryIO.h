@@ -0,0 +1,49 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef PHHEPMC_PHHEPMCBINARYIO_H
+#define PHHEPMC_PHHEPMCBINARYIO_H
+
+#include <fstream>
+#include <string>
+
+namespace HepMC
+{
+  class GenEvent;
+}
+
+/*!
+ * \brief Compact binary cache of HepMC events
+ *
+ * Stores everything the ascii IO_GenEvent format keeps except color flow and
+ * polarization, without any text formatting or parsing. Meant to cache generator
+ * samples which are read many times, files are written in the native byte order.
+ * Fun4AllHepMCOutputManager writes and Fun4AllHepMCInputManager reads files with
+ * the .hepmcbin extension in this format.
+ */
+class PHHepMCBinaryIO
+{
+ public:
+  //! open for reading (std::ios::in) or writing (std::ios::out)
+  PHHepMCBinaryIO(const std::string &filename, std::ios::openmode mode);
+  virtual ~PHHepMCBinaryIO() = default;
+
+  //! false if the file could not be opened or the header is wrong
+  bool is_good() const { return m_Good; }
+
+  bool write_event(const HepMC::GenEvent *evt);
+
+  //! next event (owned by the caller), nullptr at the end of the file
+  HepMC::GenEvent *read_next_event();
+
+  //! true for file names with the .hepmcbin extension
+  static bool is_binary_file(const std::string &filename);
+
+ private:
+  //! report a bad event, stop reading and delete the partially read event
+  HepMC::GenEvent *corrupt_event(HepMC::GenEvent *evt, int event_number, const std::string &what);
+
+  std::fstream m_File;
+  bool m_Good = false;
+};
+
+#endif /* PHHEPMC_PHHEPMCBINARYIO_H */
@@ -27,6 +27,8 @@
 #include <TH1.h>
 #include <TH2.h>
 
+#include <omp.h>
+
 #include <format>
 
 //____________________________________________________________________________..
@@ -78,65 +80,62 @@ int InttClusterQA::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  // group the hitsets by sensor, all crossings of a sensor going to the same partition,
+  // so that the per sensor histograms and counters are only filled by one thread
+  std::map<TrkrDefs::hitsetkey, QAClusterCache::Partition> sensorHitSets;
   for (auto &hsk : clusterContainer->getHitSetKeys(TrkrDefs::TrkrId::inttId))
   {
-    int numclusters = 0;
-    auto range = clusterContainer->getClusters(hsk);
-    auto layer = TrkrDefs::getLayer(hsk);
-    auto ladderphiid = InttDefs::getLadderPhiId(hsk);
-    auto sensor = InttDefs::getLadderZId(hsk);
+    sensorHitSets[InttDefs::resetCrossing(hsk)].push_back(hsk);
+  }
+  std::vector<QAClusterCache::Partition> partitions;
+  partitions.reserve(sensorHitSets.size());
+  for (auto &[sensorkey, hitsetkeys] : sensorHitSets)
+  {
+    partitions.push_back(std::move(hitsetkeys));
+  }
 
-    if (m_sensorInfo)
+  const int nthreads = m_clusterHistos.size();
+  m_clusterCache.fill(clusterContainer, tGeometry, partitions, nthreads);
+
+  const int npartitions = m_clusterCache.npartitions();
+  int totalClusters = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) reduction(+ : totalClusters)
+  for (int ipartition = 0; ipartition < npartitions; ++ipartition)
+  {
+    const auto &histos = m_clusterHistos[omp_get_thread_num()];
+    for (auto ientry = m_clusterCache.begin(ipartition); ientry < m_clusterCache.end(ipartition); ++ientry)
     {
-      for (auto iter = range.first; iter != range.second; ++iter)
+      const auto &entry = m_clusterCache.entry(ientry);
+      auto *const cluster = entry.cluster;
+      const auto &globalpos = entry.global;
+      auto phi = atan2(globalpos(1), globalpos(0));
+      auto clayer = TrkrDefs::getLayer(entry.key);
+      if (m_sensorInfo)
       {
-        const auto cluskey = iter->first;
-        auto *const cluster = iter->second;
-        auto globalpos = tGeometry->getGlobalPosition(cluskey, cluster);
-        auto phi = atan2(globalpos(1), globalpos(0));
-        auto clayer = TrkrDefs::getLayer(cluskey);
-        h_cluspersensor[(int) (layer) -3][(int) ladderphiid][(int) sensor]->Fill(cluster->getLocalY(), cluster->getLocalX());
-        h_clusPhi_incl->Fill(phi);
-        if (clayer == 3 || clayer == 4)
-        {
-          h_clusPhi_l34->Fill(phi);
-          h_clusZ_clusPhi_l34->Fill(globalpos(2), phi);
-        }
-        else if (clayer == 5 || clayer == 6)
-        {
-          h_clusPhi_l56->Fill(phi);
-          h_clusZ_clusPhi_l56->Fill(globalpos(2), phi);
-        }
-
-        m_totalClusters++;
-        numclusters++;
+        auto ladderphiid = InttDefs::getLadderPhiId(entry.key);
+        auto sensor = InttDefs::getLadderZId(entry.key);
+        h_cluspersensor[(int) (clayer) -3][(int) ladderphiid][(int) sensor]->Fill(cluster->getLocalY(), cluster->getLocalX());
+        m_nclustersPerSensor[((int) clayer) - 3][(int) ladderphiid][(int) sensor]++;
+        totalClusters++;
       }
-      m_nclustersPerSensor[((int) layer) - 3][(int) ladderphiid][(int) sensor] += numclusters;
-    }
-    else
-    {
-      for (auto iter = range.first; iter != range.second; ++iter)
+      else
       {
-        const auto cluskey = iter->first;
-        auto *const cluster = iter->second;
-        auto globalpos = tGeometry->getGlobalPosition(cluskey, cluster);
-        auto phi = atan2(globalpos(1), globalpos(0));
-        auto clayer = TrkrDefs::getLayer(cluskey);
-        h_clusSize->Fill(cluster->getSize());
-        h_clusPhi_incl->Fill(phi);
-        if (clayer == 3 || clayer == 4)
-        {
-          h_clusPhi_l34->Fill(phi);
-          h_clusZ_clusPhi_l34->Fill(globalpos(2), phi);
-        }
-        else if (clayer == 5 || clayer == 6)
-        {
-          h_clusPhi_l56->Fill(phi);
-          h_clusZ_clusPhi_l56->Fill(globalpos(2), phi);
-        }
+        histos.clusSize->Fill(cluster->getSize());
+      }
+      histos.clusPhi_incl->Fill(phi);
+      if (clayer == 3 || clayer == 4)
+      {
+        histos.clusPhi_l34->Fill(phi);
+        histos.clusZ_clusPhi_l34->Fill(globalpos(2), phi);
+      }
+      else if (clayer == 5 || clayer == 6)
+      {
+        histos.clusPhi_l56->Fill(phi);
+        histos.clusZ_clusPhi_l56->Fill(globalpos(2), phi);
       }
     }
   }
+  m_totalClusters += totalClusters;
 
   TrkrHitSetContainer::ConstRange hitsetrange = trkrHitSetContainer->getHitSets(TrkrDefs::TrkrId::inttId);
 
@@ -147,12 +146,14 @@ int InttClusterQA::process_event(PHCompositeNode *topNode)
     h_occupancy->Fill(100. * sensor_occupancy);
   }
 
+  m_threadHistos.end_event();
   m_event++;
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 int InttClusterQA::EndRun(const int /*runnumber*/)
 {
+  m_threadHistos.merge();
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -214,5 +215,28 @@ void InttClusterQA::createHistos()
     }
   }
 
+  // thread local copies of the cluster histograms. The per sensor histograms are not copied,
+  // each sensor being filled by a single thread
+  m_threadHistos.clear();
+  for (auto *histo : {h_clusSize, h_clusPhi_incl, h_clusPhi_l34, h_clusPhi_l56,
+                      static_cast<TH1 *>(h_clusZ_clusPhi_l34), static_cast<TH1 *>(h_clusZ_clusPhi_l56)})
+  {
+    m_threadHistos.add(histo);
+  }
+  m_threadHistos.init(m_num_threads);
+
+  m_clusterHistos.clear();
+  for (int thread = 0; thread < m_threadHistos.get_num_threads(); ++thread)
+  {
+    ClusterHistos histos;
+    histos.clusSize = m_threadHistos.get(0, thread);
+    histos.clusPhi_incl = m_threadHistos.get(1, thread);
+    histos.clusPhi_l34 = m_threadHistos.get(2, thread);
+    histos.clusPhi_l56 = m_threadHistos.get(3, thread);
+    histos.clusZ_clusPhi_l34 = static_cast<TH2 *>(m_threadHistos.get(4, thread));
+    histos.clusZ_clusPhi_l56 = static_cast<TH2 *>(m_threadHistos.get(5, thread));
+    m_clusterHistos.push_back(histos);
+  }
+
   return;
 }
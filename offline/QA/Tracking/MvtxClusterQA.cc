@@ -28,6 +28,8 @@
 #include <TH1.h>
 #include <TH2.h>
 
+#include <omp.h>
+
 #include <format>
 
 //____________________________________________________________________________..
@@ -89,88 +91,56 @@ int MvtxClusterQA::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
-  int numclusters = 0;
+  // group the hitsets by chip, all strobes of a chip going to the same partition,
+  // so that the per chip histograms and counters are only filled by one thread
+  std::map<TrkrDefs::hitsetkey, QAClusterCache::Partition> chipHitSets;
   for (auto &hsk : clusterContainer->getHitSetKeys(TrkrDefs::TrkrId::mvtxId))
   {
-    auto range = clusterContainer->getClusters(hsk);
-    for (auto iter = range.first; iter != range.second; ++iter)
-    {
-      numclusters++;
-    }
+    chipHitSets[MvtxDefs::resetStrobe(hsk)].push_back(hsk);
   }
-
-  for (auto &hsk : clusterContainer->getHitSetKeys(TrkrDefs::TrkrId::mvtxId))
+  std::vector<QAClusterCache::Partition> partitions;
+  partitions.reserve(chipHitSets.size());
+  for (auto &[chipkey, hitsetkeys] : chipHitSets)
   {
-    int numclusters_chip = 0;
-    auto range = clusterContainer->getClusters(hsk);
-    auto layer = TrkrDefs::getLayer(hsk);
-    auto stave = MvtxDefs::getStaveId(hsk);
-    auto chip = MvtxDefs::getChipId(hsk);
+    partitions.push_back(std::move(hitsetkeys));
+  }
 
-    if (m_chipInfo)
+  const int nthreads = m_clusterHistos.size();
+  m_clusterCache.fill(clusterContainer, tGeometry, partitions, nthreads);
+  const int numclusters = m_clusterCache.size();
+
+  const int npartitions = m_clusterCache.npartitions();
+  int totalClusters = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) reduction(+ : totalClusters)
+  for (int ipartition = 0; ipartition < npartitions; ++ipartition)
+  {
+    const auto &histos = m_clusterHistos[omp_get_thread_num()];
+    for (auto ientry = m_clusterCache.begin(ipartition); ientry < m_clusterCache.end(ipartition); ++ientry)
     {
-      for (auto iter = range.first; iter != range.second; ++iter)
+      const auto &entry = m_clusterCache.entry(ientry);
+      auto *const cluster = entry.cluster;
+      const auto &globalpos = entry.global;
+      auto phi = atan2(globalpos(1), globalpos(0));
+      auto clayer = TrkrDefs::getLayer(entry.key);
+      if (m_chipInfo)
       {
-        const auto cluskey = iter->first;
-        auto *const cluster = iter->second;
-        auto globalpos = tGeometry->getGlobalPosition(cluskey, cluster);
-        auto phi = atan2(globalpos(1), globalpos(0));
-        auto clayer = TrkrDefs::getLayer(cluskey);
-        h_clusperchip[(int) layer][(int) stave][(int) chip]->Fill(cluster->getLocalY(), cluster->getLocalX());
-        h_clusSize->Fill(cluster->getSize());
-        h_clusSize_nClus->Fill(numclusters, cluster->getSize());
-        h_clusPhi_incl->Fill(phi);
-        if (clayer == 0)
-        {
-          h_clusPhi_l0->Fill(phi);
-          h_clusZ_clusPhi_l0->Fill(globalpos(2), phi);
-        }
-        else if (clayer == 1)
-        {
-          h_clusPhi_l1->Fill(phi);
-          h_clusZ_clusPhi_l1->Fill(globalpos(2), phi);
-        }
-        else if (clayer == 2)
-        {
-          h_clusPhi_l2->Fill(phi);
-          h_clusZ_clusPhi_l2->Fill(globalpos(2), phi);
-        }
-        m_totalClusters++;
-        numclusters_chip++;
+        auto stave = MvtxDefs::getStaveId(entry.key);
+        auto chip = MvtxDefs::getChipId(entry.key);
+        h_clusperchip[(int) clayer][(int) stave][(int) chip]->Fill(cluster->getLocalY(), cluster->getLocalX());
+        m_nclustersPerChip[(int) clayer][(int) stave][(int) chip]++;
+        totalClusters++;
       }
-
-      m_nclustersPerChip[(int) layer][(int) stave][(int) chip] += numclusters_chip;
-    }
-    else
-    {
-      for (auto iter = range.first; iter != range.second; ++iter)
+      histos.clusSize->Fill(cluster->getSize());
+      histos.clusSize_nClus->Fill(numclusters, cluster->getSize());
+      histos.clusPhi_incl->Fill(phi);
+      if (clayer < 3)
       {
-        const auto cluskey = iter->first;
-        auto *const cluster = iter->second;
-        auto globalpos = tGeometry->getGlobalPosition(cluskey, cluster);
-        auto phi = atan2(globalpos(1), globalpos(0));
-        auto clayer = TrkrDefs::getLayer(cluskey);
-        h_clusSize->Fill(cluster->getSize());
-        h_clusSize_nClus->Fill(numclusters, cluster->getSize());
-        h_clusPhi_incl->Fill(phi);
-        if (clayer == 0)
-        {
-          h_clusPhi_l0->Fill(phi);
-          h_clusZ_clusPhi_l0->Fill(globalpos(2), phi);
-        }
-        else if (clayer == 1)
-        {
-          h_clusPhi_l1->Fill(phi);
-          h_clusZ_clusPhi_l1->Fill(globalpos(2), phi);
-        }
-        else if (clayer == 2)
-        {
-          h_clusPhi_l2->Fill(phi);
-          h_clusZ_clusPhi_l2->Fill(globalpos(2), phi);
-        }
+        histos.clusPhi[clayer]->Fill(phi);
+        histos.clusZ_clusPhi[clayer]->Fill(globalpos(2), phi);
       }
     }
   }
+  m_totalClusters += totalClusters;
 
   TrkrHitSetContainer::ConstRange hitsetrange = trkrHitSetContainer->getHitSets(TrkrDefs::TrkrId::mvtxId);
 
@@ -187,11 +157,13 @@ int MvtxClusterQA::process_event(PHCompositeNode *topNode)
     }
   }
 
+  m_threadHistos.end_event();
   m_event++;
   return Fun4AllReturnCodes::EVENT_OK;
 }
 int MvtxClusterQA::EndRun(const int /*runnumber*/)
 {
+  m_threadHistos.merge();
   return Fun4AllReturnCodes::EVENT_OK;
 }
 //____________________________________________________________________________..
@@ -270,5 +242,31 @@ void MvtxClusterQA::createHistos()
     }
   }
 
+  // thread local copies of the cluster histograms. The per chip histograms are not copied,
+  // each chip being filled by a single thread
+  m_threadHistos.clear();
+  for (auto *histo : {h_clusSize, static_cast<TH1 *>(h_clusSize_nClus), h_clusPhi_incl,
+                      h_clusPhi_l0, h_clusPhi_l1, h_clusPhi_l2,
+                      static_cast<TH1 *>(h_clusZ_clusPhi_l0), static_cast<TH1 *>(h_clusZ_clusPhi_l1), static_cast<TH1 *>(h_clusZ_clusPhi_l2)})
+  {
+    m_threadHistos.add(histo);
+  }
+  m_threadHistos.init(m_num_threads);
+
+  m_clusterHistos.clear();
+  for (int thread = 0; thread < m_threadHistos.get_num_threads(); ++thread)
+  {
+    ClusterHistos histos;
+    histos.clusSize = m_threadHistos.get(0, thread);
+    histos.clusSize_nClus = static_cast<TH2 *>(m_threadHistos.get(1, thread));
+    histos.clusPhi_incl = m_threadHistos.get(2, thread);
+    for (int layer = 0; layer < 3; ++layer)
+    {
+      histos.clusPhi[layer] = m_threadHistos.get(3 + layer, thread);
+      histos.clusZ_clusPhi[layer] = static_cast<TH2 *>(m_threadHistos.get(6 + layer, thread));
+    }
+    m_clusterHistos.push_back(histos);
+  }
+
   return;
 }
@@ -3,12 +3,17 @@
 #ifndef QA_TRACKING_MVTXCLUSTERQA_H
 #define QA_TRACKING_MVTXCLUSTERQA_H
 
+#include "QAClusterCache.h"
+
 #include <fun4all/SubsysReco.h>
 
+#include <qautils/QAThreadHistos.h>
+
 #include <cmath>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class TH1;
@@ -30,9 +35,30 @@ class MvtxClusterQA : public SubsysReco
     m_chipInfo = value;
   }
 
+  //! number of threads used to fill the cluster histograms
+  void set_num_threads(int n) { m_num_threads = n; }
+
+  //! merge the thread local histograms every n events, on top of EndRun
+  void set_merge_interval(int n) { m_threadHistos.set_merge_interval(n); }
+
  private:
   void createHistos();
 
+  //! cluster histograms filled by one thread
+  struct ClusterHistos
+  {
+    TH1 *clusSize{nullptr};
+    TH2 *clusSize_nClus{nullptr};
+    TH1 *clusPhi_incl{nullptr};
+    TH1 *clusPhi[3]{nullptr, nullptr, nullptr};
+    TH2 *clusZ_clusPhi[3]{nullptr, nullptr, nullptr};
+  };
+
+  int m_num_threads = 1;
+  QAThreadHistos m_threadHistos;
+  std::vector<ClusterHistos> m_clusterHistos;
+  QAClusterCache m_clusterCache;
+
   std::string getHistoPrefix() const;
   std::map<int, int> m_layerStaveMap;
   int m_event = 0;
@@ -0,0 +1,32 @@
+#include "QAClusterCache.h"
+
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterContainer.h>
+
+//____________________________________________________________________________..
+void QAClusterCache::fill(TrkrClusterContainer *clusterContainer, ActsGeometry *tGeometry, const std::vector<Partition> &partitions, int nthreads)
+{
+  m_entries.clear();
+  m_offsets.assign(1, 0);
+
+  for (const auto &partition : partitions)
+  {
+    for (const auto &hsk : partition)
+    {
+      auto range = clusterContainer->getClusters(hsk);
+      for (auto iter = range.first; iter != range.second; ++iter)
+      {
+        m_entries.push_back({iter->first, iter->second, Acts::Vector3::Zero()});
+      }
+    }
+    m_offsets.push_back(m_entries.size());
+  }
+
+  const int nentries = m_entries.size();
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+  for (int i = 0; i < nentries; ++i)
+  {
+    auto &entry = m_entries[i];
+    entry.global = tGeometry->getGlobalPosition(entry.key, entry.cluster);
+  }
+}
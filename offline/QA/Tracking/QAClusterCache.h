@@ -0,0 +1,56 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef QA_TRACKING_QACLUSTERCACHE_H
+#define QA_TRACKING_QACLUSTERCACHE_H
+
+#include <trackbase/ActsGeometry.h>
+#include <trackbase/TrkrDefs.h>
+
+#include <cstddef>
+#include <vector>
+
+class TrkrCluster;
+class TrkrClusterContainer;
+
+/*!
+ * Flat per event list of clusters and their global positions, grouped in partitions of hitsets.
+ * The list is built serially, since TrkrClusterContainer::getClusters is not reentrant,
+ * the global positions are then calculated in parallel, once per cluster.
+ * Cluster QA modules fill their histograms from it in parallel, one partition per task.
+ */
+class QAClusterCache
+{
+ public:
+  using Partition = std::vector<TrkrDefs::hitsetkey>;
+
+  struct Entry
+  {
+    TrkrDefs::cluskey key = 0;
+    TrkrCluster *cluster = nullptr;
+    Acts::Vector3 global = Acts::Vector3::Zero();
+  };
+
+  //! fill clusters and global positions for the given hitset partitions
+  void fill(TrkrClusterContainer *clusterContainer, ActsGeometry *tGeometry, const std::vector<Partition> &partitions, int nthreads);
+
+  //! number of partitions
+  std::size_t npartitions() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+
+  //! number of clusters
+  std::size_t size() const { return m_entries.size(); }
+
+  //! first entry of a given partition
+  std::size_t begin(std::size_t partition) const { return m_offsets[partition]; }
+
+  //! one past the last entry of a given partition
+  std::size_t end(std::size_t partition) const { return m_offsets[partition + 1]; }
+
+  //! cluster entry
+  const Entry &entry(std::size_t index) const { return m_entries[index]; }
+
+ private:
+  std::vector<Entry> m_entries;
+  std::vector<std::size_t> m_offsets;
+};
+
+#endif  // QA_TRACKING_QACLUSTERCACHE_H
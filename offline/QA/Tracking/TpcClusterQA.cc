@@ -30,6 +30,8 @@
 #include <TH1.h>
 #include <TH2.h>
 
+#include <omp.h>
+
 #include <format>
 
 //____________________________________________________________________________..
@@ -96,67 +98,37 @@ int TpcClusterQA::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
-  struct HistoList
-  {
-    TH1 *crphisize_side0 = nullptr;
-    TH1 *crphisize_side1 = nullptr;
-    TH1 *czsize = nullptr;
-    TH1 *crphierr = nullptr;
-    TH1 *czerr = nullptr;
-    TH1 *cedge = nullptr;
-    TH1 *coverlap = nullptr;
-    TH1 *cxposition_side0 = nullptr;
-    TH1 *cxposition_side1 = nullptr;
-    TH1 *cyposition_side0 = nullptr;
-    TH1 *cyposition_side1 = nullptr;
-    TH1 *czposition_side0 = nullptr;
-    TH1 *czposition_side1 = nullptr;
-  };
-
-  int hitsetkeynum = 0;
-  using HistoMap = std::map<int, HistoList>;
-  HistoMap histos;
-
-  for (const auto &region : {0, 1, 2})
-  {
-    HistoList hist;
-    hist.crphisize_side0 = h_phisize_side0[region];
-    hist.crphisize_side1 = h_phisize_side1[region];
-    hist.czsize = h_zsize[region];
-    hist.crphierr = h_rphierror[region];
-    hist.czerr = h_zerror[region];
-    hist.cedge = h_clusedge[region];
-    hist.coverlap = h_clusoverlap[region];
-
-    hist.cxposition_side0 = h_clusxposition_side0[region];
-    hist.cxposition_side1 = h_clusxposition_side1[region];
-
-    hist.cyposition_side0 = h_clusyposition_side0[region];
-    hist.cyposition_side1 = h_clusyposition_side1[region];
-
-    hist.czposition_side0 = h_cluszposition_side0[region];
-    hist.czposition_side1 = h_cluszposition_side1[region];
-
-    histos.insert(std::make_pair(region, hist));
-  }
-  auto fill = [](TH1 *h, float val)
-  { if (h) { h->Fill(val); 
-} };
+  const int nthreads = m_histos.size();
 
+  // hits are filled in parallel, one hitset per task
+  std::vector<std::pair<TrkrDefs::hitsetkey, TrkrHitSet *>> hitsets;
   TrkrHitSetContainer::ConstRange all_hitsets = hitmap->getHitSets(TrkrDefs::TrkrId::tpcId);
   for (TrkrHitSetContainer::ConstIterator hitsetiter = all_hitsets.first;
        hitsetiter != all_hitsets.second;
        ++hitsetiter)
   {
-    auto hitsetkey = hitsetiter->first;
-    TrkrHitSet *hitset = hitsetiter->second;
-    if (TrkrDefs::getTrkrId(hitsetkey) != TrkrDefs::TrkrId::tpcId)
+    if (TrkrDefs::getTrkrId(hitsetiter->first) == TrkrDefs::TrkrId::tpcId)
     {
-      continue;
+      hitsets.emplace_back(hitsetiter->first, hitsetiter->second);
     }
+  }
+
+  const int nhitsets = hitsets.size();
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (int ihitset = 0; ihitset < nhitsets; ++ihitset)
+  {
+    const auto &histos = m_histos[omp_get_thread_num()];
+    auto hitsetkey = hitsets[ihitset].first;
+    TrkrHitSet *hitset = hitsets[ihitset].second;
     int hitlayer = TrkrDefs::getLayer(hitsetkey);
     // auto sector = TpcDefs::getSectorId(hitsetkey);
     auto m_side = TpcDefs::getSide(hitsetkey);
+    // Check TrackResiduals.cc
+    auto *geoLayer = geomContainer->GetLayerCellGeom(hitlayer);
+    auto radius = geoLayer->get_radius();
+    float AdcClockPeriod = geoLayer->get_zstep();
+    double NZBinsSide = 249;  // physical z bins per TPC side
+    double tdriftmax = AdcClockPeriod * NZBinsSide;
     auto hitrangei = hitset->getHits();
     for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
          hitr != hitrangei.second;
@@ -167,88 +139,99 @@ int TpcClusterQA::process_event(PHCompositeNode *topNode)
       // auto adc = hit->getAdc();
       auto hitpad = TpcDefs::getPad(hitkey);
       auto m_hittbin = TpcDefs::getTBin(hitkey);
-      // Check TrackResiduals.cc
-      auto *geoLayer = geomContainer->GetLayerCellGeom(hitlayer);
       auto phi = geoLayer->get_phicenter(hitpad, m_side);
-      auto radius = geoLayer->get_radius();
       auto m_hitgx = radius * std::cos(phi);
       auto m_hitgy = radius * std::sin(phi);
-      float AdcClockPeriod = geoLayer->get_zstep();
       float m_zdriftlength = m_hittbin * tGeometry->get_drift_velocity() * AdcClockPeriod;
-      double NZBinsSide = 249;  // physical z bins per TPC side
-      double tdriftmax = AdcClockPeriod * NZBinsSide;
       auto m_hitgz = (tdriftmax * tGeometry->get_drift_velocity()) - m_zdriftlength;
       if (m_side == 0)
       {
         m_hitgz *= -1;
       }
       // geoLayer->identify(std::cout);
-      h_hitpositions->Fill(m_hitgx, m_hitgy);
+      histos.hitpositions->Fill(m_hitgx, m_hitgy);
       if (m_side == 0)
       {
-        h_hitzpositions_side0->Fill(m_hitgz);
+        histos.hitzpositions_side0->Fill(m_hitgz);
       }
       if (m_side == 1)
       {
-        h_hitzpositions_side1->Fill(m_hitgz);
+        histos.hitzpositions_side1->Fill(m_hitgz);
       }
     }
   }
-  float nclusperevent[24] = {0};
+
+  // clusters and their global positions are cached once per event, then filled in parallel, one hitset per task
+  std::vector<QAClusterCache::Partition> partitions;
   for (auto &hsk : clusterContainer->getHitSetKeys(TrkrDefs::TrkrId::tpcId))
   {
-    int numclusters = 0;
-    auto range = clusterContainer->getClusters(hsk);
-    int sector = TpcDefs::getSectorId(hsk);
-    int side = TpcDefs::getSide(hsk);
-    if (side > 0)
-    {
-      sector += 12;
-    }
-    for (auto iter = range.first; iter != range.second; ++iter)
+    partitions.push_back({hsk});
+  }
+  m_clusterCache.fill(clusterContainer, tGeometry, partitions, nthreads);
+
+  auto fill = [](TH1 *h, float val)
+  { if (h) { h->Fill(val); 
+} };
+
+  const int npartitions = m_clusterCache.npartitions();
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for (int ipartition = 0; ipartition < npartitions; ++ipartition)
+  {
+    const auto &histos = m_histos[omp_get_thread_num()];
+    int side = TpcDefs::getSide(partitions[ipartition].front());
+    for (auto ientry = m_clusterCache.begin(ipartition); ientry < m_clusterCache.end(ipartition); ++ientry)
     {
-      const auto cluskey = iter->first;
-      auto *const cluster = iter->second;  // auto cluster = clusters->findCluster(key);
-      auto glob = tGeometry->getGlobalPosition(cluskey, cluster);
-      auto sclusgx = glob.x();
-      auto sclusgy = glob.y();
-      auto sclusgz = glob.z();
-
-      const auto it = m_layerRegionMap.find(TrkrDefs::getLayer(cluskey));
-      int region = it->second;
-      const auto hiter = histos.find(region);
-      if (hiter == histos.end())
+      const auto &entry = m_clusterCache.entry(ientry);
+      auto *const cluster = entry.cluster;
+      auto sclusgx = entry.global.x();
+      auto sclusgy = entry.global.y();
+      auto sclusgz = entry.global.z();
+
+      const auto it = m_layerRegionMap.find(TrkrDefs::getLayer(entry.key));
+      if (it == m_layerRegionMap.end())
       {
         continue;
       }
-      fill(hiter->second.czsize, cluster->getZSize());
-      fill(hiter->second.crphierr, cluster->getRPhiError());
-      fill(hiter->second.czerr, cluster->getZError());
-      fill(hiter->second.cedge, cluster->getEdge());
-      fill(hiter->second.coverlap, cluster->getOverlap());
+      int region = it->second;
+      fill(histos.zsize[region], cluster->getZSize());
+      fill(histos.rphierror[region], cluster->getRPhiError());
+      fill(histos.zerror[region], cluster->getZError());
+      fill(histos.clusedge[region], cluster->getEdge());
+      fill(histos.clusoverlap[region], cluster->getOverlap());
 
       if (side == 0)
       {
-        fill(hiter->second.crphisize_side0, cluster->getPhiSize());
-        fill(hiter->second.cxposition_side0, sclusgx);
-        fill(hiter->second.cyposition_side0, sclusgy);
-        fill(hiter->second.czposition_side0, sclusgz);
+        fill(histos.phisize_side0[region], cluster->getPhiSize());
+        fill(histos.clusxposition_side0[region], sclusgx);
+        fill(histos.clusyposition_side0[region], sclusgy);
+        fill(histos.cluszposition_side0[region], sclusgz);
       }
       if (side == 1)
       {
-        fill(hiter->second.crphisize_side1, cluster->getPhiSize());
-        fill(hiter->second.cxposition_side1, sclusgx);
-        fill(hiter->second.cyposition_side1, sclusgy);
-        fill(hiter->second.czposition_side1, sclusgz);
+        fill(histos.phisize_side1[region], cluster->getPhiSize());
+        fill(histos.clusxposition_side1[region], sclusgx);
+        fill(histos.clusyposition_side1[region], sclusgy);
+        fill(histos.cluszposition_side1[region], sclusgz);
       }
+    }
+  }
 
-      numclusters++;
+  // per hitset and per sector counts are filled serially, in hitset order
+  float nclusperevent[24] = {0};
+  for (int hitsetkeynum = 0; hitsetkeynum < npartitions; ++hitsetkeynum)
+  {
+    const auto hsk = partitions[hitsetkeynum].front();
+    int numclusters = m_clusterCache.end(hitsetkeynum) - m_clusterCache.begin(hitsetkeynum);
+    int sector = TpcDefs::getSectorId(hsk);
+    int side = TpcDefs::getSide(hsk);
+    if (side > 0)
+    {
+      sector += 12;
     }
 
     nclusperevent[sector] += numclusters;
     h_totalclusters->Fill(hitsetkeynum, numclusters);
     m_totalClusters += numclusters;
-    hitsetkeynum++;
   }
   for (int i = 0; i < 24; i++)
   {
@@ -256,12 +239,14 @@ int TpcClusterQA::process_event(PHCompositeNode *topNode)
     m_clustersPerSector[i] += nclusperevent[i];
   }
 
+  m_threadHistos.end_event();
   m_event++;
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int TpcClusterQA::EndRun(const int /*runnumber*/)
 {
+  m_threadHistos.merge();
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -390,5 +375,46 @@ void TpcClusterQA::createHistos()
     h_hitzpositions_side1->GetXaxis()->SetTitle("z (cm)");
     hm->registerHisto(h_hitzpositions_side1);
   }
+
+  // thread local copies of the hit and cluster histograms. The per hitset and per sector
+  // count histograms are filled serially and not copied
+  m_threadHistos.clear();
+  m_threadHistos.add(h_hitpositions);
+  m_threadHistos.add(h_hitzpositions_side0);
+  m_threadHistos.add(h_hitzpositions_side1);
+  for (const auto &region : {0, 1, 2})
+  {
+    for (auto *histo : {h_phisize_side0[region], h_phisize_side1[region], h_zsize[region],
+                        h_rphierror[region], h_zerror[region], h_clusedge[region], h_clusoverlap[region],
+                        h_clusxposition_side0[region], h_clusxposition_side1[region],
+                        h_clusyposition_side0[region], h_clusyposition_side1[region],
+                        h_cluszposition_side0[region], h_cluszposition_side1[region]})
+    {
+      m_threadHistos.add(histo);
+    }
+  }
+  m_threadHistos.init(m_num_threads);
+
+  m_histos.clear();
+  for (int thread = 0; thread < m_threadHistos.get_num_threads(); ++thread)
+  {
+    ThreadHistos histos;
+    histos.hitpositions = static_cast<TH2 *>(m_threadHistos.get(0, thread));
+    histos.hitzpositions_side0 = m_threadHistos.get(1, thread);
+    histos.hitzpositions_side1 = m_threadHistos.get(2, thread);
+    std::size_t index = 3;
+    for (const auto &region : {0, 1, 2})
+    {
+      for (auto *histo : {&histos.phisize_side0[region], &histos.phisize_side1[region], &histos.zsize[region],
+                          &histos.rphierror[region], &histos.zerror[region], &histos.clusedge[region], &histos.clusoverlap[region],
+                          &histos.clusxposition_side0[region], &histos.clusxposition_side1[region],
+                          &histos.clusyposition_side0[region], &histos.clusyposition_side1[region],
+                          &histos.cluszposition_side0[region], &histos.cluszposition_side1[region]})
+      {
+        *histo = m_threadHistos.get(index++, thread);
+      }
+    }
+    m_histos.push_back(histos);
+  }
   return;
 }
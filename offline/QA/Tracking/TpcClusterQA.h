@@ -3,8 +3,12 @@
 #ifndef QA_TRACKING_TPCCLUSTERQA_H
 #define QA_TRACKING_TPCCLUSTERQA_H
 
+#include "QAClusterCache.h"
+
 #include <fun4all/SubsysReco.h>
 
+#include <qautils/QAThreadHistos.h>
+
 #include <map>
 #include <set>
 #include <string>
@@ -24,9 +28,42 @@ class TpcClusterQA : public SubsysReco
   int process_event(PHCompositeNode *topNode) override;
   int EndRun(const int runnumber) override;
 
+  //! number of threads used to fill the hit and cluster histograms
+  void set_num_threads(int n) { m_num_threads = n; }
+
+  //! merge the thread local histograms every n events, on top of EndRun
+  void set_merge_interval(int n) { m_threadHistos.set_merge_interval(n); }
+
  private:
   void createHistos();
 
+  //! hit and cluster histograms filled by one thread
+  struct ThreadHistos
+  {
+    TH2 *hitpositions = nullptr;
+    TH1 *hitzpositions_side0 = nullptr;
+    TH1 *hitzpositions_side1 = nullptr;
+
+    TH1 *phisize_side0[3] = {nullptr};
+    TH1 *phisize_side1[3] = {nullptr};
+    TH1 *zsize[3] = {nullptr};
+    TH1 *rphierror[3] = {nullptr};
+    TH1 *zerror[3] = {nullptr};
+    TH1 *clusedge[3] = {nullptr};
+    TH1 *clusoverlap[3] = {nullptr};
+    TH1 *clusxposition_side0[3] = {nullptr};
+    TH1 *clusxposition_side1[3] = {nullptr};
+    TH1 *clusyposition_side0[3] = {nullptr};
+    TH1 *clusyposition_side1[3] = {nullptr};
+    TH1 *cluszposition_side0[3] = {nullptr};
+    TH1 *cluszposition_side1[3] = {nullptr};
+  };
+
+  int m_num_threads = 1;
+  QAThreadHistos m_threadHistos;
+  std::vector<ThreadHistos> m_histos;
+  QAClusterCache m_clusterCache;
+
   std::vector<float> m_clusgz;
   std::vector<int> m_cluslayer;
   std::vector<int> m_clusphisize;
@@ -227,18 +227,12 @@ float TpcSeedsQA::calc_dedx(TrackSeed *tpcseed)
   return sumdedx;
 }
 
-float TpcSeedsQA::cal_track_length(SvtxTrack *track)
+float TpcSeedsQA::cal_track_length(const ClusterGlobalPositions &global_raw)
 {
   float minR = std::numeric_limits<float>::max();
   float maxR = 0;
-  for (const auto &ckey : get_cluster_keys(track))
+  for (const auto &[ckey, global] : global_raw)
   {
-    auto *cluster = clustermap->findCluster(ckey);
-
-    // Fully correct the cluster positions for the crossing and all distortions
-    Acts::Vector3 global = m_globalPositionWrapper.getGlobalPositionDistortionCorrected(ckey, cluster, track->get_crossing());
-
-    // add the global positions to a vector to give to the cluster mover
     float R = std::sqrt(pow(global.x(), 2) + pow(global.y(), 2));
     minR = std::min(R, minR);
     maxR = std::max(R, maxR);
@@ -247,27 +241,11 @@ float TpcSeedsQA::cal_track_length(SvtxTrack *track)
   return tracklength;
 }
 
-float *TpcSeedsQA::cal_dedx_cluster(SvtxTrack *track)
+float *TpcSeedsQA::cal_dedx_cluster(SvtxTrack *track, const ClusterGlobalPositions &global_raw)
 {
-  // get the fully corrected cluster global positions
-  std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>> global_raw;
+  // the fully corrected cluster global positions are provided by the caller
   std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>> global_moved;
-  float minR = std::numeric_limits<float>::max();
-  float maxR = 0;
-  for (const auto &ckey : get_cluster_keys(track))
-  {
-    auto *cluster = clustermap->findCluster(ckey);
-
-    // Fully correct the cluster positions for the crossing and all distortions
-    Acts::Vector3 global = m_globalPositionWrapper.getGlobalPositionDistortionCorrected(ckey, cluster, track->get_crossing());
-
-    // add the global positions to a vector to give to the cluster mover
-    global_raw.emplace_back(ckey, global);
-    float R = std::sqrt(pow(global.x(), 2) + pow(global.y(), 2));
-    minR = std::min(R, minR);
-    maxR = std::max(R, maxR);
-  }
-  float tracklength = maxR - minR;
+  float tracklength = cal_track_length(global_raw);
   if (collision_or_cosmics == true && tracklength < 25)
   {
     float *dedxarray = new float[10];
@@ -671,10 +649,18 @@ int TpcSeedsQA::process_event(PHCompositeNode *topNode)
       }
     }
 
+    // fully correct the cluster positions for the crossing and all distortions, once per track.
+    // They are reused for the track length and the cluster dE/dx
+    ClusterGlobalPositions global_raw;
     for (const auto &ckey : get_cluster_keys(track))
     {
       TrkrCluster *cluster = clustermap->findCluster(ckey);
-      const Acts::Vector3 clusglob = m_globalPositionWrapper.getGlobalPositionDistortionCorrected(ckey, cluster, track->get_crossing());
+      global_raw.emplace_back(ckey, m_globalPositionWrapper.getGlobalPositionDistortionCorrected(ckey, cluster, track->get_crossing()));
+    }
+
+    for (const auto &[ckey, clusglob] : global_raw)
+    {
+      TrkrCluster *cluster = clustermap->findCluster(ckey);
 
       switch (TrkrDefs::getTrkrId(ckey))  // NOLINT(bugprone-switch-missing-default-case
       {
@@ -710,7 +696,7 @@ int TpcSeedsQA::process_event(PHCompositeNode *topNode)
     if (m_ptot > 0.2 && m_ptot < 4 && m_ntpc > 30)
     {
       h_dedx->Fill(m_charge * m_ptot, m_dedx);
-      if (collision_or_cosmics == false || (collision_or_cosmics == true && cal_track_length(track) > 25))
+      if (collision_or_cosmics == false || (collision_or_cosmics == true && cal_track_length(global_raw) > 25))
       {
         h_dedx_pcaz->Fill(track->get_z(), m_dedx);
       }
@@ -723,11 +709,12 @@ int TpcSeedsQA::process_event(PHCompositeNode *topNode)
 
     if (m_ntpc > 30)
     {
-      float *cluster_dedx = cal_dedx_cluster(track);
+      float *cluster_dedx = cal_dedx_cluster(track, global_raw);
       for (int iz = 0; iz < 10; iz++)
       {
         h_dedx_pq_z[iz]->Fill(m_charge * m_ptot, cluster_dedx[iz]);
       }
+      delete[] cluster_dedx;
     }
 
     // if (m_pt > 1)
@@ -63,8 +63,9 @@ class TpcSeedsQA : public SubsysReco
   std::multimap<int, int> m_layerRegionMap;
   static std::pair<float, float> cal_tpc_eta_min_max(float vtxz);
   static float eta_to_theta(float eta);
-  float* cal_dedx_cluster(SvtxTrack* track);
-  float cal_track_length(SvtxTrack* track);
+  using ClusterGlobalPositions = std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>>;
+  float* cal_dedx_cluster(SvtxTrack* track, const ClusterGlobalPositions& global_raw);
+  static float cal_track_length(const ClusterGlobalPositions& global_raw);
 
   std::string m_clusterContainerName{"TRKR_CLUSTER"};
   std::string m_actsGeomName{"ActsGeometry"};
@@ -0,0 +1,101 @@
+#include "Fun4AllDstIndex.h"
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <fstream>
+#include <iostream>
+#include <iterator>  // for prev
+#include <sstream>
+
+void Fun4AllDstIndex::clear()
+{
+  m_Records.clear();
+  m_EventMap.clear();
+  m_BCOMap.clear();
+}
+
+void Fun4AllDstIndex::add(const Record &rec)
+{
+  m_Records.push_back(rec);
+  m_EventMap.emplace(std::make_pair(rec.run, rec.event), rec.entry);
+  m_BCOMap.emplace(rec.bco, rec.entry);
+}
+
+bool Fun4AllDstIndex::Write(const std::string &filename) const
+{
+  std::ofstream out(filename);
+  if (!out.is_open())
+  {
+    std::cout << PHWHERE << " could not open " << filename << " for writing" << std::endl;
+    return false;
+  }
+  out << "# entry run segment event bco" << std::endl;
+  for (const auto &rec : m_Records)
+  {
+    out << rec.entry << " " << rec.run << " " << rec.segment << " "
+        << rec.event << " " << rec.bco << "\n";
+  }
+  return out.good();
+}
+
+bool Fun4AllDstIndex::Read(const std::string &filename)
+{
+  clear();
+  std::ifstream in(filename);
+  if (!in.is_open())
+  {
+    return false;
+  }
+  std::string line;
+  while (std::getline(in, line))
+  {
+    if (line.empty() || line[0] == '#')
+    {
+      continue;
+    }
+    std::istringstream iss(line);
+    Record rec;
+    if (!(iss >> rec.entry >> rec.run >> rec.segment >> rec.event >> rec.bco))
+    {
+      std::cout << PHWHERE << " corrupt index " << filename << ", ignoring it" << std::endl;
+      clear();
+      return false;
+    }
+    add(rec);
+  }
+  return true;
+}
+
+int64_t Fun4AllDstIndex::FindEvent(const int run, const int event) const
+{
+  auto iter = m_EventMap.find(std::make_pair(run, event));
+  if (iter == m_EventMap.end())
+  {
+    return -1;
+  }
+  return static_cast<int64_t>(iter->second);
+}
+
+int64_t Fun4AllDstIndex::FindBCO(const int64_t bco, const int64_t window) const
+{
+  // candidates are the first BCO >= bco and the one before it
+  auto upper = m_BCOMap.lower_bound(bco);
+  auto best = m_BCOMap.end();
+  if (upper != m_BCOMap.end() && upper->first - bco <= window)
+  {
+    best = upper;
+  }
+  if (upper != m_BCOMap.begin())
+  {
+    auto lower = std::prev(upper);
+    if (bco - lower->first <= window && (best == m_BCOMap.end() || bco - lower->first < best->first - bco))
+    {
+      best = lower;
+    }
+  }
+  if (best == m_BCOMap.end())
+  {
+    return -1;
+  }
+  return static_cast<int64_t>(best->second);
+}
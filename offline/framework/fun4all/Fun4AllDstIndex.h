@@ -0,0 +1,51 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLDSTINDEX_H
+#define FUN4ALL_FUN4ALLDSTINDEX_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>  // for pair
+#include <vector>
+
+// Sidecar index of a DST: one record per event with its entry in the event
+// tree and the run, segment, event number and BCO it was written with.
+// It is a small text file next to the DST (<dst>.idx) so events can be
+// located without reading the DST itself
+class Fun4AllDstIndex
+{
+ public:
+  struct Record
+  {
+    uint64_t entry{0};
+    int run{0};
+    int segment{0};
+    int event{0};
+    int64_t bco{0};
+  };
+
+  static std::string IndexFileName(const std::string &dstname) { return dstname + ".idx"; }
+
+  void clear();
+  void add(const Record &rec);
+  bool Write(const std::string &filename) const;
+  bool Read(const std::string &filename);
+  size_t size() const { return m_Records.size(); }
+  bool empty() const { return m_Records.empty(); }
+  const std::vector<Record> &Records() const { return m_Records; }
+
+  //! entry of (run, event), -1 if it is not in this file
+  int64_t FindEvent(const int run, const int event) const;
+  //! entry with the BCO closest to bco within +-window, -1 if there is none
+  int64_t FindBCO(const int64_t bco, const int64_t window = 0) const;
+  int64_t FirstBCO() const { return m_BCOMap.empty() ? 0 : m_BCOMap.begin()->first; }
+  int64_t LastBCO() const { return m_BCOMap.empty() ? 0 : m_BCOMap.rbegin()->first; }
+
+ private:
+  std::vector<Record> m_Records;
+  std::map<std::pair<int, int>, uint64_t> m_EventMap;
+  std::map<int64_t, uint64_t> m_BCOMap;
+};
+
+#endif
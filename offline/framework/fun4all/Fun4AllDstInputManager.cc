@@ -5,6 +5,7 @@
 #include "Fun4AllServer.h"
 #include "InputFileHandlerReturnCodes.h"
 
+#include <ffaobjects/EventHeader.h>
 #include <ffaobjects/RunHeader.h>
 #include <ffaobjects/SyncDefs.h>
 #include <ffaobjects/SyncObject.h>
@@ -22,6 +23,7 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <iostream>  // for operator<<, basic_ostream, endl
@@ -136,6 +138,10 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
     {
       m_IManager->DisableReadCache();
     }
+    else if (m_ReadAheadThreads > 0)
+    {
+      m_IManager->ReadAhead(m_ReadAheadThreads, m_ReadAheadBudget);
+    }
     if (m_IManager->NodeExist(syncdefs::SYNCNODENAME))
     {
       m_HaveSyncObject = 1;
@@ -144,7 +150,7 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
     {
       m_HaveSyncObject = -1;
     }
-
+    load_index();
     return 0;
   }
 
@@ -179,6 +185,20 @@ int Fun4AllDstInputManager::run(const int nevents)
     std::cout << "Getting Event from " << Name() << std::endl;
   }
 readagain:
+  if (!m_EventSelection.empty())
+  {
+    if (m_SelectedPos >= m_SelectedEntries.size())  // no (more) selected events in this file
+    {
+      fileclose();
+      if (OpenNextFile() == InputFileHandlerReturnCodes::SUCCESS)
+      {
+        goto readagain;  // NOLINT(hicpp-avoid-goto)
+      }
+      return -1;
+    }
+    m_IManager->setEventNumber(m_SelectedEntries[m_SelectedPos]);
+    m_SelectedPos++;
+  }
   PHCompositeNode *dummy;
   int ncount = 0;
   dummy = m_IManager->read(dstNode);
@@ -219,6 +239,7 @@ int Fun4AllDstInputManager::fileclose()
     std::cout << Name() << ": fileclose: No Input file open" << std::endl;
     return -1;
   }
+  m_ReadStatistics += m_IManager->GetReadStatistics();
   delete m_IManager;
   m_IManager = nullptr;
   IsOpen(0);
@@ -626,12 +647,56 @@ void Fun4AllDstInputManager::Print(const std::string &what) const
   return;
 }
 
+int Fun4AllDstInputManager::End()
+{
+  if (m_ReadAheadThreads > 0)
+  {
+    PHNodeIOManager::ReadStatistics stats = m_ReadStatistics;
+    if (m_IManager)
+    {
+      stats += m_IManager->GetReadStatistics();
+    }
+    std::cout << Name() << ": read ahead with " << m_ReadAheadThreads << " threads: "
+              << stats.events << " events, " << stats.bytes << " bytes in "
+              << stats.readcalls << " read calls, " << stats.unzipped
+              << " baskets unzipped ahead, " << stats.missed
+              << " unzipped on demand, " << stats.stalltime << " ms waiting for events"
+              << std::endl;
+  }
+  return 0;
+}
+
 int Fun4AllDstInputManager::PushBackEvents(const int i)
 {
   if (m_IManager)
   {
     unsigned EventOnDst = m_IManager->getEventNumber();
     EventOnDst -= static_cast<unsigned>(i);
+    if (!m_EventSelection.empty())
+    {
+      // pushing back re-reads the last i selected events, skipping (i < 0) drops the next ones
+      if (i > 0)
+      {
+        m_SelectedPos -= std::min(static_cast<size_t>(i), m_SelectedPos);
+      }
+      else
+      {
+        m_SelectedPos = std::min(m_SelectedPos + static_cast<size_t>(-i), m_SelectedEntries.size());
+      }
+      return 0;
+    }
+    // with an index the number of events in the file is known and
+    // skipping continues in the next files without reading events
+    while (i < 0 && !m_Index.empty() && EventOnDst > m_Index.size())
+    {
+      unsigned remaining = EventOnDst - m_Index.size();
+      fileclose();
+      if (OpenNextFile() != InputFileHandlerReturnCodes::SUCCESS)
+      {
+        return -1;
+      }
+      EventOnDst = m_IManager->getEventNumber() + remaining;
+    }
     m_IManager->setEventNumber(EventOnDst);
     return 0;
   }
@@ -654,3 +719,85 @@ int Fun4AllDstInputManager::HasSyncObject() const
   }
   return 0;
 }
+
+void Fun4AllDstInputManager::SelectEvents(const std::vector<std::pair<int, int>> &runevents)
+{
+  m_EventSelection.insert(runevents.begin(), runevents.end());
+  if (IsOpen())
+  {
+    load_index();
+  }
+}
+
+void Fun4AllDstInputManager::load_index()
+{
+  m_Index.clear();
+  m_SelectedEntries.clear();
+  m_SelectedPos = 0;
+  if (!m_UseIndexFlag && m_EventSelection.empty())
+  {
+    return;
+  }
+  std::string indexfile = Fun4AllDstIndex::IndexFileName(fullfilename);
+  if (!m_Index.Read(indexfile))
+  {
+    std::cout << Name() << ": no index " << indexfile;
+    if (!m_EventSelection.empty())
+    {
+      std::cout << ", cannot select events, skipping " << FileName();
+    }
+    std::cout << std::endl;
+    return;
+  }
+  for (const auto &rec : m_Index.Records())
+  {
+    if (m_EventSelection.contains(std::make_pair(rec.run, rec.event)))
+    {
+      m_SelectedEntries.push_back(rec.entry);
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": read index of " << m_Index.size() << " events from "
+              << indexfile << ", " << m_SelectedEntries.size() << " selected" << std::endl;
+  }
+}
+
+int64_t Fun4AllDstInputManager::CurrentBCO() const
+{
+  EventHeader *evthead = findNode::getClass<EventHeader>(dstNode, "EventHeader");
+  if (!evthead)
+  {
+    return Fun4AllInputManager::CurrentBCO();
+  }
+  return evthead->get_BunchCrossing();
+}
+
+int Fun4AllDstInputManager::PositionToBCO(const int64_t bco, const int64_t window)
+{
+  if (!IsOpen() && OpenNextFile() != InputFileHandlerReturnCodes::SUCCESS)
+  {
+    return -1;
+  }
+  while (!m_Index.empty())
+  {
+    int64_t entry = m_Index.FindBCO(bco, window);
+    if (entry >= 0)
+    {
+      m_IManager->setEventNumber(entry);
+      return 0;
+    }
+    // the bco can only be in one of the next files if it is past this one
+    if (bco - window <= m_Index.LastBCO())
+    {
+      return -1;
+    }
+    fileclose();
+    if (OpenNextFile() != InputFileHandlerReturnCodes::SUCCESS)
+    {
+      return -1;
+    }
+  }
+  std::cout << PHWHERE << Name() << ": positioning by BCO needs the index, call UseIndex()" << std::endl;
+  return -1;
+}
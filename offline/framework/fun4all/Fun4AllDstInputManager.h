@@ -3,12 +3,17 @@
 #ifndef FUN4ALL_FUN4ALLDSTINPUTMANAGER_H
 #define FUN4ALL_FUN4ALLDSTINPUTMANAGER_H
 
+#include "Fun4AllDstIndex.h"
 #include "Fun4AllInputManager.h"
 
 #include <phool/PHNodeIOManager.h>
 
+#include <cstdint>
 #include <map>
+#include <set>
 #include <string>
+#include <utility>  // for pair
+#include <vector>
 
 class PHCompositeNode;
 class PHNodeIOManager;
@@ -27,13 +32,31 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   int BranchSelect(const std::string &branch, const int iflag) override;
   int setBranches() override;
   void CacheSize(uint64_t size) { m_IManager->CacheSize(size); }
+  // prefetch and unzip the selected branches on nthreads worker threads,
+  // using up to memorybudget bytes of tree cache per file. Off by default.
+  // Enables the ROOT implicit MT pool while the input files are open if it is
+  // not enabled yet, see PHNodeIOManager::ReadAhead
+  void ReadAhead(const unsigned int nthreads, const uint64_t memorybudget = 100000000)
+  {
+    m_ReadAheadThreads = nthreads;
+    m_ReadAheadBudget = memorybudget;
+  }
   virtual int setSyncBranches(PHNodeIOManager *iman);
   void Print(const std::string &what = "ALL") const override;
   int PushBackEvents(const int i) override;
   int HasSyncObject() const override;
+  int End() override;
+  int64_t CurrentBCO() const override;
+  int PositionToBCO(const int64_t bco, const int64_t window) override;
+  //! use the sidecar index written by Fun4AllDstOutputManager::WriteIndex()
+  //! to skip across files and to position by BCO without reading events
+  void UseIndex(const bool b = true) { m_UseIndexFlag = b; }
+  //! only read the given (run, event) pairs, needs the sidecar index
+  void SelectEvents(const std::vector<std::pair<int, int>> &runevents);
 
  protected:
   int ReadNextEventSyncObject();
+  void load_index();
   void ReadRunTTree(const int i) { m_ReadRunTTree = i; }
   void IManager(PHNodeIOManager *iman) { m_IManager = iman; }
   PHNodeIOManager *IManager() { return m_IManager; }
@@ -58,6 +81,15 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   int events_thisfile{0};
   int events_skipped_during_sync{0};
   int m_HaveSyncObject{0};
+  unsigned int m_ReadAheadThreads{0};
+  uint64_t m_ReadAheadBudget{0};
+  PHNodeIOManager::ReadStatistics m_ReadStatistics;
+  bool m_UseIndexFlag{false};
+  Fun4AllDstIndex m_Index;
+  std::set<std::pair<int, int>> m_EventSelection;
+  //! tree entries of the selected events in this file, m_SelectedPos is the next one to read
+  std::vector<uint64_t> m_SelectedEntries;
+  size_t m_SelectedPos{0};
   std::map<const std::string, int> branchread;
   std::string syncbranchname;
   std::string RunNode{"RUN"};
@@ -2,10 +2,15 @@
 
 #include "Fun4AllServer.h"
 
+#include <ffaobjects/EventHeader.h>
+#include <ffaobjects/SyncDefs.h>
+#include <ffaobjects/SyncObject.h>
+
 #include <phool/PHCompositeNode.h>
 #include <phool/PHNode.h>
 #include <phool/PHNodeIOManager.h>
 #include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 #include <phool/recoConsts.h>
 
@@ -25,6 +30,7 @@ Fun4AllDstOutputManager::Fun4AllDstOutputManager(const std::string &myname, cons
 
 Fun4AllDstOutputManager::~Fun4AllDstOutputManager()
 {
+  save_index();
   delete dstOut;
   return;
 }
@@ -172,6 +178,10 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
     }
   }
   dstOut->write(startNode);
+  if (m_WriteIndexFlag)
+  {
+    add_index_record(startNode);
+  }
   // to save some cpu cycles we only make it globally transient if
   // all nodes have been written (savenodes set is empty)
   // else we only make the nodes transient which we have written (all
@@ -197,6 +207,7 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
 
 int Fun4AllDstOutputManager::WriteNode(PHCompositeNode *thisNode)
 {
+  save_index();
   if (!m_SaveRunNodeFlag)
   {
     dstOut = nullptr;
@@ -355,9 +366,58 @@ int Fun4AllDstOutputManager::outfile_open_first_write()
   }
 
   dstOut->SetCompressionSetting(m_CompressionSetting);
+  dstOut->Verbosity(Verbosity());
+  if (m_AsyncQueueDepth > 0)
+  {
+    dstOut->AsyncWrite(m_AsyncQueueDepth);
+  }
+  if (m_WriteIndexFlag)
+  {
+    m_Index.clear();
+    m_IndexFileName = Fun4AllDstIndex::IndexFileName(OutFileName());
+  }
   return 0;
 }
 
+void Fun4AllDstOutputManager::add_index_record(PHCompositeNode *startNode)
+{
+  Fun4AllDstIndex::Record rec;
+  rec.entry = m_Index.size();
+  EventHeader *evthead = findNode::getClass<EventHeader>(startNode, "EventHeader");
+  if (evthead)
+  {
+    rec.run = evthead->get_RunNumber();
+    rec.event = evthead->get_EvtSequence();
+    rec.bco = evthead->get_BunchCrossing();
+  }
+  SyncObject *syncobject = findNode::getClass<SyncObject>(startNode, syncdefs::SYNCNODENAME);
+  if (syncobject)
+  {
+    rec.run = syncobject->RunNumber();
+    rec.segment = syncobject->SegmentNumber();
+    rec.event = syncobject->EventNumber();
+  }
+  m_Index.add(rec);
+}
+
+// the index belongs to the file which is currently open, it is saved when
+// this file is closed (rollover or end of job)
+void Fun4AllDstOutputManager::save_index()
+{
+  if (m_IndexFileName.empty())
+  {
+    return;
+  }
+  m_Index.Write(m_IndexFileName);
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": wrote index of " << m_Index.size() << " events to "
+              << m_IndexFileName << std::endl;
+  }
+  m_Index.clear();
+  m_IndexFileName.clear();
+}
+
 // this method figures out the last event number to be saved before rolling over
 // an integer div of the current event by the number of events gives the first event we can expect
 // in this process (this is not needed), then adding the number of events we want gives us the last event
@@ -3,6 +3,7 @@
 #ifndef FUN4ALL_FUN4ALLDSTOUTPUTMANAGER_H
 #define FUN4ALL_FUN4ALLDSTOUTPUTMANAGER_H
 
+#include "Fun4AllDstIndex.h"
 #include "Fun4AllOutputManager.h"
 
 #include <set>
@@ -36,14 +37,24 @@ class Fun4AllDstOutputManager : public Fun4AllOutputManager
   const std::string &UsedOutFileName() const { return m_UsedOutFileName; }
   void CompressionSetting(const int i) override { m_CompressionSetting = i; }
   void InitializeLastEvent(int eventnumber) override;
-  
+  //! compress and write events on a separate thread, with at most queuedepth events in flight (0: off)
+  void AsyncWrite(const unsigned int queuedepth) { m_AsyncQueueDepth = queuedepth; }
+  //! write a sidecar index (entry, run, segment, event, bco) next to each output file
+  void WriteIndex(const bool b = true) { m_WriteIndexFlag = b; }
+
  private:
   int outfile_open_first_write();
+  void add_index_record(PHCompositeNode *startNode);
+  void save_index();
   PHNodeIOManager *dstOut{nullptr};
   int m_SaveRunNodeFlag{1};
   int m_SaveDstNodeFlag{1};
   int m_CompressionSetting{505};
+  unsigned int m_AsyncQueueDepth{0};
   bool m_LastEventInitialized{false};
+  bool m_WriteIndexFlag{false};
+  Fun4AllDstIndex m_Index;
+  std::string m_IndexFileName;
   std::string m_FileNameStem;
   std::string m_UsedOutFileName;
   std::set<std::string> savenodes;
@@ -7,6 +7,8 @@
 #include "Fun4AllReturnCodes.h"
 #include "InputFileHandler.h"
 
+#include <cstdint>
+#include <limits>
 #include <list>
 #include <string>
 #include <type_traits>  // for __decay_and_strip<>::__type
@@ -40,6 +42,12 @@ class Fun4AllInputManager : public Fun4AllBase, public InputFileHandler
   virtual int NoSyncPushBackEvents(const int /*nevt*/) { return -1; }
   virtual void setSyncManager(Fun4AllSyncManager *master) { m_MySyncManager = master; }
   virtual int ResetEvent() { return 0; }
+  //! called once from Fun4AllServer::End, does nothing by default (statistics printouts go under Verbosity())
+  virtual int End() { return 0; }
+  //! BCO of the event in memory (used by the sync manager to match inputs by BCO)
+  virtual int64_t CurrentBCO() const { return std::numeric_limits<int64_t>::min(); }
+  //! make the next event read the one closest to bco within +-window
+  virtual int PositionToBCO(const int64_t /*bco*/, const int64_t /*window*/) { return -1; }
   virtual void SetRunNumber(const int runno) { m_MyRunNumber = runno; }
   virtual int RunNumber() const { return m_MyRunNumber; }
 
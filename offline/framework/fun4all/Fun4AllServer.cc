@@ -1151,6 +1151,13 @@ int Fun4AllServer::End()
     std::cout.copyfmt(m_saved_cout_state); // restore cout to default formatting
   }
   gROOT->cd(currdir.c_str());
+  for (auto *syncman : SyncManagers)
+  {
+    for (auto *inman : syncman->GetInputManagers())
+    {
+      i += inman->End();
+    }
+  }
   PHNodeIterator nodeiter(TopNode);
   PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(nodeiter.findFirst("PHCompositeNode", "RUN"));
   if (!runNode)
@@ -94,8 +94,25 @@ int Fun4AllSyncManager::run(const int nevnts)
     unsigned iman = 0;
     int ifirst = 0;
     int hassync = 0;
+    bool bcomiss = false;
+    iretsync = 0;
     for (auto &iter : m_InManager)
     {
+      if (m_SyncBCOWindow >= 0 && iman > 0 && !m_iretInManager[0])
+      {
+        // no matching bco in this input: drop the event of the first input
+        if (iter->PositionToBCO(m_InManager[0]->CurrentBCO(), m_SyncBCOWindow))
+        {
+          if (Verbosity() > 1)
+          {
+            std::cout << Name() << ": no BCO " << m_InManager[0]->CurrentBCO()
+                      << " in " << iter->Name() << std::endl;
+          }
+          iretsync = 1;
+          bcomiss = true;
+          break;
+        }
+      }
       m_iretInManager[iman] = iter->run(1);
       iret += m_iretInManager[iman];
       // one can run DSTs without sync object via the DST input manager
@@ -139,7 +156,7 @@ int Fun4AllSyncManager::run(const int nevnts)
           }
         }
       }
-      else
+      else if (m_SyncBCOWindow < 0)
       {
         iretsync = CheckSync(iman);
         if (iretsync)
@@ -218,6 +235,13 @@ int Fun4AllSyncManager::run(const int nevnts)
         // NOLINTNEXTLINE(hicpp-avoid-goto)
         goto readerror;
       }
+      else if (bcomiss)
+      {
+        // the event of the first input has no partner, drop it.
+        // No push back, the run(1) of the next pass reads the next event of the
+        // first input and the other inputs are positioned on its bco again
+        continue;
+      }
       else
       {
         // just read the next event and hope it syncs
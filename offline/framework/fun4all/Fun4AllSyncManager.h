@@ -9,6 +9,7 @@
 
 #include "Fun4AllBase.h"
 
+#include <cstdint>
 #include <string>  // for string
 #include <vector>
 
@@ -56,6 +57,9 @@ class Fun4AllSyncManager : public Fun4AllBase
   const std::vector<Fun4AllInputManager *> &GetInputManagers() const { return m_InManager; }
   bool MixRunsOk() const { return m_MixRunsOkFlag; }
   void MixRunsOk(bool b) { m_MixRunsOkFlag = b; }
+  //! match the events of all input managers to the BCO of the first one
+  //! (within +-window) instead of comparing sync objects, needs indexed inputs
+  void SyncByBCO(const int64_t window = 0) { m_SyncBCOWindow = window; }
 
  private:
   void PrintSyncProblem() const;
@@ -67,6 +71,7 @@ class Fun4AllSyncManager : public Fun4AllBase
   int m_CurrentEvent = 0;
   int m_Repeat = 0;
   bool m_MixRunsOkFlag = false;
+  int64_t m_SyncBCOWindow = -1;
   SyncObject *m_MasterSync = nullptr;
   std::vector<Fun4AllInputManager *> m_InManager;
   std::vector<int> m_iretInManager;
@@ -0,0 +1,112 @@
+// writes two events of different size with the asynchronous writer of
+// PHNodeIOManager and checks that both are read back as they were written
+
+#include <ffaobjects/FlagSave.h>
+#include <ffaobjects/FlagSavev1.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHFlag.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNodeIOManager.h>
+#include <phool/PHObject.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // the int flags of every event, the second one is smaller than the first
+  std::vector<std::map<std::string, int>> event_flags()
+  {
+    return {{{"FIRST", 1}, {"SECOND", 2}, {"THIRD", 3}}, {{"ONLY", 4}}};
+  }
+
+  bool write_file(const std::string &filename)
+  {
+    PHNodeIOManager out(filename, PHWrite);
+    if (!out.isFunctional())
+    {
+      std::cout << PHWHERE << " cannot open " << filename << std::endl;
+      return false;
+    }
+    out.AsyncWrite(2);
+
+    PHCompositeNode *topNode = new PHCompositeNode("DST");
+    FlagSave *flagsave = new FlagSavev1();
+    topNode->addNode(new PHIODataNode<PHObject>(flagsave, "FLAGS", "PHObject"));
+
+    PHFlag flags;
+    for (const auto &intflags : event_flags())
+    {
+      flags.ClearAll();
+      for (const auto &[name, value] : intflags)
+      {
+        flags.set_IntFlag(name, value);
+      }
+      flagsave->FillFromPHFlag(&flags, true);
+      out.write(topNode);
+      // the payload is serialized by write(), emptying the node must not change what is written
+      flags.ClearAll();
+      flagsave->FillFromPHFlag(&flags, true);
+    }
+    out.closeFile();
+    delete topNode;
+    return true;
+  }
+
+  bool read_file(const std::string &filename)
+  {
+    PHNodeIOManager in(filename, PHReadOnly);
+    if (!in.isFunctional())
+    {
+      std::cout << PHWHERE << " cannot open " << filename << std::endl;
+      return false;
+    }
+    bool ok = true;
+    PHCompositeNode *topNode = nullptr;
+    const std::vector<std::map<std::string, int>> expected = event_flags();
+    for (size_t ievent = 0; ievent < expected.size(); ievent++)
+    {
+      topNode = in.read(topNode, ievent);
+      FlagSave *flagsave = topNode ? findNode::getClass<FlagSave>(topNode, "FLAGS") : nullptr;
+      if (!flagsave)
+      {
+        std::cout << PHWHERE << " cannot read event " << ievent << std::endl;
+        ok = false;
+        break;
+      }
+      PHFlag flags;
+      flagsave->PutFlagsBack(&flags, true);
+      if (*flags.IntMap() != expected[ievent])
+      {
+        std::cout << PHWHERE << " event " << ievent << " has " << flags.IntMap()->size()
+                  << " int flags instead of " << expected[ievent].size() << std::endl;
+        flags.PrintIntFlags();
+        ok = false;
+      }
+    }
+    in.closeFile();
+    delete topNode;
+    return ok;
+  }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+  std::string filename = "testasyncwrite.root";
+  if (argc > 1)
+  {
+    filename = argv[1];
+  }
+  if (!write_file(filename) || !read_file(filename))
+  {
+    std::cout << "asynchronous writing test failed" << std::endl;
+    return 1;
+  }
+  std::cout << "asynchronous writing test passed" << std::endl;
+  return 0;
+}
@@ -5,11 +5,13 @@
 #include "PHCompositeNode.h"
 #include "PHIODataNode.h"
 #include "PHNodeIterator.h"
+#include "PHObject.h"
 #include "phooldefs.h"
 
 #include <TBranch.h>  // for TBranch
 #include <TBranchElement.h>
 #include <TBranchObject.h>
+#include <TBufferFile.h>
 #include <TClass.h>
 #include <TDirectory.h>  // for TDirectory
 #include <TFile.h>
@@ -20,17 +22,195 @@
 #include <TSystem.h>
 #include <TTree.h>
 #include <TTreeCache.h>
+#include <TTreeCacheUnzip.h>
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+unsigned int PHNodeIOManager::s_ImplicitMTUsers = 0;
+bool PHNodeIOManager::s_ImplicitMTEnabledHere = false;
+
+// Writes events on a dedicated thread. The payload of every persistent node
+// is streamed into a TBufferFile on the event loop thread (no compression),
+// the writer thread streams it back into its own copy of the object, which
+// is the address of the branch, and fills the tree. Filling, compression and
+// disk writes thus overlap with the processing of the next events, while
+// the content written is what the nodes held when write() was called
+class PHNodeIOManager::AsyncWriter
+{
+ public:
+  AsyncWriter(PHNodeIOManager *manager, unsigned int queuedepth)
+    : m_Manager(manager)
+    , m_QueueDepth(std::max(queuedepth, 1U))
+  {
+    m_Thread = std::thread(&AsyncWriter::run, this);
+  }
+
+  ~AsyncWriter()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Stop = true;
+    }
+    m_NotEmpty.notify_all();
+    m_Thread.join();
+    for (auto &iter : m_Objects)
+    {
+      delete iter.second;
+    }
+  }
+
+  AsyncWriter(const AsyncWriter &) = delete;
+  AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+  // serialize one node payload into the current event
+  void add(TObject *data, const std::string &path, int buffersize, int splitlevel)
+  {
+    Node node{path, data->ClassName(), buffersize, splitlevel, std::make_unique<TBufferFile>(TBuffer::kWrite)};
+    data->Streamer(*node.buffer);
+    m_Event.push_back(std::move(node));
+  }
+
+  // queue the current event, blocks while the queue is full
+  void push()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    if (m_Queue.size() >= m_QueueDepth)
+    {
+      auto start = std::chrono::steady_clock::now();
+      m_NotFull.wait(lock, [this]
+                     { return m_Queue.size() < m_QueueDepth; });
+      m_BlockedTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      ++m_BlockedEvents;
+    }
+    m_Queue.push_back(std::move(m_Event));
+    m_Event.clear();
+    m_MaxQueueSize = std::max(m_MaxQueueSize, m_Queue.size());
+    ++m_Events;
+    lock.unlock();
+    m_NotEmpty.notify_one();
+  }
+
+  // wait until all queued events are written
+  void drain()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_NotFull.wait(lock, [this]
+                   { return m_Queue.empty() && !m_Busy; });
+  }
+
+  void print() const
+  {
+    std::cout << "PHNodeIOManager async writer: " << m_Events << " events, queue depth "
+              << m_QueueDepth << " (max used " << m_MaxQueueSize << "), blocked "
+              << m_BlockedEvents << " times for " << m_BlockedTime << " ms" << std::endl;
+  }
+
+ private:
+  struct Node
+  {
+    std::string path;
+    std::string classname;
+    int buffersize;
+    int splitlevel;
+    std::unique_ptr<TBufferFile> buffer;
+  };
+  using Event = std::vector<Node>;
+
+  void run()
+  {
+    while (true)
+    {
+      Event event;
+      {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_NotEmpty.wait(lock, [this]
+                        { return m_Stop || !m_Queue.empty(); });
+        if (m_Queue.empty())
+        {
+          return;
+        }
+        event = std::move(m_Queue.front());
+        m_Queue.pop_front();
+        m_Busy = true;
+      }
+      // the producer can continue as soon as there is space in the queue
+      m_NotFull.notify_all();
+
+      write(event);
+
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Busy = false;
+      }
+      m_NotFull.notify_all();
+    }
+  }
+
+  void write(Event &event)
+  {
+    TTree *tree = m_Manager->tree;
+    for (auto &node : event)
+    {
+      auto objiter = m_Objects.find(node.path);
+      if (objiter == m_Objects.end())
+      {
+        TClass *cl = TClass::GetClass(node.classname.c_str());
+        objiter = m_Objects.insert(std::make_pair(node.path, static_cast<TObject *>(cl->New()))).first;
+        tree->Branch(node.path.c_str(), node.classname.c_str(), &objiter->second, node.buffersize, node.splitlevel);
+      }
+      node.buffer->SetReadMode();
+      node.buffer->SetBufferOffset(0);
+      objiter->second->Streamer(*node.buffer);
+    }
+    tree->Fill();
+    // like the nodes after the event reset, nothing is carried over into the next event
+    for (auto &iter : m_Objects)
+    {
+      if (PHObject *obj = dynamic_cast<PHObject *>(iter.second))
+      {
+        obj->Reset();
+      }
+    }
+  }
+
+  PHNodeIOManager *m_Manager{nullptr};
+  size_t m_QueueDepth{1};
+
+  // event being serialized, only used by the event loop thread
+  Event m_Event;
+
+  // writer copies of the node payloads, addresses of the branches
+  std::map<std::string, TObject *> m_Objects;
+
+  std::mutex m_Mutex;
+  std::condition_variable m_NotEmpty;
+  std::condition_variable m_NotFull;
+  std::deque<Event> m_Queue;
+  bool m_Busy{false};
+  bool m_Stop{false};
+  std::thread m_Thread;
+
+  // back pressure statistics
+  uint64_t m_Events{0};
+  uint64_t m_BlockedEvents{0};
+  double m_BlockedTime{0};
+  size_t m_MaxQueueSize{0};
+};
+
 PHNodeIOManager::PHNodeIOManager(const std::string& f,
                                  const PHAccessType a)
 {
@@ -59,18 +239,48 @@ PHNodeIOManager::~PHNodeIOManager()
 {
   closeFile();
   delete file;
+  // the tree is gone with the file, now the writer objects can be deleted
+  m_AsyncWriter.reset();
 }
 
 void PHNodeIOManager::closeFile()
 {
+  if (m_AsyncWriter)
+  {
+    m_AsyncWriter->drain();
+    if (m_Verbosity > 0)
+    {
+      m_AsyncWriter->print();
+    }
+  }
   if (file)
   {
     if (accessMode == PHWrite || accessMode == PHUpdate)
     {
       file->Write();
     }
+    else
+    {
+      updateReadStatistics();
+    }
     file->Close();
   }
+  releaseImplicitMT();
+}
+
+void PHNodeIOManager::releaseImplicitMT()
+{
+  if (!m_ImplicitMTUser)
+  {
+    return;
+  }
+  m_ImplicitMTUser = false;
+  // the last file with read ahead restores the state before the first one
+  if (--s_ImplicitMTUsers == 0 && s_ImplicitMTEnabledHere)
+  {
+    ROOT::DisableImplicitMT();
+    s_ImplicitMTEnabledHere = false;
+  }
 }
 
 bool PHNodeIOManager::setFile(const std::string& f, const std::string& title,
@@ -87,6 +297,7 @@ bool PHNodeIOManager::setFile(const std::string& f, const std::string& title,
     delete file;
     file = nullptr;
   }
+  m_AsyncWriter.reset();
   std::string currdir = gDirectory->GetPath();
   gROOT->cd();
   switch (accessMode)
@@ -147,7 +358,14 @@ bool PHNodeIOManager::write(PHCompositeNode* topNode)
   // be filled.
   if (file && tree)
   {
-    tree->Fill();
+    if (m_AsyncWriter)
+    {
+      m_AsyncWriter->push();
+    }
+    else
+    {
+      tree->Fill();
+    }
     eventNumber++;
     return true;
   }
@@ -155,11 +373,32 @@ bool PHNodeIOManager::write(PHCompositeNode* topNode)
   return false;
 }
 
+void PHNodeIOManager::AsyncWrite(const unsigned int queuedepth)
+{
+  if (!tree || (accessMode != PHWrite && accessMode != PHUpdate))
+  {
+    std::cout << PHWHERE << " asynchronous writing needs a file opened for writing" << std::endl;
+    return;
+  }
+  if (tree->GetListOfBranches()->GetEntries() > 0)
+  {
+    std::cout << PHWHERE << " asynchronous writing has to be enabled before the first write" << std::endl;
+    return;
+  }
+  if (m_AsyncWriter)
+  {
+    return;
+  }
+  ROOT::EnableThreadSafety();
+  m_AsyncWriter = std::make_unique<AsyncWriter>(this, queuedepth);
+}
+
 bool PHNodeIOManager::write(TObject** data, const std::string& path, int nodebuffersize, int nodesplitlevel)
 {
   if (file && tree)
   {
-    TBranch* thisBranch = tree->GetBranch(path.c_str());
+    // with the async writer the branches are handled by the writer thread
+    TBranch* thisBranch = m_AsyncWriter ? nullptr : tree->GetBranch(path.c_str());
     if (!thisBranch)
     {
       int use_splitlevel = splitlevel;
@@ -175,6 +414,11 @@ bool PHNodeIOManager::write(TObject** data, const std::string& path, int nodebuf
       {
         use_buffersize = nodebuffersize;
       }
+      if (m_AsyncWriter)
+      {
+        m_AsyncWriter->add(*data, path, use_buffersize, use_splitlevel);
+        return true;
+      }
       tree->Branch(path.c_str(), (*data)->ClassName(),
                    data, use_buffersize, use_splitlevel);
     }
@@ -293,12 +537,20 @@ bool PHNodeIOManager::readEventFromFile(size_t requestedEvent)
   std::string currdir = gDirectory->GetPath();
   TFile* file_ptr = gFile;  // save current gFile
   file->cd();
-  
-  if (m_cacheSize != std::numeric_limits<uint64_t>::max())
+
+  if (m_ReadAheadThreads > 0)
+  {
+    if (!m_ReadAheadReady)
+    {
+      setupReadAhead();
+    }
+  }
+  else if (m_cacheSize != std::numeric_limits<uint64_t>::max())
   {
     tree->SetCacheSize(m_cacheSize);
   }
 
+  auto start = std::chrono::steady_clock::now();
   if (requestedEvent)
   {
     bytesRead = tree->GetEvent(requestedEvent);
@@ -311,6 +563,11 @@ bool PHNodeIOManager::readEventFromFile(size_t requestedEvent)
   {
     bytesRead = tree->GetEvent(eventNumber++);
   }
+  m_ReadStatistics.stalltime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  if (bytesRead > 0)
+  {
+    ++m_ReadStatistics.events;
+  }
 
   gFile = file_ptr;  // recover gFile
   gROOT->cd(currdir.c_str());
@@ -549,6 +806,10 @@ bool PHNodeIOManager::SetCompressionSetting(const int level)
 uint64_t
 PHNodeIOManager::GetBytesWritten()
 {
+  if (m_AsyncWriter)
+  {
+    m_AsyncWriter->drain();
+  }
   if (file)
   {
     return file->GetBytesWritten();
@@ -559,6 +820,10 @@ PHNodeIOManager::GetBytesWritten()
 uint64_t
 PHNodeIOManager::GetFileSize()
 {
+  if (m_AsyncWriter)
+  {
+    m_AsyncWriter->drain();
+  }
   if (file)
   {
     return file->GetSize();
@@ -626,3 +891,86 @@ void PHNodeIOManager::DisableReadCache()
   }
   return;
 }
+
+void PHNodeIOManager::ReadAhead(const unsigned int nthreads, const uint64_t memorybudget)
+{
+  if (accessMode != PHReadOnly)
+  {
+    std::cout << PHWHERE << " read ahead is only possible for input files" << std::endl;
+    return;
+  }
+  m_ReadAheadThreads = nthreads;
+  m_ReadAheadBudget = memorybudget;
+  m_ReadAheadReady = false;
+}
+
+void PHNodeIOManager::setupReadAhead()
+{
+  m_ReadAheadReady = true;
+  // the workers of the implicit MT pool unzip baskets ahead of the event
+  // loop and deserialize the branches of an entry in parallel.
+  // The pool is process wide, it is only enabled while files with read ahead
+  // are open and only if nobody else enabled it already (see releaseImplicitMT)
+  if (!m_ImplicitMTUser)
+  {
+    m_ImplicitMTUser = true;
+    if (s_ImplicitMTUsers++ == 0 && !ROOT::IsImplicitMTEnabled())
+    {
+      ROOT::EnableImplicitMT(m_ReadAheadThreads);
+      s_ImplicitMTEnabledHere = true;
+    }
+  }
+  // the unzip mode is a global which is picked up when a tree cache is created,
+  // switch it on for the cache of this tree only
+  const bool parallelunzip = TTreeCacheUnzip::IsParallelUnzip();
+  TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+  tree->SetCacheSize(m_ReadAheadBudget);
+  if (!parallelunzip)
+  {
+    TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+  }
+  // only the selected branches are prefetched, there is no need to learn
+  TObjArray *branchArray = tree->GetListOfBranches();
+  for (int i = 0; i < branchArray->GetEntriesFast(); i++)
+  {
+    TBranch *branch = static_cast<TBranch *>(branchArray->At(i));
+    if (!branch->TestBit(kDoNotProcess))
+    {
+      tree->AddBranchToCache(branch, true);
+    }
+  }
+  tree->StopCacheLearningPhase();
+}
+
+void PHNodeIOManager::updateReadStatistics()
+{
+  if (!file || !file->IsOpen())
+  {
+    return;
+  }
+  m_ReadStatistics.bytes = file->GetBytesRead();
+  m_ReadStatistics.readcalls = file->GetReadCalls();
+  TTreeCacheUnzip *unzip = dynamic_cast<TTreeCacheUnzip *>(file->GetCacheRead(tree));
+  if (unzip)
+  {
+    m_ReadStatistics.unzipped = unzip->GetNUnzip();
+    m_ReadStatistics.missed = unzip->GetNMissed();
+  }
+}
+
+const PHNodeIOManager::ReadStatistics &PHNodeIOManager::GetReadStatistics()
+{
+  updateReadStatistics();
+  return m_ReadStatistics;
+}
+
+PHNodeIOManager::ReadStatistics &PHNodeIOManager::ReadStatistics::operator+=(const ReadStatistics &rhs)
+{
+  events += rhs.events;
+  bytes += rhs.bytes;
+  readcalls += rhs.readcalls;
+  stalltime += rhs.stalltime;
+  unzipped += rhs.unzipped;
+  missed += rhs.missed;
+  return *this;
+}
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
 
 class PHCompositeNode;
@@ -59,10 +60,44 @@ class PHNodeIOManager : public PHIOManager
   
   void DisableReadCache();
 
+  void Verbosity(const int i) { m_Verbosity = i; }
+  int Verbosity() const { return m_Verbosity; }
+
+  // hand the compression and writing of events to a dedicated thread.
+  // Node payloads are serialized when write() is called, so the nodes can
+  // be modified right after; at most queuedepth events are kept in flight
+  void AsyncWrite(const unsigned int queuedepth);
+
+  // opt-in: read ahead and unzip the baskets of the selected branches on nthreads
+  // ROOT worker threads, keeping at most memorybudget bytes in the tree
+  // cache. Configured on the first event read from the file.
+  // Parallel unzipping is only switched on for the cache of this tree. The ROOT
+  // implicit MT pool is process wide: if it is not enabled already it is enabled
+  // while files with read ahead are open and disabled again when the last one is
+  // closed. Trees created in that window (e.g. output files) see the pool as well
+  void ReadAhead(const unsigned int nthreads, const uint64_t memorybudget);
+
+  struct ReadStatistics
+  {
+    uint64_t events{0};
+    uint64_t bytes{0};        // bytes read from disk
+    int64_t readcalls{0};     // disk read calls
+    double stalltime{0};      // ms the event loop spent in TTree::GetEvent
+    int64_t unzipped{0};      // baskets unzipped ahead by the workers
+    int64_t missed{0};        // baskets unzipped on the event loop thread
+    ReadStatistics &operator+=(const ReadStatistics &rhs);
+  };
+  const ReadStatistics &GetReadStatistics();
+
 private:
+  class AsyncWriter;
+
   int FillBranchMap();
   PHCompositeNode *reconstructNodeTree(PHCompositeNode *);
   bool readEventFromFile(size_t requestedEvent);
+  void setupReadAhead();
+  void releaseImplicitMT();
+  void updateReadStatistics();
   static std::string getBranchClassName(TBranch *);
 
   TFile *file{nullptr};
@@ -72,10 +107,20 @@ private:
   int accessMode{PHReadOnly};
   int m_CompressionSetting{505};  // ZSTD
   int isFunctionalFlag{0};        // flag to tell if that object initialized properly
+  int m_Verbosity{0};
   int buffersize{std::numeric_limits<int>::min()};
   int splitlevel{std::numeric_limits<int>::min()};
   std::map<std::string, TBranch *> fBranches;
   std::map<std::string, bool> objectToRead;
+  std::unique_ptr<AsyncWriter> m_AsyncWriter;
+  unsigned int m_ReadAheadThreads{0};
+  uint64_t m_ReadAheadBudget{0};
+  bool m_ReadAheadReady{false};
+  bool m_ImplicitMTUser{false};
+  // number of open files with read ahead and whether they enabled the implicit MT pool
+  static unsigned int s_ImplicitMTUsers;
+  static bool s_ImplicitMTEnabledHere;
+  ReadStatistics m_ReadStatistics;
 };
 
 #endif
@@ -73,7 +73,7 @@ float RawClusterBuilderTopo::calculate_dR(float eta1, float eta2, float phi1, fl
   return sqrt(pow(deta, 2) + pow(dphi, 2));
 }
 
-std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID(int ID)
+std::vector<int> RawClusterBuilderTopo::calculate_adjacent_towers_by_ID(int ID)
 {
   int this_layer = get_ilayer_from_ID(ID);
   int this_eta = get_ieta_from_ID(ID);
@@ -109,7 +109,7 @@ std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID(int ID)
           {
             if (Verbosity() > 20)
             {
-              std::cout << "RawClusterBuilderTopo::get_adjacent_towers_by_ID : corner growth not allowed " << std::endl;
+              std::cout << "RawClusterBuilderTopo::calculate_adjacent_towers_by_ID : corner growth not allowed " << std::endl;
             }
             continue;
           }
@@ -137,7 +137,7 @@ std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID(int ID)
         int EMCal_tower = get_ID(2, new_eta, new_phi);
         if (Verbosity() > 20)
         {
-          std::cout << "RawClusterBuilderTopo::get_adjacent_towers_by_ID : HCal tower with eta / phi = " << this_eta << " / " << this_phi << ", adding EMCal tower with eta / phi = " << new_eta << " / " << new_phi << std::endl;
+          std::cout << "RawClusterBuilderTopo::calculate_adjacent_towers_by_ID : HCal tower with eta / phi = " << this_eta << " / " << this_phi << ", adding EMCal tower with eta / phi = " << new_eta << " / " << new_phi << std::endl;
         }
         adjacent_towers.push_back(EMCal_tower);
       }
@@ -181,7 +181,7 @@ std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID(int ID)
         int IHCal_tower = get_ID(0, HCal_eta, HCal_phi);
         if (Verbosity() > 20)
         {
-          std::cout << "RawClusterBuilderTopo::get_adjacent_towers_by_ID : EMCal tower with eta / phi = " << this_eta << " / " << this_phi << ", adding IHCal tower with eta / phi = " << HCal_eta << " / " << HCal_phi << std::endl;
+          std::cout << "RawClusterBuilderTopo::calculate_adjacent_towers_by_ID : EMCal tower with eta / phi = " << this_eta << " / " << this_phi << ", adding IHCal tower with eta / phi = " << HCal_eta << " / " << HCal_phi << std::endl;
         }
         adjacent_towers.push_back(IHCal_tower);
       }
@@ -189,7 +189,7 @@ std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID(int ID)
       {
         if (Verbosity() > 20)
         {
-          std::cout << "RawClusterBuilderTopo::get_adjacent_towers_by_ID : EMCal tower with eta / phi = " << this_eta << " / " << this_phi << ", does not have matching IHCal due to large eta " << std::endl;
+          std::cout << "RawClusterBuilderTopo::calculate_adjacent_towers_by_ID : EMCal tower with eta / phi = " << this_eta << " / " << this_phi << ", does not have matching IHCal due to large eta " << std::endl;
         }
       }
     }
@@ -198,6 +198,43 @@ std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID(int ID)
   return adjacent_towers;
 }
 
+void RawClusterBuilderTopo::initialize_geometry()
+{
+  _EMCAL_NETA = _geom_containers[2]->get_etabins();
+  _EMCAL_NPHI = _geom_containers[2]->get_phibins();
+
+  _HCAL_NETA = _geom_containers[1]->get_etabins();
+  _HCAL_NPHI = _geom_containers[1]->get_phibins();
+
+  // EMCal IDs start after the (EMCal sized) HCal block, see get_ID
+  int n_IDs = 2 * _EMCAL_NETA * _EMCAL_NPHI;
+  int n_HCal_IDs = 2 * _HCAL_NETA * _HCAL_NPHI;
+
+  _tower_E.assign(n_IDs, 0);
+  _tower_key.assign(n_IDs, 0);
+  _tower_status.assign(n_IDs, -2);
+  _tower_ownership.assign(n_IDs, std::pair<int, int>(-1, -1));
+
+  // tabulate the adjacent towers of every tower once
+  _neighbor_offsets.assign(1, 0);
+  _neighbor_offsets.reserve(n_IDs + 1);
+  _neighbor_IDs.clear();
+  for (int ID = 0; ID < n_IDs; ID++)
+  {
+    if (ID < n_HCal_IDs || ID >= _EMCAL_NETA * _EMCAL_NPHI)
+    {
+      std::vector<int> adjacent_towers = calculate_adjacent_towers_by_ID(ID);
+      _neighbor_IDs.insert(_neighbor_IDs.end(), adjacent_towers.begin(), adjacent_towers.end());
+    }
+    _neighbor_offsets.push_back(_neighbor_IDs.size());
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "RawClusterBuilderTopo::initialize_geometry: EMCal eta / phi bins = " << _EMCAL_NETA << " / " << _EMCAL_NPHI << ", HCal eta / phi bins = " << _HCAL_NETA << " / " << _HCAL_NPHI << ", " << _neighbor_IDs.size() << " tower adjacencies" << std::endl;
+  }
+}
+
 void RawClusterBuilderTopo::export_single_cluster(const std::vector<int> &original_towers)
 {
   if (Verbosity() > 2)
@@ -205,17 +242,16 @@ void RawClusterBuilderTopo::export_single_cluster(const std::vector<int> &origin
     std::cout << "RawClusterBuilderTopo::export_single_cluster called " << std::endl;
   }
 
-  std::map<int, std::pair<int, int> > tower_ownership;
   for (const int &original_tower : original_towers)
   {
-    tower_ownership[original_tower] = std::pair<int, int>(0, -1);  // all towers owned by cluster 0
+    _tower_ownership[original_tower] = std::pair<int, int>(0, -1);  // all towers owned by cluster 0
   }
-  export_clusters(original_towers, tower_ownership, 1, std::vector<float>(), std::vector<float>(), std::vector<float>());
+  export_clusters(original_towers, 1, std::vector<float>(), std::vector<float>(), std::vector<float>());
 
   return;
 }
 
-void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_towers, std::map<int, std::pair<int, int> > tower_ownership, unsigned int n_clusters, const std::vector<float> &pseudocluster_sumE, const std::vector<float> &pseudocluster_eta, const std::vector<float> &pseudocluster_phi)
+void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_towers, unsigned int n_clusters, const std::vector<float> &pseudocluster_sumE, const std::vector<float> &pseudocluster_eta, const std::vector<float> &pseudocluster_phi)
 {
   if (n_clusters != 1)  // if we didn't just pass down from export_single_cluster
   {
@@ -245,26 +281,15 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
   for (int original_tower : original_towers)
   {
     int this_ID = original_tower;
-    std::pair<int, int> the_pair = tower_ownership[this_ID];
+    const std::pair<int, int> &the_pair = _tower_ownership[this_ID];
 
     if (Verbosity() > 5)
     {
       std::cout << "RawClusterBuilderTopo::export_clusters -> assigning tower " << original_tower << " with ownership ( " << the_pair.first << ", " << the_pair.second << " ) " << std::endl;
     }
-    int this_ieta = get_ieta_from_ID(this_ID);
-    int this_iphi = get_iphi_from_ID(this_ID);
     int this_layer = get_ilayer_from_ID(this_ID);
     float this_E = get_E_from_ID(this_ID);
-
-    int this_key = 0;
-    if (this_layer == 2)
-    {
-      this_key = _EMTOWERMAP_KEY_ETA_PHI[this_ieta][this_iphi];
-    }
-    else
-    {
-      this_key = _TOWERMAP_KEY_LAYER_ETA_PHI[this_layer][this_ieta][this_iphi];
-    }
+    int this_key = _tower_key[this_ID];
 
     RawTowerGeom *tower_geom = _geom_containers[this_layer]->get_tower_geometry(this_key);
 
@@ -372,6 +397,16 @@ int RawClusterBuilderTopo::InitRun(PHCompositeNode *topNode)
     throw;
   }
 
+  // build the tower tables and the neighbour table if the geometry is already there,
+  // otherwise this happens with the first event
+  _geom_containers[0] = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
+  _geom_containers[1] = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
+  _geom_containers[2] = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
+  if (_geom_containers[0] && _geom_containers[1] && _geom_containers[2] && _neighbor_offsets.empty())
+  {
+    initialize_geometry();
+  }
+
   if (Verbosity() > 0)
   {
     std::cout << "RawClusterBuilderTopo::InitRun: initialized with EMCal enable = " << _enable_EMCal << " and I+OHCal enable = " << _enable_HCal << std::endl;
@@ -450,49 +485,16 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     std::cout << "RawClusterBuilderTopo::process_event: pointer to TOWERGEOM_HCALOUT: " << _geom_containers[1] << std::endl;
   }
 
-  if (_EMCAL_NETA < 0)
+  if (_neighbor_offsets.empty())
   {
     // define geometry only once if it has not been yet
-    _EMCAL_NETA = _geom_containers[2]->get_etabins();
-    _EMCAL_NPHI = _geom_containers[2]->get_phibins();
-
-    _EMTOWERMAP_STATUS_ETA_PHI.resize(_EMCAL_NETA, std::vector<int>(_EMCAL_NPHI, -2));
-    _EMTOWERMAP_KEY_ETA_PHI.resize(_EMCAL_NETA, std::vector<int>(_EMCAL_NPHI, 0));
-    _EMTOWERMAP_E_ETA_PHI.resize(_EMCAL_NETA, std::vector<float>(_EMCAL_NPHI, 0));
+    initialize_geometry();
   }
 
-  if (_HCAL_NETA < 0)
-  {
-    // define geometry only once if it has not been yet
-    _HCAL_NETA = _geom_containers[1]->get_etabins();
-    _HCAL_NPHI = _geom_containers[1]->get_phibins();
-
-    _TOWERMAP_STATUS_LAYER_ETA_PHI.resize(2, std::vector<std::vector<int> >(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, -2)));
-    _TOWERMAP_KEY_LAYER_ETA_PHI.resize(2, std::vector<std::vector<int> >(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0)));
-    _TOWERMAP_E_LAYER_ETA_PHI.resize(2, std::vector<std::vector<float> >(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0)));
-  }
-
-  // reset maps
+  // reset tower arrays
   // but note -- do not reset keys!
-  for (int ieta = 0; ieta < _EMCAL_NETA; ieta++)
-  {
-    for (int iphi = 0; iphi < _EMCAL_NPHI; iphi++)
-    {
-      _EMTOWERMAP_STATUS_ETA_PHI[ieta][iphi] = -2;  // set tower does not exist
-      _EMTOWERMAP_E_ETA_PHI[ieta][iphi] = 0;        // set zero energy
-    }
-  }
-  for (int ilayer = 0; ilayer < 2; ilayer++)
-  {
-    for (int ieta = 0; ieta < _HCAL_NETA; ieta++)
-    {
-      for (int iphi = 0; iphi < _HCAL_NPHI; iphi++)
-      {
-        _TOWERMAP_STATUS_LAYER_ETA_PHI[ilayer][ieta][iphi] = -2;  // set tower does not exist
-        _TOWERMAP_E_LAYER_ETA_PHI[ilayer][ieta][iphi] = 0;        // set zero energy
-      }
-    }
-  }
+  std::fill(_tower_status.begin(), _tower_status.end(), -2);  // set tower does not exist
+  std::fill(_tower_E.begin(), _tower_E.end(), 0);             // set zero energy
 
   // setup
   std::vector<std::pair<int, float> > list_of_seeds;
@@ -530,14 +532,14 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      _EMTOWERMAP_STATUS_ETA_PHI[ieta][iphi] = -1;  // change status to unknown
-      _EMTOWERMAP_E_ETA_PHI[ieta][iphi] = this_E;
-      _EMTOWERMAP_KEY_ETA_PHI[ieta][iphi] = key;
+      int ID = get_ID(2, ieta, iphi);
+      _tower_status[ID] = -1;  // change status to unknown
+      _tower_E[ID] = this_E;
+      _tower_key[ID] = key;
 
       // use fabs() here for simplicity - if we're not using abs E, negative towers are already excluded
       if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[2])
       {
-        int ID = get_ID(2, ieta, iphi);
         list_of_seeds.emplace_back(ID, this_E);
         if (Verbosity() > 10)
         {
@@ -576,13 +578,13 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[0][ieta][iphi] = -1;  // change status to unknown
-      _TOWERMAP_E_LAYER_ETA_PHI[0][ieta][iphi] = this_E;
-      _TOWERMAP_KEY_LAYER_ETA_PHI[0][ieta][iphi] = key;
+      int ID = get_ID(0, ieta, iphi);
+      _tower_status[ID] = -1;  // change status to unknown
+      _tower_E[ID] = this_E;
+      _tower_key[ID] = key;
 
       if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[0])
       {
-        int ID = get_ID(0, ieta, iphi);
         list_of_seeds.emplace_back(ID, this_E);
         if (Verbosity() > 10)
         {
@@ -615,13 +617,13 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[1][ieta][iphi] = -1;  // change status to unknown
-      _TOWERMAP_E_LAYER_ETA_PHI[1][ieta][iphi] = this_E;
-      _TOWERMAP_KEY_LAYER_ETA_PHI[1][ieta][iphi] = key;
+      int ID = get_ID(1, ieta, iphi);
+      _tower_status[ID] = -1;  // change status to unknown
+      _tower_E[ID] = this_E;
+      _tower_key[ID] = key;
 
       if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[1])
       {
-        int ID = get_ID(1, ieta, iphi);
         list_of_seeds.emplace_back(ID, this_E);
         if (Verbosity() > 10)
         {
@@ -659,14 +661,14 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
   std::vector<std::vector<int> > all_cluster_towers;  // store final cluster tower lists here
 
-  while (!list_of_seeds.empty())
+  // walk through the sorted seeds with an index instead of erasing the front of the vector
+  for (unsigned int iseed = 0; iseed < list_of_seeds.size(); iseed++)
   {
-    int seed_ID = list_of_seeds.at(0).first;
-    list_of_seeds.erase(list_of_seeds.begin());
+    int seed_ID = list_of_seeds[iseed].first;
 
     if (Verbosity() > 5)
     {
-      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << list_of_seeds.size() << std::endl;
+      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << list_of_seeds.size() - iseed - 1 << std::endl;
     }
 
     // if this seed was already claimed by some other seed during its growth, remove it and do nothing
@@ -696,17 +698,16 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       std::cout << " RawClusterBuilderTopo::process_event: Entering Growth stage for cluster " << cluster_index << std::endl;
     }
 
-    while (!grow_tower_ID.empty())
+    for (unsigned int igrow = 0; igrow < grow_tower_ID.size(); igrow++)
     {
-      int grow_ID = grow_tower_ID.at(0);
-      grow_tower_ID.erase(grow_tower_ID.begin());
+      int grow_ID = grow_tower_ID[igrow];
 
       if (Verbosity() > 5)
       {
-        std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << grow_tower_ID.size() << " grow towers left" << std::endl;
+        std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << grow_tower_ID.size() - igrow - 1 << " grow towers left" << std::endl;
       }
 
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(grow_ID);
+      const NeighborRange adjacent_tower_IDs = get_adjacent_towers_by_ID(grow_ID);
 
       for (int this_adjacent_tower_ID : adjacent_tower_IDs)
       {
@@ -768,7 +769,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
       if (Verbosity() > 5)
       {
-        std::cout << " --> after examining neighbors, grow list is now " << grow_tower_ID.size() << ", # of towers in cluster = " << cluster_tower_ID.size() << std::endl;
+        std::cout << " --> after examining neighbors, grow list is now " << grow_tower_ID.size() - igrow - 1 << ", # of towers in cluster = " << cluster_tower_ID.size() << std::endl;
       }
     }
 
@@ -788,7 +789,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       {
         std::cout << " --> cluster " << cluster_index << ", perimeter stage, examining neighbors of ID " << core_ID << ", core cluster # " << ic << " of " << n_core_towers << " total " << std::endl;
       }
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(core_ID);
+      const NeighborRange adjacent_tower_IDs = get_adjacent_towers_by_ID(core_ID);
 
       for (int this_adjacent_tower_ID : adjacent_tower_IDs)
       {
@@ -862,7 +863,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
   for (int cl = 0; cl < original_cluster_index; cl++)
   {
-    std::vector<int> original_towers = all_cluster_towers.at(cl);
+    const std::vector<int> &original_towers = all_cluster_towers.at(cl);
 
     if (!_do_split)
     {
@@ -896,7 +897,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       }
 
       // examine neighbors
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(tower_ID);
+      const NeighborRange adjacent_tower_IDs = get_adjacent_towers_by_ID(tower_ID);
       int neighbors_in_cluster = 0;
 
       // check for higher neighbor
@@ -1043,10 +1044,9 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // -1 means unseen
     // -2 means seen and in the seed list now (e.g. don't add it to the seed list again)
     // -3 shared tower, ignore going forward...
-    std::map<int, std::pair<int, int> > tower_ownership;
-    for (int &original_tower : original_towers)
+    for (const int &original_tower : original_towers)
     {
-      tower_ownership[original_tower] = std::pair<int, int>(-1, -1);  // initialize all towers as un-seen
+      _tower_ownership[original_tower] = std::pair<int, int>(-1, -1);  // initialize all towers as un-seen
     }
     std::vector<int> seed_list;
     std::vector<int> neighbor_list;
@@ -1058,15 +1058,15 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // initialize neighbor list
     for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
     {
-      tower_ownership[local_maxima_ID.at(s).first] = std::pair<int, int>(s, -1);
+      _tower_ownership[local_maxima_ID.at(s).first] = std::pair<int, int>(s, -1);
       neighbor_list.push_back(local_maxima_ID.at(s).first);
     }
 
     if (Verbosity() > 100)
     {
-      for (int &original_tower : original_towers)
+      for (const int &original_tower : original_towers)
       {
-        std::pair<int, int> the_pair = tower_ownership[original_tower];
+        std::pair<int, int> the_pair = _tower_ownership[original_tower];
         std::cout << " Debug Pre-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
         std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
         std::cout << std::endl;
@@ -1096,19 +1096,15 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         {
           if (Verbosity() > 10)
           {
-            std::cout << " -> -> -> special first pass rules, this tower already owned by pseudocluster " << tower_ownership[neighbor_ID].first << std::endl;
+            std::cout << " -> -> -> special first pass rules, this tower already owned by pseudocluster " << _tower_ownership[neighbor_ID].first << std::endl;
           }
-          new_ownerships.push_back(tower_ownership[neighbor_ID].first);
+          new_ownerships.push_back(_tower_ownership[neighbor_ID].first);
         }
         else
         {
-          std::map<int, bool> pseudocluster_adjacency;
-          for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
-          {
-            pseudocluster_adjacency[s] = false;
-          }
+          std::vector<bool> pseudocluster_adjacency(local_maxima_ID.size(), false);
           // look over all towers THIS one is adjacent to, and count up...
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
+          const NeighborRange adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1117,13 +1113,13 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
               continue;
             }
 
-            if (tower_ownership[this_adjacent_tower_ID].first > -1)
+            if (_tower_ownership[this_adjacent_tower_ID].first > -1 && _tower_ownership[this_adjacent_tower_ID].first < (int) pseudocluster_adjacency.size())
             {
               if (Verbosity() > 20)
               {
-                std::cout << " -> -> -> adjacent tower to this one, with ID " << this_adjacent_tower_ID << " , is owned by pseudocluster " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
+                std::cout << " -> -> -> adjacent tower to this one, with ID " << this_adjacent_tower_ID << " , is owned by pseudocluster " << _tower_ownership[this_adjacent_tower_ID].first << std::endl;
               }
-              pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].first] = true;
+              pseudocluster_adjacency[_tower_ownership[this_adjacent_tower_ID].first] = true;
             }
           }
           int n_pseudocluster_adjacent = 0;
@@ -1175,7 +1171,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         int neighbor_ID = neighbor_list.at(n);
         if (new_ownerships.at(n) > -1)
         {
-          tower_ownership[neighbor_ID] = std::pair<int, int>(new_ownerships.at(n), -1);
+          _tower_ownership[neighbor_ID] = std::pair<int, int>(new_ownerships.at(n), -1);
           seed_list.push_back(neighbor_ID);
           if (Verbosity() > 20)
           {
@@ -1184,7 +1180,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         }
         if (new_ownerships.at(n) == -3)
         {
-          tower_ownership[neighbor_ID] = std::pair<int, int>(-3, -1);
+          _tower_ownership[neighbor_ID] = std::pair<int, int>(-3, -1);
           shared_list.push_back(neighbor_ID);
           if (Verbosity() > 20)
           {
@@ -1204,7 +1200,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         int neighbor_ID = neighbor_list.at(n);
         if (new_ownerships.at(n) > -1)
         {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
+          const NeighborRange adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1212,7 +1208,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
             {
               continue;
             }
-            if (tower_ownership[this_adjacent_tower_ID].first == -1)
+            if (_tower_ownership[this_adjacent_tower_ID].first == -1)
             {
               new_neighbor_list.push_back(this_adjacent_tower_ID);
               if (Verbosity() > 5)
@@ -1253,15 +1249,15 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
     if (Verbosity() > 100)
     {
-      for (int &original_tower : original_towers)
+      for (const int &original_tower : original_towers)
       {
-        std::pair<int, int> the_pair = tower_ownership[original_tower];
+        std::pair<int, int> the_pair = _tower_ownership[original_tower];
         std::cout << " Debug Mid-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
         std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
         std::cout << std::endl;
         if (the_pair.first == -1)
         {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(original_tower);
+          const NeighborRange adjacent_tower_IDs = get_adjacent_towers_by_ID(original_tower);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1269,7 +1265,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
             {
               continue;
             }
-            std::cout << "    -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
+            std::cout << "    -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << _tower_ownership[this_adjacent_tower_ID].first << std::endl;
           }
         }
       }
@@ -1288,9 +1284,9 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     pseudocluster_sumE.resize(local_maxima_ID.size(), 0);
     pseudocluster_ntower.resize(local_maxima_ID.size(), 0);
 
-    for (int &original_tower : original_towers)
+    for (const int &original_tower : original_towers)
     {
-      std::pair<int, int> the_pair = tower_ownership[original_tower];
+      std::pair<int, int> the_pair = _tower_ownership[original_tower];
       if (the_pair.first > -1)
       {
         float this_ID = original_tower;
@@ -1320,21 +1316,20 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       std::cout << "RawClusterBuilderTopo::process_event now splitting up shared clusters (including unassigned clusters), initial shared list has size " << shared_list.size() << std::endl;
     }
     // iterate through shared cells, identifying which two they belong to
-    while (!shared_list.empty())
+    for (unsigned int ishared = 0; ishared < shared_list.size(); ishared++)
     {
-      // pick the first cell and pop off list
-      int shared_ID = shared_list.at(0);
-      shared_list.erase(shared_list.begin());
+      // pick the next cell in the list
+      int shared_ID = shared_list[ishared];
 
       if (Verbosity() > 5)
       {
-        std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() << " shared towers left " << std::endl;
+        std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() - ishared - 1 << " shared towers left " << std::endl;
       }
       // look through adjacent pseudoclusters, taking two with highest energies
       std::vector<bool> pseudocluster_adjacency;
       pseudocluster_adjacency.resize(local_maxima_ID.size(), false);
 
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(shared_ID);
+      const NeighborRange adjacent_tower_IDs = get_adjacent_towers_by_ID(shared_ID);
 
       for (int this_adjacent_tower_ID : adjacent_tower_IDs)
       {
@@ -1342,19 +1337,19 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         {
           continue;
         }
-        if (tower_ownership[this_adjacent_tower_ID].first > -1)
+        if (_tower_ownership[this_adjacent_tower_ID].first > -1)
         {
-          pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].first] = true;
+          pseudocluster_adjacency[_tower_ownership[this_adjacent_tower_ID].first] = true;
         }
-        if (tower_ownership[this_adjacent_tower_ID].second > -1)
+        if (_tower_ownership[this_adjacent_tower_ID].second > -1)
         {  // can inherit adjacency from shared cluster
-          pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].second] = true;
+          pseudocluster_adjacency[_tower_ownership[this_adjacent_tower_ID].second] = true;
         }
         // at the same time, add unowned towers to the list for later examination
-        if (tower_ownership[this_adjacent_tower_ID].first == -1)
+        if (_tower_ownership[this_adjacent_tower_ID].first == -1)
         {
           shared_list.push_back(this_adjacent_tower_ID);
-          tower_ownership[this_adjacent_tower_ID] = std::pair<int, int>(-3, -1);
+          _tower_ownership[this_adjacent_tower_ID] = std::pair<int, int>(-3, -1);
           if (Verbosity() > 10)
           {
             std::cout << " -> while looking at neighbors, have added un-examined tower " << this_adjacent_tower_ID << " to shared list " << std::endl;
@@ -1396,20 +1391,20 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         std::cout << " -> highest pseudoclusters its adjacent to are " << highest_pseudocluster_index << " ( E = " << highest_pseudocluster_E << " ) and " << second_highest_pseudocluster_index << " ( E = " << second_highest_pseudocluster_E << " ) " << std::endl;
       }
       // assign these clusters as owners
-      tower_ownership[shared_ID] = std::pair<int, int>(highest_pseudocluster_index, second_highest_pseudocluster_index);
+      _tower_ownership[shared_ID] = std::pair<int, int>(highest_pseudocluster_index, second_highest_pseudocluster_index);
     }
 
     if (Verbosity() > 100)
     {
-      for (int &original_tower : original_towers)
+      for (const int &original_tower : original_towers)
       {
-        std::pair<int, int> the_pair = tower_ownership[original_tower];
+        std::pair<int, int> the_pair = _tower_ownership[original_tower];
         std::cout << " Debug Post-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
         std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
         std::cout << std::endl;
         if (the_pair.first == -1)
         {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(original_tower);
+          const NeighborRange adjacent_tower_IDs = get_adjacent_towers_by_ID(original_tower);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1417,14 +1412,14 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
             {
               continue;
             }
-            std::cout << " -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
+            std::cout << " -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << _tower_ownership[this_adjacent_tower_ID].first << std::endl;
           }
         }
       }
     }
 
     // call helper function
-    export_clusters(original_towers, tower_ownership, local_maxima_ID.size(), pseudocluster_sumE, pseudocluster_eta, pseudocluster_phi);
+    export_clusters(original_towers, local_maxima_ID.size(), pseudocluster_sumE, pseudocluster_eta, pseudocluster_phi);
   }
 
   if (Verbosity() > 1)
@@ -9,7 +9,6 @@
 
 #include <fun4all/SubsysReco.h>
 
-#include <map>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
@@ -124,13 +123,29 @@ class RawClusterBuilderTopo : public SubsysReco
     return ((index_emcal_phi + 251) / 4) % _HCAL_NPHI;
   }
 
-  std::vector<int> get_adjacent_towers_by_ID(int ID);
+  // view of the neighbours of one tower in the neighbour table
+  struct NeighborRange
+  {
+    const int *first;
+    const int *last;
+    const int *begin() const { return first; }
+    const int *end() const { return last; }
+  };
+
+  NeighborRange get_adjacent_towers_by_ID(int ID) const
+  {
+    return {_neighbor_IDs.data() + _neighbor_offsets[ID], _neighbor_IDs.data() + _neighbor_offsets[ID + 1]};
+  }
+
+  std::vector<int> calculate_adjacent_towers_by_ID(int ID);
+
+  void initialize_geometry();
 
   static float calculate_dR(float, float, float, float);
 
   void export_single_cluster(const std::vector<int> &);
 
-  void export_clusters(const std::vector<int> &, std::map<int, std::pair<int, int> >, unsigned int, const std::vector<float> &, const std::vector<float> &, const std::vector<float> &);
+  void export_clusters(const std::vector<int> &, unsigned int, const std::vector<float> &, const std::vector<float> &, const std::vector<float> &);
 
   int get_ID(int ilayer, int ieta, int iphi)
   {
@@ -177,34 +192,19 @@ class RawClusterBuilderTopo : public SubsysReco
     }
   }
 
-  int get_status_from_ID(int ID)
+  int get_status_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      return _TOWERMAP_STATUS_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
-    }
-    return _EMTOWERMAP_STATUS_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
+    return _tower_status[ID];
   }
 
-  float get_E_from_ID(int ID)
+  float get_E_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      return _TOWERMAP_E_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
-    }
-    return _EMTOWERMAP_E_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
+    return _tower_E[ID];
   }
 
   void set_status_by_ID(int ID, int status)
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)] = status;
-    }
-    else
-    {
-      _EMTOWERMAP_STATUS_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)] = status;
-    }
+    _tower_status[ID] = status;
   }
 
   RawClusterContainer *_clusters {nullptr};
@@ -236,13 +236,17 @@ class RawClusterBuilderTopo : public SubsysReco
   bool _do_split {true};
   bool _only_good_towers {true};
 
-  std::vector<std::vector<std::vector<float> > > _TOWERMAP_E_LAYER_ETA_PHI;
-  std::vector<std::vector<std::vector<int> > > _TOWERMAP_KEY_LAYER_ETA_PHI;
-  std::vector<std::vector<std::vector<int> > > _TOWERMAP_STATUS_LAYER_ETA_PHI;
-
-  std::vector<std::vector<float> > _EMTOWERMAP_E_ETA_PHI;
-  std::vector<std::vector<int> > _EMTOWERMAP_KEY_ETA_PHI;
-  std::vector<std::vector<int> > _EMTOWERMAP_STATUS_ETA_PHI;
+  // per tower arrays indexed by tower ID (see get_ID)
+  std::vector<float> _tower_E;
+  std::vector<int> _tower_key;
+  std::vector<int> _tower_status;
+  // ownership (pseudocluster, second pseudocluster) of towers during splitting,
+  // only valid for the towers of the cluster being split
+  std::vector<std::pair<int, int> > _tower_ownership;
+
+  // adjacent towers of each tower ID in compressed row form, built once the geometry is known
+  std::vector<int> _neighbor_offsets;
+  std::vector<int> _neighbor_IDs;
 
   std::string _inputnodeprefix;
   std::string ClusterNodeName {"TOPOCLUSTER_HCAL"};
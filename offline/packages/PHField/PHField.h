@@ -1,6 +1,9 @@
 #ifndef PHFIELD_PHFIELD_H
 #define PHFIELD_PHFIELD_H
 
+#include <cstddef>
+#include <memory>
+
 // units of this class. To convert internal value to Geant4/CLHEP units for fast access
 
 //! \brief transient object for field storage and access
@@ -30,6 +33,48 @@ class PHField
       double *Bfield) const
   { return GetFieldValue( Point, Bfield ); }
 
+  //! caller owned lookup state of a field map
+  /*
+   * the cache of GetFieldValue lives inside the field and is not thread safe.
+   * Concurrent callers get one Cache per thread from MakeCache and pass it to
+   * GetFieldValue_cache or GetFieldValues
+   */
+  class Cache
+  {
+   public:
+    virtual ~Cache() = default;
+  };
+
+  //! new lookup cache for this field, nullptr if the field has no lookup state
+  virtual std::unique_ptr<Cache> MakeCache() const
+  { return nullptr; }
+
+  //! thread safe cached field accessor
+  /*
+   * the cache must come from MakeCache of this field and must not be shared between threads.
+   * Without cache this is the same as GetFieldValue_nocache
+   */
+  virtual void GetFieldValue_cache(
+      const double Point[4],
+      double *Bfield,
+      Cache * /*cache*/) const
+  { return GetFieldValue_nocache( Point, Bfield ); }
+
+  //! batch field accessor, thread safe under the same conditions as GetFieldValue_cache
+  //! @param[in]  Points  n space time coordinates, point i is Points[4*i] ... Points[4*i+3]
+  //! @param[out] Bfields n field values, field i is Bfields[3*i] ... Bfields[3*i+2]
+  virtual void GetFieldValues(
+      const double *Points,
+      double *Bfields,
+      const std::size_t n,
+      Cache *cache = nullptr) const
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      GetFieldValue_cache(Points + 4 * i, Bfields + 3 * i, cache);
+    }
+  }
+
   //! verbosity
   void Verbosity(const int i) { m_Verbosity = i; }
 
@@ -18,10 +18,6 @@
 
 PHField2D::PHField2D(const std::string &filename, const int verb, const float magfield_rescale)
   : PHField(verb)
-  , r_index0_cache(0)
-  , r_index1_cache(0)
-  , z_index0_cache(0)
-  , z_index1_cache(0)
 {
   if (Verbosity() > 0)
   {
@@ -228,6 +224,21 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
 
 void PHField2D::GetFieldValue(const double point[4], double *Bfield) const
 {
+  GetFieldValue_cache(point, Bfield, &m_Cache);
+}
+
+std::unique_ptr<PHField::Cache> PHField2D::MakeCache() const
+{
+  return std::make_unique<FieldCache>();
+}
+
+void PHField2D::GetFieldValue_cache(const double point[4], double *Bfield, PHField::Cache *cache) const
+{
+  if (!cache)
+  {
+    GetFieldValue_nocache(point, Bfield);
+    return;
+  }
   if (Verbosity() > 2)
   {
     std::cout << "\nPHField2D::GetFieldValue" << std::endl;
@@ -250,7 +261,7 @@ void PHField2D::GetFieldValue(const double point[4], double *Bfield) const
     double cylpoint[4] = {z, r, phi, 0};
 
     // take <z,r,phi> location and return a vector of <Bz, Br, Bphi>
-    GetFieldCyl(cylpoint, BFieldCyl);
+    GetFieldCyl(cylpoint, BFieldCyl, *static_cast<FieldCache *>(cache));
 
     // X direction of B-field ( Bx = Br*cos(phi) - Bphi*sin(phi)
     Bfield[0] = cos(phi) * BFieldCyl[1] - sin(phi) * BFieldCyl[2];  // unit vector transformations
@@ -339,6 +350,11 @@ void PHField2D::GetFieldValue_nocache(const double point[4], double *Bfield) con
 }
 
 void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
+{
+  GetFieldCyl(CylPoint, BfieldCyl, m_Cache);
+}
+
+void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl, FieldCache &cache) const
 {
   float z = CylPoint[0];
   float r = CylPoint[1];
@@ -364,8 +380,8 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
   // since GEANT4 looks up the field ~95% of the time in the same voxel
   // between subsequent calls, we can save on the expense of the upper_bound
   // lookup (~10-15% of central event run time) with some caching between calls
-  unsigned int r_index0 = r_index0_cache;
-  unsigned int r_index1 = r_index1_cache;
+  unsigned int r_index0 = cache.r_index0_cache;
+  unsigned int r_index1 = cache.r_index1_cache;
 
   if (!((r > r_map_[r_index0]) && (r < r_map_[r_index1])))
   {
@@ -392,12 +408,12 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
     }
 
     // update cache
-    r_index0_cache = r_index0;
-    r_index1_cache = r_index1;
+    cache.r_index0_cache = r_index0;
+    cache.r_index1_cache = r_index1;
   }
 
-  unsigned int z_index0 = z_index0_cache;
-  unsigned int z_index1 = z_index1_cache;
+  unsigned int z_index0 = cache.z_index0_cache;
+  unsigned int z_index1 = cache.z_index1_cache;
 
   if (!((z > z_map_[z_index0]) && (z < z_map_[z_index1])))
   {
@@ -415,8 +431,8 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
     }
 
     // update cache
-    z_index0_cache = z_index0;
-    z_index1_cache = z_index1;
+    cache.z_index0_cache = z_index0;
+    cache.z_index1_cache = z_index1;
   }
 
   double Br000 = BFieldR_[z_index0][r_index0];
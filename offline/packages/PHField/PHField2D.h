@@ -5,6 +5,7 @@
 #include "PHField.h"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -25,6 +26,12 @@ class PHField2D : public PHField
   //! access field value
   void GetFieldValue_nocache(const double Point[4], double *Bfield) const override;
 
+  //! lookup cache for GetFieldValue_cache, one per thread
+  std::unique_ptr<PHField::Cache> MakeCache() const override;
+
+  //! thread safe field accessor using the caller owned cache
+  void GetFieldValue_cache(const double Point[4], double *Bfield, PHField::Cache *cache) const override;
+
   void GetFieldCyl(const double CylPoint[4], double *Bfield) const;
 
   void GetFieldCyl_nocache(const double CylPoint[4], double *Bfield) const;
@@ -44,6 +51,18 @@ class PHField2D : public PHField
   double magfield_unit;
 
  private:
+  //! r and z indices of the last grid cell
+  class FieldCache : public PHField::Cache
+  {
+   public:
+    unsigned int r_index0_cache{0};
+    unsigned int r_index1_cache{0};
+    unsigned int z_index0_cache{0};
+    unsigned int z_index1_cache{0};
+  };
+
+  void GetFieldCyl(const double CylPoint[4], double *Bfield, FieldCache &cache) const;
+
   void print_map(std::map<trio, trio>::iterator &it) const;
   // mutable allows to change internal data even in const methods
   // I don't like this too much but these are cached values to speed up
@@ -52,10 +71,7 @@ class PHField2D : public PHField
   // and still have caching. Putting those as static variables into
   // the implementation will prevent this
 
-  mutable unsigned int r_index0_cache;
-  mutable unsigned int r_index1_cache;
-  mutable unsigned int z_index0_cache;
-  mutable unsigned int z_index1_cache;
+  mutable FieldCache m_Cache;
 };
 
 #endif
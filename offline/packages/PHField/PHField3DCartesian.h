@@ -5,6 +5,7 @@
 
 #include <limits>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <tuple>
@@ -27,7 +28,25 @@ class PHField3DCartesian : public PHField
 
   void GetFieldValue_nocache(const double Point[4], double *Bfield) const override;
 
+  //! lookup cache for GetFieldValue_cache, one per thread
+  std::unique_ptr<PHField::Cache> MakeCache() const override;
+
+  //! thread safe field accessor using the caller owned cache
+  void GetFieldValue_cache(const double Point[4], double *Bfield, PHField::Cache *cache) const override;
+
   private:
+  //! field values at the corners of the last grid cell
+  class FieldCache : public PHField::Cache
+  {
+   public:
+    double bf[2][2][2][3]{};
+    double xkey_save {std::numeric_limits<double>::quiet_NaN()};
+    double ykey_save {std::numeric_limits<double>::quiet_NaN()};
+    double zkey_save {std::numeric_limits<double>::quiet_NaN()};
+    int cache_hits {0};
+    int cache_misses {0};
+  };
+
   std::string filename;
   double xmin {1000000};
   double xmax {-1000000};
@@ -39,14 +58,9 @@ class PHField3DCartesian : public PHField
   double ystepsize {std::numeric_limits<double>::quiet_NaN()};
   double zstepsize {std::numeric_limits<double>::quiet_NaN()};
 
-  // these are updated in a const method
-  // to cache previous values
-  mutable double bf[2][2][2][3]{};
-  mutable double xkey_save {std::numeric_limits<double>::quiet_NaN()};
-  mutable double ykey_save {std::numeric_limits<double>::quiet_NaN()};
-  mutable double zkey_save {std::numeric_limits<double>::quiet_NaN()};
-  mutable int cache_hits {0};
-  mutable int cache_misses {0};
+  // this is updated in a const method
+  // to cache previous values for GetFieldValue
+  mutable FieldCache m_Cache;
 
   typedef std::tuple<float, float, float> trio;
   std::map<std::tuple<float, float, float>, std::tuple<float, float, float> > fieldmap;
@@ -144,6 +144,21 @@ void
 PHFieldInterpolated::GetFieldValue (
 	double const* point_as_arr, // pointer to (immutable) double[4]
 	double* field_as_arr // pointer to (mutable) double[3]
+) const {
+	GetFieldValue_cache(point_as_arr, field_as_arr, nullptr);
+}
+
+std::unique_ptr<PHField::Cache>
+PHFieldInterpolated::MakeCache (
+) const {
+	return std::make_unique<FieldCache>();
+}
+
+void
+PHFieldInterpolated::GetFieldValue_cache (
+	double const* point_as_arr, // pointer to (immutable) double[4]
+	double* field_as_arr, // pointer to (mutable) double[3]
+	PHField::Cache* cache // caller owned, nullptr for the shared per-thread caches
 ) const {
 	Point_t point {
 		(float)point_as_arr[0],
@@ -171,7 +186,14 @@ PHFieldInterpolated::GetFieldValue (
 
 	// This should not throw if point is in bounds, which we just checked
 	// If this throws, there is a bug in class logic
-	Field_t field = get_interpolated(point);
+	Field_t field;
+	if (cache) {
+		InterpolationCache& this_cache = static_cast<FieldCache*>(cache)->m_cache;
+		cache_interpolation(point, this_cache);
+		field = evaluate(point, this_cache);
+	} else {
+		field = get_interpolated(point);
+	}
 	for (int i = 0; i < 3; ++i) {
 		field_as_arr[i] = field(i);
 	}
@@ -306,10 +328,19 @@ PHFieldInterpolated::get_interpolated (
 		});
 	}
 
+	return evaluate(point, this_cache);
+}
+
+PHFieldInterpolated::Field_t
+PHFieldInterpolated::evaluate (
+	Point_t const& point,
+	InterpolationCache const& cache
+) {
+	Eigen::VectorXf design_vector = get_design_vector(point, cache);
 	return {
-		get_design_vector(point, this_cache).dot(this_cache.m_coefficients[0]),
-		get_design_vector(point, this_cache).dot(this_cache.m_coefficients[1]),
-		get_design_vector(point, this_cache).dot(this_cache.m_coefficients[2]),
+		design_vector.dot(cache.m_coefficients[0]),
+		design_vector.dot(cache.m_coefficients[1]),
+		design_vector.dot(cache.m_coefficients[2]),
 	};
 }
 
@@ -16,6 +16,7 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -42,6 +43,13 @@ public:
 	//! @param[out] pointer to double[3] representing (b_x, b_y, b_z), mutated to contain the value of the field (in Geant4/CLHEP units) (T)
 	void GetFieldValue (double const*, double*) const override;
 
+	//! caller owned interpolation cache for GetFieldValue_cache, one per thread
+	std::unique_ptr<PHField::Cache> MakeCache () const override;
+
+	//! same as GetFieldValue, but keeps the interpolation in the caller owned cache instead of the locked per-thread map
+	//! without cache this falls back to GetFieldValue
+	void GetFieldValue_cache (double const*, double*, PHField::Cache*) const override;
+
 	//! Returns an O(3) best fit interpolation of the field at the point, updating the cached interpolated parameters as needed
 	//! Thread-safe top-level access
 	Field_t get_interpolated (Point_t const&) const;
@@ -83,6 +91,14 @@ private:
 		std::array<Eigen::VectorXf, 3>	m_coefficients;
 	};
 
+	//! Caller owned wrapper of the interpolation cache
+	struct FieldCache : public PHField::Cache {
+		InterpolationCache m_cache;
+	};
+
+	//! Evaluates the interpolation stored in the cache at the point
+	static Field_t evaluate (Point_t const&, InterpolationCache const&);
+
 	//! Returns the 20 element row of a design matrix for position point about the stored value m_center
 	static Eigen::VectorXf get_design_vector (Point_t const&, InterpolationCache const&);
 
@@ -0,0 +1,89 @@
+#include "QAThreadHistos.h"
+
+#include <TH1.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <format>
+
+QAThreadHistos::~QAThreadHistos()
+{
+  clear_copies();
+}
+
+std::size_t QAThreadHistos::add(TH1 *histo)
+{
+  m_registered.push_back(histo);
+  return m_registered.size() - 1;
+}
+
+void QAThreadHistos::clear()
+{
+  clear_copies();
+  m_registered.clear();
+  m_events = 0;
+}
+
+void QAThreadHistos::init(int nthreads)
+{
+  clear_copies();
+  nthreads = std::max(nthreads, 1);
+
+  m_histos.assign(1, m_registered);
+  if (nthreads > 1)
+  {
+    ROOT::EnableThreadSafety();
+  }
+
+  for (int thread = 1; thread < nthreads; ++thread)
+  {
+    std::vector<TH1 *> copies;
+    copies.reserve(m_registered.size());
+    for (auto *histo : m_registered)
+    {
+      auto *copy = static_cast<TH1 *>(histo->Clone(std::format("{}_thread{}", histo->GetName(), thread).c_str()));
+      copy->SetDirectory(nullptr);
+      copy->Reset();
+      copies.push_back(copy);
+    }
+    m_histos.push_back(copies);
+  }
+}
+
+void QAThreadHistos::end_event()
+{
+  ++m_events;
+  if (m_merge_interval > 0 && m_events % m_merge_interval == 0)
+  {
+    merge();
+  }
+}
+
+void QAThreadHistos::merge()
+{
+  // add the copies in thread order, so that the result does not depend on scheduling
+  for (std::size_t thread = 1; thread < m_histos.size(); ++thread)
+  {
+    for (std::size_t index = 0; index < m_registered.size(); ++index)
+    {
+      auto *copy = m_histos[thread][index];
+      if (copy->GetEntries() > 0)
+      {
+        m_registered[index]->Add(copy);
+        copy->Reset();
+      }
+    }
+  }
+}
+
+void QAThreadHistos::clear_copies()
+{
+  for (std::size_t thread = 1; thread < m_histos.size(); ++thread)
+  {
+    for (auto *copy : m_histos[thread])
+    {
+      delete copy;
+    }
+  }
+  m_histos.clear();
+}
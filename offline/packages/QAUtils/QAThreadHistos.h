@@ -0,0 +1,69 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef QAUTILS_QATHREADHISTOS_H
+#define QAUTILS_QATHREADHISTOS_H
+
+/*!
+ * \file QAThreadHistos.h
+ * \brief thread local copies of QA histograms, merged back into the registered histograms
+ */
+
+#include <cstddef>
+#include <vector>
+
+class TH1;
+
+/*!
+ * QA modules register the histograms they fill from worker threads, then call init
+ * with the number of threads. Thread 0 fills the registered histograms directly,
+ * every other thread fills its own empty copy. merge adds the copies back into
+ * the registered histograms and resets them. It is called from end_event every
+ * merge_interval events (if set) and must be called from EndRun.
+ */
+class QAThreadHistos
+{
+ public:
+  QAThreadHistos() = default;
+  ~QAThreadHistos();
+
+  QAThreadHistos(const QAThreadHistos &) = delete;
+  QAThreadHistos &operator=(const QAThreadHistos &) = delete;
+
+  //! register a histogram, returns its index
+  std::size_t add(TH1 *histo);
+
+  //! forget registered histograms and delete the thread local copies
+  void clear();
+
+  //! create the thread local copies
+  void init(int nthreads);
+
+  //! number of threads copies were created for
+  int get_num_threads() const { return m_histos.size(); }
+
+  //! histogram a given thread must fill
+  TH1 *get(std::size_t index, int thread) const { return m_histos[thread][index]; }
+
+  //! merge every n events. 0 merges only when merge is called explicitly
+  void set_merge_interval(int n) { m_merge_interval = n; }
+
+  //! to be called at the end of each event, serially
+  void end_event();
+
+  //! add thread local copies to the registered histograms
+  void merge();
+
+ private:
+  void clear_copies();
+
+  //! registered histograms
+  std::vector<TH1 *> m_registered;
+
+  //! histograms per thread. Thread 0 points to the registered histograms
+  std::vector<std::vector<TH1 *>> m_histos;
+
+  int m_merge_interval = 0;
+  int m_events = 0;
+};
+
+#endif  // QAUTILS_QATHREADHISTOS_H
@@ -158,11 +158,29 @@ float FastJetAlgo::calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents
   return bge.rho();
 }
 
+JetInputCache FastJetAlgo::make_input_cache(std::vector<Jet*>& particles)
+{
+  JetInputCache inputs;
+  inputs.reserve(particles.size());
+  for (auto* particle : particles)
+  {
+    inputs.add(particle->get_px(), particle->get_py(), particle->get_pz(), particle->get_e(), particle->get_comp_vec(), JetInputCache::get_time(particle));
+  }
+  return inputs;
+}
+
 std::vector<fastjet::PseudoJet>
 FastJetAlgo::jets_to_pseudojets(std::vector<Jet*>& particles) const
+{
+  return select_pseudojets(make_input_cache(particles).pseudojets());
+}
+
+std::vector<fastjet::PseudoJet>
+FastJetAlgo::select_pseudojets(const std::vector<fastjet::PseudoJet>& inputs) const
 {
   std::vector<fastjet::PseudoJet> pseudojets;
-  for (unsigned int ipart = 0; ipart < particles.size(); ++ipart)
+  pseudojets.reserve(inputs.size());
+  for (const auto& input : inputs)
   {
     // fastjet performs strangely with exactly (px,py,pz,E) =
     // (0,0,0,0) inputs, such as placeholder towers or those with
@@ -170,32 +188,28 @@ FastJetAlgo::jets_to_pseudojets(std::vector<Jet*>& particles) const
 
     // Ignore particles with negative/small energies
 
-    if (particles[ipart]->get_e() < m_opt.constituent_min_E)
+    if (input.e() < m_opt.constituent_min_E)
     {
       continue;
     }
-    if (!std::isfinite(particles[ipart]->get_px()) ||
-        !std::isfinite(particles[ipart]->get_py()) ||
-        !std::isfinite(particles[ipart]->get_pz()) ||
-        !std::isfinite(particles[ipart]->get_e()))
+    if (!std::isfinite(input.px()) ||
+        !std::isfinite(input.py()) ||
+        !std::isfinite(input.pz()) ||
+        !std::isfinite(input.e()))
     {
       std::cout << PHWHERE << " invalid particle kinematics:"
-                << " px: " << particles[ipart]->get_px()
-                << " py: " << particles[ipart]->get_py()
-                << " pz: " << particles[ipart]->get_pz()
-                << " e: " << particles[ipart]->get_e() << std::endl;
+                << " px: " << input.px()
+                << " py: " << input.py()
+                << " pz: " << input.pz()
+                << " e: " << input.e() << std::endl;
       gSystem->Exit(1);
     }
-    fastjet::PseudoJet pseudojet(particles[ipart]->get_px(),
-                                 particles[ipart]->get_py(),
-                                 particles[ipart]->get_pz(),
-                                 particles[ipart]->get_e());
-    if (m_opt.use_constituent_min_pt && pseudojet.perp() < m_opt.constituent_min_pt)
+    if (m_opt.use_constituent_min_pt && input.perp() < m_opt.constituent_min_pt)
     {
       continue;
     }
-    pseudojet.set_user_index(ipart);
-    pseudojets.push_back(pseudojet);
+    // user_index is the position in the input cache
+    pseudojets.push_back(input);
   }
   return pseudojets;
 }
@@ -251,6 +265,11 @@ void FastJetAlgo::first_call_init(JetContainer* jetcont)
 }
 
 void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont)
+{
+  cluster_and_fill_from_cache(make_input_cache(particles), jetcont);
+}
+
+void FastJetAlgo::cluster_and_fill_from_cache(const JetInputCache& inputs, JetContainer* jetcont)
 {
   if (m_first_cluster_call)
   {
@@ -264,11 +283,11 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
   }
   if (m_opt.verbosity > 8)
   {
-    std::cout << "   Verbosity>8 #input particles: " << particles.size() << std::endl;
+    std::cout << "   Verbosity>8 #input particles: " << inputs.size() << std::endl;
   }
 
-  // translate input jets to input fastjets
-  auto pseudojets = jets_to_pseudojets(particles);
+  // select the input fastjets
+  auto pseudojets = select_pseudojets(inputs.pseudojets());
 
   // if using constituent subtraction, oberve maximum eta and subtract the constituents
   if (m_opt.cs_calc_constsub)
@@ -389,7 +408,7 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
         //        ++n_clustered;
         if (m_opt.save_jet_components)
         {
-          jet->insert_comp(particles[comp.user_index()]->get_comp_vec(), true);
+          inputs.insert_comps(comp.user_index(), jet);
         }
       }  // end loop over all constituents
     }
@@ -400,7 +419,7 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
       {
         for (auto& comp : constituents)
         {
-          jet->insert_comp(particles[comp.user_index()]->get_comp_vec(), true);
+          inputs.insert_comps(comp.user_index(), jet);
         }
       }
     }
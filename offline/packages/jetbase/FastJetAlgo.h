@@ -4,6 +4,7 @@
 #include "FastJetOptions.h"
 #include "Jet.h"
 #include "JetAlgo.h"
+#include "JetInputCache.h"
 
 #include <fastjet/JetDefinition.hh>
 #include <fastjet/PseudoJet.hh>
@@ -49,6 +50,10 @@ class FastJetAlgo : public JetAlgo
   std::vector<Jet*> get_jets(std::vector<Jet*> particles) override;
   void cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont) override;
 
+  bool supports_input_cache() const override { return true; }
+  void cluster_and_fill_from_cache(const JetInputCache& inputs, JetContainer* jetcont) override;
+  bool uses_random_ghosts() const override { return m_opt.calc_area || m_opt.calc_jetmedbkgdens; }
+
  private:
   FastJetOptions m_opt{};
   bool m_first_cluster_call{true};
@@ -60,7 +65,9 @@ class FastJetAlgo : public JetAlgo
   Jet::PROPERTY m_area_index{Jet::PROPERTY::no_property};
 
   // Internal processes
+  static JetInputCache make_input_cache(std::vector<Jet*>& particles);
   std::vector<fastjet::PseudoJet> jets_to_pseudojets(std::vector<Jet*>& particles) const;
+  std::vector<fastjet::PseudoJet> select_pseudojets(const std::vector<fastjet::PseudoJet>& inputs) const;
   std::vector<fastjet::PseudoJet> cluster_jets(std::vector<fastjet::PseudoJet>& pseudojets);
   std::vector<fastjet::PseudoJet> cluster_area_jets(std::vector<fastjet::PseudoJet>& pseudojets);
   float calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents) const;
@@ -6,6 +6,7 @@
 #include <limits>
 
 class JetContainer;
+class JetInputCache;
 class JetAlgo
 {
  public:
@@ -30,6 +31,16 @@ class JetAlgo
   {
   }
 
+  // shared-input version -- cluster from the per-event input cache filled
+  // once by JetReco; algos not supporting it get Jets built from the cache
+  virtual bool supports_input_cache() const { return false; }
+  virtual void cluster_and_fill_from_cache(const JetInputCache& /*inputs*/, JetContainer* /*clones*/)
+  {
+  }
+  // areas and background estimates with random ghosts draw from fastjet's
+  // shared random generator, JetReco never runs such algos in parallel
+  virtual bool uses_random_ghosts() const { return false; }
+
   virtual std::map<Jet::PROPERTY, unsigned int>& property_indices();
 
  protected:
@@ -2,6 +2,7 @@
 #define JETBASE_JETINPUT_H
 
 #include "Jet.h"
+#include "JetInputCache.h"
 
 #include <iostream>
 #include <vector>
@@ -24,6 +25,19 @@ class JetInput
   {
     return std::vector<Jet*>();
   }
+
+  // append this input to the per-event cache shared by all algorithms;
+  // the default converts the Jet objects from get_input, inputs that can
+  // should override it to fill the cache without allocating Jets
+  virtual void fill_input_cache(PHCompositeNode* topNode, JetInputCache& cache)
+  {
+    std::vector<Jet*> parts = get_input(topNode);
+    for (auto* part : parts)
+    {
+      cache.add(part->get_px(), part->get_py(), part->get_pz(), part->get_e(), part->get_comp_vec(), JetInputCache::get_time(part));
+      delete part;
+    }
+  }
   virtual int Verbosity() const { return m_Verbosity; }
   virtual void Verbosity(int i) { m_Verbosity = i; }
 
@@ -0,0 +1,106 @@
+#ifndef JETBASE_JETINPUTCACHE_H
+#define JETBASE_JETINPUTCACHE_H
+
+#include "Jet.h"
+
+#include <fastjet/PseudoJet.hh>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Flat, per-event cache of jet inputs shared by all algorithms of a JetReco
+// module. Each input is stored once as a fastjet::PseudoJet whose user_index
+// is its position in the cache; its components (Jet::SRC, id) are kept in a
+// CSR layout (comps + comp_offsets) so no Jet object is allocated per input.
+// The input time (Jet::PROPERTY::prop_t) is kept per input, NaN if it has none.
+class JetInputCache
+{
+ public:
+  void clear()
+  {
+    m_pseudojets.clear();
+    m_times.clear();
+    m_comps.clear();
+    m_comp_offsets.assign(1, 0);
+  }
+
+  void reserve(size_t n)
+  {
+    m_pseudojets.reserve(n);
+    m_times.reserve(n);
+    m_comps.reserve(n);
+    m_comp_offsets.reserve(n + 1);
+  }
+
+  // add an input with a single component (towers, clusters, tracks)
+  void add(double px, double py, double pz, double e, Jet::SRC src, unsigned int id,
+           float t = std::numeric_limits<float>::quiet_NaN())
+  {
+    add_pseudojet(px, py, pz, e, t);
+    m_comps.emplace_back(src, id);
+    m_comp_offsets.push_back(m_comps.size());
+  }
+
+  // add an input carrying an arbitrary list of components
+  void add(double px, double py, double pz, double e, const Jet::TYPE_comp_vec& comps,
+           float t = std::numeric_limits<float>::quiet_NaN())
+  {
+    add_pseudojet(px, py, pz, e, t);
+    m_comps.insert(m_comps.end(), comps.begin(), comps.end());
+    m_comp_offsets.push_back(m_comps.size());
+  }
+
+  size_t size() const { return m_pseudojets.size(); }
+  bool empty() const { return m_pseudojets.empty(); }
+
+  const std::vector<fastjet::PseudoJet>& pseudojets() const { return m_pseudojets; }
+
+  // copy the components of input "index" into a jet
+  void insert_comps(unsigned int index, Jet* jet) const
+  {
+    for (size_t i = m_comp_offsets[index]; i < m_comp_offsets[index + 1]; ++i)
+    {
+      jet->insert_comp(m_comps[i].first, m_comps[i].second, true);
+    }
+  }
+
+  // copy the time of input "index" into a jet, if it has one
+  void insert_time(unsigned int index, Jet* jet) const
+  {
+    if (std::isnan(m_times[index]))
+    {
+      return;
+    }
+    if (jet->size_properties() < Jet::PROPERTY::prop_t + 1)
+    {
+      jet->resize_properties(Jet::PROPERTY::prop_t + 1);
+    }
+    jet->set_property(Jet::PROPERTY::prop_t, m_times[index]);
+  }
+
+  // time of a Jet input, NaN if it has none
+  static float get_time(const Jet* jet)
+  {
+    if (jet->size_properties() > Jet::PROPERTY::prop_t)
+    {
+      return jet->get_property(Jet::PROPERTY::prop_t);
+    }
+    return std::numeric_limits<float>::quiet_NaN();
+  }
+
+ private:
+  void add_pseudojet(double px, double py, double pz, double e, float t)
+  {
+    m_pseudojets.emplace_back(px, py, pz, e);
+    m_pseudojets.back().set_user_index(m_pseudojets.size() - 1);
+    m_times.push_back(t);
+  }
+
+  std::vector<fastjet::PseudoJet> m_pseudojets;
+  std::vector<float> m_times;
+  Jet::TYPE_comp_vec m_comps;
+  std::vector<size_t> m_comp_offsets{0};
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include "JetInput.h"
 #include "JetMap.h"
 #include "JetMapv1.h"
+#include "Jetv2.h"
 
 // PHENIX includes
 #include <fun4all/Fun4AllReturnCodes.h>
@@ -82,6 +83,113 @@ int JetReco::InitRun(PHCompositeNode *topNode)
   return CreateNodes(topNode);
 }
 
+void JetReco::process_input_cache(PHCompositeNode *topNode)
+{
+  // convert all inputs once
+  m_input_cache.clear();
+  for (auto &_input : _inputs)
+  {
+    _input->fill_input_cache(topNode, m_input_cache);
+  }
+
+  // Jets are only built for the JetMap and for algos which cannot use the cache
+  bool need_jets = use_jetmap;
+  for (auto &_algo : _algos)
+  {
+    need_jets |= !_algo->supports_input_cache();
+  }
+  std::vector<Jet *> inputs;  // owns memory
+  if (need_jets)
+  {
+    inputs.reserve(m_input_cache.size());
+    for (unsigned int ipart = 0; ipart < m_input_cache.size(); ++ipart)
+    {
+      const fastjet::PseudoJet &part = m_input_cache.pseudojets()[ipart];
+      Jet *jet = new Jetv2();
+      jet->set_px(part.px());
+      jet->set_py(part.py());
+      jet->set_pz(part.pz());
+      jet->set_e(part.e());
+      jet->set_id(ipart);
+      m_input_cache.insert_comps(ipart, jet);
+      m_input_cache.insert_time(ipart, jet);
+      inputs.push_back(jet);
+    }
+  }
+
+  if (use_jetcon)
+  {
+    FillJetContainers(topNode, inputs);
+  }
+  if (use_jetmap)
+  {
+    for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
+    {
+      std::vector<Jet *> jets = _algos[ialgo]->get_jets(inputs);  // owns memory
+      FillJetNode(topNode, ialgo, jets);
+    }
+  }
+
+  for (auto &input : inputs)
+  {
+    delete input;
+  }
+}
+
+void JetReco::FillJetContainers(PHCompositeNode *topNode, std::vector<Jet *> &inputs)
+{
+  // node lookups and resets stay on this thread
+  std::vector<JetContainer *> jetconns;
+  std::vector<unsigned int> cached_algos;
+  for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
+  {
+    JetContainer *jetconn = findNode::getClass<JetContainer>(topNode, JC_name(_outputs[ialgo]));
+    if (!jetconn)
+    {
+      std::cout << PHWHERE << " ERROR: Can't find JetContainer: " << _outputs[ialgo] << std::endl;
+      exit(-1);
+    }
+    jetconn->Reset();
+    jetconns.push_back(jetconn);
+    if (!_algos[ialgo]->supports_input_cache())
+    {
+      _algos[ialgo]->cluster_and_fill(inputs, jetconn);
+    }
+    else if (_algos[ialgo]->uses_random_ghosts())
+    {
+      // ghosts come from fastjet's shared random generator, keep these in order on this
+      // thread so the result does not depend on the number of threads
+      _algos[ialgo]->cluster_and_fill_from_cache(m_input_cache, jetconn);
+    }
+    else
+    {
+      cached_algos.push_back(ialgo);
+    }
+  }
+
+  // every algo owns its ClusterSequence and fills its own container
+  // the thread count only applies to this loop, not to other OpenMP users in the job
+#pragma omp parallel for schedule(dynamic) num_threads(m_num_threads) if (m_num_threads > 1)
+  for (size_t i = 0; i < cached_algos.size(); ++i)
+  {
+    const unsigned int ialgo = cached_algos[i];
+    _algos[ialgo]->cluster_and_fill_from_cache(m_input_cache, jetconns[ialgo]);
+  }
+
+  for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
+  {
+    for (auto &_input : _inputs)
+    {
+      jetconns[ialgo]->insert_src(_input->get_src());
+    }
+    if (Verbosity() > 7)
+    {
+      std::cout << " Verbosity()>7:: jets in container " << _outputs[ialgo] << std::endl;
+      jetconns[ialgo]->print_jets();
+    }
+  }
+}
+
 int JetReco::process_event(PHCompositeNode *topNode)
 {
   if (Verbosity() > 1)
@@ -89,6 +197,16 @@ int JetReco::process_event(PHCompositeNode *topNode)
     std::cout << "JetReco::process_event -- entered" << std::endl;
   }
 
+  if (m_use_input_cache)
+  {
+    process_input_cache(topNode);
+    if (Verbosity() > 1)
+    {
+      std::cout << "JetReco::process_event -- exited" << std::endl;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   //------------------------------------------------------------------
   // This will also need to go into TClonesArrays in a future revision
   // Get Objects off of the Node Tree
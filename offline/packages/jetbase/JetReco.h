@@ -7,6 +7,8 @@
 /// \author Mike McCumber
 //===========================================================
 
+#include "JetInputCache.h"
+
 // PHENIX includes
 #include <fun4all/SubsysReco.h>
 
@@ -52,6 +54,15 @@ class JetReco : public SubsysReco
     _outputs.push_back(output);
   }
 
+  // convert the inputs once per event into a shared PseudoJet cache and
+  // cluster every algo (e.g. all radii) from it, instead of allocating a
+  // Jet per input and converting it again in each algo
+  void set_use_input_cache(bool b) { m_use_input_cache = b; }
+  // cluster the algos from the shared cache in parallel (OpenMP); only
+  // used with the input cache and for algos supporting it, algos with jet
+  // areas or median background density always run on the calling thread
+  void set_num_threads(int value) { m_num_threads = value; }
+
   void set_algo_node(const std::string &algonode) { _algonode = algonode; }
   void set_input_node(const std::string &inputnode) { _inputnode = inputnode; }
   /* void set_fill_JetContainer(bool b) { _fill_JetContainer = b; } */
@@ -62,6 +73,8 @@ class JetReco : public SubsysReco
   int CreateNodes(PHCompositeNode *topNode);
   void FillJetNode(PHCompositeNode *topNode, int ipos, const std::vector<Jet *> &jets);
   void FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<Jet *> &inputs);
+  void FillJetContainers(PHCompositeNode *topNode, std::vector<Jet *> &inputs);
+  void process_input_cache(PHCompositeNode *topNode);
 
   std::vector<JetInput *> _inputs;
   std::vector<JetAlgo *> _algos;
@@ -69,6 +82,10 @@ class JetReco : public SubsysReco
   std::string _inputnode;
   std::vector<std::string> _outputs;
 
+  bool m_use_input_cache{false};
+  int m_num_threads{1};
+  JetInputCache m_input_cache;
+
   // transition functions, while moving from JetMap to JetContainer.
   // May be removed after transition is made, depending on state of
   // functions
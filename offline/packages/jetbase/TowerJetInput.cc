@@ -18,6 +18,7 @@
 #include <cassert>
 #include <cmath>  // for asinh, atan2, cos, cosh
 #include <iostream>
+#include <limits>
 #include <map>      // for _Rb_tree_const_iterator
 #include <utility>  // for pair
 #include <vector>
@@ -58,8 +59,9 @@ void TowerJetInput::identify(std::ostream &os)
   os << std::endl;
 }
 
-std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
+bool TowerJetInput::fill_towers(PHCompositeNode *topNode)
 {
+  m_towers.clear();
   if (Verbosity() > 0)
   {
     std::cout << "TowerJetInput::process_event -- entered" << std::endl;
@@ -71,7 +73,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     std::cout << "TowerJetInput::get_input - Fatal Error - GlobalVertexMap node is missing. Please turn on the do_global flag in the main macro in order to reconstruct the global vertex." << std::endl;
     assert(vertexmap);  // force quit
 
-    return std::vector<Jet *>();
+    return false;
   }
   if (vertexmap->empty())
   {
@@ -166,7 +168,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO)
@@ -178,7 +180,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_EMBED)
@@ -190,7 +192,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_SIM)
@@ -202,7 +204,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::EEMC_TOWER)
@@ -211,7 +213,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_EEMC");
     if ((!towers && !towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER)
@@ -220,7 +222,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO)
@@ -232,7 +234,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_EMBED)
@@ -244,7 +246,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_SIM)
@@ -256,7 +258,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER)
@@ -265,7 +267,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO)
@@ -277,7 +279,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_EMBED)
@@ -289,7 +291,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_SIM)
@@ -301,7 +303,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
 
@@ -311,7 +313,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FEMC");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::FHCAL_TOWER)
@@ -320,7 +322,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FHCAL");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_RETOWER)
@@ -329,7 +331,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_RETOWER)
@@ -341,7 +343,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_SUB1)
@@ -350,7 +352,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_SUB1)
@@ -362,7 +364,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER_SUB1)
@@ -371,7 +373,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_SUB1)
@@ -383,7 +385,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER_SUB1)
@@ -392,7 +394,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_SUB1)
@@ -404,7 +406,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_SUB1CS)
@@ -413,7 +415,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER_SUB1CS)
@@ -422,7 +424,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER_SUB1CS)
@@ -431,12 +433,12 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else
   {
-    return std::vector<Jet *>();
+    return false;
   }
 
   // for those cases we need to use the EMCal R and IHCal eta phi to calculate the vertex correction
@@ -445,22 +447,22 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     EMCal_geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
     if (!EMCal_geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
 
   // first grab the event vertex or bail
 
 
-  std::vector<Jet *> pseudojets;
   if (m_use_towerinfo)
   {
     if (!towerinfos)
     {
-      return std::vector<Jet *>();
+      return false;
     }
 
     unsigned int nchannels = towerinfos->size();
+    m_towers.reserve(nchannels);
     for (unsigned int channel = 0; channel < nchannels; channel++)
     {
       TowerInfo *tower = towerinfos->get_tower_at_channel(channel);
@@ -500,26 +502,12 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       double py = pt * sin(phi);
       double pz = pt * sinh(eta);
 
-      Jet *jet = new Jetv2();
-      jet->set_px(px);
-      jet->set_py(py);
-      jet->set_pz(pz);
-      jet->set_e(e);
-      jet->insert_comp(m_input, channel);
       float tower_t = 17.6*tower->get_time(); // 17.6 ns/sample and get_time() returns t in samples
-      if(jet->size_properties() < Jet::PROPERTY::prop_t+1)
-	{
-	  jet->resize_properties(Jet::PROPERTY::prop_t + 1);
-	}
-      if(e > m_timing_e_threshold)
-	{
-	  jet->set_property(Jet::PROPERTY::prop_t, tower_t);
-	}
-      else
-	{
-	  jet->set_property(Jet::PROPERTY::prop_t, std::numeric_limits<float>::quiet_NaN());
-	}
-      pseudojets.push_back(jet);
+      if (e <= m_timing_e_threshold)
+      {
+        tower_t = std::numeric_limits<float>::quiet_NaN();
+      }
+      m_towers.push_back({px, py, pz, e, channel, tower_t});
     }
   }
   else
@@ -551,18 +539,55 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       double py = pt * sin(phi);
       double pz = pt * sinh(eta);
 
-      Jet *jet = new Jetv2();
-      jet->set_px(px);
-      jet->set_py(py);
-      jet->set_pz(pz);
-      jet->set_e(tower->get_energy());
-      jet->insert_comp(m_input, tower->get_id());
-      pseudojets.push_back(jet);
+      m_towers.push_back({px, py, pz, tower->get_energy(), tower->get_id(), std::numeric_limits<float>::quiet_NaN()});
     }
   }
   if (Verbosity() > 0)
   {
     std::cout << "TowerJetInput::process_event -- exited" << std::endl;
   }
+  return true;
+}
+
+std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
+{
+  std::vector<Jet *> pseudojets;
+  if (!fill_towers(topNode))
+  {
+    return pseudojets;
+  }
+  pseudojets.reserve(m_towers.size());
+  for (const auto &tower : m_towers)
+  {
+    Jet *jet = new Jetv2();
+    jet->set_px(tower.px);
+    jet->set_py(tower.py);
+    jet->set_pz(tower.pz);
+    jet->set_e(tower.e);
+    jet->insert_comp(m_input, tower.id);
+    if (m_use_towerinfo)
+    {
+      if (jet->size_properties() < Jet::PROPERTY::prop_t + 1)
+      {
+        jet->resize_properties(Jet::PROPERTY::prop_t + 1);
+      }
+      jet->set_property(Jet::PROPERTY::prop_t, tower.t);
+    }
+    pseudojets.push_back(jet);
+  }
   return pseudojets;
 }
+
+void TowerJetInput::fill_input_cache(PHCompositeNode *topNode, JetInputCache &cache)
+{
+  if (!fill_towers(topNode))
+  {
+    return;
+  }
+  cache.reserve(cache.size() + m_towers.size());
+  for (const auto &tower : m_towers)
+  {
+    // t is NaN for RawTowers and below the timing threshold
+    cache.add(tower.px, tower.py, tower.pz, tower.e, m_input, tower.id, tower.t);
+  }
+}
@@ -24,6 +24,7 @@ class TowerJetInput : public JetInput
   Jet::SRC get_src() override { return m_input; }
 
   std::vector<Jet*> get_input(PHCompositeNode* topNode) override;
+  void fill_input_cache(PHCompositeNode* topNode, JetInputCache& cache) override;
 
   void reset_GlobalVertexType()
   {
@@ -59,6 +60,20 @@ class TowerJetInput : public JetInput
   void set_timing_e_threshold(float new_threshold) { m_timing_e_threshold = new_threshold; }
 
  private:
+  // kinematics of one accepted tower, vertex corrected
+  struct TowerKinematics
+  {
+    double px;
+    double py;
+    double pz;
+    double e;
+    unsigned int id;
+    float t;  // NaN below m_timing_e_threshold or for RawTowers
+  };
+
+  // locate the tower nodes and fill m_towers, false if they are missing
+  bool fill_towers(PHCompositeNode* topNode);
+
   Jet::SRC m_input;
   RawTowerDefs::CalorimeterId geocaloid{RawTowerDefs::CalorimeterId::NONE};
   bool m_use_towerinfo {false};
@@ -67,6 +82,7 @@ class TowerJetInput : public JetInput
   bool m_use_vertextype {false};
   std::vector<GlobalVertex::VTXTYPE> m_vertex_type{GlobalVertex::UNDEFINED};
   float m_timing_e_threshold{0.1};
+  std::vector<TowerKinematics> m_towers;
 };
 
 #endif
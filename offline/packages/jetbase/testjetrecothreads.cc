@@ -0,0 +1,175 @@
+// clusters the same events with JetReco on one and on several threads and
+// checks that the jet containers are identical, including the jet areas
+
+#include "FastJetAlgo.h"
+#include "FastJetOptions.h"
+#include "Jet.h"
+#include "JetContainer.h"
+#include "JetInput.h"
+#include "JetReco.h"
+#include "Jetv2.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <fastjet/AreaDefinition.hh>
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // the same pseudo random particles for every JetReco, a new set for every event
+  class FixedJetInput : public JetInput
+  {
+   public:
+    explicit FixedJetInput(const unsigned int seed)
+      : m_Seed(seed)
+    {
+    }
+    Jet::SRC get_src() override { return Jet::PARTICLE; }
+    std::vector<Jet *> get_input(PHCompositeNode * /*topNode*/) override
+    {
+      std::mt19937 rng(m_Seed + m_Event++);
+      std::uniform_real_distribution<double> eta(-1.1, 1.1);
+      std::uniform_real_distribution<double> phi(-M_PI, M_PI);
+      std::exponential_distribution<double> pt(1.);
+      std::vector<Jet *> particles;
+      for (unsigned int i = 0; i < 300; i++)
+      {
+        const double ptval = pt(rng);
+        const double etaval = eta(rng);
+        const double phival = phi(rng);
+        Jet *particle = new Jetv2();
+        particle->set_px(ptval * std::cos(phival));
+        particle->set_py(ptval * std::sin(phival));
+        particle->set_pz(ptval * std::sinh(etaval));
+        particle->set_e(ptval * std::cosh(etaval));
+        particle->insert_comp(Jet::PARTICLE, i);
+        particles.push_back(particle);
+      }
+      return particles;
+    }
+
+   private:
+    unsigned int m_Seed{0};
+    unsigned int m_Event{0};
+  };
+
+  const std::vector<std::string> &outputs()
+  {
+    static const std::vector<std::string> names{"AntiKt_r02", "AntiKt_r04_area", "AntiKt_r06", "Kt_r04_rho"};
+    return names;
+  }
+
+  JetReco *make_jetreco(const std::string &name, const int nthreads)
+  {
+    JetReco *jetreco = new JetReco(name);
+    jetreco->add_input(new FixedJetInput(42));
+    jetreco->add_algo(new FastJetAlgo({{Jet::ANTIKT, JET_R, 0.2}}), name + outputs()[0]);
+    jetreco->add_algo(new FastJetAlgo({{Jet::ANTIKT, JET_R, 0.4, CALC_AREA}}), name + outputs()[1]);
+    jetreco->add_algo(new FastJetAlgo({{Jet::ANTIKT, JET_R, 0.6}}), name + outputs()[2]);
+    jetreco->add_algo(new FastJetAlgo({{Jet::KT, JET_R, 0.4, CALC_RhoMedDens}}), name + outputs()[3]);
+    jetreco->set_algo_node(name);
+    jetreco->set_input_node("PARTICLE");
+    jetreco->set_use_input_cache(true);
+    jetreco->set_num_threads(nthreads);
+    return jetreco;
+  }
+
+  bool same_jets(JetContainer *a, JetContainer *b, const std::string &name)
+  {
+    if (a->size() != b->size())
+    {
+      std::cout << PHWHERE << " " << name << ": " << a->size() << " vs " << b->size() << " jets" << std::endl;
+      return false;
+    }
+    const float rho_a = a->get_rho_median();
+    const float rho_b = b->get_rho_median();
+    if (rho_a != rho_b && !(std::isnan(rho_a) && std::isnan(rho_b)))
+    {
+      std::cout << PHWHERE << " " << name << ": rho " << rho_a << " vs " << rho_b << std::endl;
+      return false;
+    }
+    const bool has_area = a->has_property(Jet::PROPERTY::prop_area);
+    for (unsigned int ijet = 0; ijet < a->size(); ijet++)
+    {
+      Jet *ja = a->get_jet(ijet);
+      Jet *jb = b->get_jet(ijet);
+      if (ja->get_px() != jb->get_px() || ja->get_py() != jb->get_py() ||
+          ja->get_pz() != jb->get_pz() || ja->get_e() != jb->get_e() ||
+          ja->get_comp_vec() != jb->get_comp_vec())
+      {
+        std::cout << PHWHERE << " " << name << ": jet " << ijet << " differs" << std::endl;
+        return false;
+      }
+      if (has_area)
+      {
+        const Jet::PROPERTY index = a->property_index(Jet::PROPERTY::prop_area);
+        if (ja->get_property(index) != jb->get_property(index))
+        {
+          std::cout << PHWHERE << " " << name << ": area of jet " << ijet << " differs "
+                    << ja->get_property(index) << " vs " << jb->get_property(index) << std::endl;
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+}  // namespace
+
+int main()
+{
+  PHCompositeNode *topNode = new PHCompositeNode("TOP");
+  topNode->addNode(new PHCompositeNode("DST"));
+
+  JetReco *serial = make_jetreco("SERIAL", 1);
+  JetReco *parallel = make_jetreco("PARALLEL", 4);
+  if (serial->InitRun(topNode) != Fun4AllReturnCodes::EVENT_OK ||
+      parallel->InitRun(topNode) != Fun4AllReturnCodes::EVENT_OK)
+  {
+    std::cout << "cannot create the jet nodes" << std::endl;
+    return 1;
+  }
+
+  // both runs start from the same state of fastjet's ghost random generator
+  fastjet::GhostedAreaSpec ghosts;
+  std::vector<int> random_status;
+  bool ok = true;
+  for (int ievent = 0; ievent < 10 && ok; ievent++)
+  {
+    ghosts.get_random_status(random_status);
+    serial->process_event(topNode);
+    ghosts.set_random_status(random_status);
+    parallel->process_event(topNode);
+    for (const auto &output : outputs())
+    {
+      JetContainer *a = findNode::getClass<JetContainer>(topNode, "SERIAL" + output);
+      JetContainer *b = findNode::getClass<JetContainer>(topNode, "PARALLEL" + output);
+      if (!a || !b)
+      {
+        std::cout << "missing jet container " << output << std::endl;
+        ok = false;
+        break;
+      }
+      ok &= same_jets(a, b, output);
+    }
+  }
+
+  delete serial;
+  delete parallel;
+  delete topNode;
+  if (!ok)
+  {
+    std::cout << "jet reconstruction thread test failed" << std::endl;
+    return 1;
+  }
+  std::cout << "jet reconstruction thread test passed" << std::endl;
+  return 0;
+}
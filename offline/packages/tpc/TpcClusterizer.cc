@@ -95,6 +95,7 @@ namespace
   struct thread_data
   {
     PHG4TpcGeom *layergeom = nullptr;
+    const PHG4TpcGeomContainer::LayerTable *padtable = nullptr;
     TrkrHitSet *hitset = nullptr;
     RawHitSet *rawhitset = nullptr;
     ActsGeometry *tGeometry = nullptr;
@@ -561,7 +562,7 @@ namespace
       iphi2_sum += square(iphi) * adc;
 
       // update t sums
-      double t = my_data.layergeom->get_zcenter(it);
+      double t = my_data.padtable->t_center[it];
       t_sum += t * adc;
       t2_sum += square(t) * adc;
 
@@ -659,7 +660,7 @@ namespace
 
     // This is the global position
     double clusiphi = iphi_sum / adc_sum;
-    double clusphi = my_data.layergeom->get_phi(clusiphi, my_data.side);
+    double clusphi = my_data.padtable->get_phi(clusiphi, my_data.side);
 
     double clusx = radius * cos(clusphi);
     double clusy = radius * sin(clusphi);
@@ -1298,6 +1299,9 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
   
   AdcClockPeriod = geom->GetFirstLayerCellGeom()->get_zstep();
 
+  // time bin centers and pad phi are needed per hit
+  geom->build_tables();
+
   std::cout << "FirstLayerCellGeomv1 streamer: " << std::endl;  
   auto *g1 = static_cast<PHG4TpcGeomv1*> (geom->GetFirstLayerCellGeom()); // cast because << not in the base class
   std::cout << *g1 << std::endl;
@@ -1485,6 +1489,7 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       };
 
       thread_pair.data.layergeom = layergeom;
+      thread_pair.data.padtable = geom_container->get_layer_table(layer);
       thread_pair.data.hitset = hitset;
       thread_pair.data.rawhitset = nullptr;
       thread_pair.data.layer = layer;
@@ -1619,6 +1624,7 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       thread_pair_t &thread_pair = threads.emplace_back();
 
       thread_pair.data.layergeom = layergeom;
+      thread_pair.data.padtable = geom_container->get_layer_table(layer);
       thread_pair.data.hitset = nullptr;
       thread_pair.data.rawhitset = hitset;
       thread_pair.data.layer = layer;
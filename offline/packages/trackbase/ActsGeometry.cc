@@ -5,6 +5,12 @@
 #include "alignmentTransformationContainer.h"
 #include <phool/sphenix_constants.h>
 
+#include <Acts/Surfaces/Surface.hpp>
+
+#include <any>
+#include <cmath>
+#include <mutex>
+
 namespace
 {
   /// square
@@ -20,6 +26,16 @@ namespace
   {
     return std::sqrt(square(x) + square(y));
   }
+
+  /// update stamp of the alignment transforms in the geometry context, 0 without alignment container
+  unsigned long alignmentStamp(const Acts::GeometryContext& context)
+  {
+    const auto* transformMap = std::any_cast<alignmentTransformationContainer*>(&context.item());
+    return (transformMap && *transformMap) ? (*transformMap)->updateStamp() : 0;
+  }
+
+  /// serializes the rebuilds of the transform table
+  std::mutex transform_cache_mutex;
 }  // namespace
 
 //________________________________________________________________________________________________
@@ -57,6 +73,65 @@ Acts::Vector3 ActsGeometry::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster
   return global;
 }
 
+//________________________________________________________________________________________________
+void ActsGeometry::updateTransformCache() const
+{
+  std::lock_guard<std::mutex> lock(transform_cache_mutex);
+
+  const auto& geocontext = m_tGeometry.getGeoContext();
+  const unsigned long stamp = alignmentStamp(geocontext);
+  if (m_transformCacheValid &&
+      m_transformCacheStamp == stamp &&
+      m_transformCacheAlignment == alignmentTransformationContainer::use_alignment)
+  {
+    return;
+  }
+
+  const size_t nsurfaces = m_surfMaps.getNFlatSurfaces();
+  m_transformCache.resize(nsurfaces);
+  for (size_t index = 0; index < nsurfaces; ++index)
+  {
+    const auto& surface = m_surfMaps.getFlatSurface(index);
+    m_transformCache[index].transform = surface->transform(geocontext);
+    m_transformCache[index].planar = (surface->type() == Acts::Surface::Plane);
+  }
+  m_transformCacheStamp = stamp;
+  m_transformCacheAlignment = alignmentTransformationContainer::use_alignment;
+  m_transformCacheValid = true;
+}
+
+//________________________________________________________________________________________________
+std::vector<Acts::Vector3> ActsGeometry::getGlobalPositions(
+    const std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>>& clusters) const
+{
+  updateTransformCache();
+
+  std::vector<Acts::Vector3> positions;
+  positions.reserve(clusters.size());
+
+  const auto& geocontext = m_tGeometry.getGeoContext();
+  for (const auto& [key, cluster] : clusters)
+  {
+    const int index = m_surfMaps.getFlatIndex(key);
+    if (index < 0)
+    {
+      // TPC, or a hitset without surface, which getGlobalPosition reports
+      positions.push_back(getGlobalPosition(key, cluster));
+      continue;
+    }
+
+    const Acts::Vector2 local = Acts::Vector2(cluster->getLocalX(), cluster->getLocalY()) * Acts::UnitConstants::cm;
+    const auto& entry = m_transformCache[index];
+
+    // for planar surfaces localToGlobal is the affine transform of (x, y, 0)
+    Acts::Vector3 global = entry.planar ? Acts::Vector3(entry.transform * Acts::Vector3(local.x(), local.y(), 0)) : m_surfMaps.getFlatSurface(index)->localToGlobal(geocontext, local, Acts::Vector3(1, 1, 1));
+    global /= Acts::UnitConstants::cm;
+    positions.push_back(global);
+  }
+
+  return positions;
+}
+
 //________________________________________________________________________________________________
 Acts::Vector3 ActsGeometry::getGlobalPositionTpc(const TrkrDefs::hitsetkey& hitsetkey,
 const TrkrDefs::hitkey& hitkey, const float& phi, const float& rad,
@@ -5,6 +5,9 @@
 
 #include <Acts/Definitions/Units.hpp>
 
+#include <utility>
+#include <vector>
+
 class TrkrCluster;
 
 class ActsGeometry
@@ -16,11 +19,14 @@ class ActsGeometry
   void setGeometry(const ActsTrackingGeometry& tGeometry)
   {
     m_tGeometry = tGeometry;
+    m_transformCacheValid = false;
   }
 
   void setSurfMaps(const ActsSurfaceMaps& surfMaps)
   {
     m_surfMaps = surfMaps;
+    m_surfMaps.buildIndex();
+    m_transformCacheValid = false;
   }
 
   //! const accessor
@@ -35,18 +41,12 @@ class ActsGeometry
     return m_tGeometry;
   }
 
-  //! const accessor
+  //! const accessor, the maps are only changed through setSurfMaps, which rebuilds their lookup index
   const ActsSurfaceMaps& maps() const
   {
     return m_surfMaps;
   }
 
-  //! mutable accessor
-  ActsSurfaceMaps& maps()
-  {
-    return m_surfMaps;
-  }
-
   void set_drift_velocity(double vd) { _drift_velocity = vd; }
   void set_max_driftlength(double val) { _max_driftlength = val; }
   void set_CM_halfwidth(double val) { _CM_halfwidth = val; }
@@ -67,6 +67,13 @@ class ActsGeometry
       TrkrDefs::cluskey key,
       TrkrCluster* cluster) const;
 
+  //! global positions of a list of clusters, same as calling getGlobalPosition on each
+  /** silicon and micromegas clusters use a table of the surface transforms, alignment
+   * included, indexed like the flat surface tables of ActsSurfaceMaps. The table is rebuilt
+   * when the alignment transforms of the geometry context change */
+  std::vector<Acts::Vector3> getGlobalPositions(
+      const std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>>& clusters) const;
+
   Acts::Vector3 getGlobalPositionTpc(
       const TrkrDefs::hitsetkey& hitsetkey, const TrkrDefs::hitkey& hitkey, const float& phi, const float& rad,
       const float& clockPeriod) const;
@@ -82,8 +89,24 @@ class ActsGeometry
   Acts::Vector2 getLocalCoords(TrkrDefs::cluskey key, TrkrCluster* cluster, short int crossing) const;
 
  private:
+  //! rebuild the transform table if the surfaces or the alignment changed
+  void updateTransformCache() const;
+
   ActsTrackingGeometry m_tGeometry;
   ActsSurfaceMaps m_surfMaps;
+
+  //! local to global transform of a silicon or micromegas surface
+  struct SurfaceTransform
+  {
+    Acts::Transform3 transform = Acts::Transform3::Identity();
+    bool planar = false;
+  };
+
+  //! one entry per flat surface of m_surfMaps, see ActsSurfaceMaps::getFlatIndex
+  mutable std::vector<SurfaceTransform> m_transformCache;
+  mutable bool m_transformCacheValid = false;
+  mutable bool m_transformCacheAlignment = false;
+  mutable unsigned long m_transformCacheStamp = 0;
   double _drift_velocity = 8.0e-3;  // cm/ns
   double _max_driftlength = 102.235;  // cm
   double _CM_halfwidth = 0.28;  // cm
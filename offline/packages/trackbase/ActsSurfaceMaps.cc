@@ -12,6 +12,8 @@
 #include <Acts/Definitions/Units.hpp>
 #include <Acts/Surfaces/Surface.hpp>
 
+#include <algorithm>
+
 namespace
 {
   /// square
@@ -27,6 +29,20 @@ namespace
   {
     return std::sqrt(square(x) + square(y));
   }
+
+  /// silicon surfaces are stored with zero crossing (INTT) or strobe (MVTX)
+  TrkrDefs::hitsetkey siliconSurfaceKey(TrkrDefs::hitsetkey hitsetkey)
+  {
+    switch (TrkrDefs::getTrkrId(hitsetkey))
+    {
+    case TrkrDefs::inttId:
+      return InttDefs::resetCrossing(hitsetkey);
+    case TrkrDefs::mvtxId:
+      return MvtxDefs::resetStrobe(hitsetkey);
+    default:
+      return hitsetkey;
+    }
+  }
 }  // namespace
 
 bool ActsSurfaceMaps::isTpcSurface(const Acts::Surface* surface) const
@@ -71,23 +87,21 @@ Surface ActsSurfaceMaps::getSurface(TrkrDefs::cluskey key,
 
 Surface ActsSurfaceMaps::getSiliconSurface(TrkrDefs::hitsetkey hitsetkey) const
 {
-  unsigned int trkrid = TrkrDefs::getTrkrId(hitsetkey);
-  TrkrDefs::hitsetkey tmpkey = hitsetkey;
+  // Set the hitsetkey crossing to zero
+  const TrkrDefs::hitsetkey tmpkey = siliconSurfaceKey(hitsetkey);
 
-  if (trkrid == TrkrDefs::inttId)
-  {
-    // Set the hitsetkey crossing to zero
-    tmpkey = InttDefs::resetCrossing(hitsetkey);
-  }
+  // std::cout << "tmpkey = " << tmpkey << std::endl;
 
-  if (trkrid == TrkrDefs::mvtxId)
+  if (m_indexed)
   {
-    // Set the hitsetkey crossing to zero
-    tmpkey = MvtxDefs::resetStrobe(hitsetkey);
+    if (auto surface = findFlatSurface(m_siliconKeys, m_siliconSurfaces, tmpkey))
+    {
+      return surface;
+    }
+    std::cout << "Failed to find silicon surface for hitsetkey " << hitsetkey << " tmpkey " << tmpkey << std::endl;
+    return nullptr;
   }
 
-  // std::cout << "tmpkey = " << tmpkey << std::endl;
-
   auto iter = m_siliconSurfaceMap.find(tmpkey);
   if (iter != m_siliconSurfaceMap.end())
   {
@@ -106,11 +120,21 @@ Surface ActsSurfaceMaps::getTpcSurface(TrkrDefs::hitsetkey hitsetkey,
                                        TrkrDefs::subsurfkey surfkey) const
 {
   unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+  if (m_indexed && layer + 1 < m_tpcLayerOffsets.size())
+  {
+    const size_t begin = m_tpcLayerOffsets[layer];
+    const size_t end = m_tpcLayerOffsets[layer + 1];
+    if (begin + surfkey < end)
+    {
+      return m_tpcFlatSurfaces[begin + surfkey];
+    }
+  }
+
   const auto iter = m_tpcSurfaceMap.find(layer);
 
   if (iter != m_tpcSurfaceMap.end())
   {
-    auto surfvec = iter->second;
+    const auto& surfvec = iter->second;
     return surfvec.at(surfkey);
   }
 
@@ -120,6 +144,101 @@ Surface ActsSurfaceMaps::getTpcSurface(TrkrDefs::hitsetkey hitsetkey,
 
 Surface ActsSurfaceMaps::getMMSurface(TrkrDefs::hitsetkey hitsetkey) const
 {
+  if (m_indexed)
+  {
+    return findFlatSurface(m_mmKeys, m_mmSurfaces, hitsetkey);
+  }
+
   const auto iter = m_mmSurfaceMap.find(hitsetkey);
   return (iter == m_mmSurfaceMap.end()) ? nullptr : iter->second;
 }
+
+const Surface& ActsSurfaceMaps::getFlatSurface(size_t index) const
+{
+  return (index < m_siliconSurfaces.size()) ? m_siliconSurfaces[index] : m_mmSurfaces.at(index - m_siliconSurfaces.size());
+}
+
+int ActsSurfaceMaps::getFlatIndex(TrkrDefs::cluskey key) const
+{
+  if (!m_indexed)
+  {
+    return -1;
+  }
+
+  const auto hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+  switch (TrkrDefs::getTrkrId(key))
+  {
+  case TrkrDefs::TrkrId::mvtxId:
+  case TrkrDefs::TrkrId::inttId:
+    return findFlatIndex(m_siliconKeys, siliconSurfaceKey(hitsetkey));
+
+  case TrkrDefs::TrkrId::micromegasId:
+  {
+    const int index = findFlatIndex(m_mmKeys, hitsetkey);
+    return (index < 0) ? index : index + static_cast<int>(m_siliconKeys.size());
+  }
+
+  default:
+    return -1;
+  }
+}
+
+int ActsSurfaceMaps::findFlatIndex(const std::vector<TrkrDefs::hitsetkey>& keys,
+                                   TrkrDefs::hitsetkey hitsetkey)
+{
+  const auto iter = std::lower_bound(keys.begin(), keys.end(), hitsetkey);
+  if (iter == keys.end() || *iter != hitsetkey)
+  {
+    return -1;
+  }
+  return static_cast<int>(iter - keys.begin());
+}
+
+Surface ActsSurfaceMaps::findFlatSurface(const std::vector<TrkrDefs::hitsetkey>& keys,
+                                         const SurfaceVec& surfaces,
+                                         TrkrDefs::hitsetkey hitsetkey)
+{
+  const int index = findFlatIndex(keys, hitsetkey);
+  return (index < 0) ? nullptr : surfaces[index];
+}
+
+void ActsSurfaceMaps::buildFlatIndex(const std::map<TrkrDefs::hitsetkey, Surface>& map,
+                                     std::vector<TrkrDefs::hitsetkey>& keys,
+                                     SurfaceVec& surfaces)
+{
+  // std::map is already sorted by hitsetkey
+  keys.clear();
+  surfaces.clear();
+  keys.reserve(map.size());
+  surfaces.reserve(map.size());
+  for (const auto& [hitsetkey, surface] : map)
+  {
+    keys.push_back(hitsetkey);
+    surfaces.push_back(surface);
+  }
+}
+
+void ActsSurfaceMaps::buildIndex()
+{
+  // silicon and micromegas, one sorted table each so a lookup never returns the other subsystem's surface
+  buildFlatIndex(m_siliconSurfaceMap, m_siliconKeys, m_siliconSurfaces);
+  buildFlatIndex(m_mmSurfaceMap, m_mmKeys, m_mmSurfaces);
+
+  // TPC, one contiguous range per layer
+  m_tpcFlatSurfaces.clear();
+  m_tpcLayerOffsets.clear();
+  const unsigned int nlayers = m_tpcSurfaceMap.empty() ? 0 : m_tpcSurfaceMap.rbegin()->first + 1;
+  m_tpcLayerOffsets.reserve(nlayers + 1);
+  m_tpcLayerOffsets.push_back(0);
+  for (unsigned int layer = 0; layer < nlayers; ++layer)
+  {
+    const auto iter = m_tpcSurfaceMap.find(layer);
+    if (iter != m_tpcSurfaceMap.end())
+    {
+      m_tpcFlatSurfaces.insert(m_tpcFlatSurfaces.end(), iter->second.begin(), iter->second.end());
+    }
+    m_tpcLayerOffsets.push_back(m_tpcFlatSurfaces.size());
+  }
+
+  m_indexed = true;
+}
@@ -23,6 +23,7 @@ class TrkrCluster;
 
 #include <map>
 #include <memory>
+#include <cstddef>
 #include <set>
 #include <vector>
 
@@ -49,6 +50,21 @@ struct ActsSurfaceMaps
 
   Surface getMMSurface(TrkrDefs::hitsetkey hitsetkey) const;
 
+  //! number of silicon and micromegas surfaces in the flat lookup tables, zero before buildIndex
+  size_t getNFlatSurfaces() const { return m_siliconSurfaces.size() + m_mmSurfaces.size(); }
+
+  //! silicon or micromegas surface at a given position in the flat lookup tables
+  /** silicon surfaces come first, then micromegas, each sorted by hitsetkey */
+  const Surface& getFlatSurface(size_t index) const;
+
+  //! position of the surface of a silicon or micromegas cluster in the flat lookup tables
+  /** -1 for TPC clusters, unknown hitsets or before buildIndex */
+  int getFlatIndex(TrkrDefs::cluskey key) const;
+
+  //! build flat lookup tables from the maps below
+  /** lookups fall back to the maps until this is called. It must be called again if the maps are modified */
+  void buildIndex();
+
   //! map hitset to Surface for the silicon detectors (MVTX and INTT)
   std::map<TrkrDefs::hitsetkey, Surface> m_siliconSurfaceMap;
 
@@ -68,6 +84,35 @@ struct ActsSurfaceMaps
   //! stores all acts volume ids relevant to the micromegas
   /** it is used to quickly tell if a given Acts Surface belongs to micromegas */
   std::set<int> m_micromegasVolumeIds;
+
+ private:
+  //! sorted silicon hitsetkeys (with zero crossing/strobe) and matching surfaces
+  std::vector<TrkrDefs::hitsetkey> m_siliconKeys;
+  SurfaceVec m_siliconSurfaces;
+
+  //! sorted micromegas hitsetkeys and matching surfaces
+  std::vector<TrkrDefs::hitsetkey> m_mmKeys;
+  SurfaceVec m_mmSurfaces;
+
+  //! TPC surfaces, contiguous. Surfaces of layer l are in [m_tpcLayerOffsets[l], m_tpcLayerOffsets[l+1])
+  SurfaceVec m_tpcFlatSurfaces;
+  std::vector<size_t> m_tpcLayerOffsets;
+
+  bool m_indexed = false;
+
+  //! position of hitsetkey in one of the key tables above, -1 if not found
+  static int findFlatIndex(const std::vector<TrkrDefs::hitsetkey>& keys,
+                           TrkrDefs::hitsetkey hitsetkey);
+
+  //! flat lookup in one of the tables above, with hitsetkey already stripped of crossing/strobe
+  static Surface findFlatSurface(const std::vector<TrkrDefs::hitsetkey>& keys,
+                                 const SurfaceVec& surfaces,
+                                 TrkrDefs::hitsetkey hitsetkey);
+
+  //! fill one of the tables above from its map
+  static void buildFlatIndex(const std::map<TrkrDefs::hitsetkey, Surface>& map,
+                             std::vector<TrkrDefs::hitsetkey>& keys,
+                             SurfaceVec& surfaces);
 };
 
 #endif
@@ -73,6 +73,16 @@ class TrkrHitTruthAssoc : public PHObject
   {
   }
 
+  /**
+   * @brief Get all hit to g4hit associations in a given hitset
+   * @param[in] hset TrkrHitSet key
+   * @param[out] Range over (hitkey, g4hitkey) pairs associated with @c hset
+   */
+  virtual ConstRange getG4Hits(const TrkrDefs::hitsetkey /*hitsetkey*/) const
+  {
+    return ConstRange();
+  }
+
  protected:
   //! ctor
   TrkrHitTruthAssoc() = default;
@@ -113,3 +113,8 @@ void TrkrHitTruthAssocv1::getG4Hits(const TrkrDefs::hitsetkey hitsetkey, const u
     }
   }
 }
+
+TrkrHitTruthAssocv1::ConstRange TrkrHitTruthAssocv1::getG4Hits(const TrkrDefs::hitsetkey hitsetkey) const
+{
+  return m_map.equal_range(hitsetkey);
+}
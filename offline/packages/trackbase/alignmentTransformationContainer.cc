@@ -11,13 +11,21 @@
 #include <Eigen/Geometry>
 
 #include <algorithm>
+#include <atomic>
 #include <ostream>
 #include <utility>
 
+namespace
+{
+  // source of the update stamps, shared by all containers
+  std::atomic<unsigned long> update_count{0};
+}  // namespace
+
 bool alignmentTransformationContainer::use_alignment = false;
 
 alignmentTransformationContainer::alignmentTransformationContainer()
 {
+  updated();
   for (uint8_t layer = 0; layer < 57; layer++)
   {
     m_misalignmentFactor.insert(std::make_pair(layer, 1.));
@@ -34,8 +42,14 @@ void alignmentTransformationContainer::setMisalignmentFactor(uint8_t layer, doub
   std::cout << "You provided a nonexistent layer in alignmentTransformationContainer::setMisalignmentFactor..."
             << std::endl;
 }
+void alignmentTransformationContainer::updated()
+{
+  m_updateStamp = ++update_count;
+}
+
 void alignmentTransformationContainer::Reset()
 {
+  updated();
   if (transformVec.size() == 0)
   {
     return;
@@ -81,6 +95,7 @@ void alignmentTransformationContainer::identify(std::ostream& os)
 
 void alignmentTransformationContainer::addTransform(const Acts::GeometryIdentifier id, const Acts::Transform3& transform)
 {
+  updated();
   unsigned int sphlayer = getsphlayer(id);
   unsigned int sensor = id.sensitive() - 1;  // Acts sensor numbering starts at 1
 
@@ -139,6 +154,7 @@ Acts::Transform3& alignmentTransformationContainer::getTransform(const Acts::Geo
 
 void alignmentTransformationContainer::replaceTransform(const Acts::GeometryIdentifier id, Acts::Transform3 transform)
 {
+  updated();
   unsigned int sphlayer = getsphlayer(id);
   unsigned int sensor = id.sensitive() - 1;  // Acts sensor numbering starts at 1
 
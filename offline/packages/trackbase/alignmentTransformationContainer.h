@@ -38,6 +38,11 @@ class alignmentTransformationContainer : public Acts::GeometryContext
   const std::vector<std::vector<Acts::Transform3>>& getMap() const;
   void setMisalignmentFactor(uint8_t layer, double factor);
   const double& getMisalignmentFactor(uint8_t layer) const { return m_misalignmentFactor.find(layer)->second; }
+
+  //! changes whenever transforms are added, replaced or reset, and differs between containers
+  /** changes made through the reference returned by getTransform are not seen */
+  unsigned long updateStamp() const { return m_updateStamp; }
+
   static bool use_alignment;
 
  private:
@@ -47,6 +52,9 @@ class alignmentTransformationContainer : public Acts::GeometryContext
 
   std::vector<std::vector<Acts::Transform3>> transformVec;
 
+  void updated();
+  unsigned long m_updateStamp = 0;
+
   /// Map of TrkrDefs::Layer to misalignment factor
   std::map<uint8_t, double> m_misalignmentFactor;
 
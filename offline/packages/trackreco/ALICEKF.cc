@@ -63,7 +63,13 @@ ALICEKF::ALICEKF( TrkrClusterContainer* cmap, PHField* B, unsigned int min_clust
   _v(verbosity),
   _max_sin_phi(max_sin_phi),
   _ClusErrPara(new ClusterErrorPara)
-{}
+{
+  _field_caches.resize(omp_get_max_threads());
+  for (auto& cache : _field_caches)
+  {
+    cache = _B->MakeCache();
+  }
+}
 
 double ALICEKF::get_Bz(double x, double y, double z) const
 {
@@ -78,10 +84,12 @@ double ALICEKF::get_Bz(double x, double y, double z) const
     const std::array<double,4> p = {x * cm, y * cm, z * cm, 0. * cm};
     double bfield[3];
 
-    // check thread number. Use uncached field accessor for all but thread 0.
-    if( omp_get_thread_num() == 0 )
+    // every thread uses its own lookup cache
+    // threads beyond the ones counted at construction use the uncached accessor
+    const size_t thread = omp_get_thread_num();
+    if( thread < _field_caches.size() )
     {
-      _B->GetFieldValue(&p[0], bfield);
+      _B->GetFieldValue_cache(&p[0], bfield, _field_caches[thread].get());
     } else {
       _B->GetFieldValue_nocache(&p[0], bfield);
     }
@@ -14,6 +14,7 @@
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -67,6 +68,9 @@ class ALICEKF
   //! magnetic field map
   PHField* _B = nullptr;
 
+  //! field map lookup cache for each OpenMP thread
+  std::vector<std::unique_ptr<PHField::Cache>> _field_caches;
+
   //! constant magnetic field
   /**
    * it is used for fast momentum calculation, or when positions are outside the field map boundaries along z
@@ -50,6 +50,7 @@
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
+#include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
@@ -87,16 +88,40 @@
 
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <utility>
 #include <vector>
 
+#include <unistd.h>
+
 namespace
 {
+  // bump whenever the content or the format of the surface map cache changes
+  constexpr int geometryCacheVersion = 2;
+
+  // maximum distance (mm) between cached and rebuilt surface centers
+  constexpr double geometryCacheTolerance = 1e-3;
+
+  // FNV-1a, stable across compilers and platforms, unlike std::hash
+  uint64_t fnv1a(const std::string &value)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char c : value)
+    {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
   // navigate Acts volumes to find one matching a given name (recursive)
   // NOLINTNEXTLINE(misc-no-recursion)
   TrackingVolumePtr find_volume_by_name(const Acts::TrackingVolume *master, const std::string &name)
@@ -182,6 +207,9 @@ int MakeActsGeometry::InitRun(PHCompositeNode *topNode)
   
   m_maxSurfZ = m_max_driftlength - 0.0001; // add clearance from physical TPC gas volume length to avoid overlaps
     
+  PHTimer startupTimer("MakeActsGeometryTimer");
+  startupTimer.restart();
+
   // Alignment Transformation declaration of instance - must be here to set initial alignment flag
   AlignmentTransformation alignment_transformation;
   alignment_transformation.createAlignmentTransformContainer(topNode);
@@ -213,6 +241,16 @@ int MakeActsGeometry::InitRun(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  startupTimer.stop();
+  std::cout << "MakeActsGeometry::InitRun - geometry built in "
+            << startupTimer.get_accumulated_time() / 1000. << " s";
+  if (!m_geometryCacheFile.empty())
+  {
+    std::cout << " (surface map cache " << (m_geometryCacheHit ? "hit" : "miss")
+              << ": " << m_geometryCacheFile << ")";
+  }
+  std::cout << std::endl;
+
   // load relevant magnetic field map on the node tree
   double fieldstrength = std::numeric_limits<double>::quiet_NaN();
   if( isConstantField( m_magField, fieldstrength ) )
@@ -595,6 +633,8 @@ void MakeActsGeometry::buildActsSurfaces()
 
   std::string responseFile, materialFile;
   setMaterialResponseFile(responseFile, materialFile);
+  m_responseFile = responseFile;
+  m_materialFile = materialFile;
 
   // arguments
   // material and response file contains arguments necessary for geometry building
@@ -830,6 +870,15 @@ void MakeActsGeometry::unpackVolumes()
     std::cout << "Before: Mvtx: m_clusterSurfaceMapSilicon size    " << m_clusterSurfaceMapSilicon.size() << std::endl;
     std::cout << "Before: m_clusterSurfaceMapTpc size    " << m_clusterSurfaceMapTpcEdit.size() << std::endl;
   }
+
+  // restore surface maps from cache if available
+  m_geometryCacheHit = false;
+  if (!m_geometryCacheFile.empty() && readGeometryCache())
+  {
+    m_geometryCacheHit = true;
+    return;
+  }
+
   {
     // micromegas
     auto mmBarrel = find_volume_by_name(vol, "MICROMEGAS::Barrel");
@@ -873,9 +922,229 @@ void MakeActsGeometry::unpackVolumes()
     }
   }
 
+  if (!m_geometryCacheFile.empty())
+  {
+    writeGeometryCache();
+  }
+
   return;
 }
 
+//____________________________________________________________________________________________
+std::string MakeActsGeometry::geometryCacheKey() const
+{
+  // everything that changes the surfaces or their association to hitsetkeys
+  std::ostringstream key;
+  key << std::setprecision(17)
+      << "response " << m_responseFile
+      << " material " << m_materialFile
+      << " nSurfPhi " << m_nSurfPhi
+      << " nSurfZ " << m_nSurfZ
+      << " minSurfZ " << m_minSurfZ
+      << " maxSurfZ " << m_maxSurfZ
+      << " modulePhiStart " << m_modulePhiStart
+      << " moduleStepPhi " << m_moduleStepPhi
+      << " inttSurvey " << m_inttSurvey
+      << " mvtxMisalign " << m_mvtxapplymisalign;
+  if (m_mvtxapplymisalign)
+  {
+    key << " mvtxAlignment " << CDBInterface::instance()->getUrl("MVTX_ALIGNMENT");
+  }
+  for (unsigned int ilayer = 0; ilayer < m_nTpcLayers; ++ilayer)
+  {
+    key << " " << m_layerRadius[ilayer] << " " << m_layerThickness[ilayer];
+  }
+
+  std::ostringstream hash;
+  hash << std::hex << std::setw(16) << std::setfill('0') << fnv1a(key.str());
+  return hash.str();
+}
+
+//____________________________________________________________________________________________
+bool MakeActsGeometry::readGeometryCache()
+{
+  std::ifstream in(m_geometryCacheFile);
+  if (!in.is_open())
+  {
+    return false;
+  }
+
+  // header, skipping comments
+  std::string line;
+  while (std::getline(in, line))
+  {
+    if (!line.empty() && line[0] != '#')
+    {
+      break;
+    }
+  }
+  std::istringstream header(line);
+  std::string tag;
+  int version = -1;
+  std::string key;
+  // number of silicon, TPC and micromegas entries, there are no micromegas in some geometries
+  size_t nsilicon = 0;
+  size_t ntpc = 0;
+  size_t nmm = 0;
+  header >> tag >> version >> key >> nsilicon >> ntpc >> nmm;
+  if (!header || tag != "version" || version != geometryCacheVersion || key != geometryCacheKey())
+  {
+    std::cout << "MakeActsGeometry::readGeometryCache - " << m_geometryCacheFile
+              << " does not match geometry configuration, rebuilding" << std::endl;
+    return false;
+  }
+
+  std::map<TrkrDefs::hitsetkey, Surface> siliconMap;
+  std::map<unsigned int, std::vector<Surface>> tpcMap;
+  std::map<TrkrDefs::hitsetkey, Surface> mmMap;
+
+  // entries: detector, key, geometry id and surface center in mm
+  char detector = 0;
+  uint64_t key_value = 0;
+  Acts::GeometryIdentifier::Value geoid = 0;
+  double x = 0;
+  double y = 0;
+  double z = 0;
+  while (in >> detector >> key_value >> geoid >> x >> y >> z)
+  {
+    const auto surface = m_tGeometry->findSurface(Acts::GeometryIdentifier(geoid));
+    if (!surface)
+    {
+      std::cout << "MakeActsGeometry::readGeometryCache - surface " << geoid
+                << " not found, rebuilding" << std::endl;
+      return false;
+    }
+
+    // make sure the surface did not move with respect to the cached one
+    const auto center = surface->center(m_geoCtxt);
+    if (std::abs(center.x() - x) > geometryCacheTolerance ||
+        std::abs(center.y() - y) > geometryCacheTolerance ||
+        std::abs(center.z() - z) > geometryCacheTolerance)
+    {
+      std::cout << "MakeActsGeometry::readGeometryCache - surface " << geoid
+                << " moved, rebuilding" << std::endl;
+      return false;
+    }
+
+    auto surf = surface->getSharedPtr();
+    switch (detector)
+    {
+    case 'S':
+      siliconMap.insert(std::make_pair(static_cast<TrkrDefs::hitsetkey>(key_value), surf));
+      break;
+    case 'T':
+      tpcMap[static_cast<unsigned int>(key_value)].push_back(surf);
+      break;
+    case 'M':
+      mmMap.insert(std::make_pair(static_cast<TrkrDefs::hitsetkey>(key_value), surf));
+      break;
+    default:
+      std::cout << "MakeActsGeometry::readGeometryCache - invalid entry in "
+                << m_geometryCacheFile << ", rebuilding" << std::endl;
+      return false;
+    }
+  }
+
+  size_t ntpcread = 0;
+  for (const auto &[layer, surfaces] : tpcMap)
+  {
+    ntpcread += surfaces.size();
+  }
+  if (!in.eof() || siliconMap.empty() || tpcMap.empty() ||
+      siliconMap.size() != nsilicon || ntpcread != ntpc || mmMap.size() != nmm)
+  {
+    std::cout << "MakeActsGeometry::readGeometryCache - " << m_geometryCacheFile
+              << " is incomplete, rebuilding" << std::endl;
+    return false;
+  }
+
+  m_clusterSurfaceMapSilicon = std::move(siliconMap);
+  m_clusterSurfaceMapTpcEdit = std::move(tpcMap);
+  m_clusterSurfaceMapMmEdit = std::move(mmMap);
+
+  if (Verbosity())
+  {
+    std::cout << "MakeActsGeometry::readGeometryCache - restored "
+              << m_clusterSurfaceMapSilicon.size() << " silicon, "
+              << m_clusterSurfaceMapTpcEdit.size() << " TPC layers and "
+              << m_clusterSurfaceMapMmEdit.size() << " micromegas surfaces from "
+              << m_geometryCacheFile << std::endl;
+  }
+
+  return true;
+}
+
+//____________________________________________________________________________________________
+void MakeActsGeometry::writeGeometryCache() const
+{
+  // write to a temporary file first and rename, so that concurrent jobs never read a partial cache
+  const std::string tmpfile = m_geometryCacheFile + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream out(tmpfile);
+    if (!out.is_open())
+    {
+      std::cout << "MakeActsGeometry::writeGeometryCache - cannot open " << tmpfile << std::endl;
+      return;
+    }
+
+    out << "# MakeActsGeometry surface map cache" << std::endl;
+    out << "# detector key geometryid x y z (mm)" << std::endl;
+    size_t ntpc = 0;
+    for (const auto &[layer, surfaces] : m_clusterSurfaceMapTpcEdit)
+    {
+      ntpc += surfaces.size();
+    }
+    out << "# version number key silicon_entries tpc_entries micromegas_entries" << std::endl;
+    out << "version " << geometryCacheVersion << " " << geometryCacheKey() << " "
+        << m_clusterSurfaceMapSilicon.size() << " " << ntpc << " "
+        << m_clusterSurfaceMapMmEdit.size() << std::endl;
+    out << std::setprecision(17);
+
+    auto write = [&out, this](char detector, uint64_t key, const Surface &surface)
+    {
+      const auto center = surface->center(m_geoCtxt);
+      out << detector << " " << key << " " << surface->geometryId().value() << " "
+          << center.x() << " " << center.y() << " " << center.z() << "\n";
+    };
+
+    for (const auto &[hitsetkey, surface] : m_clusterSurfaceMapSilicon)
+    {
+      write('S', hitsetkey, surface);
+    }
+    for (const auto &[layer, surfaces] : m_clusterSurfaceMapTpcEdit)
+    {
+      for (const auto &surface : surfaces)
+      {
+        write('T', layer, surface);
+      }
+    }
+    for (const auto &[hitsetkey, surface] : m_clusterSurfaceMapMmEdit)
+    {
+      write('M', hitsetkey, surface);
+    }
+
+    if (!out.good())
+    {
+      std::cout << "MakeActsGeometry::writeGeometryCache - error writing " << tmpfile << std::endl;
+      out.close();
+      std::filesystem::remove(tmpfile);
+      return;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpfile, m_geometryCacheFile, ec);
+  if (ec)
+  {
+    std::cout << "MakeActsGeometry::writeGeometryCache - cannot write " << m_geometryCacheFile
+              << ": " << ec.message() << std::endl;
+    std::filesystem::remove(tmpfile, ec);
+    return;
+  }
+
+  std::cout << "MakeActsGeometry::writeGeometryCache - wrote " << m_geometryCacheFile << std::endl;
+}
+
 void MakeActsGeometry::makeTpcMapPairs(TrackingVolumePtr &tpcVolume)
 {
   if (Verbosity() > 10)
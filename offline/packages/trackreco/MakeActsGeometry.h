@@ -154,6 +154,11 @@ class MakeActsGeometry : public SubsysReco
   void setUseModuleTiltAlways(bool flag) { m_use_module_tilt_always = flag; }
   void setUseNewSiliconRotationOrder(bool flag) { m_use_new_silicon_rotation_order = flag; }
 
+  /// file used to cache the association between Acts surfaces and hitsetkeys.
+  /// It is written on the first run and restored on subsequent runs
+  /// with the same geometry configuration, skipping the surface to sensor matching
+  void setGeometryCache(const std::string &filename) { m_geometryCacheFile = filename; }
+
 private:
   /// Main function to build all acts geometry for use in the fitting modules
   int buildAllGeometry(PHCompositeNode *topNode);
@@ -217,6 +222,11 @@ private:
 
   void unpackVolumes();
 
+  /// surface map cache
+  std::string geometryCacheKey() const;
+  bool readGeometryCache();
+  void writeGeometryCache() const;
+
   /// Subdetector geometry containers for getting layer information
   PHG4CylinderGeomContainer *m_geomContainerMvtx = nullptr;
   PHG4CylinderGeomContainer *m_geomContainerIntt = nullptr;
@@ -314,6 +324,14 @@ private:
 
   bool m_use_module_tilt_always = false;
   bool m_use_new_silicon_rotation_order = false;
+
+  /// Acts response and material files, part of the geometry cache key
+  std::string m_responseFile;
+  std::string m_materialFile;
+
+  /// surface map cache file, disabled if empty
+  std::string m_geometryCacheFile;
+  bool m_geometryCacheHit = false;
 };
 
 #endif
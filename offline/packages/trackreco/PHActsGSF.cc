@@ -43,6 +43,9 @@
 #include "ActsEvaluator.h"
 
 #include <TDatabasePDG.h>
+#include <TROOT.h>
+
+#include <omp.h>
 
 //____________________________________________________________________________..
 PHActsGSF::PHActsGSF(const std::string& name)
@@ -95,6 +98,25 @@ int PHActsGSF::InitRun(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  // the copies of the transient transforms are made again for this run
+  if (m_fitContexts.size() > 1)
+  {
+    m_fitContexts.resize(1);
+  }
+  m_transientMapCopies.clear();
+  if (m_num_threads > 1)
+  {
+    if (useThreads())
+    {
+      ROOT::EnableThreadSafety();
+    }
+    else
+    {
+      std::cout << PHWHERE << " the evaluator needs a serial fit, ignoring set_num_threads("
+                << m_num_threads << ")" << std::endl;
+    }
+  }
+
   auto bha = Acts::makeDefaultBetheHeitlerApprox();
   ActsGsfTrackFittingAlgorithm gsf;
   m_fitCfg.fit = gsf.makeGsfFitterFunction(
@@ -144,122 +166,168 @@ int PHActsGSF::process_event(PHCompositeNode* topNode)
 
   auto logger = Acts::getDefaultLogger("PHActsGSF", logLevel);
 
+  setupFitContexts();
+
+  std::vector<SvtxTrack*> tracks;
+  tracks.reserve(m_trackMap->size());
   for (const auto& [key, track] : *m_trackMap)
   {
-    auto pSurface = makePerigee(track);
-    if (!pSurface)
+    tracks.push_back(track);
+  }
+
+  // tracks are refit in place, they are independent of each other
+  if (useThreads())
+  {
+    const int ntracks = tracks.size();
+#pragma omp parallel for schedule(dynamic) num_threads(m_num_threads)
+    for (int itrack = 0; itrack < ntracks; ++itrack)
     {
-      //! If no vertex was assigned to track, just skip it
-      continue;
+      refitTrack(tracks[itrack], m_fitContexts[omp_get_thread_num()]);
     }
-    const auto seed = makeSeed(track, pSurface);
-
-    auto svtxseed = new TrackSeed_v2();
-    std::map<TrkrDefs::cluskey, Acts::Vector3> clusterPositions;
-    for (auto& cKey : get_cluster_keys(track))
+  }
+  else
+  {
+    for (auto* track : tracks)
     {
-      auto cluster = m_clusterContainer->findCluster(cKey);
-      auto globalPosition = m_tGeometry->getGlobalPosition(cKey, cluster);
-      clusterPositions.insert(std::make_pair(cKey, globalPosition));
-      svtxseed->insert_cluster_key(cKey);
+      refitTrack(track, m_fitContexts.front());
     }
-    svtxseed->set_phi(track->get_phi());
-    TrackSeedHelper::circleFitByTaubin(svtxseed,clusterPositions, 0, 57);
-    TrackSeedHelper::lineFit(svtxseed, clusterPositions, 7, 57);
+  }
 
-    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
-    TrackSeed* tpcseed = track->get_tpc_seed();
-    TrackSeed* silseed = track->get_silicon_seed();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-    /// We only fit full sPHENIX tracks
-    if (!silseed || !tpcseed)
-    {
-      continue;
-    }
+void PHActsGSF::refitTrack(SvtxTrack* track, FitContext& context)
+{
+  auto pSurface = makePerigee(track);
+  if (!pSurface)
+  {
+    //! If no vertex was assigned to track, just skip it
+    return;
+  }
+  const auto seed = makeSeed(track, pSurface);
 
-    auto crossing = silseed->get_crossing();
-    if (crossing == SHRT_MAX)
-    {
-      continue;
-    }
+  auto svtxseed = new TrackSeed_v2();
+  std::map<TrkrDefs::cluskey, Acts::Vector3> clusterPositions;
+  for (auto& cKey : get_cluster_keys(track))
+  {
+    auto cluster = m_clusterContainer->findCluster(cKey);
+    auto globalPosition = m_tGeometry->getGlobalPosition(cKey, cluster);
+    clusterPositions.insert(std::make_pair(cKey, globalPosition));
+    svtxseed->insert_cluster_key(cKey);
+  }
+  svtxseed->set_phi(track->get_phi());
+  TrackSeedHelper::circleFitByTaubin(svtxseed,clusterPositions, 0, 57);
+  TrackSeedHelper::lineFit(svtxseed, clusterPositions, 7, 57);
 
-    /*
-    auto sourceLinks = getSourceLinks(tpcseed, measurements, crossing);
-    auto silSourceLinks = getSourceLinks(silseed, measurements, crossing);
-    */
-
-    // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
-    MakeSourceLinks makeSourceLinks;
-    makeSourceLinks.setVerbosity(Verbosity());
-    makeSourceLinks.set_pp_mode(m_pp_mode);
-
-    makeSourceLinks.resetTransientTransformMap(
-        m_alignmentTransformationMapTransient,
-        m_transient_id_set,
-        m_tGeometry);
-
-    // TPC source links
-    auto sourceLinks = makeSourceLinks.getSourceLinks(
-        tpcseed,
-        measurements,
-        m_clusterContainer,
-        m_tGeometry,
-        m_globalPositionWrapper,
-        m_alignmentTransformationMapTransient,
-        m_transient_id_set,
-        crossing);
-
-    // silicon source links
-    auto silSourceLinks = makeSourceLinks.getSourceLinks(
-        silseed,
-        measurements,
-        m_clusterContainer,
-        m_tGeometry,
-        m_globalPositionWrapper,
-        m_alignmentTransformationMapTransient,
-        m_transient_id_set,
-        crossing);
-
-    // copy transient map for this track into transient geoContext
-    m_transient_geocontext = m_alignmentTransformationMapTransient;
-
-    for (auto& siSL : silSourceLinks)
-    {
-      sourceLinks.push_back(siSL);
-    }
+  ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+  TrackSeed* tpcseed = track->get_tpc_seed();
+  TrackSeed* silseed = track->get_silicon_seed();
 
-    auto calibptr = std::make_unique<Calibrator>();
-    CalibratorAdapter calibrator(*calibptr, measurements);
-    auto magcontext = m_tGeometry->geometry().magFieldContext;
-    auto calcontext = m_tGeometry->geometry().calibContext;
+  /// We only fit full sPHENIX tracks
+  if (!silseed || !tpcseed)
+  {
+    return;
+  }
+
+  auto crossing = silseed->get_crossing();
+  if (crossing == SHRT_MAX)
+  {
+    return;
+  }
 
-    auto ppoptions = Acts::PropagatorPlainOptions();
+  /*
+  auto sourceLinks = getSourceLinks(tpcseed, measurements, crossing);
+  auto silSourceLinks = getSourceLinks(silseed, measurements, crossing);
+  */
+
+  // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
+  MakeSourceLinks makeSourceLinks;
+  makeSourceLinks.setVerbosity(Verbosity());
+  makeSourceLinks.set_pp_mode(m_pp_mode);
+
+  makeSourceLinks.resetTransientTransformMap(
+      context.transientMap,
+      context.transientIds,
+      m_tGeometry);
+
+  // TPC source links
+  auto sourceLinks = makeSourceLinks.getSourceLinks(
+      tpcseed,
+      measurements,
+      m_clusterContainer,
+      m_tGeometry,
+      m_globalPositionWrapper,
+      context.transientMap,
+      context.transientIds,
+      crossing);
+
+  // silicon source links
+  auto silSourceLinks = makeSourceLinks.getSourceLinks(
+      silseed,
+      measurements,
+      m_clusterContainer,
+      m_tGeometry,
+      m_globalPositionWrapper,
+      context.transientMap,
+      context.transientIds,
+      crossing);
+
+  for (auto& siSL : silSourceLinks)
+  {
+    sourceLinks.push_back(siSL);
+  }
 
-    ActsTrackFittingAlgorithm::GeneralFitterOptions options{
-        m_transient_geocontext,
-        magcontext,
-        calcontext,
-        &(*pSurface),
-        ppoptions};
-    if (Verbosity() > 2)
-    {
-      std::cout << "calling gsf with position "
-                << seed.position(m_transient_geocontext).transpose()
-                << " and momentum " << seed.momentum().transpose()
-                << std::endl;
-    }
-    auto trackContainer = std::make_shared<Acts::VectorTrackContainer>();
-    auto trackStateContainer = std::make_shared<Acts::VectorMultiTrajectory>();
-    ActsTrackFittingAlgorithm::TrackContainer tracks(trackContainer, trackStateContainer);
-    auto result = fitTrack(sourceLinks, seed, options, calibrator, tracks);
+  auto calibptr = std::make_unique<Calibrator>();
+  CalibratorAdapter calibrator(*calibptr, measurements);
+  auto magcontext = m_tGeometry->geometry().magFieldContext;
+  auto calcontext = m_tGeometry->geometry().calibContext;
 
-    if (result.ok())
-    {
-      updateTrack(result, track, tracks, svtxseed, measurements);
-    }
+  auto ppoptions = Acts::PropagatorPlainOptions();
+
+  ActsTrackFittingAlgorithm::GeneralFitterOptions options{
+      context.geocontext,
+      magcontext,
+      calcontext,
+      &(*pSurface),
+      ppoptions};
+  if (Verbosity() > 2)
+  {
+    std::cout << "calling gsf with position "
+              << seed.position(context.geocontext).transpose()
+              << " and momentum " << seed.momentum().transpose()
+              << std::endl;
   }
+  auto trackContainer = std::make_shared<Acts::VectorTrackContainer>();
+  auto trackStateContainer = std::make_shared<Acts::VectorMultiTrajectory>();
+  ActsTrackFittingAlgorithm::TrackContainer tracks(trackContainer, trackStateContainer);
+  auto result = fitTrack(sourceLinks, seed, options, calibrator, tracks);
 
-  return Fun4AllReturnCodes::EVENT_OK;
+  if (result.ok())
+  {
+    updateTrack(result, track, tracks, svtxseed, measurements, context.geocontext);
+  }
+}
+
+void PHActsGSF::setupFitContexts()
+{
+  const unsigned int nthreads = useThreads() ? m_num_threads : 1;
+  // the first context works directly on the transient transforms of the node tree
+  if (m_fitContexts.empty())
+  {
+    m_fitContexts.resize(1);
+  }
+  m_fitContexts.front().transientMap = m_alignmentTransformationMapTransient;
+  m_fitContexts.front().geocontext = m_alignmentTransformationMapTransient;
+  // the others on copies made once per run, which start with the same modified set
+  while (m_fitContexts.size() < nthreads)
+  {
+    m_transientMapCopies.push_back(std::make_unique<alignmentTransformationContainer>(*m_alignmentTransformationMapTransient));
+    FitContext context;
+    context.transientMap = m_transientMapCopies.back().get();
+    context.transientIds = m_fitContexts.front().transientIds;
+    context.geocontext = context.transientMap;
+    m_fitContexts.push_back(std::move(context));
+  }
 }
 
 std::shared_ptr<Acts::PerigeeSurface> PHActsGSF::makePerigee(SvtxTrack* track) const
@@ -318,7 +386,8 @@ ActsTrackFittingAlgorithm::TrackFitterResult PHActsGSF::fitTrack(
 void PHActsGSF::updateTrack(FitResult& result, SvtxTrack* track,
                             ActsTrackFittingAlgorithm::TrackContainer& tracks,
                             const TrackSeed* seed,
-                            const ActsTrackFittingAlgorithm::MeasurementContainer& measurements)
+                            const ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
+                            const Acts::GeometryContext& geocontext)
 {
   std::vector<Acts::MultiTrajectoryTraits::IndexType> trackTips;
   trackTips.reserve(1);
@@ -330,7 +399,7 @@ void PHActsGSF::updateTrack(FitResult& result, SvtxTrack* track,
                                   ActsExamples::TrackParameters{outtrack.referenceSurface().getSharedPtr(),
                                                                 outtrack.parameters(), outtrack.covariance(), Acts::ParticleHypothesis::electron()}});
 
-  updateSvtxTrack(trackTips, indexedParams, tracks, track);
+  updateSvtxTrack(trackTips, indexedParams, tracks, track, geocontext);
 
   if (m_actsEvaluator)
   {
@@ -342,7 +411,8 @@ void PHActsGSF::updateTrack(FitResult& result, SvtxTrack* track,
 void PHActsGSF::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                                 Trajectory::IndexedParameters& paramsMap,
                                 ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                                SvtxTrack* track)
+                                SvtxTrack* track,
+                                const Acts::GeometryContext& geocontext)
 {
   const auto& mj = tracks.trackStateContainer();
   const auto& tracktip = tips.front();
@@ -359,7 +429,7 @@ void PHActsGSF::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexTy
               << "   (" << track->get_px() << ", " << track->get_py()
               << ", " << track->get_pz() << ")" << std::endl;
     std::cout << "New GSF track parameters: " << std::endl
-              << "   " << params.position(m_transient_geocontext).transpose()
+              << "   " << params.position(geocontext).transpose()
               << std::endl
               << "   " << params.momentum().transpose()
               << std::endl;
@@ -377,9 +447,9 @@ void PHActsGSF::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexTy
   out.set_z(0.0);
   track->insert_state(&out);
 
-  track->set_x(params.position(m_transient_geocontext)(0) / Acts::UnitConstants::cm);
-  track->set_y(params.position(m_transient_geocontext)(1) / Acts::UnitConstants::cm);
-  track->set_z(params.position(m_transient_geocontext)(2) / Acts::UnitConstants::cm);
+  track->set_x(params.position(geocontext)(0) / Acts::UnitConstants::cm);
+  track->set_y(params.position(geocontext)(1) / Acts::UnitConstants::cm);
+  track->set_z(params.position(geocontext)(2) / Acts::UnitConstants::cm);
 
   track->set_px(params.momentum()(0));
   track->set_py(params.momentum()(1));
@@ -403,7 +473,7 @@ void PHActsGSF::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexTy
     }
   }
 
-  transformer.fillSvtxTrackStates(mj, tracktip, track, m_transient_geocontext);
+  transformer.fillSvtxTrackStates(mj, tracktip, track, geocontext);
 }
 
 //____________________________________________________________________________..
@@ -11,6 +11,7 @@
 
 #include <trackbase/ActsSourceLink.h>
 #include <trackbase/ActsTrackFittingAlgorithm.h>
+#include <trackbase/alignmentTransformationContainer.h>
 #include <trackbase/Calibrator.h>
 #include <trackbase/ClusterErrorPara.h>
 
@@ -25,7 +26,10 @@
 #include <ActsExamples/EventData/Trajectories.hpp>
 
 
+#include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class ActsGeometry;
@@ -59,8 +63,23 @@ class PHActsGSF : public SubsysReco
     m_actsEvaluator = actsEvaluator;
   }
 
+  //! refit the tracks on n threads (OpenMP), not available with the evaluator
+  void set_num_threads(int n) { m_num_threads = n; }
+
  private:
+  //! state of one fitting thread: the transient transforms it modifies with
+  //! the distortion corrections of the track being fitted
+  struct FitContext
+  {
+    alignmentTransformationContainer* transientMap = nullptr;
+    std::set<Acts::GeometryIdentifier> transientIds;
+    Acts::GeometryContext geocontext;
+  };
+
   int getNodes(PHCompositeNode* topNode);
+  void refitTrack(SvtxTrack* track, FitContext& context);
+  void setupFitContexts();
+  bool useThreads() const { return m_num_threads > 1 && !m_actsEvaluator; }
   std::shared_ptr<Acts::PerigeeSurface> makePerigee(SvtxTrack* track) const;
   ActsTrackFittingAlgorithm::TrackParameters makeSeed(
       SvtxTrack* track,
@@ -77,11 +96,13 @@ class PHActsGSF : public SubsysReco
 
   void updateTrack(FitResult& result, SvtxTrack* track,
                    ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                   const TrackSeed* seed, const ActsTrackFittingAlgorithm::MeasurementContainer& measurements);
+                   const TrackSeed* seed, const ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
+                   const Acts::GeometryContext& geocontext);
   void updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                        Trajectory::IndexedParameters& paramsMap,
                        ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                       SvtxTrack* track);
+                       SvtxTrack* track,
+                       const Acts::GeometryContext& geocontext);
   std::vector<TrkrDefs::cluskey> get_cluster_keys(SvtxTrack* track);
 
   ActsGeometry* m_tGeometry = nullptr;
@@ -91,8 +112,12 @@ class PHActsGSF : public SubsysReco
 
 //  alignmentTransformationContainer* m_alignmentTransformationMap = nullptr;  // added for testing purposes
   alignmentTransformationContainer* m_alignmentTransformationMapTransient = nullptr;
-  std::set< Acts::GeometryIdentifier> m_transient_id_set;
-  Acts::GeometryContext m_transient_geocontext;
+
+  //! fitting threads and their contexts, the first one uses the transient
+  //! transforms of the node tree, the others copies of them
+  int m_num_threads = 1;
+  std::vector<FitContext> m_fitContexts;
+  std::vector<std::unique_ptr<alignmentTransformationContainer>> m_transientMapCopies;
 
   // Tpc Global position wrapper
   TpcGlobalPositionWrapper m_globalPositionWrapper;
@@ -57,6 +57,10 @@
 #include <Acts/TrackFitting/GainMatrixSmoother.hpp>
 #include <Acts/TrackFitting/GainMatrixUpdater.hpp>
 
+#include <TROOT.h>
+
+#include <omp.h>
+
 #include <cmath>
 #include <filesystem>
 #include <iostream>
@@ -102,6 +106,25 @@ int PHActsTrkFitter::InitRun(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  // the copies of the transient transforms are made again for this run
+  if (m_fitContexts.size() > 1)
+  {
+    m_fitContexts.resize(1);
+  }
+  m_transientMapCopies.clear();
+  if (m_num_threads > 1)
+  {
+    if (useThreads())
+    {
+      ROOT::EnableThreadSafety();
+    }
+    else
+    {
+      std::cout << PHWHERE << " evaluator, commissioning, time analysis and outlier finder"
+                << " need a serial fit, ignoring set_num_threads(" << m_num_threads << ")" << std::endl;
+    }
+  }
+
   // configure alignStates
   m_alignStates.loadNodes(topNode);
   m_alignStates.verbosity(Verbosity());
@@ -298,574 +321,632 @@ int PHActsTrkFitter::End(PHCompositeNode* /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
+void PHActsTrkFitter::loopTracks(Acts::Logging::Level /*logLevel*/)
 {
-  auto logger = Acts::getDefaultLogger("PHActsTrkFitter", logLevel);
+  setupFitContexts();
 
-  for (auto track : *m_seedMap)
+  if (!useThreads())
   {
-    if (!track)
-    {
-      continue;
-    }
-
-    unsigned int tpcid = track->get_tpc_seed_index();
-    unsigned int siid = track->get_silicon_seed_index();
-
-    // capture the input crossing value, and set crossing parameters
-    //==============================
-    short silicon_crossing = SHRT_MAX;
-    auto *siseed = m_siliconSeeds->get(siid);
-    if (siseed)
+    for (auto* track : *m_seedMap)
     {
-      silicon_crossing = siseed->get_crossing();
-    }
-    short crossing = silicon_crossing;
-    short int crossing_estimate = crossing;
-
-    if (m_enable_crossing_estimate)
-    {
-      crossing_estimate = track->get_crossing_estimate();  // geometric crossing estimate from matcher
-    }
-    //===============================
-
-    // must have silicon seed with valid crossing if we are doing a SC calibration fit
-    if (m_fitSiliconMMs)
-    {
-      if ((siid == std::numeric_limits<unsigned int>::max()) || (silicon_crossing == SHRT_MAX))
+      if (!track)
       {
         continue;
       }
+      SeedFitOutput output;
+      fitSeed(track, m_fitContexts.front(), output);
+      insertTracks(output);
     }
+    return;
+  }
 
-    // do not skip TPC only tracks, just set crossing to the nominal zero
-    if (!siseed)
+  // fit the seeds in parallel, each thread with its own copy of the transient
+  // transforms. The fitted tracks are buffered per seed and inserted in seed
+  // order afterwards, so the track ids do not depend on the number of threads
+  std::vector<TrackSeed*> seeds(m_seedMap->begin(), m_seedMap->end());
+  std::vector<SeedFitOutput> outputs(seeds.size());
+  const int nseeds = seeds.size();
+#pragma omp parallel for schedule(dynamic) num_threads(m_num_threads)
+  for (int iseed = 0; iseed < nseeds; ++iseed)
+  {
+    if (seeds[iseed])
     {
-      crossing = 0;
+      fitSeed(seeds[iseed], m_fitContexts[omp_get_thread_num()], outputs[iseed]);
     }
+  }
+  for (auto& output : outputs)
+  {
+    insertTracks(output);
+  }
+}
 
-    if (Verbosity() > 1)
-    {
-      if (siseed)
-      {
-        std::cout << "tpc and si id " << tpcid << ", " << siid << " silicon_crossing " << silicon_crossing
-                  << " crossing " << crossing << " crossing estimate " << crossing_estimate << std::endl;
-      }
-    }
+void PHActsTrkFitter::fitSeed(TrackSeed* track, FitContext& context, SeedFitOutput& output)
+{
+  unsigned int tpcid = track->get_tpc_seed_index();
+  unsigned int siid = track->get_silicon_seed_index();
+
+  // capture the input crossing value, and set crossing parameters
+  //==============================
+  short silicon_crossing = SHRT_MAX;
+  auto *siseed = m_siliconSeeds->get(siid);
+  if (siseed)
+  {
+    silicon_crossing = siseed->get_crossing();
+  }
+  short crossing = silicon_crossing;
+  short int crossing_estimate = crossing;
 
-    auto *tpcseed = m_tpcSeeds->get(tpcid);
+  if (m_enable_crossing_estimate)
+  {
+    crossing_estimate = track->get_crossing_estimate();  // geometric crossing estimate from matcher
+  }
+  //===============================
 
-    /// Need to also check that the tpc seed wasn't removed by the ghost finder
-    if (!tpcseed)
+  // must have silicon seed with valid crossing if we are doing a SC calibration fit
+  if (m_fitSiliconMMs)
+  {
+    if ((siid == std::numeric_limits<unsigned int>::max()) || (silicon_crossing == SHRT_MAX))
     {
-      std::cout << "no tpc seed" << std::endl;
-      continue;
+      return;
     }
+  }
 
-    if (Verbosity() > 0)
+  // do not skip TPC only tracks, just set crossing to the nominal zero
+  if (!siseed)
+  {
+    crossing = 0;
+  }
+
+  if (Verbosity() > 1)
+  {
+    if (siseed)
     {
-      if (siseed)
-      {
-        const auto si_position = TrackSeedHelper::get_xyz(siseed);
-        const auto tpc_position = TrackSeedHelper::get_xyz(tpcseed);
-        std::cout << "    silicon seed position is (x,y,z) = " << si_position.x() << "  " << si_position.y() << "  " << si_position.z() << std::endl;
-        std::cout << "    tpc seed position is (x,y,z) = " << tpc_position.x() << "  " << tpc_position.y() << "  " << tpc_position.z() << std::endl;
-      }
+      std::cout << "tpc and si id " << tpcid << ", " << siid << " silicon_crossing " << silicon_crossing
+                << " crossing " << crossing << " crossing estimate " << crossing_estimate << std::endl;
     }
+  }
 
-    PHTimer trackTimer("TrackTimer");
-    trackTimer.stop();
-    trackTimer.restart();
+  auto *tpcseed = m_tpcSeeds->get(tpcid);
 
-    if (Verbosity() > 1 && siseed)
+  /// Need to also check that the tpc seed wasn't removed by the ghost finder
+  if (!tpcseed)
+  {
+    std::cout << "no tpc seed" << std::endl;
+    return;
+  }
+
+  if (Verbosity() > 0)
+  {
+    if (siseed)
     {
-      std::cout << " m_pp_mode " << m_pp_mode << " m_enable_crossing_estimate " << m_enable_crossing_estimate
-                << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
+      const auto si_position = TrackSeedHelper::get_xyz(siseed);
+      const auto tpc_position = TrackSeedHelper::get_xyz(tpcseed);
+      std::cout << "    silicon seed position is (x,y,z) = " << si_position.x() << "  " << si_position.y() << "  " << si_position.z() << std::endl;
+      std::cout << "    tpc seed position is (x,y,z) = " << tpc_position.x() << "  " << tpc_position.y() << "  " << tpc_position.z() << std::endl;
     }
+  }
 
-    short int this_crossing = crossing;
-    bool use_estimate = false;
-    short int nvary = 0;
-    std::vector<float> chisq_ndf;
-    std::vector<SvtxTrack_v4> svtx_vec;
+  PHTimer trackTimer("TrackTimer");
+  trackTimer.stop();
+  trackTimer.restart();
 
-    if (m_pp_mode)
+  if (Verbosity() > 1 && siseed)
+  {
+    std::cout << " m_pp_mode " << m_pp_mode << " m_enable_crossing_estimate " << m_enable_crossing_estimate
+              << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
+  }
+
+  short int this_crossing = crossing;
+  bool use_estimate = false;
+  short int nvary = 0;
+  std::vector<float> chisq_ndf;
+  std::vector<SvtxTrack_v4> svtx_vec;
+
+  if (m_pp_mode)
+  {
+    if (m_enable_crossing_estimate && crossing == SHRT_MAX)
     {
-      if (m_enable_crossing_estimate && crossing == SHRT_MAX)
-      {
-        // this only happens if there is a silicon seed but no assigned INTT crossing, and only in pp_mode
-        // If there is no INTT crossing, start with the crossing_estimate value, vary up and down, fit, and choose the best chisq/ndf
-        use_estimate = true;
-        nvary = max_bunch_search;
-        if (Verbosity() > 1)
-        {
-          std::cout << " No INTT crossing: use crossing_estimate " << crossing_estimate << " with nvary " << nvary << std::endl;
-        }
-      }
-      else
+      // this only happens if there is a silicon seed but no assigned INTT crossing, and only in pp_mode
+      // If there is no INTT crossing, start with the crossing_estimate value, vary up and down, fit, and choose the best chisq/ndf
+      use_estimate = true;
+      nvary = max_bunch_search;
+      if (Verbosity() > 1)
       {
-        // use INTT crossing
-        crossing_estimate = crossing;
+        std::cout << " No INTT crossing: use crossing_estimate " << crossing_estimate << " with nvary " << nvary << std::endl;
       }
     }
     else
     {
-      // non pp mode, we want only crossing zero, veto others
-      if (siseed && silicon_crossing != 0)
-      {
-        crossing = 0;
-        // continue;
-      }
+      // use INTT crossing
       crossing_estimate = crossing;
     }
+  }
+  else
+  {
+    // non pp mode, we want only crossing zero, veto others
+    if (siseed && silicon_crossing != 0)
+    {
+      crossing = 0;
+      // return;
+    }
+    crossing_estimate = crossing;
+  }
 
-    // Fit this track assuming either:
-    //    crossing = INTT value, if it exists (uses nvary = 0)
-    //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists and m_enable_crossing_estimate flag is set.
+  // Fit this track assuming either:
+  //    crossing = INTT value, if it exists (uses nvary = 0)
+  //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists and m_enable_crossing_estimate flag is set.
 
-    for (short int ivary = -nvary; ivary <= nvary; ++ivary)
-    {
-      this_crossing = crossing_estimate + ivary;
+  for (short int ivary = -nvary; ivary <= nvary; ++ivary)
+  {
+    this_crossing = crossing_estimate + ivary;
 
-      if (Verbosity() > 1)
-      {
-        std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
-      }
+    if (Verbosity() > 1)
+    {
+      std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
+    }
 
-      ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
 
-      SourceLinkVec sourceLinks;
+    SourceLinkVec sourceLinks;
 
-      MakeSourceLinks makeSourceLinks;
-      makeSourceLinks.initialize(_tpccellgeo);
-      makeSourceLinks.setVerbosity(Verbosity());
-      makeSourceLinks.set_pp_mode(m_pp_mode);
-      makeSourceLinks.set_cluster_edge_rejection(m_cluster_edge_rejection);
-      for (const auto& layer : m_ignoreLayer)
-      {
-        makeSourceLinks.ignoreLayer(layer);
-      }
-      // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
-      // does nothing if m_transient_id_set is empty
-      makeSourceLinks.resetTransientTransformMap(
-          m_alignmentTransformationMapTransient,
-          m_transient_id_set,
-          m_tGeometry);
-
-      if (m_use_clustermover)
+    MakeSourceLinks makeSourceLinks;
+    makeSourceLinks.initialize(_tpccellgeo);
+    makeSourceLinks.setVerbosity(Verbosity());
+    makeSourceLinks.set_pp_mode(m_pp_mode);
+    makeSourceLinks.set_cluster_edge_rejection(m_cluster_edge_rejection);
+    for (const auto& layer : m_ignoreLayer)
+    {
+      makeSourceLinks.ignoreLayer(layer);
+    }
+    // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
+    // does nothing if the transient id set is empty
+    makeSourceLinks.resetTransientTransformMap(
+        context.transientMap,
+        context.transientIds,
+        m_tGeometry);
+
+    if (m_use_clustermover)
+    {
+      // make source links using cluster mover after making distortion correction
+      if (siseed && !m_ignoreSilicon)
       {
-        // make source links using cluster mover after making distortion correction
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-              siseed,
-              measurements,
-              m_clusterContainer,
-              m_tGeometry,
-              m_globalPositionWrapper,
-              this_crossing);
-        }
-
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-            tpcseed,
+        // silicon source links
+        sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+            siseed,
             measurements,
             m_clusterContainer,
             m_tGeometry,
             m_globalPositionWrapper,
             this_crossing);
-
-        // add tpc sourcelinks to silicon source links
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
       }
-      else
-      {
-        // make source links using transient transforms for distortion corrections
-        if (Verbosity() > 1)
-        {
-          std::cout << "Calling getSourceLinks for si seed, siid " << siid << " and tpcid " << tpcid << std::endl;
-        }
 
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinks(
-              siseed,
-              measurements,
-              m_clusterContainer,
-              m_tGeometry,
-              m_globalPositionWrapper,
-              m_alignmentTransformationMapTransient,
-              m_transient_id_set,
-              this_crossing);
-        }
-
-        if (Verbosity() > 1)
-        {
-          std::cout << "Calling getSourceLinks for tpc seed, siid " << siid << " and tpcid " << tpcid << std::endl;
-        }
+      // tpc source links
+      const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+          tpcseed,
+          measurements,
+          m_clusterContainer,
+          m_tGeometry,
+          m_globalPositionWrapper,
+          this_crossing);
+
+      // add tpc sourcelinks to silicon source links
+      sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+    }
+    else
+    {
+      // make source links using transient transforms for distortion corrections
+      if (Verbosity() > 1)
+      {
+        std::cout << "Calling getSourceLinks for si seed, siid " << siid << " and tpcid " << tpcid << std::endl;
+      }
 
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
-            tpcseed,
+      if (siseed && !m_ignoreSilicon)
+      {
+        // silicon source links
+        sourceLinks = makeSourceLinks.getSourceLinks(
+            siseed,
             measurements,
             m_clusterContainer,
             m_tGeometry,
             m_globalPositionWrapper,
-            m_alignmentTransformationMapTransient,
-            m_transient_id_set,
+            context.transientMap,
+            context.transientIds,
             this_crossing);
-
-        // add tpc sourcelinks to silicon source links
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
       }
 
-      // copy transient map for this track into transient geoContext
-      m_transient_geocontext = m_alignmentTransformationMapTransient;
-
-      // position comes from the silicon seed, unless there is no silicon seed
-      Acts::Vector3 position(0, 0, 0);
-      if (siseed)
-      {
-        position = TrackSeedHelper::get_xyz(siseed) * Acts::UnitConstants::cm;
-      }
-      if (!siseed || !is_valid(position) || m_ignoreSilicon)
+      if (Verbosity() > 1)
       {
-        position = TrackSeedHelper::get_xyz(tpcseed) * Acts::UnitConstants::cm;
+        std::cout << "Calling getSourceLinks for tpc seed, siid " << siid << " and tpcid " << tpcid << std::endl;
       }
-      if (!is_valid(position))
+
+      // tpc source links
+      const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
+          tpcseed,
+          measurements,
+          m_clusterContainer,
+          m_tGeometry,
+          m_globalPositionWrapper,
+          context.transientMap,
+          context.transientIds,
+          this_crossing);
+
+      // add tpc sourcelinks to silicon source links
+      sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+    }
+
+    // position comes from the silicon seed, unless there is no silicon seed
+    Acts::Vector3 position(0, 0, 0);
+    if (siseed)
+    {
+      position = TrackSeedHelper::get_xyz(siseed) * Acts::UnitConstants::cm;
+    }
+    if (!siseed || !is_valid(position) || m_ignoreSilicon)
+    {
+      position = TrackSeedHelper::get_xyz(tpcseed) * Acts::UnitConstants::cm;
+    }
+    if (!is_valid(position))
+    {
+      if (Verbosity() > 4)
       {
-        if (Verbosity() > 4)
-        {
-          std::cout << "Invalid position of " << position.transpose() << std::endl;
-        }
-        continue;
+        std::cout << "Invalid position of " << position.transpose() << std::endl;
       }
+      continue;
+    }
+
+    // filter sourcelinks to remove detectors that we don't want to include in the fit
+    sourceLinks = filterSourceLinks( sourceLinks );
+
+    if (sourceLinks.empty())
+    {
+      continue;
+    }
+
+    /// If using directed navigation, collect surface list to navigate
+    SurfacePtrVec surfaces;
+    if (m_fitSiliconMMs || m_directNavigation)
+    {
 
-      // filter sourcelinks to remove detectors that we don't want to include in the fit
-      sourceLinks = filterSourceLinks( sourceLinks );
+      // get surfaces matching source links
+      const auto surfaces_tmp = getSurfaceVector(sourceLinks);
 
-      if (sourceLinks.empty())
+      // skip if there is no surfaces
+      if (surfaces_tmp.empty())
       {
         continue;
       }
 
-      /// If using directed navigation, collect surface list to navigate
-      SurfacePtrVec surfaces;
-      if (m_fitSiliconMMs || m_directNavigation)
+      for (const auto& surface_apr : m_materialSurfaces)
       {
-
-        // get surfaces matching source links
-        const auto surfaces_tmp = getSurfaceVector(sourceLinks);
-
-        // skip if there is no surfaces
-        if (surfaces_tmp.empty())
+        if (m_forceSiOnlyFit)
         {
-          continue;
+          if (surface_apr->geometryId().volume() > 12)
+          {
+            continue;
+          }
         }
-
-        for (const auto& surface_apr : m_materialSurfaces)
+        bool pop_flag = false;
+        if (surface_apr->geometryId().approach() == 1)
+        {
+          surfaces.push_back(surface_apr);
+        }
+        else
         {
-          if (m_forceSiOnlyFit)
+          pop_flag = true;
+          for (const auto& surface_sns : surfaces_tmp)
           {
-            if (surface_apr->geometryId().volume() > 12)
+            if (surface_apr->geometryId().volume() == surface_sns->geometryId().volume())
             {
-              continue;
+              if (surface_apr->geometryId().layer() == surface_sns->geometryId().layer())
+              {
+                pop_flag = false;
+                surfaces.push_back(surface_sns);
+              }
             }
           }
-          bool pop_flag = false;
-          if (surface_apr->geometryId().approach() == 1)
+          if (!pop_flag)
           {
             surfaces.push_back(surface_apr);
           }
           else
           {
-            pop_flag = true;
+            surfaces.pop_back();
+            pop_flag = false;
+          }
+          if (surface_apr->geometryId().volume() == 12 && surface_apr->geometryId().layer() == 8)
+          {
             for (const auto& surface_sns : surfaces_tmp)
             {
-              if (surface_apr->geometryId().volume() == surface_sns->geometryId().volume())
-              {
-                if (surface_apr->geometryId().layer() == surface_sns->geometryId().layer())
-                {
-                  pop_flag = false;
-                  surfaces.push_back(surface_sns);
-                }
-              }
-            }
-            if (!pop_flag)
-            {
-              surfaces.push_back(surface_apr);
-            }
-            else
-            {
-              surfaces.pop_back();
-              pop_flag = false;
-            }
-            if (surface_apr->geometryId().volume() == 12 && surface_apr->geometryId().layer() == 8)
-            {
-              for (const auto& surface_sns : surfaces_tmp)
+              if (14 == surface_sns->geometryId().volume())
               {
-                if (14 == surface_sns->geometryId().volume())
-                {
-                  surfaces.push_back(surface_sns);
-                }
+                surfaces.push_back(surface_sns);
               }
             }
           }
         }
-        checkSurfaceVec(surfaces);
-        if (Verbosity() > 1)
+      }
+      checkSurfaceVec(surfaces);
+      if (Verbosity() > 1)
+      {
+        for (const auto& surf : surfaces)
         {
-          for (const auto& surf : surfaces)
-          {
-            std::cout << "Surface vector : " << surf->geometryId() << std::endl;
-          }
+          std::cout << "Surface vector : " << surf->geometryId() << std::endl;
         }
+      }
 
-        if (m_fitSiliconMMs)
+      if (m_fitSiliconMMs)
+      {
+        // make sure micromegas are in the tracks, if required
+        if (m_useMicromegas &&
+            std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
+                         { return m_tGeometry->maps().isMicromegasSurface(surface); }))
         {
-          // make sure micromegas are in the tracks, if required
-          if (m_useMicromegas &&
-              std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
-                           { return m_tGeometry->maps().isMicromegasSurface(surface); }))
-          {
-            continue;
-          }
+          continue;
         }
       }
+    }
 
-      float px = std::numeric_limits<float>::quiet_NaN();
-      float py = std::numeric_limits<float>::quiet_NaN();
-      float pz = std::numeric_limits<float>::quiet_NaN();
+    float px = std::numeric_limits<float>::quiet_NaN();
+    float py = std::numeric_limits<float>::quiet_NaN();
+    float pz = std::numeric_limits<float>::quiet_NaN();
 
-      // get phi and theta from the silicon seed, momentum from the TPC seed
-      float seedphi = 0;
-      float seedtheta = 0;
-      float seedeta = 0;
-      if (siseed)
-      {
-        seedphi = siseed->get_phi();
-        seedtheta = siseed->get_theta();
-        seedeta = siseed->get_eta();
-      }
-      else
-      {
-        seedphi = tpcseed->get_phi();
-        seedtheta = tpcseed->get_theta();
-        seedeta = tpcseed->get_eta();
-      }
+    // get phi and theta from the silicon seed, momentum from the TPC seed
+    float seedphi = 0;
+    float seedtheta = 0;
+    float seedeta = 0;
+    if (siseed)
+    {
+      seedphi = siseed->get_phi();
+      seedtheta = siseed->get_theta();
+      seedeta = siseed->get_eta();
+    }
+    else
+    {
+      seedphi = tpcseed->get_phi();
+      seedtheta = tpcseed->get_theta();
+      seedeta = tpcseed->get_eta();
+    }
 
-      float seedpt = tpcseed->get_pt();
+    float seedpt = tpcseed->get_pt();
 
-      if (m_ConstField)
-      {
-        float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
-        float phi = seedphi;
-        float eta = seedeta;
-        float theta = seedtheta;
-        px = pt * std::cos(phi);
-        py = pt * std::sin(phi);
-        pz = pt * std::cosh(eta) * std::cos(theta);
-      }
-      else
-      {
-        px = seedpt * std::cos(seedphi);
-        py = seedpt * std::sin(seedphi);
-        pz = seedpt * std::cosh(seedeta) * std::cos(seedtheta);
-      }
+    if (m_ConstField)
+    {
+      float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
+      float phi = seedphi;
+      float eta = seedeta;
+      float theta = seedtheta;
+      px = pt * std::cos(phi);
+      py = pt * std::sin(phi);
+      pz = pt * std::cosh(eta) * std::cos(theta);
+    }
+    else
+    {
+      px = seedpt * std::cos(seedphi);
+      py = seedpt * std::sin(seedphi);
+      pz = seedpt * std::cosh(seedeta) * std::cos(seedtheta);
+    }
 
-      Acts::Vector3 momentum(px, py, pz);
-      if (!is_valid(momentum))
+    Acts::Vector3 momentum(px, py, pz);
+    if (!is_valid(momentum))
+    {
+      if (Verbosity() > 4)
       {
-        if (Verbosity() > 4)
-        {
-          std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
-        }
-        continue;
+        std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
       }
+      continue;
+    }
 
-      auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(position);
+    auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(position);
 
-      Acts::Vector4 actsFourPos(position(0), position(1), position(2), 10 * Acts::UnitConstants::ns);
-      Acts::BoundSquareMatrix cov = setDefaultCovariance();
+    Acts::Vector4 actsFourPos(position(0), position(1), position(2), 10 * Acts::UnitConstants::ns);
+    Acts::BoundSquareMatrix cov = setDefaultCovariance();
 
-      int charge = tpcseed->get_charge();
+    int charge = tpcseed->get_charge();
 
-      /// Reset the track seed with the dummy covariance
-      auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
-                      pSurface,
-                      m_transient_geocontext,
-                      actsFourPos,
-                      momentum,
-                      charge / momentum.norm(),
-                      cov,
-                      Acts::ParticleHypothesis::pion())
-                      .value();
+    /// Reset the track seed with the dummy covariance
+    auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
+                    pSurface,
+                    context.geocontext,
+                    actsFourPos,
+                    momentum,
+                    charge / momentum.norm(),
+                    cov,
+                    Acts::ParticleHypothesis::pion())
+                    .value();
 
-      if (Verbosity() > 2)
-      {
-        printTrackSeed(seed);
-      }
+    if (Verbosity() > 2)
+    {
+      printTrackSeed(seed, context.geocontext);
+    }
 
-      /// Set host of propagator options for Acts to do e.g. material integration
-      Acts::PropagatorPlainOptions ppPlainOptions;
+    /// Set host of propagator options for Acts to do e.g. material integration
+    Acts::PropagatorPlainOptions ppPlainOptions;
 
-      auto calibptr = std::make_unique<Calibrator>();
-      CalibratorAdapter calibrator{*calibptr, measurements};
+    auto calibptr = std::make_unique<Calibrator>();
+    CalibratorAdapter calibrator{*calibptr, measurements};
 
-      auto magcontext = m_tGeometry->geometry().magFieldContext;
-      auto calibcontext = m_tGeometry->geometry().calibContext;
+    auto magcontext = m_tGeometry->geometry().magFieldContext;
+    auto calibcontext = m_tGeometry->geometry().calibContext;
 
-      ActsTrackFittingAlgorithm::GeneralFitterOptions
-          kfOptions{
-              m_transient_geocontext,
-              magcontext,
-              calibcontext,
-              pSurface.get(),
-              ppPlainOptions};
+    ActsTrackFittingAlgorithm::GeneralFitterOptions
+        kfOptions{
+            context.geocontext,
+            magcontext,
+            calibcontext,
+            pSurface.get(),
+            ppPlainOptions};
 
-      PHTimer fitTimer("FitTimer");
-      fitTimer.stop();
-      fitTimer.restart();
+    PHTimer fitTimer("FitTimer");
+    fitTimer.stop();
+    fitTimer.restart();
 
-      auto trackContainer = std::make_shared<Acts::VectorTrackContainer>();
-      auto trackStateContainer = std::make_shared<Acts::VectorMultiTrajectory>();
-      ActsTrackFittingAlgorithm::TrackContainer tracks(trackContainer, trackStateContainer);
+    auto trackContainer = std::make_shared<Acts::VectorTrackContainer>();
+    auto trackStateContainer = std::make_shared<Acts::VectorMultiTrajectory>();
+    ActsTrackFittingAlgorithm::TrackContainer tracks(trackContainer, trackStateContainer);
 
-      if (Verbosity() > 1)
-      {
-        std::cout << "Calling fitTrack for track with siid " << siid << " tpcid " << tpcid << " crossing " << crossing << std::endl;
-      }
+    if (Verbosity() > 1)
+    {
+      std::cout << "Calling fitTrack for track with siid " << siid << " tpcid " << tpcid << " crossing " << crossing << std::endl;
+    }
 
-      auto result = fitTrack(sourceLinks, seed, kfOptions, surfaces, calibrator, tracks);
-      fitTimer.stop();
+    auto result = fitTrack(sourceLinks, seed, kfOptions, surfaces, calibrator, tracks);
+    fitTimer.stop();
 
-      if (Verbosity() > 1)
-      {
-        const auto fitTime = fitTimer.get_accumulated_time();
-        std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
-      }
+    if (Verbosity() > 1)
+    {
+      const auto fitTime = fitTimer.get_accumulated_time();
+      std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
+    }
 
-      /// Check that the track fit result did not return an error
-      if (result.ok())
+    /// Check that the track fit result did not return an error
+    if (result.ok())
+    {
+      if (use_estimate)  // trial variation case
       {
-        if (use_estimate)  // trial variation case
-        {
-          // this is a trial variation of the crossing estimate for this track
-          // Capture the chisq/ndf so we can choose the best one after all trials
+        // this is a trial variation of the crossing estimate for this track
+        // Capture the chisq/ndf so we can choose the best one after all trials
 
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
+        SvtxTrack_v4 newTrack;
+        newTrack.set_tpc_seed(tpcseed);
+        newTrack.set_crossing(this_crossing);
+        newTrack.set_silicon_seed(siseed);
 
-          if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
+        if (getTrackFitResult(result, track, &newTrack, tracks, measurements, context.geocontext))
+        {
+          float chi2ndf = newTrack.get_quality();
+          chisq_ndf.push_back(chi2ndf);
+          svtx_vec.push_back(newTrack);
+          if (Verbosity() > 1)
           {
-            float chi2ndf = newTrack.get_quality();
-            chisq_ndf.push_back(chi2ndf);
-            svtx_vec.push_back(newTrack);
-            if (Verbosity() > 1)
-            {
-              std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
-            }
+            std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
           }
+        }
 
-          if (ivary != nvary)
+        if (ivary != nvary)
+        {
+          if (Verbosity() > 3)
           {
-            if (Verbosity() > 3)
-            {
-              std::cout << "Skipping track fit for trial variation" << std::endl;
-            }
-            continue;
+            std::cout << "Skipping track fit for trial variation" << std::endl;
           }
+          continue;
+        }
 
-          // if we are here this is the last crossing iteration, evaluate the results
-          if (Verbosity() > 1)
+        // if we are here this is the last crossing iteration, evaluate the results
+        if (Verbosity() > 1)
+        {
+          std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
+        }
+        float best_chisq = 1000.0;
+        short int best_ivary = 0;
+        for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
+        {
+          if (chisq_ndf[i] < best_chisq)
           {
-            std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
+            best_chisq = chisq_ndf[i];
+            best_ivary = i;
           }
-          float best_chisq = 1000.0;
-          short int best_ivary = 0;
-          for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
+          if (Verbosity() > 1)
           {
-            if (chisq_ndf[i] < best_chisq)
-            {
-              best_chisq = chisq_ndf[i];
-              best_ivary = i;
-            }
-            if (Verbosity() > 1)
-            {
-              std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
-            }
+            std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
           }
-          unsigned int trid = m_trackMap->size();
-          svtx_vec[best_ivary].set_id(trid);
-
-          m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
         }
-        else  // case where INTT crossing is known
+        output.tracks.emplace_back(false, svtx_vec[best_ivary]);
+      }
+      else  // case where INTT crossing is known
+      {
+        SvtxTrack_v4 newTrack;
+        newTrack.set_tpc_seed(tpcseed);
+        newTrack.set_crossing(this_crossing);
+        newTrack.set_silicon_seed(siseed);
+
+        if (m_fitSiliconMMs)
         {
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
+          // provisional id, the final one is set when the track is inserted
+          unsigned int trid = m_directedTrackMap->size();
+          newTrack.set_id(trid);
 
-          if (m_fitSiliconMMs)
+          if (getTrackFitResult(result, track, &newTrack, tracks, measurements, context.geocontext))
           {
-            unsigned int trid = m_directedTrackMap->size();
-            newTrack.set_id(trid);
+            // insert in dedicated map
+            output.tracks.emplace_back(true, newTrack);
+          }
 
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              // insert in dedicated map
-              m_directedTrackMap->insertWithKey(&newTrack, trid);
-            }
+        }  // end insert track for SC calib fit
+        else
+        {
+          // provisional id, the final one is set when the track is inserted
+          unsigned int trid = m_trackMap->size();
+          newTrack.set_id(trid);
 
-          }  // end insert track for SC calib fit
-          else
+          if (getTrackFitResult(result, track, &newTrack, tracks, measurements, context.geocontext))
           {
-            unsigned int trid = m_trackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_trackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for normal fit
-        }  // end case where INTT crossing is known
-      }
-      else if (!m_fitSiliconMMs)
+            output.tracks.emplace_back(false, newTrack);
+          }
+        }  // end insert track for normal fit
+      }  // end case where INTT crossing is known
+    }
+    else if (!m_fitSiliconMMs)
+    {
+      /// Track fit failed, get rid of the track from the map
+      output.nBadFits++;
+      if (Verbosity() > 1)
       {
-        /// Track fit failed, get rid of the track from the map
-        m_nBadFits++;
-        if (Verbosity() > 1)
-        {
-          std::cout << "Track fit failed for track " << m_seedMap->find(track)
-                    << " with Acts error message "
-                    << result.error() << ", " << result.error().message()
-                    << std::endl;
-        }
-      }  // end fit failed case
-    }  // end ivary loop
+        std::cout << "Track fit failed for track " << m_seedMap->find(track)
+                  << " with Acts error message "
+                  << result.error() << ", " << result.error().message()
+                  << std::endl;
+      }
+    }  // end fit failed case
+  }  // end ivary loop
 
-    trackTimer.stop();
-    auto trackTime = trackTimer.get_accumulated_time();
+  trackTimer.stop();
+  auto trackTime = trackTimer.get_accumulated_time();
 
-    if (Verbosity() > 1)
-    {
-      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
-    }
+  if (Verbosity() > 1)
+  {
+    std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
   }
+}
 
-  return;
+void PHActsTrkFitter::insertTracks(SeedFitOutput& output)
+{
+  for (auto& [directed, track] : output.tracks)
+  {
+    SvtxTrackMap* trackmap = directed ? m_directedTrackMap : m_trackMap;
+    unsigned int trid = trackmap->size();
+    track.set_id(trid);
+    trackmap->insertWithKey(&track, trid);
+  }
+  m_nBadFits += output.nBadFits;
+}
+
+void PHActsTrkFitter::setupFitContexts()
+{
+  const unsigned int nthreads = useThreads() ? m_num_threads : 1;
+  // the first context works directly on the transient transforms of the node tree
+  if (m_fitContexts.empty())
+  {
+    m_fitContexts.resize(1);
+  }
+  m_fitContexts.front().transientMap = m_alignmentTransformationMapTransient;
+  m_fitContexts.front().geocontext = m_alignmentTransformationMapTransient;
+  // the others on copies made once per run, which start with the same modified set
+  while (m_fitContexts.size() < nthreads)
+  {
+    m_transientMapCopies.push_back(std::make_unique<alignmentTransformationContainer>(*m_alignmentTransformationMapTransient));
+    FitContext context;
+    context.transientMap = m_transientMapCopies.back().get();
+    context.transientIds = m_fitContexts.front().transientIds;
+    context.geocontext = context.transientMap;
+    m_fitContexts.push_back(std::move(context));
+  }
 }
 
 bool PHActsTrkFitter::getTrackFitResult(
     const FitResult& fitOutput,
     TrackSeed* seed, SvtxTrack* track,
     const ActsTrackFittingAlgorithm::TrackContainer& tracks,
-    const ActsTrackFittingAlgorithm::MeasurementContainer& measurements)
+    const ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
+    const Acts::GeometryContext& geocontext)
 {
   /// Make a trajectory state for storage, which conforms to Acts track fit
   /// analysis tool
@@ -889,7 +970,7 @@ bool PHActsTrkFitter::getTrackFitResult(
     if (Verbosity() > 2)
     {
       std::cout << "Fitted parameters for track" << std::endl;
-      std::cout << " position : " << outtrack.referenceSurface().localToGlobal(m_transient_geocontext, Acts::Vector2(outtrack.loc0(), outtrack.loc1()), Acts::Vector3(1, 1, 1)).transpose()
+      std::cout << " position : " << outtrack.referenceSurface().localToGlobal(geocontext, Acts::Vector2(outtrack.loc0(), outtrack.loc1()), Acts::Vector3(1, 1, 1)).transpose()
 
                 << std::endl;
       int otcharge = outtrack.qOverP() > 0 ? 1 : -1;
@@ -904,7 +985,7 @@ bool PHActsTrkFitter::getTrackFitResult(
     PHTimer updateTrackTimer("UpdateTrackTimer");
     updateTrackTimer.stop();
     updateTrackTimer.restart();
-    updateSvtxTrack(trackTips, indexedParams, tracks, track);
+    updateSvtxTrack(trackTips, indexedParams, tracks, track, geocontext);
 
     if (m_commissioning)
     {
@@ -1057,7 +1138,8 @@ void PHActsTrkFitter::updateSvtxTrack(
     const std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
     const Trajectory::IndexedParameters& paramsMap,
     const ActsTrackFittingAlgorithm::TrackContainer& tracks,
-    SvtxTrack* track)
+    SvtxTrack* track,
+    const Acts::GeometryContext& geocontext)
 {
   const auto& mj = tracks.trackStateContainer();
 
@@ -1093,9 +1175,9 @@ void PHActsTrkFitter::updateSvtxTrack(
   const auto& params = paramsMap.find(trackTip)->second;
 
   /// Acts default unit is mm. So convert to cm
-  track->set_x(params.position(m_transient_geocontext)(0) / Acts::UnitConstants::cm);
-  track->set_y(params.position(m_transient_geocontext)(1) / Acts::UnitConstants::cm);
-  track->set_z(params.position(m_transient_geocontext)(2) / Acts::UnitConstants::cm);
+  track->set_x(params.position(geocontext)(0) / Acts::UnitConstants::cm);
+  track->set_y(params.position(geocontext)(1) / Acts::UnitConstants::cm);
+  track->set_z(params.position(geocontext)(2) / Acts::UnitConstants::cm);
 
   track->set_px(params.momentum()(0));
   track->set_py(params.momentum()(1));
@@ -1129,7 +1211,7 @@ void PHActsTrkFitter::updateSvtxTrack(
 
   if (m_fillSvtxTrackStates)
   {
-    transformer.fillSvtxTrackStates(mj, trackTip, track, m_transient_geocontext);
+    transformer.fillSvtxTrackStates(mj, trackTip, track, geocontext);
   }
 
   // in using silicon mm fit also extrapolate track parameters to all TPC surfaces with clusters
@@ -1165,7 +1247,7 @@ void PHActsTrkFitter::updateSvtxTrack(
       pathLength /= Acts::UnitConstants::cm;
 
       // create track state and add to track
-      transformer.addTrackState(track, cluskey, pathLength, trackStateParams, m_transient_geocontext);
+      transformer.addTrackState(track, cluskey, pathLength, trackStateParams, geocontext);
     }
   }
 
@@ -1200,7 +1282,7 @@ void PHActsTrkFitter::updateSvtxTrack(
       pathLength /= Acts::UnitConstants::cm;
 
       // create track state and add to track
-      transformer.addTrackState(track, cluskey, pathLength, trackStateParams, m_transient_geocontext);
+      transformer.addTrackState(track, cluskey, pathLength, trackStateParams, geocontext);
     }
   }
 
@@ -1274,7 +1356,7 @@ Acts::BoundSquareMatrix PHActsTrkFitter::setDefaultCovariance() const
   return cov;
 }
 
-void PHActsTrkFitter::printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed) const
+void PHActsTrkFitter::printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed, const Acts::GeometryContext& geocontext) const
 {
   std::cout
       << PHWHERE
@@ -1282,7 +1364,7 @@ void PHActsTrkFitter::printTrackSeed(const ActsTrackFittingAlgorithm::TrackParam
       << std::endl;
 
   std::cout
-      << "position: " << seed.position(m_transient_geocontext).transpose()
+      << "position: " << seed.position(geocontext).transpose()
       << std::endl
       << "momentum: " << seed.momentum().transpose()
       << std::endl;
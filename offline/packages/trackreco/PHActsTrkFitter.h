@@ -15,9 +15,12 @@
 
 #include <trackbase/ActsSourceLink.h>
 #include <trackbase/ActsTrackFittingAlgorithm.h>
+#include <trackbase/alignmentTransformationContainer.h>
 
 #include <tpc/TpcGlobalPositionWrapper.h>
 
+#include <trackbase_historic/SvtxTrack_v4.h>
+
 #include <Acts/Definitions/Algebra.hpp>
 #include <Acts/EventData/VectorMultiTrajectory.hpp>
 #include <Acts/Utilities/BinnedArray.hpp>
@@ -29,10 +32,13 @@
 #include <TFile.h>
 #include <TH1.h>
 #include <TH2.h>
+
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
-class alignmentTransformationContainer;
 class ActsGeometry;
 class SvtxTrack;
 class SvtxTrackMap;
@@ -145,7 +151,28 @@ class PHActsTrkFitter : public SubsysReco
   void setTrkrClusterContainerName(const std::string& name) { m_clusterContainerName = name; }
   void setDirectNavigation(bool flag) { m_directNavigation = flag; }
   void setClusterEdgeRejection(int edge ) { m_cluster_edge_rejection = edge; }
+
+  /// fit the seeds on n threads (OpenMP). Not available together with the
+  /// evaluator, commissioning, time analysis or the outlier finder
+  void set_num_threads(int n) { m_num_threads = n; }
+
  private:
+  /// state of one fitting thread: the transient transforms it modifies with
+  /// the distortion corrections of the track being fitted
+  struct FitContext
+  {
+    alignmentTransformationContainer* transientMap = nullptr;
+    std::set<Acts::GeometryIdentifier> transientIds;
+    Acts::GeometryContext geocontext;
+  };
+
+  /// tracks fitted from one seed, inserted into the maps in seed order
+  struct SeedFitOutput
+  {
+    std::vector<std::pair<bool, SvtxTrack_v4>> tracks;  // (directed map, track)
+    int nBadFits = 0;
+  };
+
   /// Get all the nodes
   int getNodes(PHCompositeNode* topNode);
 
@@ -154,12 +181,27 @@ class PHActsTrkFitter : public SubsysReco
 
   void loopTracks(Acts::Logging::Level logLevel);
 
+  /// fit one seed, trying all crossings if needed
+  void fitSeed(TrackSeed* track, FitContext& context, SeedFitOutput& output);
+
+  /// insert the fitted tracks of one seed, assigning their ids
+  void insertTracks(SeedFitOutput& output);
+
+  /// make sure there is one fit context per thread
+  void setupFitContexts();
+
+  bool useThreads() const
+  {
+    return m_num_threads > 1 && !m_actsEvaluator && !m_commissioning && !m_timeAnalysis && !m_useOutlierFinder;
+  }
+
   /// Convert the acts track fit result to an svtx track
   void updateSvtxTrack(
       const std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
       const Trajectory::IndexedParameters& paramsMap,
       const ActsTrackFittingAlgorithm::TrackContainer& tracks,
-      SvtxTrack* track);
+      SvtxTrack* track,
+      const Acts::GeometryContext& geocontext);
 
   /// Helper function to call either the regular navigation or direct
   /// navigation, depending on m_fitSiliconMMs
@@ -183,10 +225,11 @@ class PHActsTrkFitter : public SubsysReco
   bool getTrackFitResult(const FitResult& fitOutput, TrackSeed* seed,
                          SvtxTrack* track,
                          const ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                         const ActsTrackFittingAlgorithm::MeasurementContainer& measurements);
+                         const ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
+                         const Acts::GeometryContext& geocontext);
 
   Acts::BoundSquareMatrix setDefaultCovariance() const;
-  void printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed) const;
+  void printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed, const Acts::GeometryContext& geocontext) const;
 
   /// Event counter
   int m_event = 0;
@@ -200,8 +243,6 @@ class PHActsTrkFitter : public SubsysReco
   /// TrackMap containing SvtxTracks
   alignmentTransformationContainer* m_alignmentTransformationMap = nullptr;  // added for testing purposes
   alignmentTransformationContainer* m_alignmentTransformationMapTransient = nullptr;
-  std::set<Acts::GeometryIdentifier> m_transient_id_set;
-  Acts::GeometryContext m_transient_geocontext;
   SvtxTrackMap* m_trackMap = nullptr;
   SvtxTrackMap* m_directedTrackMap = nullptr;
   TrkrClusterContainer* m_clusterContainer = nullptr;
@@ -285,6 +326,12 @@ class PHActsTrkFitter : public SubsysReco
 
   PHG4TpcGeomContainer* _tpccellgeo = nullptr;
 
+  /// number of fitting threads and their contexts, the first one uses the
+  /// transient transforms of the node tree, the others copies of them
+  int m_num_threads = 1;
+  std::vector<FitContext> m_fitContexts;
+  std::vector<std::unique_ptr<alignmentTransformationContainer>> m_transientMapCopies;
+
   /// Variables for doing event time execution analysis
   bool m_timeAnalysis = false;
   TFile* m_timeFile = nullptr;
@@ -13,11 +13,101 @@
 #include <trackbase_historic/TrackSeedContainer.h>
 #include <trackbase_historic/TrackSeedHelper.h>
 
-#include <cmath>     // for sqrt, fabs, atan2, cos
-#include <iostream>  // for operator<<, basic_ostream
-#include <map>       // for map
-#include <set>       // for _Rb_tree_const_iterator
-#include <utility>   // for pair, make_pair
+#include <algorithm>      // for sort, unique, upper_bound, clamp
+#include <cmath>          // for sqrt, fabs, atan2, cos
+#include <cstdint>
+#include <iostream>       // for operator<<, basic_ostream
+#include <limits>
+#include <unordered_map>
+#include <utility>        // for pair, make_pair
+#include <vector>
+
+namespace
+{
+  // seeds hashed by (phi, eta) cell. Cells are a bit larger than the cuts so
+  // that rounding cannot push a matching pair more than one cell apart.
+  // Cells one turn (2 pi) away in phi are searched as well, which covers the
+  // wrap-around of the phi difference
+  class SeedBuckets
+  {
+   public:
+    SeedBuckets(double phi_cut, double eta_cut)
+      : m_phi_cell(cell_size(phi_cut))
+      , m_eta_cell(cell_size(eta_cut))
+    {
+    }
+
+    void insert(float phi, float eta, unsigned int index)
+    {
+      if (std::isfinite(phi) && std::isfinite(eta))
+      {
+        m_cells[key(cell(phi, m_phi_cell), cell(eta, m_eta_cell))].push_back(index);
+      }
+    }
+
+    // indices > index in the cells around (phi, eta), sorted and unique
+    void candidates(float phi, float eta, unsigned int index, std::vector<unsigned int>& out) const
+    {
+      out.clear();
+      if (!std::isfinite(phi) || !std::isfinite(eta))
+      {
+        return;
+      }
+      const int64_t ieta = cell(eta, m_eta_cell);
+      for (const double shift : {0., -2 * M_PI, 2 * M_PI})
+      {
+        const int64_t iphi = cell(phi + shift, m_phi_cell);
+        for (int64_t dphi = -1; dphi <= 1; ++dphi)
+        {
+          for (int64_t deta = -1; deta <= 1; ++deta)
+          {
+            auto iter = m_cells.find(key(iphi + dphi, ieta + deta));
+            if (iter == m_cells.end())
+            {
+              continue;
+            }
+            // cells are filled in index order
+            auto first = std::upper_bound(iter->second.begin(), iter->second.end(), index);
+            out.insert(out.end(), first, iter->second.end());
+          }
+        }
+      }
+      std::sort(out.begin(), out.end());
+      out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+   private:
+    static double cell_size(double cut)
+    {
+      // a single cell if the cut does not restrict anything
+      if (!std::isfinite(cut) || cut <= 0 || cut > 4 * M_PI)
+      {
+        return std::numeric_limits<double>::infinity();
+      }
+      return cut * 1.001;
+    }
+
+    static int64_t cell(double value, double size)
+    {
+      if (std::isinf(size))
+      {
+        return 0;
+      }
+      // the clamp keeps far outliers away from integer overflow
+      static constexpr double maxcell = 1e9;
+      return static_cast<int64_t>(std::floor(std::clamp(value / size, -maxcell, maxcell)));
+    }
+
+    static uint64_t key(int64_t iphi, int64_t ieta)
+    {
+      return (static_cast<uint64_t>(static_cast<uint32_t>(iphi)) << 32U) | static_cast<uint32_t>(ieta);
+    }
+
+    double m_phi_cell;
+    double m_eta_cell;
+    std::unordered_map<uint64_t, std::vector<unsigned int>> m_cells;
+  };
+}  // namespace
 
 //____________________________________________________________________________..
 bool PHGhostRejection::cut_from_clusters(int itrack) {
@@ -101,26 +191,48 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
     }
   }
 
-  // Elimate low-interest track, and try to eliminate repeated tracks
-  std::set<unsigned int> matches_set;
-  std::multimap<unsigned int, unsigned int> matches;
-  for (size_t trid1 = 0; trid1 < seeds.size(); ++trid1)
+  // Elimate low-interest track, and try to eliminate repeated tracks.
+  // Seeds are bucketed in (phi, eta) cells slightly larger than the cuts, so
+  // that only seeds in neighbouring cells can pass them. Matches are stored
+  // per seed in seed order (CSR), as the full pairwise comparison gives them
+  std::vector<unsigned int> good_seeds;
+  good_seeds.reserve(seeds.size());
+  for (unsigned int trid = 0; trid < seeds.size(); ++trid)
+  {
+    if (!m_rejected[trid])
+    {
+      good_seeds.push_back(trid);
+    }
+  }
+
+  std::vector<Acts::Vector3> positions;
+  positions.reserve(good_seeds.size());
+  SeedBuckets buckets(_phi_cut, _eta_cut);
+  for (unsigned int i = 0; i < good_seeds.size(); ++i)
+  {
+    const auto& track = seeds[good_seeds[i]];
+    positions.push_back(TrackSeedHelper::get_xyz(&track));
+    buckets.insert(track.get_phi(), track.get_eta(), i);
+  }
+
+  std::vector<unsigned int> match_offsets(good_seeds.size() + 1, 0);
+  std::vector<unsigned int> match_list;
+  std::vector<unsigned int> candidates;
+  for (unsigned int i = 0; i < good_seeds.size(); ++i)
   {
-    if (m_rejected[trid1]) { continue; }
+    const unsigned int trid1 = good_seeds[i];
     const auto& track1 = seeds[trid1];
     const float track1phi = track1.get_phi();
-
-    const auto track1_pos = TrackSeedHelper::get_xyz(&track1);
+    const auto& track1_pos = positions[i];
     const float track1eta = track1.get_eta();
-    for (size_t trid2 = trid1+1; trid2 < seeds.size(); ++trid2)
-    {
-      if (m_rejected[trid2])
-      {
-        continue;
-      }
 
+    // candidates following this seed, in seed order
+    buckets.candidates(track1phi, track1eta, i, candidates);
+    for (auto j : candidates)
+    {
+      const unsigned int trid2 = good_seeds[j];
       const auto& track2 = seeds[trid2];
-      const auto track2_pos = TrackSeedHelper::get_xyz(&track2);
+      const auto& track2_pos = positions[j];
       const float track2eta = track2.get_eta();
       auto delta_phi = std::abs(track1phi - track2.get_phi());
 
@@ -133,8 +245,7 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
           std::abs(track1_pos.y() - track2_pos.y()) < _y_cut &&
           std::abs(track1_pos.z() - track2_pos.z()) < _z_cut)
       {
-        matches_set.insert(trid1);
-        matches.insert(std::pair(trid1, trid2));
+        match_list.push_back(trid2);
 
         if (m_verbosity > 1)
         {
@@ -142,13 +253,14 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
         }
       }
     }
+    match_offsets[i + 1] = match_list.size();
   }
 
-  for (auto set_it : matches_set)
+  for (unsigned int i = 0; i < good_seeds.size(); ++i)
   {
+    const unsigned int set_it = good_seeds[i];
+    if (match_offsets[i] == match_offsets[i + 1]) { continue; } // no match
     if (m_rejected[set_it]) { continue; } // already rejected
-    auto match_list = matches.equal_range(set_it);
-
     auto tr1 = seeds[set_it];
     double best_qual = trackChi2.at(set_it);
     unsigned int best_track = set_it;
@@ -158,14 +270,15 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
       std::cout << " ****** start checking track " << set_it << " with best quality " << best_qual << " best_track " << best_track << std::endl;
     }
 
-    for (auto it = match_list.first; it != match_list.second; ++it)
+    for (auto imatch = match_offsets[i]; imatch < match_offsets[i + 1]; ++imatch)
     {
+      const unsigned int match = match_list[imatch];
       if (m_verbosity > 1)
       {
-        std::cout << "    match of track " << it->first << " to track " << it->second << std::endl;
+        std::cout << "    match of track " << set_it << " to track " << match << std::endl;
       }
 
-      auto tr2 = seeds[it->second];
+      auto tr2 = seeds[match];
 
       // Check that these two tracks actually share the same clusters, if not skip this pair
       bool is_same_track = checkClusterSharing(tr1, tr2);
@@ -175,7 +288,7 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
       }
 
       // which one has the best quality?
-      double tr2_qual = trackChi2.at(it->second);
+      double tr2_qual = trackChi2.at(match);
       if (m_verbosity > 1)
       {
         std::cout << "       Compare: best quality " << best_qual << " track 2 quality " << tr2_qual << std::endl;
@@ -193,21 +306,21 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
       {
         if (m_verbosity > 1)
         {
-          std::cout << "       --------- Track " << it->second << " has better quality, erase track " << best_track << std::endl;
+          std::cout << "       --------- Track " << match << " has better quality, erase track " << best_track << std::endl;
           std::cout << " rejecting track ID " << ((int)best_track) << "  because it is a ghost " << std::endl;
         }
         m_rejected[best_track] = true;
         best_qual = tr2_qual;
-        best_track = it->second;
+        best_track = match;
       }
       else
       {
         if (m_verbosity > 1)
         {
-          std::cout << "       --------- Track " << best_track << " has better quality, erase track " << it->second << std::endl;
+          std::cout << "       --------- Track " << best_track << " has better quality, erase track " << match << std::endl;
           std::cout << " rejecting track ID " << ((int)best_track) << "  because it is a ghost " << std::endl;
         }
-        m_rejected[it->second] = true;
+        m_rejected[match] = true;
       }
     }
     if (m_verbosity > 1)
@@ -91,6 +91,10 @@ int PHSimpleKFProp::InitRun(PHCompositeNode* topNode)
   /* note: if field is not found it is created with default configuration, as defined in PHFieldUtility */
   const auto field_map = PHFieldUtility::GetFieldMapNode(nullptr, topNode);
 
+  // assign number of threads, before the fitter allocates its per-thread field caches
+  std::cout << "PHSimpleKFProp::InitRun - m_num_threads: " << m_num_threads << std::endl;
+  if( m_num_threads >= 1 ) { omp_set_num_threads( m_num_threads ); }
+
   // alice kalman filter
   fitter = std::make_unique<ALICEKF>(_cluster_map, field_map, _min_clusters_per_track, _max_sin_phi, Verbosity());
   fitter->setNeonFraction(Ne_frac);
@@ -108,10 +112,6 @@ int PHSimpleKFProp::InitRun(PHCompositeNode* topNode)
   if( field_config->get_field_config() == PHFieldConfig::kFieldUniform )
   { fitter->setConstBField(field_config->get_field_mag_z()); }
 
-  // assign number of threads
-  std::cout << "PHSimpleKFProp::InitRun - m_num_threads: " << m_num_threads << std::endl;
-  if( m_num_threads >= 1 ) { omp_set_num_threads( m_num_threads ); }
-
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -41,6 +41,53 @@
 #include <string>
 #include <utility>
 
+namespace
+{
+  const unsigned int n_lut_entries = 1024;
+  const unsigned int n_emcal_channels = 24576;
+  const unsigned int n_hcal_channels = 1536;
+  const unsigned int n_hcal_sums = 384;       // 24 primitives x 16 2x2 sums
+  const unsigned int n_jet_primitives = 16;
+  const unsigned int n_jet_prim_sums = 24;
+  const unsigned int n_8x8_sums = 384;        // 16 jet primitives x 24 8x8 sums (32 phi x 12 eta)
+  const int n_8x8_eta = 12;
+  const int n_jet_phi = 32;
+  const int n_jet_eta = 9;
+
+  // one bit for every threshold the sum reaches
+  unsigned int threshold_bits(unsigned int sum, const unsigned int *thresholds)
+  {
+    unsigned int bit = 0;
+    for (unsigned int i = 0; i < 4; i++)
+    {
+      bit |= (sum >= thresholds[i] ? 0x1U << (i) : 0);
+    }
+    return bit;
+  }
+
+  // peak (maximum of three consecutive samples) minus the sample sub_delay earlier,
+  // for the samples in [start, end). samples needs to hold end + 2 values.
+  void peak_sub_ped(const int *samples, int start, int end, int sub_delay, unsigned int *peaks)
+  {
+    for (int i = start; i < end; i++)
+    {
+      int16_t maxim = (samples[i] > samples[i + 1] ? samples[i] : samples[i + 1]);
+      maxim = (maxim > samples[i + 2] ? maxim : samples[i + 2]);
+      uint16_t sam = 0;
+      if (i >= sub_delay)
+      {
+        sam = i - sub_delay;
+      }
+      unsigned int sub = 0;
+      if (maxim > samples[sam])
+      {
+        sub = (((uint16_t) (maxim - samples[sam])) & 0x3fffU);
+      }
+      *peaks++ = sub;
+    }
+  }
+}  // namespace
+
 // constructor
 CaloTriggerEmulator::CaloTriggerEmulator(const std::string &name)
   : SubsysReco(name)
@@ -74,23 +121,6 @@ CaloTriggerEmulator::CaloTriggerEmulator(const std::string &name)
     m_l1_slewing_table[i] = (i) & 0x3ffU;
   }
 
-  for (int i = 0; i < 24576; i++)
-  {
-    unsigned int key = TowerInfoDefs::encode_emcal(i);
-    h_emcal_lut[key] = nullptr;
-  }
-
-  for (int i = 0; i < 1536; i++)
-  {
-    unsigned int key = TowerInfoDefs::encode_hcal(i);
-    h_hcalin_lut[key] = nullptr;
-  }
-  for (int i = 0; i < 1536; i++)
-  {
-    unsigned int key = TowerInfoDefs::encode_hcal(i);
-    h_hcalout_lut[key] = nullptr;
-  }
-
   // Set HCAL LL1 lookup table for the cosmic coincidence trigger.
   if (m_triggerid == TriggerDefs::TriggerId::cosmic_coinTId)
   {
@@ -404,6 +434,14 @@ int CaloTriggerEmulator::InitRun(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+  BuildPrimitiveTables();
+
+  if (m_check_batch && m_isdata)
+  {
+    std::cout << PHWHERE << " the batch emulation check needs simulated waveforms, disabling it" << std::endl;
+    m_check_batch = false;
+  }
+
   CreateNodes(topNode);
 
   return 0;
@@ -453,15 +491,12 @@ int CaloTriggerEmulator::Download_Calibrations()
     if (cdbttree_emcal)
     {
       cdbttree_emcal->LoadCalibrations();
-
-      for (int i = 0; i < 24576; i++)
-      {
-        std::string histoname = "h_emcal_lut_" + std::to_string(i);
-        unsigned int key = TowerInfoDefs::encode_emcal(i);
-        h_emcal_lut[key] = cdbttree_emcal->getHisto(histoname);
-      }
     }
   }
+  if (m_do_emcal)
+  {
+    FillLUT(m_lut_emcal, (m_default_lut_emcal ? nullptr : cdbttree_emcal), "h_emcal_lut_", n_emcal_channels);
+  }
   if (m_do_hcalin && !m_default_lut_hcalin)
   {
     if (!m_hcalin_lutname.empty())
@@ -484,15 +519,12 @@ int CaloTriggerEmulator::Download_Calibrations()
     if (cdbttree_hcalin)
     {
       cdbttree_hcalin->LoadCalibrations();
-
-      for (int i = 0; i < 1536; i++)
-      {
-        std::string histoname = "h_hcalin_lut_" + std::to_string(i);
-        unsigned int key = TowerInfoDefs::encode_hcal(i);
-        h_hcalin_lut[key] = cdbttree_hcalin->getHisto(histoname);
-      }
     }
   }
+  if (m_do_hcalin)
+  {
+    FillLUT(m_lut_hcalin, (m_default_lut_hcalin ? nullptr : cdbttree_hcalin), "h_hcalin_lut_", n_hcal_channels);
+  }
   if (m_do_hcalout && !m_default_lut_hcalout)
   {
     if (!m_hcalout_lutname.empty())
@@ -515,17 +547,151 @@ int CaloTriggerEmulator::Download_Calibrations()
     if (cdbttree_hcalout)
     {
       cdbttree_hcalout->LoadCalibrations();
+    }
+  }
+  if (m_do_hcalout)
+  {
+    FillLUT(m_lut_hcalout, (m_default_lut_hcalout ? nullptr : cdbttree_hcalout), "h_hcalout_lut_", n_hcal_channels);
+  }
+  return 0;
+}
+
+// copy the LUT histograms into one contiguous integer table per detector,
+// the default (identity) LUT is a single table shared by all channels.
+void CaloTriggerEmulator::FillLUT(FlatLUT &lut, CDBHistos *histos, const std::string &prefix, unsigned int nchannels)
+{
+  if (!histos)
+  {
+    lut.stride = 0;
+    lut.table.assign(m_l1_adc_table, m_l1_adc_table + n_lut_entries);
+    return;
+  }
+  lut.stride = n_lut_entries;
+  lut.table.assign(static_cast<size_t>(nchannels) * n_lut_entries, 0);
+  for (unsigned int ich = 0; ich < nchannels; ich++)
+  {
+    uint16_t *table = lut.table.data() + static_cast<size_t>(ich) * n_lut_entries;
+    TH1 *h = histos->getHisto(prefix + std::to_string(ich));
+    for (unsigned int i = 0; i < n_lut_entries; i++)
+    {
+      // a missing histogram (reported by CDBHistos) falls back to the identity table
+      table[i] = (h ? ((unsigned int) h->GetBinContent(i + 1)) : m_l1_adc_table[i]) & 0x3ffU;
+    }
+  }
+}
+
+// set the sample window, the per event buffers, the tower channels of every 2x2 sum
+// and where the 2x2 and 8x8 sums go in the 8x8 and jet primitive sums
+void CaloTriggerEmulator::BuildPrimitiveTables()
+{
+  m_sample_start = 1;
+  m_sample_end = m_nsamples;
+  if (m_trig_sample > 0)
+  {
+    m_sample_start = m_trig_sample;
+    m_sample_end = m_trig_sample + 1;
+  }
+  m_nwindow = m_sample_end - m_sample_start;
+  m_samples.assign(m_sample_end + 2, 0);
+
+  m_sum_channels_emcal.clear();
+  m_sum_channels_hcal.clear();
+  m_peak_sub_ped_emcal.clear();
+  m_peak_sub_ped_hcalin.clear();
+  m_peak_sub_ped_hcalout.clear();
+  m_sums_emcal.clear();
+  m_sums_hcalin.clear();
+  m_sums_hcalout.clear();
 
-      for (int i = 0; i < 1536; i++)
+  if (m_do_emcal)
+  {
+    m_peak_sub_ped_emcal.assign(n_emcal_channels * m_nwindow, 0);
+    for (int ip = 0; ip < m_prim_map[TriggerDefs::DetectorId::emcalDId]; ip++)
+    {
+      for (int isum = 0; isum < m_n_sums; isum++)
       {
-        std::string histoname = "h_hcalout_lut_" + std::to_string(i);
-        unsigned int key = TowerInfoDefs::encode_hcal(i);
-        h_hcalout_lut[key] = cdbttree_hcalout->getHisto(histoname);
+        for (int j = 0; j < 4; j++)
+        {
+          unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::DetectorId::emcalDId, ip, isum, j);
+          m_sum_channels_emcal.push_back(TowerInfoDefs::decode_emcal(key));
+        }
       }
     }
   }
-  return 0;
+  if (m_do_hcalin || m_do_hcalout)
+  {
+    if (m_do_hcalin)
+    {
+      m_peak_sub_ped_hcalin.assign(n_hcal_channels * m_nwindow, 0);
+    }
+    if (m_do_hcalout)
+    {
+      m_peak_sub_ped_hcalout.assign(n_hcal_channels * m_nwindow, 0);
+    }
+    for (int ip = 0; ip < m_prim_map[TriggerDefs::DetectorId::hcalDId]; ip++)
+    {
+      for (int isum = 0; isum < m_n_sums; isum++)
+      {
+        for (int j = 0; j < 4; j++)
+        {
+          unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::DetectorId::hcalDId, ip, isum, j);
+          m_sum_channels_hcal.push_back(TowerInfoDefs::decode_hcal(key));
+        }
+      }
+    }
+  }
+  if (m_do_emcal)
+  {
+    m_sums_emcal.assign(static_cast<size_t>(m_prim_map[TriggerDefs::DetectorId::emcalDId]) * m_n_sums * m_nwindow, 0);
+  }
+  if (m_do_hcalin)
+  {
+    m_sums_hcalin.assign(n_hcal_sums * m_nwindow, 0);
+  }
+  if (m_do_hcalout)
+  {
+    m_sums_hcalout.assign(n_hcal_sums * m_nwindow, 0);
+  }
+  m_sums_emcal_8x8.assign(n_8x8_sums * m_nwindow, 0);
+  m_sums_hcal_8x8.assign(n_8x8_sums * m_nwindow, 0);
+  m_sums_jet.assign(n_8x8_sums * m_nwindow, 0);
+  m_jet_map.assign(n_jet_phi * n_jet_eta * m_nwindow, 0);
+  m_photon_bits.assign(m_nwindow, 0);
+  m_jet_bits.assign(m_nwindow, 0);
+
+  // the 8x8 sum every hcal 2x2 sum goes into
+  m_hcal_8x8_index.clear();
+  for (int ip = 0; ip < m_prim_map[TriggerDefs::DetectorId::hcalDId]; ip++)
+  {
+    for (int isum = 0; isum < m_n_sums; isum++)
+    {
+      TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::TriggerId::noneTId, TriggerDefs::DetectorId::hcalDId, TriggerDefs::PrimitiveId::calPId, ip, isum);
+      unsigned int sumphi = (TriggerDefs::getPrimitivePhiId_from_TriggerSumKey(sumkey) * 4) + TriggerDefs::getSumPhiId(sumkey);
+      unsigned int sumeta = (TriggerDefs::getPrimitiveEtaId_from_TriggerSumKey(sumkey) * 4) + TriggerDefs::getSumEtaId(sumkey);
+      // jet primitive sumphi / 2, the odd phi row comes after the 12 eta bins of the even one
+      m_hcal_8x8_index.push_back(((sumphi / 2) * n_jet_prim_sums) + sumeta + ((sumphi % 2) * n_8x8_eta));
+    }
+  }
+  // the hcal 8x8 sum every jet primitive sum is built with, the last 4 jet primitives
+  // have the hcal sums ordered eta first
+  m_jet_hcal_index.clear();
+  m_jet_prim_masked.clear();
+  for (unsigned int iprim = 0; iprim < n_jet_primitives; iprim++)
+  {
+    for (unsigned int isum = 0; isum < n_jet_prim_sums; isum++)
+    {
+      TriggerDefs::TriggerSumKey jet_skey = TriggerDefs::getTriggerSumKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::DetectorId::noneDId, TriggerDefs::PrimitiveId::jetPId, iprim, isum);
+      unsigned int hcal_sum = isum;
+      if (iprim >= 12)
+      {
+        hcal_sum = (TriggerDefs::getSumPhiId(jet_skey) % 2) + (TriggerDefs::getSumEtaId(jet_skey) * 2);
+      }
+      m_jet_hcal_index.push_back((iprim * n_jet_prim_sums) + hcal_sum);
+    }
+    m_jet_prim_masked.push_back(CheckFiberMasks(TriggerDefs::getTriggerPrimKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::DetectorId::emcalDId, TriggerDefs::PrimitiveId::jetPId, iprim)));
+  }
 }
+
 // process event procedure
 int CaloTriggerEmulator::process_event(PHCompositeNode *topNode)
 {
@@ -563,6 +729,11 @@ int CaloTriggerEmulator::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
+  if (m_check_batch)
+  {
+    CheckBatch();
+  }
+
   m_nevent++;
 
   if (Verbosity() >= 2)
@@ -576,23 +747,15 @@ int CaloTriggerEmulator::process_event(PHCompositeNode *topNode)
 // RESET event procedure that takes all variables to 0 and clears the primitives.
 int CaloTriggerEmulator::ResetEvent(PHCompositeNode * /*topNode*/)
 {
-  // here, the peak minus pedestal map is cleanly disposed of
-  m_peak_sub_ped_emcal.clear();
-  m_peak_sub_ped_hcalin.clear();
-  m_peak_sub_ped_hcalout.clear();
+  // here, the peak minus pedestal arrays are zeroed, channels missing in the next event stay empty
+  std::fill(m_peak_sub_ped_emcal.begin(), m_peak_sub_ped_emcal.end(), 0);
+  std::fill(m_peak_sub_ped_hcalin.begin(), m_peak_sub_ped_hcalin.end(), 0);
+  std::fill(m_peak_sub_ped_hcalout.begin(), m_peak_sub_ped_hcalout.end(), 0);
 
   return 0;
 }
 int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
 {
-  int sample_start = 1;
-  int sample_end = m_nsamples;
-  if (m_trig_sample > 0)
-  {
-    sample_start = m_trig_sample;
-    sample_end = m_trig_sample + 1;
-  }
-
   if (m_do_emcal)
   {
     if (Verbosity())
@@ -637,64 +800,30 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
             {
               for (int iskip = 0; iskip < 64; iskip++)
               {
-                std::vector<unsigned int> v_peak_sub_ped;
-                for (int i = sample_start; i < sample_end; i++)
-                {
-                  v_peak_sub_ped.push_back(0);
-                }
-                unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-                m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+                store_peak_sub_ped(m_peak_sub_ped_emcal, iwave, nullptr);
                 iwave++;
               }
             }
           }
-          std::vector<unsigned int> v_peak_sub_ped;
           if (packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
+            store_peak_sub_ped(m_peak_sub_ped_emcal, iwave, nullptr);
           }
           else
           {
-            for (int i = sample_start; i < sample_end; i++)
+            for (unsigned int i = 0; i < m_samples.size(); i++)
             {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
+              m_samples[i] = packet->iValue(i, channel);
             }
+            store_peak_sub_ped(m_peak_sub_ped_emcal, iwave, m_samples.data());
           }
-          unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-          m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
           iwave++;
         }
         if (nchannels < 192 && !(adc_skip_mask < 4))
         {
           for (int iskip = 0; iskip < 192 - nchannels; iskip++)
           {
-            std::vector<unsigned int> v_peak_sub_ped;
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
-            unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-            m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+            store_peak_sub_ped(m_peak_sub_ped_emcal, iwave, nullptr);
             iwave++;
           }
         }
@@ -727,40 +856,18 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
 
         for (int channel = 0; channel < nchannels; channel++)
         {
-          std::vector<unsigned int> v_peak_sub_ped;
           if (packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
+            store_peak_sub_ped(m_peak_sub_ped_hcalout, iwave, nullptr);
           }
           else
           {
-            for (int i = sample_start; i < sample_end; i++)
+            for (unsigned int i = 0; i < m_samples.size(); i++)
             {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
+              m_samples[i] = packet->iValue(i, channel);
             }
+            store_peak_sub_ped(m_peak_sub_ped_hcalout, iwave, m_samples.data());
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalout[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -792,40 +899,18 @@ int CaloTriggerEmulator::process_offline(PHCompositeNode *topNode)
 
         for (int channel = 0; channel < nchannels; channel++)
         {
-          std::vector<unsigned int> v_peak_sub_ped;
           if (packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
+            store_peak_sub_ped(m_peak_sub_ped_hcalin, iwave, nullptr);
           }
           else
           {
-            for (int i = sample_start; i < sample_end; i++)
+            for (unsigned int i = 0; i < m_samples.size(); i++)
             {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
+              m_samples[i] = packet->iValue(i, channel);
             }
+            store_peak_sub_ped(m_peak_sub_ped_hcalin, iwave, m_samples.data());
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalin[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -862,14 +947,6 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
     std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing waveforms" << std::endl;
   }
 
-  int sample_start = 1;
-  int sample_end = m_nsamples;
-  if (m_trig_sample > 0)
-  {
-    sample_start = m_trig_sample;
-    sample_end = m_trig_sample + 1;
-  }
-
   if (m_do_emcal)
   {
     if (Verbosity())
@@ -896,52 +973,24 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
             {
               for (int iskip = 0; iskip < 64; iskip++)
               {
-                std::vector<unsigned int> v_peak_sub_ped;
-                for (int i = sample_start; i < sample_end; i++)
-                {
-                  v_peak_sub_ped.push_back(0);
-                }
-                unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-                m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+                store_peak_sub_ped(m_peak_sub_ped_emcal, iwave, nullptr);
                 iwave++;
               }
               continue;
             }
           }
-          std::vector<unsigned int> v_peak_sub_ped;
           if (packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
+            store_peak_sub_ped(m_peak_sub_ped_emcal, iwave, nullptr);
           }
           else
           {
-            for (int i = sample_start; i < sample_end; i++)
+            for (unsigned int i = 0; i < m_samples.size(); i++)
             {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
+              m_samples[i] = packet->iValue(i, channel);
             }
+            store_peak_sub_ped(m_peak_sub_ped_emcal, iwave, m_samples.data());
           }
-          unsigned int key = TowerInfoDefs::encode_emcal(iwave);
-          m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -965,40 +1014,18 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
 
         for (int channel = 0; channel < nchannels; channel++)
         {
-          std::vector<unsigned int> v_peak_sub_ped;
           if (packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
+            store_peak_sub_ped(m_peak_sub_ped_hcalout, iwave, nullptr);
           }
           else
           {
-            for (int i = sample_start; i < sample_end; i++)
+            for (unsigned int i = 0; i < m_samples.size(); i++)
             {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
+              m_samples[i] = packet->iValue(i, channel);
             }
+            store_peak_sub_ped(m_peak_sub_ped_hcalout, iwave, m_samples.data());
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalout[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -1022,40 +1049,18 @@ int CaloTriggerEmulator::process_waveforms(PHCompositeNode *topNode)
 
         for (int channel = 0; channel < nchannels; channel++)
         {
-          std::vector<unsigned int> v_peak_sub_ped;
           if (packet->iValue(channel, "SUPPRESSED"))
           {
-            for (int i = sample_start; i < sample_end; i++)
-            {
-              v_peak_sub_ped.push_back(0);
-            }
+            store_peak_sub_ped(m_peak_sub_ped_hcalin, iwave, nullptr);
           }
           else
           {
-            for (int i = sample_start; i < sample_end; i++)
+            for (unsigned int i = 0; i < m_samples.size(); i++)
             {
-              int16_t maxim = (packet->iValue(i, channel) > packet->iValue(i + 1, channel) ? packet->iValue(i, channel) : packet->iValue(i + 1, channel));
-              maxim = (maxim > packet->iValue(i + 2, channel) ? maxim : packet->iValue(i + 2, channel));
-              uint16_t sam = 0;
-              if (i >= m_trig_sub_delay)
-              {
-                sam = i - m_trig_sub_delay;
-              }
-              else
-              {
-                sam = 0;
-              }
-              unsigned int sub = 0;
-              if (maxim > packet->iValue(sam, channel))
-              {
-                sub = (((uint16_t) (maxim - packet->iValue(sam, channel))) & 0x3fffU);
-              }
-
-              v_peak_sub_ped.push_back(sub);
+              m_samples[i] = packet->iValue(i, channel);
             }
+            store_peak_sub_ped(m_peak_sub_ped_hcalin, iwave, m_samples.data());
           }
-          unsigned int key = TowerInfoDefs::encode_hcal(iwave);
-          m_peak_sub_ped_hcalin[key] = v_peak_sub_ped;
           iwave++;
         }
       }
@@ -1074,14 +1079,6 @@ int CaloTriggerEmulator::process_sim()
     std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing waveforms" << std::endl;
   }
 
-  int sample_start = 1;
-  int sample_end = m_nsamples;
-  if (m_trig_sample > 0)
-  {
-    sample_start = m_trig_sample;
-    sample_end = m_trig_sample + 1;
-  }
-
   if (m_do_emcal)
   {
     if (Verbosity())
@@ -1095,42 +1092,17 @@ int CaloTriggerEmulator::process_sim()
     // for each waveform, clauclate the peak - pedestal given the sub-delay setting
     for (unsigned int iwave = 0; iwave < (unsigned int) m_waveforms_emcal->size(); iwave++)
     {
-      std::vector<unsigned int> v_peak_sub_ped;
       TowerInfo *tower = m_waveforms_emcal->get_tower_at_channel(iwave);
-      unsigned int key = TowerInfoDefs::encode_emcal(iwave);
       if (tower->get_isZS())
       {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          v_peak_sub_ped.push_back(0);
-        }
+        store_peak_sub_ped(m_peak_sub_ped_emcal, iwave, nullptr);
+        continue;
       }
-      else
+      for (unsigned int i = 0; i < m_samples.size(); i++)
       {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          int16_t maxim = (tower->get_waveform_value(i) > tower->get_waveform_value(i + 1) ? tower->get_waveform_value(i) : tower->get_waveform_value(i + 1));
-          maxim = (maxim > tower->get_waveform_value(i + 2) ? maxim : tower->get_waveform_value(i + 2));
-          uint16_t sam = 0;
-          if (i >= m_trig_sub_delay)
-          {
-            sam = i - m_trig_sub_delay;
-          }
-          else
-          {
-            sam = 0;
-          }
-          unsigned int sub = 0;
-          if (maxim > tower->get_waveform_value(sam))
-          {
-            sub = (((uint16_t) (maxim - tower->get_waveform_value(sam))) & 0x3fffU);
-          }
-
-          v_peak_sub_ped.push_back(sub);
-        }
+        m_samples[i] = tower->get_waveform_value(i);
       }
-      // save in global.
-      m_peak_sub_ped_emcal[key] = v_peak_sub_ped;
+      store_peak_sub_ped(m_peak_sub_ped_emcal, iwave, m_samples.data());
     }
   }
   if (m_do_hcalout)
@@ -1140,7 +1112,6 @@ int CaloTriggerEmulator::process_sim()
       std::cout << __FILE__ << "::" << __FUNCTION__ << ":: ohcal" << std::endl;
     }
 
-    std::vector<int> wave;
     // for each waveform, clauclate the peak - pedestal given the sub-delay setting
     if (!m_waveforms_hcalout->size())
     {
@@ -1149,42 +1120,17 @@ int CaloTriggerEmulator::process_sim()
 
     for (unsigned int iwave = 0; iwave < (unsigned int) m_waveforms_hcalout->size(); iwave++)
     {
-      std::vector<unsigned int> v_peak_sub_ped;
       TowerInfo *tower = m_waveforms_hcalout->get_tower_at_channel(iwave);
-      unsigned int key = TowerInfoDefs::encode_hcal(iwave);
       if (tower->get_isZS())
       {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          v_peak_sub_ped.push_back(0);
-        }
+        store_peak_sub_ped(m_peak_sub_ped_hcalout, iwave, nullptr);
+        continue;
       }
-      else
+      for (unsigned int i = 0; i < m_samples.size(); i++)
       {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          int16_t maxim = (tower->get_waveform_value(i) > tower->get_waveform_value(i + 1) ? tower->get_waveform_value(i) : tower->get_waveform_value(i + 1));
-          maxim = (maxim > tower->get_waveform_value(i + 2) ? maxim : tower->get_waveform_value(i + 2));
-          uint16_t sam = 0;
-          if (i >= m_trig_sub_delay)
-          {
-            sam = i - m_trig_sub_delay;
-          }
-          else
-          {
-            sam = 0;
-          }
-          unsigned int sub = 0;
-          if (maxim > tower->get_waveform_value(sam))
-          {
-            sub = (((uint16_t) (maxim - tower->get_waveform_value(sam))) & 0x3fffU);
-          }
-
-          v_peak_sub_ped.push_back(sub);
-        }
+        m_samples[i] = tower->get_waveform_value(i);
       }
-      // save in global.
-      m_peak_sub_ped_hcalout[key] = v_peak_sub_ped;
+      store_peak_sub_ped(m_peak_sub_ped_hcalout, iwave, m_samples.data());
     }
   }
   if (m_do_hcalin)
@@ -1202,93 +1148,228 @@ int CaloTriggerEmulator::process_sim()
       std::cout << __FILE__ << "::" << __FUNCTION__ << ":: ihcal" << std::endl;
     }
 
-    std::vector<unsigned int> wave;
-
     // for each waveform, clauclate the peak - pedestal given the sub-delay setting
     for (unsigned int iwave = 0; iwave < (unsigned int) m_waveforms_hcalin->size(); iwave++)
     {
-      std::vector<unsigned int> v_peak_sub_ped;
       TowerInfo *tower = m_waveforms_hcalin->get_tower_at_channel(iwave);
-      unsigned int key = TowerInfoDefs::encode_hcal(iwave);
       if (tower->get_isZS())
       {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          v_peak_sub_ped.push_back(0);
-        }
+        store_peak_sub_ped(m_peak_sub_ped_hcalin, iwave, nullptr);
+        continue;
       }
-      else
+      for (unsigned int i = 0; i < m_samples.size(); i++)
       {
-        for (int i = sample_start; i < sample_end; i++)
-        {
-          int16_t maxim = (tower->get_waveform_value(i) > tower->get_waveform_value(i + 1) ? tower->get_waveform_value(i) : tower->get_waveform_value(i + 1));
-          maxim = (maxim > tower->get_waveform_value(i + 2) ? maxim : tower->get_waveform_value(i + 2));
-          uint16_t sam = 0;
-          if (i >= m_trig_sub_delay)
-          {
-            sam = i - m_trig_sub_delay;
-          }
-          else
-          {
-            sam = 0;
-          }
-          unsigned int sub = 0;
-          if (maxim > tower->get_waveform_value(sam))
-          {
-            sub = (((uint16_t) (maxim - tower->get_waveform_value(sam))) & 0x3fffU);
-          }
-
-          v_peak_sub_ped.push_back(sub);
-        }
+        m_samples[i] = tower->get_waveform_value(i);
       }
-      // save in global.
-      m_peak_sub_ped_hcalin[key] = v_peak_sub_ped;
+      store_peak_sub_ped(m_peak_sub_ped_hcalin, iwave, m_samples.data());
     }
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-// procedure to process the peak - pedestal into primitives.
-int CaloTriggerEmulator::process_primitives()
+// store the peak - pedestal of one channel in the flat [channel][sample] array,
+// a null sample pointer (suppressed or skipped channel) stores zeros.
+void CaloTriggerEmulator::store_peak_sub_ped(std::vector<unsigned int> &peaks, unsigned int channel, const int *samples) const
 {
-  int ip;
-  int i;
-  bool mask;
-  int nsample = m_nsamples - 1;
-  if (m_trig_sample > 0)
+  if ((channel + 1) * m_nwindow > peaks.size())
   {
-    nsample = 1;
+    return;
   }
-
-  if (Verbosity())
+  unsigned int *out = peaks.data() + channel * m_nwindow;
+  if (!samples)
   {
-    std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives" << std::endl;
+    std::fill(out, out + m_nwindow, 0);
+    return;
   }
+  peak_sub_ped(samples, m_sample_start, m_sample_end, m_trig_sub_delay, out);
+}
 
-  if (m_do_emcal)
+// 2x2 sum of the LUT outputs of the four towers of a trigger sum, for all samples in the window.
+void CaloTriggerEmulator::sum_2x2(const unsigned int *peaks, const FlatLUT &lut, const unsigned int *channels, unsigned int tower_mask, unsigned int sum_mask, unsigned int *sums) const
+{
+  const unsigned int *tower_peaks[4];
+  const uint16_t *tower_lut[4];
+  for (int j = 0; j < 4; j++)
   {
-    if (Verbosity())
+    tower_peaks[j] = peaks + channels[j] * m_nwindow;
+    tower_lut[j] = lut.channel(channels[j]);
+  }
+  for (unsigned int is = 0; is < m_nwindow; is++)
+  {
+    unsigned int temp_sum = 0;
+    for (int j = 0; j < 4; j++)
     {
-      std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: emcal" << std::endl;
+      // shift before the sum
+      unsigned int lut_input = (tower_peaks[j][is] >> 4U) & 0x3ffU;
+      temp_sum += ((tower_lut[j][lut_input] >> 2U) & tower_mask);
     }
+    // shift after the sum, the sum is now 8 bits and sent to the LL1
+    sums[is] = ((temp_sum & sum_mask) >> 2U) & 0xffU;
+  }
+}
 
-    ip = 0;
-
-    // get the number of primitives needed to process
-    m_n_primitives = m_prim_map[TriggerDefs::DetectorId::emcalDId];
-    for (i = 0; i < m_n_primitives; i++, ip++)
+// 8x8 non-overlapping sums of the EMCAL and the HCAL and the jet primitive sums (EMCAL + HCAL)
+// from the 2x2 sums, for all samples in the window. A null pointer stands for a calorimeter
+// which is not used, all outputs are [jet primitive][sum][sample in window].
+void CaloTriggerEmulator::sum_8x8(const unsigned int *emcal, const unsigned int *hcalin, const unsigned int *hcalout, unsigned int *emcal_8x8, unsigned int *hcal_8x8, unsigned int *jet) const
+{
+  std::fill(emcal_8x8, emcal_8x8 + (n_8x8_sums * m_nwindow), 0);
+  std::fill(hcal_8x8, hcal_8x8 + (n_8x8_sums * m_nwindow), 0);
+  if (emcal)
+  {
+    // an emcal primitive covers exactly one 8x8 sum, in the same order
+    for (unsigned int ip = 0; ip < n_8x8_sums; ip++)
     {
-      if (Verbosity())
+      const unsigned int *in = emcal + (ip * m_n_sums * m_nwindow);
+      unsigned int *out = emcal_8x8 + (ip * m_nwindow);
+      for (int isum = 0; isum < m_n_sums; isum++)
       {
-        std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: adding " << i << std::endl;
+        for (unsigned int is = 0; is < m_nwindow; is++)
+        {
+          out[is] += (in[(isum * m_nwindow) + is] & 0xffU);
+        }
       }
-      unsigned int tmp = 0;
-      // get the primitive key of what we are making, in order of the packet ID and channel number
+      // saturates at 8 bits
+      for (unsigned int is = 0; is < m_nwindow; is++)
+      {
+        out[is] = std::min(out[is], 0xffU);
+      }
+    }
+  }
+  for (const unsigned int *hcal : {hcalin, hcalout})
+  {
+    if (!hcal)
+    {
+      continue;
+    }
+    for (unsigned int i = 0; i < n_hcal_sums; i++)
+    {
+      const unsigned int *in = hcal + (i * m_nwindow);
+      unsigned int *out = hcal_8x8 + (m_hcal_8x8_index[i] * m_nwindow);
+      for (unsigned int is = 0; is < m_nwindow; is++)
+      {
+        out[is] += ((in[is] & 0xffU) >> 1U);
+      }
+    }
+  }
+  for (unsigned int i = 0; i < n_8x8_sums * m_nwindow; i++)
+  {
+    hcal_8x8[i] &= 0xffU;
+  }
+  for (unsigned int i = 0; i < n_8x8_sums; i++)
+  {
+    const unsigned int *in_emcal = emcal_8x8 + (i * m_nwindow);
+    const unsigned int *in_hcal = hcal_8x8 + (m_jet_hcal_index[i] * m_nwindow);
+    unsigned int *out = jet + (i * m_nwindow);
+    for (unsigned int is = 0; is < m_nwindow; is++)
+    {
+      out[is] = ((in_hcal[is] >> 1U) + (in_emcal[is] >> 1U)) & 0xffU;
+    }
+  }
+}
+
+// photon trigger on the 8x8 EMCAL sums and jet trigger on the 4x4 overlapping windows of
+// the jet primitive sums (jet_map is [phi][eta][sample in window]), bits per sample in window
+void CaloTriggerEmulator::trigger_decision(const unsigned int *emcal_8x8, const unsigned int *jet, unsigned int *jet_map, unsigned int *photon_bits, unsigned int *jet_bits) const
+{
+  std::fill(photon_bits, photon_bits + m_nwindow, 0);
+  std::fill(jet_bits, jet_bits + m_nwindow, 0);
+  std::fill(jet_map, jet_map + (n_jet_phi * n_jet_eta * m_nwindow), 0);
+
+  for (unsigned int iprim = 0; iprim < n_jet_primitives; iprim++)
+  {
+    if (m_jet_prim_masked[iprim])
+    {
+      continue;
+    }
+    const unsigned int *in = emcal_8x8 + (iprim * n_jet_prim_sums * m_nwindow);
+    for (unsigned int i = 0; i < n_jet_prim_sums * m_nwindow; i++)
+    {
+      photon_bits[i % m_nwindow] |= threshold_bits(in[i], m_threshold_photon);
+    }
+  }
+
+  // add every jet primitive sum to the 4x4 windows it is part of, phi wraps around
+  for (int i = 0; i < static_cast<int>(n_8x8_sums); i++)
+  {
+    int sum_phi = i / n_8x8_eta;
+    int sum_eta = i % n_8x8_eta;
+    const unsigned int *in = jet + (i * m_nwindow);
+    for (int ijeta = std::max(sum_eta - 3, 0); ijeta <= std::min(sum_eta, n_jet_eta - 1); ijeta++)
+    {
+      for (int ijphi = sum_phi - 3; ijphi <= sum_phi; ijphi++)
+      {
+        int iphi = (ijphi < 0 ? n_jet_phi + ijphi : ijphi);
+        unsigned int *out = jet_map + (((iphi * n_jet_eta) + ijeta) * m_nwindow);
+        for (unsigned int is = 0; is < m_nwindow; is++)
+        {
+          out[is] += in[is];
+        }
+      }
+    }
+  }
+  for (unsigned int i = 0; i < n_jet_phi * n_jet_eta * m_nwindow; i++)
+  {
+    jet_bits[i % m_nwindow] |= threshold_bits(jet_map[i], m_threshold_jet);
+  }
+}
+
+// append the sums of this event to the 16 x 24 sums of one of the jet primitive containers
+void CaloTriggerEmulator::fill_jet_primitives(TriggerPrimitiveContainer *primitives, const std::vector<unsigned int> &sums) const
+{
+  if (!primitives)
+  {
+    return;
+  }
+  TriggerPrimitiveContainer::Range range = primitives->getTriggerPrimitives();
+  for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
+  {
+    TriggerPrimitivev1::Range sumrange = iter->second->getSums();
+    for (TriggerPrimitivev1::Iter iter_sum = sumrange.first; iter_sum != sumrange.second; ++iter_sum)
+    {
+      TriggerDefs::TriggerSumKey sumkey = iter_sum->first;
+      unsigned int isum = (TriggerDefs::getPrimitiveLocId_from_TriggerSumKey(sumkey) * n_jet_prim_sums) + TriggerDefs::getSumLocId(sumkey);
+      const unsigned int *in = sums.data() + (isum * m_nwindow);
+      iter_sum->second->insert(iter_sum->second->end(), in, in + m_nwindow);
+    }
+  }
+}
+
+// procedure to process the peak - pedestal into primitives.
+int CaloTriggerEmulator::process_primitives()
+{
+  int ip;
+  int i;
+  bool mask;
+
+  if (Verbosity())
+  {
+    std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives" << std::endl;
+  }
+
+  if (m_do_emcal)
+  {
+    if (Verbosity())
+    {
+      std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: emcal" << std::endl;
+    }
+
+    ip = 0;
+    std::fill(m_sums_emcal.begin(), m_sums_emcal.end(), 0);
+
+    // get the number of primitives needed to process
+    m_n_primitives = m_prim_map[TriggerDefs::DetectorId::emcalDId];
+    for (i = 0; i < m_n_primitives; i++, ip++)
+    {
+      if (Verbosity())
+      {
+        std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: adding " << i << std::endl;
+      }
+      // get the primitive key of what we are making, in order of the packet ID and channel number
       TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("EMCAL"), ip);
 
       TriggerPrimitive *primitive = m_primitives_emcal->get_primitive_at_key(primkey);
-      unsigned int sum = 0;
       // check if masked Fiber;
       mask = CheckFiberMasks(primkey);
 
@@ -1298,53 +1379,30 @@ int CaloTriggerEmulator::process_primitives()
         // get sum key
         TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("EMCAL"), ip, isum);
 
-        // calculate sums for all samples, hense the vector.
+        // calculate sums for all samples, hense the vector. if masked, just fill with 0s
         std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
-        t_sum->clear();
+        unsigned int *sums = m_sums_emcal.data() + ((ip * m_n_sums + isum) * m_nwindow);
 
         // check to mask channel (if fiber masked, automatically mask the channel)
         bool mask_channel = mask || CheckChannelMasks(sumkey);
-        for (int is = 0; is < nsample; is++)
+        if (!mask_channel)
         {
-          sum = 0;
-          unsigned int temp_sum = 0;
-
-          // if masked, just fill with 0s
-          if (!mask_channel)
+          sum_2x2(m_peak_sub_ped_emcal.data(), m_lut_emcal, &m_sum_channels_emcal[(ip * m_n_sums + isum) * 4], 0xffU, 0x3ffU, sums);
+        }
+        t_sum->assign(sums, sums + m_nwindow);
+        if (mask_channel)
+        {
+          continue;
+        }
+        if (Verbosity() >= 10)
+        {
+          for (unsigned int sum : *t_sum)
           {
-            for (int j = 0; j < 4; j++)
-            {
-              // unsigned int iwave = 64*ip + isum*4 + j;
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("EMCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_emcal[key].at(is) >> 4U) & 0x3ffU;
-
-              // shift before the sum
-              if (m_default_lut_emcal)
-              {
-                tmp = (m_l1_adc_table[lut_input] >> 2U);
-              }
-              else
-              {
-                unsigned int lut_output = ((unsigned int) h_emcal_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
-                tmp = (lut_output >> 2U);
-              }
-              temp_sum += (tmp & 0xffU);
-            }
-            // shift after the sum
-            sum = ((temp_sum & 0x3ffU) >> 2U) & 0xffU;
-
-            // sum is now 8 bits and sends it all to the LL1
-            if (Verbosity() >= 10 && sum >= 1)
+            if (sum >= 1)
             {
               std::cout << __FILE__ << "::" << __FUNCTION__ << ":: emcal sum " << sumkey << " = " << sum << std::endl;
             }
           }
-          if (Verbosity())
-          {
-            std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: adding" << std::endl;
-          }
-
-          t_sum->push_back(sum);
         }
       }
     }
@@ -1357,6 +1415,7 @@ int CaloTriggerEmulator::process_primitives()
     }
 
     ip = 0;
+    std::fill(m_sums_hcalout.begin(), m_sums_hcalout.end(), 0);
 
     m_n_primitives = m_prim_map[TriggerDefs::DetectorId::hcaloutDId];
 
@@ -1364,43 +1423,32 @@ int CaloTriggerEmulator::process_primitives()
     {
       TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALOUT"), TriggerDefs::GetPrimitiveId("HCALOUT"), ip);
       TriggerPrimitive *primitive = m_primitives_hcalout->get_primitive_at_key(primkey);
-      unsigned int sum;
       mask = CheckFiberMasks(primkey);
       for (int isum = 0; isum < m_n_sums; isum++)
       {
         TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALOUT"), TriggerDefs::GetPrimitiveId("HCALOUT"), ip, isum);
         std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
         mask |= CheckChannelMasks(sumkey);
-        for (int is = 0; is < nsample; is++)
+        unsigned int *sums = m_sums_hcalout.data() + ((ip * m_n_sums + isum) * m_nwindow);
+        if (!mask)
         {
-          sum = 0;
-          unsigned int temp_sum = 0;
-          if (!mask)
+          sum_2x2(m_peak_sub_ped_hcalout.data(), m_lut_hcalout, &m_sum_channels_hcal[(ip * m_n_sums + isum) * 4], 0xffU, 0x3ffU, sums);
+        }
+        size_t offset = t_sum->size();
+        t_sum->insert(t_sum->end(), sums, sums + m_nwindow);
+        if (mask)
+        {
+          continue;
+        }
+        if (Verbosity() >= 10)
+        {
+          for (size_t is = offset; is < t_sum->size(); is++)
           {
-            for (int j = 0; j < 4; j++)
-            {
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("HCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_hcalout[key].at(is) >> 4U) & 0x3ffU;
-              unsigned int tmp = 0;
-              if (m_default_lut_hcalout)
-              {
-                tmp = (m_l1_adc_table[lut_input] >> 2U);
-              }
-              else
-              {
-                unsigned int lut_output = ((unsigned int) h_hcalout_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
-                tmp = (lut_output >> 2U);
-              }
-              temp_sum += (tmp & 0xffU);
-            }
-            sum = ((temp_sum & 0x3ffU) >> 2U) & 0xffU;
-
-            if (Verbosity() >= 10 && sum >= 1)
+            if (t_sum->at(is) >= 1)
             {
-              std::cout << __FILE__ << "::" << __FUNCTION__ << ":: hcalout sum " << sumkey << " = " << sum << std::endl;
+              std::cout << __FILE__ << "::" << __FUNCTION__ << ":: hcalout sum " << sumkey << " = " << t_sum->at(is) << std::endl;
             }
           }
-          t_sum->push_back(sum);
         }
       }
     }
@@ -1408,6 +1456,7 @@ int CaloTriggerEmulator::process_primitives()
   if (m_do_hcalin)
   {
     ip = 0;
+    std::fill(m_sums_hcalin.begin(), m_sums_hcalin.end(), 0);
 
     if (Verbosity())
     {
@@ -1420,42 +1469,33 @@ int CaloTriggerEmulator::process_primitives()
     {
       TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALIN"), TriggerDefs::GetPrimitiveId("HCALIN"), ip);
       TriggerPrimitive *primitive = m_primitives_hcalin->get_primitive_at_key(primkey);
-      unsigned int sum;
       mask = CheckFiberMasks(primkey);
       for (int isum = 0; isum < m_n_sums; isum++)
       {
         TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALIN"), TriggerDefs::GetPrimitiveId("HCALIN"), ip, isum);
         std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
         mask |= CheckChannelMasks(sumkey);
-        for (int is = 0; is < nsample; is++)
+        unsigned int *sums = m_sums_hcalin.data() + ((ip * m_n_sums + isum) * m_nwindow);
+        if (!mask)
         {
-          sum = 0;
-          unsigned int temp_sum = 0;
-          if (!mask)
+          // the inner hcal keeps 10 bits per tower into the sum
+          sum_2x2(m_peak_sub_ped_hcalin.data(), m_lut_hcalin, &m_sum_channels_hcal[(ip * m_n_sums + isum) * 4], 0x3ffU, 0xfffU, sums);
+        }
+        size_t offset = t_sum->size();
+        t_sum->insert(t_sum->end(), sums, sums + m_nwindow);
+        if (mask)
+        {
+          continue;
+        }
+        if (Verbosity() >= 10)
+        {
+          for (size_t is = offset; is < t_sum->size(); is++)
           {
-            for (int j = 0; j < 4; j++)
-            {
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("HCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_hcalin[key].at(is) >> 4U) & 0x3ffU;
-              unsigned int tmp = 0;
-              if (m_default_lut_hcalin)
-              {
-                tmp = (m_l1_adc_table[lut_input] >> 2U);
-              }
-              else
-              {
-                unsigned int lut_output = ((unsigned int) h_hcalin_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
-                tmp = (lut_output >> 2U);
-              }
-              temp_sum += (tmp & 0x3ffU);
-            }
-            sum = ((temp_sum & 0xfffU) >> 2U) & 0xffU;
-            if (Verbosity() >= 10 && sum >= 1)
+            if (t_sum->at(is) >= 1)
             {
-              std::cout << __FILE__ << "::" << __FUNCTION__ << ":: hcalin sum " << sumkey << " = " << sum << std::endl;
+              std::cout << __FILE__ << "::" << __FUNCTION__ << ":: hcalin sum " << sumkey << " = " << t_sum->at(is) << std::endl;
             }
           }
-          t_sum->push_back(sum);
         }
       }
     }
@@ -1464,339 +1504,273 @@ int CaloTriggerEmulator::process_primitives()
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-// Unless this is the MBD or HCAL Cosmics trigger, EMCAL and HCAL will go through here.
-// This creates the 8x8 non-overlapping sum and the 4x4 overlapping sum.
-
-int CaloTriggerEmulator::process_organizer()
+// lookup tables, tower channels and masks of one calorimeter for the batch emulation
+int CaloTriggerEmulator::GetBatchDetector(TriggerDefs::DetectorId detId, size_t nwaveform, unsigned int nevents, BatchDetector &det)
 {
-  TriggerPrimitiveContainer::Range range;
-  if (Verbosity())
+  if (detId == TriggerDefs::DetectorId::emcalDId)
   {
-    std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing organizer" << std::endl;
+    det.name = "EMCAL";
+    det.lut = &m_lut_emcal;
+    det.channels = &m_sum_channels_emcal;
+    det.nchannels = n_emcal_channels;
   }
-
-  int nsample = m_nsamples - 1;
-  // bits are to say whether the trigger has fired. this is what is sent to the GL1
-  if (m_trig_sample > 0)
+  else if (detId == TriggerDefs::DetectorId::hcalinDId)
   {
-    nsample = 1;
+    det.name = "HCALIN";
+    det.lut = &m_lut_hcalin;
+    det.channels = &m_sum_channels_hcal;
+    det.nchannels = n_hcal_channels;
+    // the inner hcal keeps 10 bits per tower into the sum
+    det.tower_mask = 0x3ffU;
+    det.sum_mask = 0xfffU;
   }
-  // 8x8 non-overlapping sums in the EMCAL
-  // create the 8x8 non-overlapping sum
+  else if (detId == TriggerDefs::DetectorId::hcaloutDId)
   {
-    if (Verbosity() >= 2)
-    {
-      std::cout << __FUNCTION__ << " " << __LINE__ << " processing 8x8 non-overlapping sums" << std::endl;
-    }
-
-    m_triggerid = TriggerDefs::TriggerId::jetTId;
+    det.name = "HCALOUT";
+    det.lut = &m_lut_hcalout;
+    det.channels = &m_sum_channels_hcal;
+    det.nchannels = n_hcal_channels;
+  }
+  else
+  {
+    std::cout << PHWHERE << " batch emulation only supports EMCAL, HCALIN and HCALOUT" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
 
-    if (!m_primitives_emcal)
-    {
-      std::cout << "There is no primitive container" << std::endl;
-      return Fun4AllReturnCodes::EVENT_OK;
-    }
+  if (det.lut->table.empty() || det.channels->empty())
+  {
+    std::cout << PHWHERE << " no lookup tables for " << det.name << ", was InitRun called with this detector enabled?" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  size_t nwaves = static_cast<size_t>(nevents) * det.nchannels;
+  if (nwaves == 0 || nwaveform == 0 || nwaveform % nwaves != 0)
+  {
+    std::cout << PHWHERE << " expected " << nevents << " x " << det.nchannels << " x nsamples"
+              << " waveform samples for " << det.name << ", got " << nwaveform << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  det.nsamples = nwaveform / nwaves;
 
-    range = m_primitives_emcal_ll1->getTriggerPrimitives();
-    for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
+  // same masking as process_primitives: the hcal masks carry over to the following sums
+  std::string detname = det.name;
+  det.masked.clear();
+  for (int ip = 0; ip < m_prim_map[detId]; ip++)
+  {
+    TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId(detname), TriggerDefs::GetPrimitiveId(detname), ip);
+    bool mask = CheckFiberMasks(primkey);
+    for (int isum = 0; isum < m_n_sums; isum++)
     {
-      TriggerPrimitivev1::Range sumrange = iter->second->getSums();
-      for (TriggerPrimitivev1::Iter siter = sumrange.first; siter != sumrange.second; ++siter)
+      TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId(detname), TriggerDefs::GetPrimitiveId(detname), ip, isum);
+      bool mask_channel = mask || CheckChannelMasks(sumkey);
+      if (detId != TriggerDefs::DetectorId::emcalDId)
       {
-        for (int is = 0; is < nsample; is++)
-        {
-          siter->second->push_back(0);
-        }
+        mask = mask_channel;
       }
+      det.masked.push_back(mask_channel);
     }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-    if (Verbosity())
+// peak - pedestal and 2x2 sums of one calorimeter for one event of a batch.
+// Samples past the end of the waveforms read as 0, like the packet and tower accessors
+void CaloTriggerEmulator::batch_sum_2x2(const BatchDetector &det, const int16_t *waveforms, std::vector<int> &samples, std::vector<unsigned int> &peaks, unsigned int *sums) const
+{
+  size_t ncopy = std::min<size_t>(det.nsamples, samples.size());
+  for (unsigned int ich = 0; ich < det.nchannels; ich++)
+  {
+    const int16_t *wave = waveforms + (ich * det.nsamples);
+    std::copy(wave, wave + ncopy, samples.begin());
+    peak_sub_ped(samples.data(), m_sample_start, m_sample_end, m_trig_sub_delay, peaks.data() + (ich * m_nwindow));
+  }
+  for (unsigned int i = 0; i < det.masked.size(); i++)
+  {
+    unsigned int *out = sums + (i * m_nwindow);
+    if (det.masked[i])
     {
-      std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing getting emcal prims" << std::endl;
+      std::fill(out, out + m_nwindow, 0);
+      continue;
     }
+    sum_2x2(peaks.data(), *det.lut, &det.channels->at(i * 4), det.tower_mask, det.sum_mask, out);
+  }
+}
 
-    // iterate through emcal primitives and organize into the 16 jet primitives each with the 8x8 nonoverlapping sum
-    range = m_primitives_emcal->getTriggerPrimitives();
-
-    for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
-    {
-      // get key and see if masked
-      TriggerDefs::TriggerPrimKey key = (*iter).first;
-      if (CheckFiberMasks(key))
-      {
-        continue;
-      }
-
-      uint16_t sumphi = TriggerDefs::getPrimitivePhiId_from_TriggerPrimKey(key);
-      uint16_t sumeta = TriggerDefs::getPrimitiveEtaId_from_TriggerPrimKey(key);
-
-      // based on where the primitive is in the detector, the location of the jet primitive is determined, 0 through 15 in phi.
-      uint16_t iprim = sumphi / 2;
-      // eta determines the location of the sum within the jet primitive.
-      uint16_t isum = (sumeta + ((sumphi % 2) * 12));
-
-      TriggerDefs::TriggerPrimKey jet_prim_key = TriggerDefs::getTriggerPrimKey(m_triggerid, TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("JET"), iprim);
-
-      TriggerDefs::TriggerPrimKey jet_sum_key = TriggerDefs::getTriggerSumKey(m_triggerid, TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("JET"), iprim, isum);
-
-      // add to primitive previously made the sum of the 8x8 non-overlapping sum.
-      std::vector<unsigned int> *t_sum = m_primitives_emcal_ll1->get_primitive_at_key(jet_prim_key)->get_sum_at_key(jet_sum_key);
+// standalone emulation of the primitive stage for a batch of events, no node tree involved.
+int CaloTriggerEmulator::process_batch(TriggerDefs::DetectorId detId, const std::vector<int16_t> &waveforms, unsigned int nevents, std::vector<unsigned int> &sums)
+{
+  BatchDetector det;
+  if (GetBatchDetector(detId, waveforms.size(), nevents, det))
+  {
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
 
-      // get the primitive (16 2x2 sums)
-      TriggerPrimitive *primitive = (*iter).second;
-      TriggerPrimitivev1::Range sumrange = primitive->getSums();
+  size_t nsums_event = det.masked.size() * m_nwindow;
+  sums.assign(nevents * nsums_event, 0);
+  std::vector<unsigned int> peaks(det.nchannels * m_nwindow, 0);
+  std::vector<int> samples(m_samples.size(), 0);
+  for (unsigned int iev = 0; iev < nevents; iev++)
+  {
+    batch_sum_2x2(det, waveforms.data() + (iev * det.nchannels * det.nsamples), samples, peaks, sums.data() + (iev * nsums_event));
+  }
 
-      // iterate through all 16 sums and add together
-      for (TriggerPrimitivev1::Iter iter_sum = sumrange.first; iter_sum != sumrange.second; ++iter_sum)
-      {
-        if (CheckChannelMasks(iter_sum->first))
-        {
-          continue;
-        }
-        int i = 0;
-        for (unsigned int &it_s : *(*iter_sum).second)
-        {
-          t_sum->at(i) += (it_s & 0xffU);
-          i++;
-        }
-      }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-      // bit shift by 16 (divide by the 16 towers) to get an 8 bit energy sum.
-      for (unsigned int &it_s : *t_sum)
-      {
-        // unsigned int sumshift = ((it_s >> 0x2U) & 0x3ffU);
-        // unsigned int sum_lower = ( sumshift & 0x7fU );
-        // unsigned int sum_higher = ( ( sumshift >> 0x7U ) > 0 ? 0x1U : 0x0U );
-        // it_s = m_l1_8x8_table[sumshift];
-        it_s = std::min(it_s, 0xffU);
-      }
-    }
-  }
+// standalone emulation of the whole chain up to the photon and jet trigger decision
+int CaloTriggerEmulator::process_batch(const std::vector<int16_t> &emcal, const std::vector<int16_t> &hcalin, const std::vector<int16_t> &hcalout, unsigned int nevents, std::vector<unsigned int> &jet_sums, std::vector<unsigned int> &photon_bits, std::vector<unsigned int> &jet_bits)
+{
+  const std::vector<int16_t> *waveforms[3] = {&emcal, &hcalin, &hcalout};
+  const TriggerDefs::DetectorId detids[3] = {TriggerDefs::DetectorId::emcalDId, TriggerDefs::DetectorId::hcalinDId, TriggerDefs::DetectorId::hcaloutDId};
+  BatchDetector dets[3];
+  std::vector<unsigned int> sums[3];
+  std::vector<unsigned int> peaks[3];
+  for (int idet = 0; idet < 3; idet++)
   {
-    if (Verbosity())
+    // an empty waveform vector leaves this calorimeter out
+    if (waveforms[idet]->empty())
     {
-      std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing HCAL" << std::endl;
+      continue;
     }
-
-    range = m_primitives_hcal_ll1->getTriggerPrimitives();
-    for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
+    if (GetBatchDetector(detids[idet], waveforms[idet]->size(), nevents, dets[idet]))
     {
-      TriggerPrimitivev1::Range sumrange = iter->second->getSums();
-      for (TriggerPrimitivev1::Iter siter = sumrange.first; siter != sumrange.second; ++siter)
-      {
-        for (int is = 0; is < nsample; is++)
-        {
-          siter->second->push_back(0);
-        }
-      }
+      return Fun4AllReturnCodes::ABORTRUN;
     }
+    sums[idet].assign(dets[idet].masked.size() * m_nwindow, 0);
+    peaks[idet].assign(dets[idet].nchannels * m_nwindow, 0);
+  }
 
-    if (m_primitives_hcalin)
-    {
-      if (Verbosity())
-      {
-        std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing organizer" << std::endl;
-      }
-
-      // iterate through emcal primitives and organize into the 16 jet primitives each with the 8x8 nonoverlapping sum
-      range = m_primitives_hcalin->getTriggerPrimitives();
-
-      // for hcalin: there are
-      for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
-      {
-        // get key and see if masked
-        TriggerDefs::TriggerPrimKey key = (*iter).first;
-        if (CheckFiberMasks(key))
-        {
-          continue;
-        }
-
-        // get the primitive (16 2x2 sums)
-        TriggerPrimitive *primitive = (*iter).second;
-        TriggerPrimitivev1::Range sumrange = primitive->getSums();
-
-        for (TriggerPrimitivev1::Iter iter_sum = sumrange.first; iter_sum != sumrange.second; ++iter_sum)
-        {
-          TriggerDefs::TriggerSumKey sumkey = (*iter_sum).first;
-          uint16_t sumphi = (TriggerDefs::getPrimitivePhiId_from_TriggerSumKey(sumkey) * 4) + TriggerDefs::getSumPhiId(sumkey);
-          uint16_t sumeta = (TriggerDefs::getPrimitiveEtaId_from_TriggerSumKey(sumkey) * 4) + TriggerDefs::getSumEtaId(sumkey);
-
-          int i = 0;
-          if (CheckChannelMasks(sumkey))
-          {
-            continue;
-          }
-          // based on where the primitive is in the detector, the location of the jet primitive is determined, 0 through 15 in phi.
-          uint16_t iprim = sumphi / 2;
-          // eta determines the location of the sum within the jet primitive.
-          uint16_t isum = (sumeta + ((sumphi % 2) * 12));
-
-          TriggerDefs::TriggerPrimKey jet_prim_key = TriggerDefs::getTriggerPrimKey(m_triggerid, TriggerDefs::GetDetectorId("HCAL"), TriggerDefs::GetPrimitiveId("JET"), iprim);
-
-          TriggerDefs::TriggerPrimKey jet_sum_key = TriggerDefs::getTriggerSumKey(m_triggerid, TriggerDefs::GetDetectorId("HCAL"), TriggerDefs::GetPrimitiveId("JET"), iprim, isum);
-
-          // add to primitive previously made the sum of the 8x8 non-overlapping sum.
-          std::vector<unsigned int> *t_sum = m_primitives_hcal_ll1->get_primitive_at_key(jet_prim_key)->get_sum_at_key(jet_sum_key);
+  size_t njet_event = static_cast<size_t>(n_jet_phi) * n_jet_eta * m_nwindow;
+  jet_sums.assign(nevents * njet_event, 0);
+  photon_bits.assign(static_cast<size_t>(nevents) * m_nwindow, 0);
+  jet_bits.assign(static_cast<size_t>(nevents) * m_nwindow, 0);
+  std::vector<unsigned int> emcal_8x8(n_8x8_sums * m_nwindow, 0);
+  std::vector<unsigned int> hcal_8x8(n_8x8_sums * m_nwindow, 0);
+  std::vector<unsigned int> jet(n_8x8_sums * m_nwindow, 0);
+  std::vector<int> samples(m_samples.size(), 0);
 
-          for (unsigned int &it_s : *(*iter_sum).second)
-          {
-            t_sum->at(i) += ((it_s & 0xffU) >> 1U);
-            i++;
-          }
-        }
-      }
-    }
-
-    if (m_primitives_hcalout)
+  for (unsigned int iev = 0; iev < nevents; iev++)
+  {
+    for (int idet = 0; idet < 3; idet++)
     {
-      if (Verbosity())
+      if (sums[idet].empty())
       {
-        std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing organizer" << std::endl;
+        continue;
       }
+      const int16_t *event_waveforms = waveforms[idet]->data() + (iev * dets[idet].nchannels * dets[idet].nsamples);
+      batch_sum_2x2(dets[idet], event_waveforms, samples, peaks[idet], sums[idet].data());
+    }
+    sum_8x8((sums[0].empty() ? nullptr : sums[0].data()),
+            (sums[1].empty() ? nullptr : sums[1].data()),
+            (sums[2].empty() ? nullptr : sums[2].data()),
+            emcal_8x8.data(), hcal_8x8.data(), jet.data());
+    trigger_decision(emcal_8x8.data(), jet.data(), jet_sums.data() + (iev * njet_event),
+                     photon_bits.data() + (iev * m_nwindow), jet_bits.data() + (iev * m_nwindow));
+  }
 
-      // iterate through emcal primitives and organize into the 16 jet primitives each with the 8x8 nonoverlapping sum
-      range = m_primitives_hcalout->getTriggerPrimitives();
-
-      // for hcalin: there are
-      for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
-      {
-        // get key and see if masked
-        TriggerDefs::TriggerPrimKey key = (*iter).first;
-        if (CheckFiberMasks(key))
-        {
-          continue;
-        }
-
-        // get the primitive (16 2x2 sums)
-        TriggerPrimitive *primitive = (*iter).second;
-        TriggerPrimitivev1::Range sumrange = primitive->getSums();
-
-        for (TriggerPrimitivev1::Iter iter_sum = sumrange.first; iter_sum != sumrange.second; ++iter_sum)
-        {
-          TriggerDefs::TriggerSumKey sumkey = (*iter_sum).first;
-          uint16_t sumphi = (TriggerDefs::getPrimitivePhiId_from_TriggerSumKey(sumkey) * 4) + TriggerDefs::getSumPhiId(sumkey);
-          //		      uint16_t sumeta = TriggerDefs::getPrimitiveEtaId_from_TriggerSumKey(sumkey)*4 + TriggerDefs::getSumEtaId(sumkey);
-          uint16_t sumeta = (TriggerDefs::getPrimitiveEtaId_from_TriggerSumKey(sumkey) * 4) + TriggerDefs::getSumEtaId(sumkey);
-
-          int i = 0;
-
-          if (CheckChannelMasks(sumkey))
-          {
-            continue;
-          }
-          // based on where the primitive is in the detector, the location of the jet primitive is determined, 0 through 15 in phi.
-          uint16_t iprim = sumphi / 2;
-          // eta determines the location of the sum within the jet primitive.
-          uint16_t isum = sumeta + ((sumphi % 2) * 12);
-          TriggerDefs::TriggerPrimKey jet_prim_key = TriggerDefs::getTriggerPrimKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::GetDetectorId("HCAL"), TriggerDefs::GetPrimitiveId("JET"), iprim);
-
-          TriggerDefs::TriggerPrimKey jet_sum_key = TriggerDefs::getTriggerSumKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::GetDetectorId("HCAL"), TriggerDefs::GetPrimitiveId("JET"), iprim, isum);
-          if (Verbosity())
-          {
-            std::cout << __FILE__ << "::" << __FUNCTION__ << "::" << __LINE__ << ":: Processing organizer" << std::endl;
-          }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-          std::vector<unsigned int> *t_sum = m_primitives_hcal_ll1->get_primitive_at_key(jet_prim_key)->get_sum_at_key(jet_sum_key);
-          for (unsigned int &it_s : *(*iter_sum).second)
-          {
-            t_sum->at(i) += ((it_s & 0xffU) >> 1U);
-            i++;
-          }
-        }
-      }
+// run the event which was just emulated through the batch emulation and compare the
+// jet sums and trigger bits with what process_event put on the node tree
+void CaloTriggerEmulator::CheckBatch()
+{
+  TowerInfoContainer *towers[3] = {(m_do_emcal ? m_waveforms_emcal : nullptr),
+                                   (m_do_hcalin ? m_waveforms_hcalin : nullptr),
+                                   (m_do_hcalout ? m_waveforms_hcalout : nullptr)};
+  const unsigned int nchannels[3] = {n_emcal_channels, n_hcal_channels, n_hcal_channels};
+  // the same samples process_sim reads
+  const size_t nsamples = m_samples.size();
+  std::vector<int16_t> waveforms[3];
+  for (int idet = 0; idet < 3; idet++)
+  {
+    if (!towers[idet])
+    {
+      continue;
     }
-
-    // iterate through emcal primitives and organize into the 16 jet primitives each with the 8x8 nonoverlapping sum
-    if (Verbosity())
+    if (towers[idet]->size() != nchannels[idet])
     {
-      std::cout << __FILE__ << "::" << __FUNCTION__ << "::" << __LINE__ << ":: Processing organizer" << std::endl;
+      std::cout << PHWHERE << " " << towers[idet]->size() << " waveforms instead of " << nchannels[idet]
+                << ", event " << m_nevent << " is not checked" << std::endl;
+      return;
     }
-
-    range = m_primitives_hcal_ll1->getTriggerPrimitives();
-    for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
+    waveforms[idet].assign(nchannels[idet] * nsamples, 0);
+    for (unsigned int iwave = 0; iwave < nchannels[idet]; iwave++)
     {
-      TriggerPrimitive *primitive = (*iter).second;
-      TriggerPrimitivev1::Range sumrange = primitive->getSums();
-
-      for (TriggerPrimitivev1::Iter iter_sum = sumrange.first; iter_sum != sumrange.second; ++iter_sum)
+      TowerInfo *tower = towers[idet]->get_tower_at_channel(iwave);
+      if (tower->get_isZS())
       {
-        for (unsigned int &it_s : *(*iter_sum).second)
-        {
-          it_s = (it_s & 0xffU);
-        }
+        continue;
       }
-    }
-
-    {
-      range = m_primitives_jet->getTriggerPrimitives();
-      for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
+      for (size_t i = 0; i < nsamples; i++)
       {
-        TriggerPrimitivev1::Range sumrange = iter->second->getSums();
-        for (TriggerPrimitivev1::Iter siter = sumrange.first; siter != sumrange.second; ++siter)
-        {
-          for (int is = 0; is < nsample; is++)
-          {
-            siter->second->push_back(0);
-          }
-        }
+        waveforms[idet][(iwave * nsamples) + i] = tower->get_waveform_value(i);
       }
     }
-    if (Verbosity())
+  }
+
+  std::vector<unsigned int> jet_sums;
+  std::vector<unsigned int> photon_bits;
+  std::vector<unsigned int> jet_bits;
+  m_batch_checks++;
+  if (process_batch(waveforms[0], waveforms[1], waveforms[2], 1, jet_sums, photon_bits, jet_bits))
+  {
+    m_batch_mismatches++;
+    return;
+  }
+
+  // the node tree vectors hold this event at the end
+  auto same = [this](std::vector<unsigned int> *node, const unsigned int *batch)
+  {
+    return node && node->size() >= m_nwindow && std::equal(node->end() - m_nwindow, node->end(), batch);
+  };
+  bool ok = same(m_ll1out_photon->GetTriggerBits(), photon_bits.data());
+  // the jet trigger word carries the photon bits as well
+  for (unsigned int is = 0; is < m_nwindow; is++)
+  {
+    jet_bits[is] |= photon_bits[is];
+  }
+  ok = ok && same(m_ll1out_jet->GetTriggerBits(), jet_bits.data());
+  for (int ijphi = 0; ijphi < n_jet_phi && ok; ijphi++)
+  {
+    for (int ijeta = 0; ijeta < n_jet_eta && ok; ijeta++)
     {
-      std::cout << __FILE__ << "::" << __FUNCTION__ << "::" << __LINE__ << ":: Processing organizer" << std::endl;
+      unsigned int sk = ((unsigned int) ijphi & 0xffffU) + (((unsigned int) ijeta & 0xffffU) << 16U);
+      ok = same(m_ll1out_jet->get_word(sk), jet_sums.data() + (((ijphi * n_jet_eta) + ijeta) * m_nwindow));
     }
-    // get jet primitives (after EMCAL and HCAL sum)
-    range = m_primitives_jet->getTriggerPrimitives();
-    for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
-    {
-      if (Verbosity())
-      {
-        std::cout << __FILE__ << "::" << __FUNCTION__ << "::" << __LINE__ << ":: Processing organizer" << std::endl;
-      }
+  }
+  if (!ok)
+  {
+    m_batch_mismatches++;
+    std::cout << PHWHERE << " batch emulation differs from process_event in event " << m_nevent << std::endl;
+  }
+}
 
-      TriggerDefs::TriggerPrimKey jet_pkey = (*iter).first;
-      TriggerDefs::TriggerPrimKey hcal_pkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::GetDetectorId("HCAL"), TriggerDefs::GetPrimitiveId("JET"), TriggerDefs::getPrimitiveLocId_from_TriggerPrimKey(jet_pkey));
-      TriggerDefs::TriggerPrimKey emcal_pkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("JET"), TriggerDefs::getPrimitiveLocId_from_TriggerPrimKey(jet_pkey));
-      TriggerPrimitive *primitive = (*iter).second;
-      TriggerPrimitivev1::Range sumrange = primitive->getSums();
-      for (TriggerPrimitivev1::Iter iter_sum = sumrange.first; iter_sum != sumrange.second; ++iter_sum)
-      {
-        if (Verbosity())
-        {
-          std::cout << __FILE__ << "::" << __FUNCTION__ << "::" << __LINE__ << ":: Processing organizer" << std::endl;
-        }
+// Unless this is the MBD or HCAL Cosmics trigger, EMCAL and HCAL will go through here.
+// This creates the 8x8 non-overlapping sums and the jet primitive sums.
 
-        TriggerDefs::TriggerSumKey jet_skey = (*iter_sum).first;
-	uint16_t jet_sum_loc =  TriggerDefs::getSumLocId(jet_skey);
-	uint16_t jet_prim_loc =  TriggerDefs::getPrimitiveLocId_from_TriggerSumKey(jet_skey);
-	if (jet_prim_loc >= 12)
-	  {
-	    uint16_t sumeta = TriggerDefs::getSumEtaId(jet_skey);
-	    uint16_t sumphi = TriggerDefs::getSumPhiId(jet_skey);
-	    jet_sum_loc = sumphi%2 + sumeta*2;
-	  }
-	TriggerDefs::TriggerSumKey hcal_skey = TriggerDefs::getTriggerSumKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::GetDetectorId("HCAL"), TriggerDefs::GetPrimitiveId("JET"), TriggerDefs::getPrimitiveLocId_from_TriggerPrimKey(jet_pkey), jet_sum_loc);
-
-	
-        TriggerDefs::TriggerSumKey emcal_skey = TriggerDefs::getTriggerSumKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("JET"), TriggerDefs::getPrimitiveLocId_from_TriggerPrimKey(jet_pkey), TriggerDefs::getSumLocId(jet_skey));
-
-        int i = 0;
-        if (Verbosity())
-        {
-          std::cout << __FILE__ << "::" << __FUNCTION__ << "::" << __LINE__ << ":: Processing organizer" << std::endl;
-        }
+int CaloTriggerEmulator::process_organizer()
+{
+  if (Verbosity())
+  {
+    std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing organizer" << std::endl;
+  }
 
-        for (unsigned int &it_s : *(iter_sum->second))
-        {
-          unsigned int sum_hcal = m_primitives_hcal_ll1->get_primitive_at_key(hcal_pkey)->get_sum_at_key(hcal_skey)->at(i);
-          unsigned int sum_emcal = m_primitives_emcal_ll1->get_primitive_at_key(emcal_pkey)->get_sum_at_key(emcal_skey)->at(i);
-          it_s = ((sum_hcal >> 1U) + (sum_emcal >> 1U)) & 0xffU;
-          i++;
-        }
-      }
-    }
+  m_triggerid = TriggerDefs::TriggerId::jetTId;
+
+  sum_8x8((m_do_emcal ? m_sums_emcal.data() : nullptr),
+          (m_do_hcalin ? m_sums_hcalin.data() : nullptr),
+          (m_do_hcalout ? m_sums_hcalout.data() : nullptr),
+          m_sums_emcal_8x8.data(), m_sums_hcal_8x8.data(), m_sums_jet.data());
+
+  if (Verbosity() >= 2)
+  {
+    std::cout << __FUNCTION__ << " " << __LINE__ << " filling 8x8 non-overlapping sums and jet primitives" << std::endl;
   }
 
+  fill_jet_primitives(m_primitives_emcal_ll1, m_sums_emcal_8x8);
+  fill_jet_primitives(m_primitives_hcal_ll1, m_sums_hcal_8x8);
+  fill_jet_primitives(m_primitives_jet, m_sums_jet);
+
   return 0;
 }
 
@@ -1804,24 +1778,10 @@ int CaloTriggerEmulator::process_organizer()
 
 int CaloTriggerEmulator::process_trigger()
 {
-  std::vector<unsigned int> bits;
-
-  int nsample = m_nsamples - 1;
-  // bits are to say whether the trigger has fired. this is what is sent to the GL1
-  if (m_trig_sample > 0)
-  {
-    nsample = 1;
-  }
-  bits.reserve(nsample);
-  for (int is = 0; is < nsample; is++)
-  {
-    bits.push_back(0);
-  }
+  trigger_decision(m_sums_emcal_8x8.data(), m_sums_jet.data(), m_jet_map.data(), m_photon_bits.data(), m_jet_bits.data());
 
   // photon
-  // 8x8 non-overlapping sums in the EMCAL
-  // create the 8x8 non-overlapping sum
-
+  // the 8x8 non-overlapping sums in the EMCAL above threshold
   {
     m_triggerid = TriggerDefs::TriggerId::photonTId;
     std::vector<unsigned int> *trig_bits = m_ll1out_photon->GetTriggerBits();
@@ -1830,51 +1790,33 @@ int CaloTriggerEmulator::process_trigger()
       std::cout << __FUNCTION__ << " " << __LINE__ << " processing PHOTON trigger , bits before: " << trig_bits->size() << std::endl;
     }
 
-    TriggerPrimitiveContainer::Range range = m_primitives_emcal_ll1->getTriggerPrimitives();
-
-    for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
+    for (unsigned int iprim = 0; iprim < n_jet_primitives; iprim++)
     {
-      // get key and see if masked
-      TriggerDefs::TriggerPrimKey key = (*iter).first;
-      if (CheckFiberMasks(key))
+      if (m_jet_prim_masked[iprim])
       {
         continue;
       }
-
-      // get the primitive (16 2x2 sums)
-      TriggerPrimitive *primitive = (*iter).second;
-
-      TriggerPrimitivev1::Range sumrange = primitive->getSums();
-
-      // iterate through all 24 sums and add together
-      for (TriggerPrimitivev1::Iter iter_sum = sumrange.first; iter_sum != sumrange.second; ++iter_sum)
+      TriggerDefs::TriggerPrimKey key = TriggerDefs::getTriggerPrimKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::DetectorId::emcalDId, TriggerDefs::PrimitiveId::jetPId, iprim);
+      for (unsigned int isum = 0; isum < n_jet_prim_sums; isum++)
       {
-        // check if sum is greater than threshold.
-        if (Verbosity() >= 2)
-        {
-          std::cout << __FUNCTION__ << " " << __LINE__ << " processing PHOTON trigger" << std::endl;
-        }
-
-        std::vector<unsigned int> *t_sum = (*iter_sum).second;
-        TriggerDefs::TriggerSumKey sumk = (*iter_sum).first;
-        for (int is = 0; is < nsample; is++)
+        const unsigned int *t_sum = m_sums_emcal_8x8.data() + (((iprim * n_jet_prim_sums) + isum) * m_nwindow);
+        for (unsigned int is = 0; is < m_nwindow; is++)
         {
-          unsigned short bit = getBits(t_sum->at(is), TriggerDefs::TriggerId::photonTId);
-          if (bit)
+          if (threshold_bits(t_sum[is], m_threshold_photon))
           {
-            m_ll1out_photon->addTriggeredSum(sumk, t_sum->at(is));
+            TriggerDefs::TriggerSumKey sumk = TriggerDefs::getTriggerSumKey(TriggerDefs::TriggerId::jetTId, TriggerDefs::DetectorId::emcalDId, TriggerDefs::PrimitiveId::jetPId, iprim, isum);
+            m_ll1out_photon->addTriggeredSum(sumk, t_sum[is]);
             m_ll1out_photon->addTriggeredPrimitive(key);
           }
-          bits.at(is) |= bit;
         }
       }
     }
 
     uint16_t pass = 0;
-    for (int is = 0; is < nsample; is++)
+    for (unsigned int is = 0; is < m_nwindow; is++)
     {
-      pass |= bits.at(is);
-      trig_bits->push_back(bits.at(is));
+      pass |= m_photon_bits[is];
+      trig_bits->push_back(m_photon_bits[is]);
     }
 
     if (pass)
@@ -1888,113 +1830,35 @@ int CaloTriggerEmulator::process_trigger()
       std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger" << std::endl;
     }
 
-    // Make the jet primitives
+    // the 4x4 overlapping sums of the jet primitives
     m_triggerid = TriggerDefs::TriggerId::jetTId;
     std::vector<unsigned int> *trig_bits = m_ll1out_jet->GetTriggerBits();
-    std::vector<unsigned int> jet_map[32][9]{};
-    for (auto &ie : jet_map)
-    {
-      for (auto &ip : ie)
-      {
-        for (int is = 0; is < nsample; is++)
-        {
-          ip.push_back(0);
-        }
-      }
-    }
-
-    if (!m_primitives_jet)
-    {
-      std::cout << "There is no primitive container" << std::endl;
-      return Fun4AllReturnCodes::EVENT_OK;
-    }
-
-    // iterate through emcal primitives and organize into the 16 jet primitives each with the 8x8 nonoverlapping sum
-    TriggerPrimitiveContainer::Range range = m_primitives_jet->getTriggerPrimitives();
-
-    for (TriggerPrimitiveContainerv1::Iter iter = range.first; iter != range.second; ++iter)
-    {
-      // get the primitive (16 2x2 sums)
-      TriggerPrimitive *primitive = (*iter).second;
-      TriggerPrimitivev1::Range sumrange = primitive->getSums();
-
-      // iterate through all 16 sums and add together
-      for (TriggerPrimitivev1::Iter iter_sum = sumrange.first; iter_sum != sumrange.second; ++iter_sum)
-      {
-        TriggerDefs::TriggerSumKey sumkey = (*iter_sum).first;
-
-        int i = 0;
-        int sum_phi = static_cast<int>((TriggerDefs::getPrimitivePhiId_from_TriggerSumKey(sumkey) * 2) + TriggerDefs::getSumPhiId(sumkey));
-        int sum_eta = static_cast<int>(TriggerDefs::getSumEtaId(sumkey));
-        if (Verbosity() >= 2)
-        {
-          std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger " << sum_phi << " " << sum_eta << std::endl;
-        }
-
-        for (unsigned int &it_s : *(iter_sum->second))
-        {
-          for (int ijeta = (sum_eta <= 3 ? 0 : sum_eta - 3); ijeta <= (sum_eta > 8 ? 8 : sum_eta); ijeta++)
-          {
-            for (int ijphi = sum_phi - 3; ijphi <= sum_phi; ijphi++)
-            {
-              int iphi = (ijphi < 0 ? 32 + ijphi : ijphi);
-              jet_map[iphi][ijeta].at(i) += it_s;
-            }
-          }
-          i++;
-        }
-      }
-    }
-    if (Verbosity() >= 2)
-    {
-      std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger" << std::endl;
-    }
 
     int pass = 0;
-    for (int ijphi = 0; ijphi < 32; ijphi++)
+    for (int ijphi = 0; ijphi < n_jet_phi; ijphi++)
     {
-      for (int ijeta = 0; ijeta < 9; ijeta++)
+      for (int ijeta = 0; ijeta < n_jet_eta; ijeta++)
       {
-        if (Verbosity() >= 2)
-        {
-          std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger " << ijphi << " " << ijeta << std::endl;
-        }
-
         unsigned int sk = ((unsigned int) ijphi & 0xffffU) + (((unsigned int) ijeta & 0xffffU) << 16U);
+        const unsigned int *jet_sum = m_jet_map.data() + (((ijphi * n_jet_eta) + ijeta) * m_nwindow);
         std::vector<unsigned int> *sum = m_ll1out_jet->get_word(sk);
-        if (Verbosity() >= 2)
-        {
-          std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger " << ijphi << " " << ijeta << std::endl;
-        }
-
-        for (int is = 0; is < nsample; is++)
+        sum->insert(sum->end(), jet_sum, jet_sum + m_nwindow);
+        for (unsigned int is = 0; is < m_nwindow; is++)
         {
-          if (Verbosity() >= 2)
-          {
-            std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger " << ijphi << " " << ijeta << std::endl;
-          }
-
-          sum->push_back(jet_map[ijphi][ijeta].at(is));
-          unsigned short bit = getBits(jet_map[ijphi][ijeta].at(is), TriggerDefs::TriggerId::jetTId);
-
-          if (bit)
+          if (threshold_bits(jet_sum[is], m_threshold_jet))
           {
-            m_ll1out_jet->addTriggeredSum(sk, jet_map[ijphi][ijeta].at(is));
+            m_ll1out_jet->addTriggeredSum(sk, jet_sum[is]);
             m_ll1out_jet->addTriggeredPrimitive(sk);
             pass = 1;
           }
-          bits.at(is) |= bit;
         }
       }
     }
-    if (Verbosity() >= 2)
-    {
-      std::cout << __FUNCTION__ << " " << __LINE__ << " processing JET trigger" << std::endl;
-    }
 
-    for (int is = 0; is < nsample; is++)
+    // the jet trigger word carries the photon bits as well
+    for (unsigned int is = 0; is < m_nwindow; is++)
     {
-      trig_bits->push_back(bits.at(is));
+      trig_bits->push_back(m_photon_bits[is] | m_jet_bits[is]);
     }
 
     if (pass)
@@ -2505,6 +2369,10 @@ int CaloTriggerEmulator::End(PHCompositeNode * /*topNode*/)
   std::cout << "Total Jet passed: " << m_jet_npassed << "/" << m_nevent << std::endl;
   std::cout << "Total Photon passed: " << m_photon_npassed << "/" << m_nevent << std::endl;
   std::cout << "Total Pair passed: " << m_pair_npassed << "/" << m_nevent << std::endl;
+  if (m_check_batch)
+  {
+    std::cout << "Batch emulation mismatches: " << m_batch_mismatches << "/" << m_batch_checks << std::endl;
+  }
   std::cout << "------------------------" << std::endl;
 
   return 0;
@@ -2597,33 +2465,15 @@ unsigned int CaloTriggerEmulator::getBits(unsigned int sum, TriggerDefs::Trigger
 {
   if (tid == TriggerDefs::TriggerId::jetTId)
   {
-    unsigned int bit = 0;
-    for (unsigned int i = 0; i < 4; i++)
-    {
-      bit |= (sum >= m_threshold_jet[i] ? 0x1U << (i) : 0);
-    }
-
-    return bit;
+    return threshold_bits(sum, m_threshold_jet);
   }
   if (tid == TriggerDefs::TriggerId::pairTId)
   {
-    unsigned int bit = 0;
-    for (unsigned int i = 0; i < 4; i++)
-    {
-      bit |= (sum >= m_threshold_pair[i] ? 0x1U << (i) : 0);
-    }
-
-    return bit;
+    return threshold_bits(sum, m_threshold_pair);
   }
   if (tid == TriggerDefs::TriggerId::photonTId)
   {
-    unsigned int bit = 0;
-    for (unsigned int i = 0; i < 4; i++)
-    {
-      bit |= (sum >= m_threshold_photon[i] ? 0x1U << (i) : 0);
-    }
-
-    return bit;
+    return threshold_bits(sum, m_threshold_photon);
   }
   return 0;
 }
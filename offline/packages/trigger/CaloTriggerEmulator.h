@@ -5,6 +5,7 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -18,7 +19,6 @@ class Event;
 class TowerInfoContainer;
 class CaloPacketContainer;
 class PHCompositeNode;
-class TH1;
 
 class CaloTriggerEmulator : public SubsysReco
 {
@@ -62,6 +62,19 @@ class CaloTriggerEmulator : public SubsysReco
 
   int process_trigger();
 
+  //! Standalone emulation of the LUT and 2x2 sum stage of one calorimeter (EMCAL, HCALIN or HCALOUT)
+  //! for a batch of events, without the node tree. waveforms holds nevents x channels x nsamples ADC
+  //! samples in channel order (nsamples is taken from the size, samples past the end read as 0),
+  //! sums is filled with nevents x primitives x 16 sums x window samples.
+  //! Needs InitRun to have loaded the LUTs with the detector enabled.
+  int process_batch(TriggerDefs::DetectorId detId, const std::vector<int16_t> &waveforms, unsigned int nevents, std::vector<unsigned int> &sums);
+
+  //! Standalone emulation of the whole jet/photon chain for a batch of events, waveforms as above,
+  //! an empty vector leaves that calorimeter out. jet_sums is filled with nevents x 32 phi x 9 eta
+  //! x window samples 4x4 jet sums, photon_bits and jet_bits with nevents x window samples trigger
+  //! bits (jet_bits without the photon bits which the LL1Out jet word carries as well).
+  int process_batch(const std::vector<int16_t> &emcal, const std::vector<int16_t> &hcalin, const std::vector<int16_t> &hcalout, unsigned int nevents, std::vector<unsigned int> &jet_sums, std::vector<unsigned int> &photon_bits, std::vector<unsigned int> &jet_bits);
+
   unsigned int getBits(unsigned int sum, TriggerDefs::TriggerId tid);
 
   int Download_Calibrations();
@@ -90,6 +103,9 @@ class CaloTriggerEmulator : public SubsysReco
   void useEMCAL(bool use);
 
   void setNSamples(int nsamples) { m_nsamples = nsamples; }
+
+  //! run every simulated event through process_batch as well and compare with the node tree output
+  void checkBatch(bool b) { m_check_batch = b; }
   void setThreshold(int threshold) { m_threshold = threshold; }
   void setJetThreshold(int t1, int t2, int t3, int t4)
   {
@@ -125,6 +141,39 @@ class CaloTriggerEmulator : public SubsysReco
   void identify();
 
  private:
+  //! integer LUT, one 1024 entry table per channel or a single shared table (stride 0)
+  struct FlatLUT
+  {
+    std::vector<uint16_t> table;
+    unsigned int stride{0};
+    const uint16_t *channel(unsigned int ch) const { return table.data() + ch * stride; }
+  };
+
+  void FillLUT(FlatLUT &lut, CDBHistos *histos, const std::string &prefix, unsigned int nchannels);
+  void BuildPrimitiveTables();
+  void store_peak_sub_ped(std::vector<unsigned int> &peaks, unsigned int channel, const int *samples) const;
+  void sum_2x2(const unsigned int *peaks, const FlatLUT &lut, const unsigned int *channels, unsigned int tower_mask, unsigned int sum_mask, unsigned int *sums) const;
+  void sum_8x8(const unsigned int *emcal, const unsigned int *hcalin, const unsigned int *hcalout, unsigned int *emcal_8x8, unsigned int *hcal_8x8, unsigned int *jet) const;
+  void trigger_decision(const unsigned int *emcal_8x8, const unsigned int *jet, unsigned int *jet_map, unsigned int *photon_bits, unsigned int *jet_bits) const;
+  void fill_jet_primitives(TriggerPrimitiveContainer *primitives, const std::vector<unsigned int> &sums) const;
+
+  //! lookup tables, tower channels and masked 2x2 sums of one calorimeter for process_batch
+  struct BatchDetector
+  {
+    std::string name;
+    const FlatLUT *lut{nullptr};
+    const std::vector<unsigned int> *channels{nullptr};
+    unsigned int nchannels{0};
+    unsigned int nsamples{0};
+    unsigned int tower_mask{0xff};
+    unsigned int sum_mask{0x3ff};
+    std::vector<bool> masked;
+  };
+
+  int GetBatchDetector(TriggerDefs::DetectorId detId, size_t nwaveform, unsigned int nevents, BatchDetector &det);
+  void batch_sum_2x2(const BatchDetector &det, const int16_t *waveforms, std::vector<int> &samples, std::vector<unsigned int> &peaks, unsigned int *sums) const;
+  void CheckBatch();
+
   std::string m_ll1_nodename;
   std::string m_prim_nodename;
   std::string m_waveform_nodename;
@@ -195,18 +244,49 @@ class CaloTriggerEmulator : public SubsysReco
   unsigned int m_l1_8x8_table[1024]{};
   unsigned int m_l1_slewing_table[4096]{};
 
-  std::map<unsigned int, TH1 *> h_emcal_lut{};
-  std::map<unsigned int, TH1 *> h_hcalin_lut{};
-  std::map<unsigned int, TH1 *> h_hcalout_lut{};
+  FlatLUT m_lut_emcal{};
+  FlatLUT m_lut_hcalin{};
+  FlatLUT m_lut_hcalout{};
 
   CDBTTree *cdbttree_adcmask{nullptr};
   CDBHistos *cdbttree_emcal{nullptr};
   CDBHistos *cdbttree_hcalin{nullptr};
   CDBHistos *cdbttree_hcalout{nullptr};
 
-  std::map<unsigned int, std::vector<unsigned int>> m_peak_sub_ped_emcal{};
-  std::map<unsigned int, std::vector<unsigned int>> m_peak_sub_ped_hcalin{};
-  std::map<unsigned int, std::vector<unsigned int>> m_peak_sub_ped_hcalout{};
+  //! peak - pedestal per [channel][sample in window]
+  std::vector<unsigned int> m_peak_sub_ped_emcal{};
+  std::vector<unsigned int> m_peak_sub_ped_hcalin{};
+  std::vector<unsigned int> m_peak_sub_ped_hcalout{};
+
+  //! tower channels of every 2x2 sum, [primitive][sum][tower]
+  std::vector<unsigned int> m_sum_channels_emcal{};
+  std::vector<unsigned int> m_sum_channels_hcal{};
+
+  //! 2x2 sums per [primitive][sum][sample in window]
+  std::vector<unsigned int> m_sums_emcal{};
+  std::vector<unsigned int> m_sums_hcalin{};
+  std::vector<unsigned int> m_sums_hcalout{};
+
+  //! 8x8 and jet primitive sums per [jet primitive][sum][sample in window]
+  std::vector<unsigned int> m_sums_emcal_8x8{};
+  std::vector<unsigned int> m_sums_hcal_8x8{};
+  std::vector<unsigned int> m_sums_jet{};
+
+  //! 4x4 jet sums per [phi][eta][sample in window] and trigger bits per sample in window
+  std::vector<unsigned int> m_jet_map{};
+  std::vector<unsigned int> m_photon_bits{};
+  std::vector<unsigned int> m_jet_bits{};
+
+  //! 8x8 sum of every hcal 2x2 sum, hcal 8x8 sum of every jet primitive sum
+  std::vector<unsigned int> m_hcal_8x8_index{};
+  std::vector<unsigned int> m_jet_hcal_index{};
+  std::vector<bool> m_jet_prim_masked{};
+
+  //! waveform samples of the channel being processed
+  std::vector<int> m_samples{};
+  int m_sample_start{1};
+  int m_sample_end{0};
+  unsigned int m_nwindow{0};
 
   //! Verbosity.
   int m_nevent{0};
@@ -214,6 +294,10 @@ class CaloTriggerEmulator : public SubsysReco
   int m_jet_npassed{0};
   int m_pair_npassed{0};
 
+  bool m_check_batch{false};
+  int m_batch_checks{0};
+  int m_batch_mismatches{0};
+
   int m_n_sums;
   int m_n_primitives;
   int m_trig_sub_delay;
@@ -0,0 +1,286 @@
+#include "PHG4ShowerLibrary.h"
+
+#include "PHG4CylinderCellGeom_Spacalv1.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+namespace
+{
+  const char file_magic[8] = {'P', 'H', 'G', '4', 'S', 'H', 'L', 'B'};
+  const uint32_t file_version = 1;
+
+  // anything above these counts means the file is corrupt
+  const uint32_t max_edges = 1U << 10U;
+  const uint32_t max_showers_per_bin = 1U << 24U;
+  const uint32_t max_deposits_per_shower = 1U << 16U;
+
+  template <typename T>
+  void write_value(std::ofstream &out, const T &value)
+  {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  bool read_value(std::ifstream &in, T &value)
+  {
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return in.good();
+  }
+
+  void write_edges(std::ofstream &out, const std::vector<double> &edges)
+  {
+    write_value(out, static_cast<uint32_t>(edges.size()));
+    for (double edge : edges)
+    {
+      write_value(out, edge);
+    }
+  }
+
+  bool read_edges(std::ifstream &in, std::vector<double> &edges)
+  {
+    uint32_t n = 0;
+    if (!read_value(in, n) || n > max_edges)
+    {
+      return false;
+    }
+    edges.resize(n);
+    for (double &edge : edges)
+    {
+      if (!read_value(in, edge))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}  // namespace
+
+void PHG4ShowerLibrary::set_binning(const std::vector<double> &energy, const std::vector<double> &eta, const std::vector<double> &angle)
+{
+  m_EnergyEdges = energy;
+  m_EtaEdges = eta;
+  m_AngleEdges = angle;
+  size_t nbins = kNClasses;
+  for (const auto *edges : {&m_EnergyEdges, &m_EtaEdges, &m_AngleEdges})
+  {
+    nbins *= (edges->size() > 1) ? edges->size() - 1 : 0;
+  }
+  m_Showers.clear();
+  m_Showers.resize(nbins);
+}
+
+int PHG4ShowerLibrary::find_bin(const std::vector<double> &edges, const double x)
+{
+  if (edges.size() < 2 || x < edges.front() || x >= edges.back())
+  {
+    return -1;
+  }
+  return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+}
+
+PHG4ShowerLibrary::ParticleClass PHG4ShowerLibrary::get_particle_class(const int pdgcode)
+{
+  switch (std::abs(pdgcode))
+  {
+  case 11:  // e+-
+  case 22:  // gamma
+    return kElectromagnetic;
+  case 211:   // pi+-
+  case 321:   // K+-
+  case 2212:  // proton
+  case 2112:  // neutron
+  case 130:   // K0L
+    return kHadron;
+  default:
+    break;
+  }
+  return kInvalid;
+}
+
+int PHG4ShowerLibrary::get_bin(const int pdgcode, const double energy, const double eta, const double angle) const
+{
+  ParticleClass pclass = get_particle_class(pdgcode);
+  if (pclass == kInvalid)
+  {
+    return -1;
+  }
+  int ienergy = find_bin(m_EnergyEdges, energy);
+  int ieta = find_bin(m_EtaEdges, std::abs(eta));
+  int iangle = find_bin(m_AngleEdges, angle);
+  if (ienergy < 0 || ieta < 0 || iangle < 0)
+  {
+    return -1;
+  }
+  const int neta = m_EtaEdges.size() - 1;
+  const int nangle = m_AngleEdges.size() - 1;
+  const int nenergy = m_EnergyEdges.size() - 1;
+  return ((pclass * nenergy + ienergy) * neta + ieta) * nangle + iangle;
+}
+
+void PHG4ShowerLibrary::add_shower(const int bin, const Shower &shower)
+{
+  if (bin < 0 || static_cast<size_t>(bin) >= m_Showers.size())
+  {
+    return;
+  }
+  m_Showers[bin].push_back(shower);
+}
+
+const PHG4ShowerLibrary::Shower *PHG4ShowerLibrary::sample(const int bin, const double u) const
+{
+  if (bin < 0 || static_cast<size_t>(bin) >= m_Showers.size() || m_Showers[bin].empty())
+  {
+    return nullptr;
+  }
+  const std::vector<Shower> &showers = m_Showers[bin];
+  size_t ishower = std::min<size_t>(u * showers.size(), showers.size() - 1);
+  return &showers[ishower];
+}
+
+size_t PHG4ShowerLibrary::get_nshowers(const int bin) const
+{
+  if (bin < 0 || static_cast<size_t>(bin) >= m_Showers.size())
+  {
+    return 0;
+  }
+  return m_Showers[bin].size();
+}
+
+bool PHG4ShowerLibrary::empty() const
+{
+  return std::all_of(m_Showers.begin(), m_Showers.end(), [](const std::vector<Shower> &showers)
+                     { return showers.empty(); });
+}
+
+bool PHG4ShowerLibrary::write(const std::string &filename) const
+{
+  std::ofstream out(filename, std::ios::binary);
+  if (!out.is_open())
+  {
+    std::cout << "PHG4ShowerLibrary::write - could not open " << filename << std::endl;
+    return false;
+  }
+  out.write(file_magic, sizeof(file_magic));
+  write_value(out, file_version);
+  write_edges(out, m_EnergyEdges);
+  write_edges(out, m_EtaEdges);
+  write_edges(out, m_AngleEdges);
+  write_value(out, static_cast<uint32_t>(m_Showers.size()));
+  for (const auto &showers : m_Showers)
+  {
+    write_value(out, static_cast<uint32_t>(showers.size()));
+    for (const auto &shower : showers)
+    {
+      write_value(out, static_cast<uint32_t>(shower.size()));
+      for (const auto &deposit : shower)
+      {
+        write_value(out, deposit.deta);
+        write_value(out, deposit.dphi);
+        write_value(out, deposit.fraction);
+      }
+    }
+  }
+  return out.good();
+}
+
+bool PHG4ShowerLibrary::read(const std::string &filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  if (!in.is_open())
+  {
+    std::cout << "PHG4ShowerLibrary::read - could not open " << filename << std::endl;
+    return false;
+  }
+  char magic[sizeof(file_magic)];
+  in.read(magic, sizeof(magic));
+  uint32_t version = 0;
+  if (!in.good() || !std::equal(magic, magic + sizeof(magic), file_magic) || !read_value(in, version) || version != file_version)
+  {
+    std::cout << "PHG4ShowerLibrary::read - " << filename << " is not a shower library (version " << file_version << ")" << std::endl;
+    return false;
+  }
+  std::vector<double> energy;
+  std::vector<double> eta;
+  std::vector<double> angle;
+  uint32_t nbins = 0;
+  if (!read_edges(in, energy) || !read_edges(in, eta) || !read_edges(in, angle) || !read_value(in, nbins))
+  {
+    std::cout << "PHG4ShowerLibrary::read - corrupt header in " << filename << std::endl;
+    return false;
+  }
+  set_binning(energy, eta, angle);
+  if (nbins != m_Showers.size())
+  {
+    std::cout << "PHG4ShowerLibrary::read - " << filename << " has " << nbins
+              << " bins, binning needs " << m_Showers.size() << std::endl;
+    m_Showers.clear();
+    return false;
+  }
+  for (auto &showers : m_Showers)
+  {
+    uint32_t nshowers = 0;
+    if (!read_value(in, nshowers) || nshowers > max_showers_per_bin)
+    {
+      std::cout << "PHG4ShowerLibrary::read - truncated or corrupt file " << filename << std::endl;
+      m_Showers.clear();
+      return false;
+    }
+    showers.resize(nshowers);
+    for (auto &shower : showers)
+    {
+      uint32_t ndeposits = 0;
+      if (!read_value(in, ndeposits) || ndeposits > max_deposits_per_shower)
+      {
+        std::cout << "PHG4ShowerLibrary::read - truncated or corrupt file " << filename << std::endl;
+        m_Showers.clear();
+        return false;
+      }
+      shower.resize(ndeposits);
+      for (auto &deposit : shower)
+      {
+        if (!read_value(in, deposit.deta) || !read_value(in, deposit.dphi) || !read_value(in, deposit.fraction) ||
+            !std::isfinite(deposit.fraction) || deposit.fraction < 0)
+        {
+          std::cout << "PHG4ShowerLibrary::read - truncated or corrupt file " << filename << std::endl;
+          m_Showers.clear();
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool PHG4ShowerLibrary::get_tower_bin(const PHG4CylinderCellGeom_Spacalv1 *geo, const double eta, const double phi, int &etabin, int &phibin)
+{
+  etabin = -1;
+  const PHG4CylinderCellGeom_Spacalv1::bound_map_t &eta_bounds = geo->get_eta_bound_map();
+  if (eta_bounds.empty() || eta < eta_bounds.begin()->second.first || eta >= eta_bounds.rbegin()->second.second)
+  {
+    return false;
+  }
+  // there are small gaps between the blocks, use the closest bin like RawTowerGeomContainer_Cylinderv1
+  double min_deta = std::numeric_limits<double>::max();
+  for (const auto &bounds : eta_bounds)
+  {
+    if (eta >= bounds.second.first && eta < bounds.second.second)
+    {
+      etabin = bounds.first;
+      break;
+    }
+    const double deta = std::abs(0.5 * (bounds.second.first + bounds.second.second) - eta);
+    if (deta < min_deta)
+    {
+      min_deta = deta;
+      etabin = bounds.first;
+    }
+  }
+  phibin = geo->get_phibin(phi);
+  return (phibin >= 0 && phibin < geo->get_phibins());
+}
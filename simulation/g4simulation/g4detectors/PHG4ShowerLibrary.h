@@ -0,0 +1,82 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4SHOWERLIBRARY_H
+#define G4DETECTORS_PHG4SHOWERLIBRARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class PHG4CylinderCellGeom_Spacalv1;
+
+/*!
+ * \brief Library of pre-generated calorimeter showers at tower granularity
+ *
+ * Showers are binned in particle class, kinetic energy, |eta| and the angle between
+ * the momentum and the position vector where the particle enters the calorimeter.
+ * A shower is a list of towers relative to the entry tower (eta bins mirrored for
+ * eta < 0) with the visible energy in units of the kinetic energy of the particle.
+ * Libraries are written by PHG4ShowerLibraryMaker and read by the stepping action
+ * which replaces the Geant4 tracking of particles entering the calorimeter.
+ * Only the spacal in tower mode uses it, the library showers are added to the towers and
+ * no PHG4Hits are made. The hadronic calorimeters are always fully simulated.
+ */
+class PHG4ShowerLibrary
+{
+ public:
+  struct Deposit
+  {
+    int16_t deta{0};
+    int16_t dphi{0};
+    float fraction{0};
+  };
+  using Shower = std::vector<Deposit>;
+
+  enum ParticleClass
+  {
+    kInvalid = -1,
+    kElectromagnetic = 0,
+    kHadron = 1,
+    kNClasses = 2
+  };
+
+  PHG4ShowerLibrary() = default;
+  virtual ~PHG4ShowerLibrary() = default;
+
+  //! bin edges in kinetic energy (GeV), |eta| and entry angle (rad), clears the library
+  void set_binning(const std::vector<double> &energy, const std::vector<double> &eta, const std::vector<double> &angle);
+
+  //! library bin, -1 if outside of the binning or for unsupported particles
+  int get_bin(const int pdgcode, const double energy, const double eta, const double angle) const;
+
+  void add_shower(const int bin, const Shower &shower);
+
+  //! pick one of the showers in a bin, u uniform in [0,1). nullptr for an empty bin
+  const Shower *sample(const int bin, const double u) const;
+
+  size_t get_nshowers(const int bin) const;
+  size_t get_nbins() const { return m_Showers.size(); }
+  bool empty() const;
+
+  //! compact binary file, returns false on failure
+  bool write(const std::string &filename) const;
+  bool read(const std::string &filename);
+
+  static ParticleClass get_particle_class(const int pdgcode);
+
+  //! tower bins in the spacal cell geometry of a point with given eta and phi, false if outside
+  static bool get_tower_bin(const PHG4CylinderCellGeom_Spacalv1 *geo, const double eta, const double phi, int &etabin, int &phibin);
+
+ private:
+  static int find_bin(const std::vector<double> &edges, const double x);
+
+  std::vector<double> m_EnergyEdges;
+  std::vector<double> m_EtaEdges;
+  std::vector<double> m_AngleEdges;
+
+  //! [class][energy][eta][angle]
+  std::vector<std::vector<Shower>> m_Showers;
+};
+
+#endif
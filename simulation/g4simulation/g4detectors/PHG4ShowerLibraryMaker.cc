@@ -0,0 +1,160 @@
+#include "PHG4ShowerLibraryMaker.h"
+
+#include "PHG4CylinderCellGeom.h"
+#include "PHG4CylinderCellGeomContainer.h"
+#include "PHG4CylinderCellGeom_Spacalv1.h"
+
+#include <calobase/TowerInfo.h>
+#include <calobase/TowerInfoContainer.h>
+#include <calobase/TowerInfoDefs.h>
+
+#include <g4main/PHG4Particle.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+#include <g4main/PHG4VtxPoint.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/getClass.h>
+
+#include <TVector3.h>
+
+#include <algorithm>  // for max
+#include <cmath>
+#include <iostream>
+#include <iterator>  // for distance
+
+PHG4ShowerLibraryMaker::PHG4ShowerLibraryMaker(const std::string &name)
+  : SubsysReco(name)
+{
+  set_binning({0.5, 1, 2, 4, 8, 16, 32, 64},
+              {0, 0.2, 0.4, 0.6, 0.8, 1.0, 1.2},
+              {0, 0.05, 0.1, 0.2, 0.4, 1.6});
+}
+
+void PHG4ShowerLibraryMaker::set_binning(const std::vector<double> &energy, const std::vector<double> &eta, const std::vector<double> &angle)
+{
+  m_Library.set_binning(energy, eta, angle);
+}
+
+int PHG4ShowerLibraryMaker::InitRun(PHCompositeNode *topNode)
+{
+  const std::string seggeonodename = "CYLINDERCELLGEOM_" + m_Detector;
+  PHG4CylinderCellGeomContainer *seggeo = findNode::getClass<PHG4CylinderCellGeomContainer>(topNode, seggeonodename);
+  if (!seggeo)
+  {
+    std::cout << Name() << " - could not locate cell geometry node " << seggeonodename << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  m_CellGeom = dynamic_cast<PHG4CylinderCellGeom_Spacalv1 *>(seggeo->GetFirstLayerCellGeom());
+  if (!m_CellGeom)
+  {
+    std::cout << Name() << " - " << seggeonodename << " is not a spacal cell geometry" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  m_TowerNodeName = "TOWERINFO_SIM_" + m_Detector;
+  if (!findNode::getClass<TowerInfoContainer>(topNode, m_TowerNodeName))
+  {
+    std::cout << Name() << " - could not locate " << m_TowerNodeName
+              << ", the shower library needs the spacal in tower mode (saveg4hit = 0)" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4ShowerLibraryMaker::process_event(PHCompositeNode *topNode)
+{
+  PHG4TruthInfoContainer *truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+  TowerInfoContainer *towers = findNode::getClass<TowerInfoContainer>(topNode, m_TowerNodeName);
+  if (!truthinfo || !towers)
+  {
+    std::cout << Name() << " - G4TruthInfo or " << m_TowerNodeName << " missing" << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  PHG4TruthInfoContainer::Range primaries = truthinfo->GetPrimaryParticleRange();
+  if (std::distance(primaries.first, primaries.second) != 1)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << Name() << " - skipping event without exactly one primary particle" << std::endl;
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  const PHG4Particle *particle = primaries.first->second;
+  const PHG4VtxPoint *vtx = truthinfo->GetPrimaryVtx(particle->get_vtx_id());
+  if (!vtx)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  const TVector3 mom(particle->get_px(), particle->get_py(), particle->get_pz());
+  const TVector3 vertex(vtx->get_x(), vtx->get_y(), vtx->get_z());
+  const double kinetic = particle->get_e() - std::sqrt(std::max(particle->get_e() * particle->get_e() - mom.Mag2(), 0.));
+
+  // straight line to the inner radius, ignores the bending in the magnetic field
+  const double radius = m_CellGeom->get_radius();
+  const double a = mom.Perp2();
+  const double b = 2 * (vertex.X() * mom.X() + vertex.Y() * mom.Y());
+  const double c = vertex.Perp2() - radius * radius;
+  if (a <= 0 || c >= 0 || kinetic <= 0)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  const TVector3 entry = vertex + ((-b + std::sqrt(b * b - 4 * a * c)) / (2 * a)) * mom;
+
+  const int bin = m_Library.get_bin(particle->get_pid(), kinetic, entry.Eta(), mom.Angle(entry));
+  int etabin = -1;
+  int phibin = -1;
+  if (bin < 0 || !PHG4ShowerLibrary::get_tower_bin(m_CellGeom, entry.Eta(), entry.Phi(), etabin, phibin))
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  const int etasign = (entry.Eta() < 0) ? -1 : 1;
+  const int nphibins = m_CellGeom->get_phibins();
+  PHG4ShowerLibrary::Shower shower;
+  const unsigned int ntowers = towers->size();
+  for (unsigned int channel = 0; channel < ntowers; channel++)
+  {
+    const float fraction = towers->get_tower_at_channel(channel)->get_energy() / kinetic;
+    if (fraction < m_FractionThreshold)
+    {
+      continue;
+    }
+    const unsigned int key = towers->encode_key(channel);
+    int dphi = static_cast<int>(TowerInfoDefs::getCaloTowerPhiBin(key)) - phibin;
+    // wrap into [-nphibins/2, nphibins/2)
+    dphi = ((dphi + nphibins / 2) % nphibins + nphibins) % nphibins - nphibins / 2;
+    PHG4ShowerLibrary::Deposit deposit;
+    deposit.deta = etasign * (static_cast<int>(TowerInfoDefs::getCaloTowerEtaBin(key)) - etabin);
+    deposit.dphi = dphi;
+    deposit.fraction = fraction;
+    shower.push_back(deposit);
+  }
+  m_Library.add_shower(bin, shower);
+
+  if (Verbosity() > 1)
+  {
+    std::cout << Name() << " - pid " << particle->get_pid() << " E_kin " << kinetic
+              << " entry eta " << entry.Eta() << " -> library bin " << bin
+              << " with " << shower.size() << " towers" << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4ShowerLibraryMaker::End(PHCompositeNode * /*topNode*/)
+{
+  size_t nshowers = 0;
+  for (size_t bin = 0; bin < m_Library.get_nbins(); bin++)
+  {
+    nshowers += m_Library.get_nshowers(bin);
+  }
+  std::cout << Name() << " - writing " << nshowers << " showers in "
+            << m_Library.get_nbins() << " bins to " << m_FileName << std::endl;
+  if (!m_Library.write(m_FileName))
+  {
+    std::cout << Name() << " - failed to write " << m_FileName << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
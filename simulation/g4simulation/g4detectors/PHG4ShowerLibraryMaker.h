@@ -0,0 +1,58 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4SHOWERLIBRARYMAKER_H
+#define G4DETECTORS_PHG4SHOWERLIBRARYMAKER_H
+
+#include "PHG4ShowerLibrary.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+class PHG4CylinderCellGeom_Spacalv1;
+
+/*!
+ * \brief Fill a PHG4ShowerLibrary from fully simulated single particle events
+ *
+ * Runs on the tower level output of the spacal (saveg4hit = 0). Every event must contain
+ * exactly one primary particle, the entry point into the calorimeter is found by a straight
+ * line extrapolation from the primary vertex to the inner radius of the cell geometry.
+ */
+class PHG4ShowerLibraryMaker : public SubsysReco
+{
+ public:
+  PHG4ShowerLibraryMaker(const std::string &name = "PHG4ShowerLibraryMaker");
+
+  ~PHG4ShowerLibraryMaker() override = default;
+
+  int InitRun(PHCompositeNode *topNode) override;
+
+  int process_event(PHCompositeNode *topNode) override;
+
+  int End(PHCompositeNode *topNode) override;
+
+  void Detector(const std::string &d) { m_Detector = d; }
+
+  void set_filename(const std::string &f) { m_FileName = f; }
+
+  //! bin edges in kinetic energy (GeV), |eta| and entry angle (rad)
+  void set_binning(const std::vector<double> &energy, const std::vector<double> &eta, const std::vector<double> &angle);
+
+  //! towers below this fraction of the kinetic energy are not stored
+  void set_fraction_threshold(const double f) { m_FractionThreshold = f; }
+
+ private:
+  std::string m_Detector{"CEMC"};
+  std::string m_FileName{"showerlibrary.bin"};
+  std::string m_TowerNodeName;
+
+  double m_FractionThreshold{1e-4};
+
+  PHG4CylinderCellGeom_Spacalv1 *m_CellGeom{nullptr};
+
+  PHG4ShowerLibrary m_Library;
+};
+
+#endif
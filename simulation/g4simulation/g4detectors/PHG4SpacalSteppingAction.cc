@@ -17,6 +17,7 @@
 #include "PHG4CylinderGeom.h"  // for PHG4CylinderGeom
 #include "PHG4CylinderGeomContainer.h"
 #include "PHG4CylinderGeom_Spacalv1.h"  // for PHG4CylinderGeom_Spaca...
+#include "PHG4ShowerLibrary.h"
 
 #include <calobase/TowerInfo.h>
 #include <calobase/TowerInfoContainer.h>
@@ -46,6 +47,7 @@
 #include <Geant4/G4MaterialCutsCouple.hh>
 #include <Geant4/G4ParticleDefinition.hh>      // for G4ParticleDefinition
 #include <Geant4/G4ReferenceCountedHandle.hh>  // for G4ReferenceCountedHandle
+#include <Geant4/Randomize.hh>
 #include <Geant4/G4Step.hh>
 #include <Geant4/G4StepPoint.hh>   // for G4StepPoint
 #include <Geant4/G4StepStatus.hh>  // for fGeomBoundary, fAtRestD...
@@ -79,7 +81,32 @@ PHG4SpacalSteppingAction::PHG4SpacalSteppingAction(PHG4SpacalDetector *indetecto
   , m_tmin(m_Params->get_double_param("tmin"))
   , m_tmax(m_Params->get_double_param("tmax"))
   , m_dt(m_Params->get_double_param("dt"))
+  , m_InnerRadius(m_Params->get_double_param("radius") * cm)
 {
+  const std::string &libraryfile = m_Params->get_string_param("shower_library");
+  if (!libraryfile.empty())
+  {
+    if (m_doG4Hit)
+    {
+      std::cout << "PHG4SpacalSteppingAction - Fatal Error - shower library " << libraryfile
+                << " only works in tower mode (saveg4hit = 0), not when saving G4 hits" << std::endl;
+      exit(1);
+    }
+    // the calorimeter envelope and blocks a particle enters first are only known with active absorbers
+    if (!m_Params->get_int_param("absorberactive"))
+    {
+      std::cout << "PHG4SpacalSteppingAction - Fatal Error - shower library " << libraryfile
+                << " needs the absorber to be active (SetAbsorberActive())" << std::endl;
+      exit(1);
+    }
+    m_ShowerLibrary = new PHG4ShowerLibrary();
+    if (!m_ShowerLibrary->read(libraryfile))
+    {
+      std::cout << "PHG4SpacalSteppingAction - Fatal Error - could not read shower library "
+                << libraryfile << std::endl;
+      exit(1);
+    }
+  }
 }
 
 PHG4SpacalSteppingAction::~PHG4SpacalSteppingAction()
@@ -89,6 +116,7 @@ PHG4SpacalSteppingAction::~PHG4SpacalSteppingAction()
   // if the last hit was saved, hit is a nullptr pointer which are
   // legal to delete (it results in a no operation)
   delete m_Hit;
+  delete m_ShowerLibrary;
 }
 
 int PHG4SpacalSteppingAction::InitWithNode(PHCompositeNode *topNode)
@@ -167,6 +195,90 @@ int PHG4SpacalSteppingAction::SetUpGeomNode(PHCompositeNode *topNode)
   return 0;
 }
 
+bool PHG4SpacalSteppingAction::ShowerLibrarySteppingAction(const G4Step *aStep)
+{
+  G4StepPoint *prePoint = aStep->GetPreStepPoint();
+  if (prePoint->GetStepStatus() != fGeomBoundary)
+  {
+    return false;
+  }
+  // only steps in this calorimeter, other detectors at the same radius are none of our business
+  G4VPhysicalVolume *volume = prePoint->GetTouchableHandle()->GetVolume();
+  if (m_Detector->IsInCylinderActive(volume) <= PHG4SpacalDetector::INACTIVE)
+  {
+    return false;
+  }
+  // only particles produced inside the calorimeter radius which just crossed the inner surface,
+  // secondaries created in the calorimeter are tracked by G4 as usual
+  const G4ThreeVector &pos = prePoint->GetPosition();
+  if (pos.perp() < m_InnerRadius - 1 * mm || pos.perp() > m_InnerRadius + 1 * cm)
+  {
+    return false;
+  }
+  if (pos.z() < get_zmin() * cm || pos.z() > get_zmax() * cm)
+  {
+    return false;
+  }
+  const G4Track *aTrack = aStep->GetTrack();
+  if (aTrack->GetVertexPosition().perp() >= m_InnerRadius)
+  {
+    return false;
+  }
+  const G4ThreeVector &direction = prePoint->GetMomentumDirection();
+  if (direction.dot(pos) <= 0)
+  {
+    return false;
+  }
+  const double pretime = prePoint->GetGlobalTime() / nanosecond;
+  if (pretime < m_tmin || pretime > m_tmax)
+  {
+    return false;
+  }
+
+  const double energy = prePoint->GetKineticEnergy() / GeV;
+  const double eta = pos.eta();
+  const int bin = m_ShowerLibrary->get_bin(aTrack->GetParticleDefinition()->GetPDGEncoding(), energy, eta, direction.angle(pos));
+  const PHG4ShowerLibrary::Shower *shower = m_ShowerLibrary->sample(bin, G4UniformRand());
+  if (!shower)
+  {
+    return false;
+  }
+  int etabin = -1;
+  int phibin = -1;
+  if (!PHG4ShowerLibrary::get_tower_bin(_geo, eta, pos.phi(), etabin, phibin))
+  {
+    return false;
+  }
+
+  // showers are stored for eta > 0, mirror the eta offsets on the other side
+  const int etasign = (eta < 0) ? -1 : 1;
+  const int netabins = _geo->get_etabins();
+  const int nphibins = _geo->get_phibins();
+  for (const auto &deposit : *shower)
+  {
+    const int ieta = etabin + etasign * deposit.deta;
+    if (ieta < 0 || ieta >= netabins)
+    {
+      continue;
+    }
+    const int iphi = ((phibin + deposit.dphi) % nphibins + nphibins) % nphibins;
+    TowerInfo *tower = m_CaloInfoContainer->get_tower_at_key(TowerInfoDefs::encode_emcal(ieta, iphi));
+    tower->set_energy(tower->get_energy() + deposit.fraction * energy);
+  }
+
+  // the library shower replaces the Geant4 one
+  G4Track *killtrack = const_cast<G4Track *>(aTrack);
+  killtrack->SetTrackStatus(fStopAndKill);
+  if (G4VUserTrackInformation *p = aTrack->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1 *pp = dynamic_cast<PHG4TrackUserInfoV1 *>(p))
+    {
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+  return true;
+}
+
 bool PHG4SpacalSteppingAction::NoHitSteppingAction(const G4Step *aStep)
 {
   // get volume of the current step
@@ -318,6 +430,10 @@ bool PHG4SpacalSteppingAction::UserSteppingAction(const G4Step *aStep, bool /*wa
 {
   if (!m_doG4Hit)
   {
+    if (m_ShowerLibrary && ShowerLibrarySteppingAction(aStep))
+    {
+      return true;
+    }
     return NoHitSteppingAction(aStep);
   }
 
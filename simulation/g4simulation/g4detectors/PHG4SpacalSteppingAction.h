@@ -26,6 +26,7 @@ class PHG4SpacalDetector;
 class PHG4Hit;
 class PHG4HitContainer;
 class PHG4Shower;
+class PHG4ShowerLibrary;
 class PHParameters;
 class TowerInfoContainer;
 
@@ -58,6 +59,8 @@ class PHG4SpacalSteppingAction : public PHG4SteppingAction
 
  private:
   bool NoHitSteppingAction(const G4Step *aStep);
+  //! replace the shower of a particle entering the calorimeter by one from the shower library
+  bool ShowerLibrarySteppingAction(const G4Step *aStep);
   //! pointer to the detector
   PHG4SpacalDetector *m_Detector = nullptr;
 
@@ -75,6 +78,7 @@ class PHG4SpacalSteppingAction : public PHG4SteppingAction
   double m_tmin = -20.;
   double m_tmax = 60.;
   double m_dt = 100.;
+  double m_InnerRadius = 0.;
 
   std::string m_AbsorberNodeName;
   std::string m_HitNodeName;
@@ -93,6 +97,8 @@ class PHG4SpacalSteppingAction : public PHG4SteppingAction
   const PHG4CylinderGeom_Spacalv3 *_layergeom = nullptr;
 
   LightCollectionModel light_collection_model;
+
+  PHG4ShowerLibrary *m_ShowerLibrary = nullptr;
 };
 
 #endif  // PHG4VHcalSteppingAction_h
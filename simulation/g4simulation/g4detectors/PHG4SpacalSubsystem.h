@@ -57,6 +57,10 @@ class PHG4SpacalSubsystem : public PHG4DetectorSubsystem
   void
   Print(const std::string &what = "ALL") const override;
 
+  //! replace the showers of particles entering the calorimeter by showers from this PHG4ShowerLibrary file.
+  //! Tower mode only: needs saveg4hit = 0 and the absorber active, anything else is a fatal error
+  void SetShowerLibrary(const std::string &filename) { set_string_param("shower_library", filename); }
+
   void CosmicSetup(const int i) { m_CosmicSetupFlag = i; }
   int CosmicSetup() const { return m_CosmicSetupFlag; }
 
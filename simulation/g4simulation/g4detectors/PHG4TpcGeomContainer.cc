@@ -2,6 +2,8 @@
 
 #include "PHG4TpcGeom.h"
 
+#include <cmath>
+
 PHG4TpcGeomContainer::~PHG4TpcGeomContainer()
 {
   while (layergeoms.begin() != layergeoms.end())
@@ -68,3 +70,75 @@ PHG4TpcGeomContainer::GetFirstLayerCellGeom()
   }
   return layergeoms.begin()->second;
 }
+
+void PHG4TpcGeomContainer::build_tables()
+{
+  layertables.clear();
+  if (layergeoms.empty())
+  {
+    return;
+  }
+  layertables.resize(layergeoms.rbegin()->first + 1);
+  for (auto &iter : layergeoms)
+  {
+    PHG4TpcGeom *geom = iter.second;
+    LayerTable &table = layertables[iter.first];
+    table.layer = iter.first;
+    table.radius = geom->get_radius();
+    table.phibins = geom->get_phibins();
+    table.zbins = geom->get_zbins();
+    table.pads_per_sector = table.phibins / 12;
+    table.phistep = geom->get_phistep();
+    table.zstep = geom->get_zstep();
+    table.max_driftlength = geom->get_max_driftlength();
+    table.sector_min_phi = geom->get_sector_min_phi();
+    table.sector_max_phi = geom->get_sector_max_phi();
+
+    for (int side = 0; side < 2; side++)
+    {
+      // layers without sector boundaries (e.g. unused sides) keep empty pad tables
+      if (table.sector_max_phi[side].size() < 12)
+      {
+        continue;
+      }
+      table.phi_center[side].resize(table.phibins);
+      table.sin_phi[side].resize(table.phibins);
+      table.cos_phi[side].resize(table.phibins);
+      for (int pad = 0; pad < table.phibins; pad++)
+      {
+        const double phi = geom->get_phicenter(pad, side);
+        table.phi_center[side][pad] = phi;
+        table.sin_phi[side][pad] = std::sin(phi);
+        table.cos_phi[side][pad] = std::cos(phi);
+      }
+    }
+
+    // get_zcenter accepts the upper edge as bin as well
+    table.t_center.resize(table.zbins + 1);
+    for (int tbin = 0; tbin <= table.zbins; tbin++)
+    {
+      table.t_center[tbin] = geom->get_zcenter(tbin);
+    }
+  }
+}
+
+void PHG4TpcGeomContainer::get_pad_xy(const int layer, const int side, const int *pads, const size_t n, double *x, double *y) const
+{
+  const LayerTable &table = layertables.at(layer);
+  const double *cos_phi = table.cos_phi[side].data();
+  const double *sin_phi = table.sin_phi[side].data();
+  for (size_t i = 0; i < n; i++)
+  {
+    x[i] = table.radius * cos_phi[pads[i]];
+    y[i] = table.radius * sin_phi[pads[i]];
+  }
+}
+
+void PHG4TpcGeomContainer::get_tbin_z(const int layer, const int side, const int *tbins, const size_t n, const double drift_velocity, double *z) const
+{
+  const LayerTable &table = layertables.at(layer);
+  for (size_t i = 0; i < n; i++)
+  {
+    z[i] = table.get_z(table.t_center[tbins[i]], side, drift_velocity);
+  }
+}
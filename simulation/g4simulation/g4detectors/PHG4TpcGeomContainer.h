@@ -5,9 +5,13 @@
 
 #include <phool/PHObject.h>
 
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <iostream>  // for cout, ostream
 #include <map>
 #include <utility>  // for make_pair, pair
+#include <vector>
 
 class PHG4TpcGeom;
 
@@ -20,6 +24,55 @@ class PHG4TpcGeomContainer : public PHObject
   typedef std::pair<Iterator, Iterator> Range;
   typedef std::pair<ConstIterator, ConstIterator> ConstRange;
 
+  //! dense pad plane tables of one layer, filled by build_tables
+  /*!
+   * copies of the PHG4TpcGeom values which are needed per hit, without the
+   * virtual calls and binning checks of the accessors. Index is [side][pad]
+   * for the pad tables and [tbin] for the time bins. Callers are responsible
+   * for passing valid bins
+   */
+  struct LayerTable
+  {
+    int layer{-1};
+    double radius{0};
+    int phibins{0};
+    int zbins{0};
+    unsigned int pads_per_sector{0};
+    double phistep{0};
+    double zstep{0};
+    double max_driftlength{0};
+
+    //! pad phi centers, same as PHG4TpcGeom::get_phicenter
+    std::array<std::vector<double>, 2> phi_center;
+    std::array<std::vector<double>, 2> sin_phi;
+    std::array<std::vector<double>, 2> cos_phi;
+
+    std::array<std::vector<double>, 2> sector_min_phi;
+    std::array<std::vector<double>, 2> sector_max_phi;
+
+    //! time bin centers (ns), same as PHG4TpcGeom::get_zcenter
+    std::vector<double> t_center;
+
+    //! phi of a fractional pad, same as PHG4TpcGeom::get_phi
+    double get_phi(const float pad, const int side) const
+    {
+      const unsigned int sector = static_cast<unsigned int>(pad) / pads_per_sector;
+      double phi = sector_max_phi[side][sector] - (pad + 0.5 - sector * pads_per_sector) * phistep;
+      if (phi <= -M_PI)
+      {
+        phi += 2 * M_PI;
+      }
+      return phi;
+    }
+
+    //! z of a drift time (ns) on the given side
+    double get_z(const double t, const int side, const double drift_velocity) const
+    {
+      const double z = max_driftlength - t * drift_velocity;
+      return (side == 0) ? -z : z;
+    }
+  };
+
   PHG4TpcGeomContainer() = default;
   ~PHG4TpcGeomContainer() override;
 
@@ -33,8 +86,28 @@ class PHG4TpcGeomContainer : public PHObject
   int get_NLayers() const { return layergeoms.size(); }
   ConstRange get_begin_end() const { return {layergeoms.begin(), layergeoms.end()}; }
 
+  //! (re)build the pad plane tables of all layers, call in InitRun after the geometry is final
+  void build_tables();
+
+  //! pad plane table of a layer, nullptr if build_tables was not called or the layer does not exist
+  const LayerTable *get_layer_table(const int layer) const
+  {
+    if (layer < 0 || static_cast<size_t>(layer) >= layertables.size() || layertables[layer].layer < 0)
+    {
+      return nullptr;
+    }
+    return &layertables[layer];
+  }
+
+  //! batch conversion of pad centers to x, y (cm)
+  void get_pad_xy(const int layer, const int side, const int *pads, const size_t n, double *x, double *y) const;
+
+  //! batch conversion of time bin centers to z (cm) with the given drift velocity (cm/ns)
+  void get_tbin_z(const int layer, const int side, const int *tbins, const size_t n, const double drift_velocity, double *z) const;
+
  protected:
   Map layergeoms;
+  std::vector<LayerTable> layertables;  //! transient, built per run
   ClassDefOverride(PHG4TpcGeomContainer, 1)
 };
 
@@ -3,6 +3,7 @@
 #include "SvtxHitEval.h"
 #include "SvtxTruthEval.h"
 
+#include <trackbase/MvtxDefs.h>
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrClusterContainer.h>
 #include <trackbase/TrkrClusterHitAssoc.h>
@@ -24,12 +25,15 @@
 
 #include <TVector3.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
 #include <iostream>  // for operator<<, basic_ostream
 #include <map>
+#include <numeric>
 #include <set>
+#include <vector>
 
 SvtxClusterEval::SvtxClusterEval(PHCompositeNode* topNode)
   : _hiteval(topNode)
@@ -50,19 +54,19 @@ SvtxClusterEval::~SvtxClusterEval()
 
 void SvtxClusterEval::next_event(PHCompositeNode* topNode)
 {
-  _cache_all_truth_hits.clear();
   _cache_all_truth_clusters.clear();
-  _cache_max_truth_hit_by_energy.clear();
   _cache_max_truth_cluster_by_energy.clear();
   _cache_all_truth_particles.clear();
   _cache_max_truth_particle_by_energy.clear();
   _cache_max_truth_particle_by_cluster_energy.clear();
-  _cache_all_clusters_from_particle.clear();
-  _cache_all_clusters_from_g4hit.clear();
   _cache_best_cluster_from_g4hit.clear();
-  _cache_get_energy_contribution_g4particle.clear();
-  _cache_get_energy_contribution_g4hit.clear();
   _cache_best_cluster_from_gtrackid_layer.clear();
+  _associations_built = false;
+  _assoc_cluskeys.clear();
+  _assoc_offsets.clear();
+  _assoc_g4hits.clear();
+  _assoc_clusters_from_g4hit.clear();
+  _assoc_clusters_from_particle.clear();
   _clusters_per_layer.clear();
   //  _g4hits_per_layer.clear();
   _hiteval.next_event(topNode);
@@ -344,30 +348,46 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
     return std::set<PHG4Hit*>();
   }
 
+  std::vector<PHG4Hit*> g4hits;
+  get_truth_hits(cluster_key, g4hits);
+
+  // g4hits are already unique and sorted by address
+  return std::set<PHG4Hit*>(g4hits.begin(), g4hits.end());
+}
+
+void SvtxClusterEval::get_truth_hits(TrkrDefs::cluskey cluster_key, std::vector<PHG4Hit*>& g4hits)
+{
+  g4hits.clear();
   if (_do_cache)
   {
-    std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>>::iterator iter =
-        _cache_all_truth_hits.find(cluster_key);
-    if (iter != _cache_all_truth_hits.end())
+    const int index = association_index(cluster_key);
+    if (index >= 0)
     {
-      return iter->second;
+      g4hits.assign(_assoc_g4hits.begin() + _assoc_offsets[index], _assoc_g4hits.begin() + _assoc_offsets[index + 1]);
+      return;
     }
   }
 
-  std::set<PHG4Hit*> truth_hits;
+  collect_truth_hits(cluster_key, g4hits);
+  std::sort(g4hits.begin(), g4hits.end());
+  g4hits.erase(std::unique(g4hits.begin(), g4hits.end()), g4hits.end());
+}
 
-  // get all truth hits for this cluster
-  //_cluster_hit_map->identify();
-  std::pair<std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator, std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator>
-      hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
+void SvtxClusterEval::collect_truth_hits(TrkrDefs::cluskey cluster_key, std::vector<PHG4Hit*>& g4hits) const
+{
+  // TrkrHitTruthAssoc uses a map with (hitsetkey, std::pair(hitkey, g4hitkey)) - get the hitsetkey from the cluskey
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(cluster_key);
+  PHG4HitContainer* g4hitcontainer = get_g4hit_container(hitsetkey);
+  if (!g4hitcontainer)
+  {
+    return;
+  }
 
-  for (std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator
-           clushititer = hitrange.first;
-       clushititer != hitrange.second; ++clushititer)
+  // get all truth hits for this cluster
+  const auto hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
+  for (auto clushititer = hitrange.first; clushititer != hitrange.second; ++clushititer)
   {
     TrkrDefs::hitkey hitkey = clushititer->second;
-    // TrkrHitTruthAssoc uses a map with (hitsetkey, std::pair(hitkey, g4hitkey)) - get the hitsetkey from the cluskey
-    TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(cluster_key);
 
     // get all of the g4hits for this hitkey
     std::multimap<TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype>> temp_map;
@@ -376,40 +396,182 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
 
     for (auto& htiter : temp_map)
     {
-      // extract the g4 hit key here and add the hits to the set
-      PHG4HitDefs::keytype g4hitkey = htiter.second.second;
-      PHG4Hit* g4hit = nullptr;
-      unsigned int trkrid = TrkrDefs::getTrkrId(hitsetkey);
-      switch (trkrid)
-      {
-      case TrkrDefs::tpcId:
-        g4hit = _g4hits_tpc->findHit(g4hitkey);
-        break;
-      case TrkrDefs::inttId:
-        g4hit = _g4hits_intt->findHit(g4hitkey);
-        break;
-      case TrkrDefs::mvtxId:
-        g4hit = _g4hits_mvtx->findHit(g4hitkey);
-        break;
-      case TrkrDefs::micromegasId:
-        g4hit = _g4hits_mms->findHit(g4hitkey);
-        break;
-      default:
-        break;
-      }
+      // extract the g4 hit key here and add the hits to the vector
+      PHG4Hit* g4hit = g4hitcontainer->findHit(htiter.second.second);
       if (g4hit)
       {
-        truth_hits.insert(g4hit);
+        g4hits.push_back(g4hit);
       }
     }  // end loop over g4hits associated with hitsetkey and hitkey
   }  // end loop over hits associated with cluskey
+}
 
-  if (_do_cache)
+PHG4HitContainer* SvtxClusterEval::get_g4hit_container(TrkrDefs::hitsetkey hitsetkey) const
+{
+  switch (TrkrDefs::getTrkrId(hitsetkey))
+  {
+  case TrkrDefs::tpcId:
+    return _g4hits_tpc;
+  case TrkrDefs::inttId:
+    return _g4hits_intt;
+  case TrkrDefs::mvtxId:
+    return _g4hits_mvtx;
+  case TrkrDefs::micromegasId:
+    return _g4hits_mms;
+  default:
+    return nullptr;
+  }
+}
+
+int SvtxClusterEval::association_index(TrkrDefs::cluskey cluster_key)
+{
+  if (!_associations_built)
+  {
+    build_association_tables();
+  }
+
+  const auto iter = std::lower_bound(_assoc_cluskeys.begin(), _assoc_cluskeys.end(), cluster_key);
+  if (iter == _assoc_cluskeys.end() || *iter != cluster_key)
+  {
+    return -1;
+  }
+  return iter - _assoc_cluskeys.begin();
+}
+
+void SvtxClusterEval::build_association_tables()
+{
+  PHTimer timer("SvtxClusterEval_assoc");
+  timer.restart();
+
+  _associations_built = true;
+  _assoc_cluskeys.clear();
+  _assoc_offsets.assign(1, 0);
+  _assoc_g4hits.clear();
+  _assoc_clusters_from_g4hit.clear();
+  _assoc_clusters_from_particle.clear();
+
+  if (!_clustermap || !_cluster_hit_map || !_hit_truth_map || !_truthinfo)
   {
-    _cache_all_truth_hits.insert(std::make_pair(cluster_key, truth_hits));
+    return;
   }
 
-  return truth_hits;
+  // (hitkey, g4hitkey) pairs for the current hitset, sorted by hitkey.
+  // This replaces one scan of the hitset associations per TrkrHit by one scan per hitset
+  using HitAssoc = std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype>;
+  const auto fill_hit_assocs = [this](TrkrDefs::hitsetkey hitsetkey, std::vector<HitAssoc>& hit_assocs)
+  {
+    hit_assocs.clear();
+    const auto range = _hit_truth_map->getG4Hits(hitsetkey);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      hit_assocs.push_back(iter->second);
+    }
+    std::sort(hit_assocs.begin(), hit_assocs.end());
+  };
+
+  const auto hitkey_less = [](const HitAssoc& lhs, const HitAssoc& rhs)
+  { return lhs.first < rhs.first; };
+
+  std::vector<HitAssoc> hit_assocs;
+  std::vector<HitAssoc> bare_hit_assocs;
+  for (const auto& hitsetkey : _clustermap->getHitSetKeys())
+  {
+    PHG4HitContainer* g4hitcontainer = get_g4hit_container(hitsetkey);
+    fill_hit_assocs(hitsetkey, hit_assocs);
+
+    // mvtx special case: hits with no association are looked up in the bare hitsetkey, as in TrkrHitTruthAssoc::getG4Hits
+    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+    bool has_bare_hit_assocs = false;
+
+    auto range = _clustermap->getClusters(hitsetkey);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      const TrkrDefs::cluskey cluster_key = iter->first;
+      const unsigned int begin = _assoc_g4hits.size();
+
+      const auto hitrange = _cluster_hit_map->getHits(cluster_key);
+      for (auto clushititer = hitrange.first; clushititer != hitrange.second && g4hitcontainer; ++clushititer)
+      {
+        const HitAssoc key(clushititer->second, 0);
+        auto assocs = std::equal_range(hit_assocs.begin(), hit_assocs.end(), key, hitkey_less);
+        if (assocs.first == assocs.second && layer < 3)
+        {
+          if (!has_bare_hit_assocs)
+          {
+            const TrkrDefs::hitsetkey bare_hitsetkey = MvtxDefs::genHitSetKey(layer, MvtxDefs::getStaveId(hitsetkey), MvtxDefs::getChipId(hitsetkey), 0);
+            fill_hit_assocs(bare_hitsetkey, bare_hit_assocs);
+            has_bare_hit_assocs = true;
+          }
+          assocs = std::equal_range(bare_hit_assocs.begin(), bare_hit_assocs.end(), key, hitkey_less);
+        }
+
+        for (auto assoc = assocs.first; assoc != assocs.second; ++assoc)
+        {
+          PHG4Hit* g4hit = g4hitcontainer->findHit(assoc->second);
+          if (g4hit)
+          {
+            _assoc_g4hits.push_back(g4hit);
+          }
+        }
+      }
+
+      // unique g4hits for this cluster, sorted by address to match the std::set ordering of all_truth_hits
+      std::sort(_assoc_g4hits.begin() + begin, _assoc_g4hits.end());
+      _assoc_g4hits.erase(std::unique(_assoc_g4hits.begin() + begin, _assoc_g4hits.end()), _assoc_g4hits.end());
+
+      _assoc_cluskeys.push_back(cluster_key);
+      _assoc_offsets.push_back(_assoc_g4hits.size());
+
+      for (auto g4hit = _assoc_g4hits.begin() + begin; g4hit != _assoc_g4hits.end(); ++g4hit)
+      {
+        _assoc_clusters_from_g4hit.emplace_back(*g4hit, cluster_key);
+        PHG4Particle* particle = _truthinfo->GetParticle((*g4hit)->get_trkid());
+        if (particle)
+        {
+          _assoc_clusters_from_particle.emplace_back(particle, cluster_key);
+        }
+      }
+    }
+  }
+
+  // cluster containers return hitsets and clusters ordered by key, check anyway since lookups rely on it
+  if (!std::is_sorted(_assoc_cluskeys.begin(), _assoc_cluskeys.end()))
+  {
+    std::vector<unsigned int> order(_assoc_cluskeys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](unsigned int lhs, unsigned int rhs)
+              { return _assoc_cluskeys[lhs] < _assoc_cluskeys[rhs]; });
+
+    std::vector<TrkrDefs::cluskey> cluskeys;
+    std::vector<unsigned int> offsets(1, 0);
+    std::vector<PHG4Hit*> g4hits;
+    cluskeys.reserve(_assoc_cluskeys.size());
+    offsets.reserve(_assoc_offsets.size());
+    g4hits.reserve(_assoc_g4hits.size());
+    for (const auto& index : order)
+    {
+      cluskeys.push_back(_assoc_cluskeys[index]);
+      g4hits.insert(g4hits.end(), _assoc_g4hits.begin() + _assoc_offsets[index], _assoc_g4hits.begin() + _assoc_offsets[index + 1]);
+      offsets.push_back(g4hits.size());
+    }
+    _assoc_cluskeys.swap(cluskeys);
+    _assoc_offsets.swap(offsets);
+    _assoc_g4hits.swap(g4hits);
+  }
+
+  std::sort(_assoc_clusters_from_g4hit.begin(), _assoc_clusters_from_g4hit.end());
+  std::sort(_assoc_clusters_from_particle.begin(), _assoc_clusters_from_particle.end());
+  _assoc_clusters_from_particle.erase(std::unique(_assoc_clusters_from_particle.begin(), _assoc_clusters_from_particle.end()), _assoc_clusters_from_particle.end());
+
+  timer.stop();
+  if (_verbosity > 0)
+  {
+    std::cout << "SvtxClusterEval::build_association_tables -"
+              << " clusters: " << _assoc_cluskeys.size()
+              << " g4hit links: " << _assoc_g4hits.size()
+              << " particle links: " << _assoc_clusters_from_particle.size()
+              << " time: " << timer.get_accumulated_time() << " ms" << std::endl;
+  }
 }
 
 PHG4Hit* SvtxClusterEval::all_truth_hits_by_nhit(TrkrDefs::cluskey cluster_key)
@@ -748,17 +910,8 @@ PHG4Hit* SvtxClusterEval::max_truth_hit_by_energy(TrkrDefs::cluskey cluster_key)
     return nullptr;
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::cluskey, PHG4Hit*>::iterator iter =
-        _cache_max_truth_hit_by_energy.find(cluster_key);
-    if (iter != _cache_max_truth_hit_by_energy.end())
-    {
-      return iter->second;
-    }
-  }
-
-  std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
+  std::vector<PHG4Hit*> hits;
+  get_truth_hits(cluster_key, hits);
   PHG4Hit* max_hit = nullptr;
   float max_e = std::numeric_limits<float>::min();
   for (auto* hit : hits)
@@ -770,11 +923,6 @@ PHG4Hit* SvtxClusterEval::max_truth_hit_by_energy(TrkrDefs::cluskey cluster_key)
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_max_truth_hit_by_energy.insert(std::make_pair(cluster_key, max_hit));
-  }
-
   return max_hit;
 }
 
@@ -937,68 +1085,29 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Particle* tru
     ++_errors;
     return std::set<TrkrDefs::cluskey>();
   }
-  // check if cache is filled, if not fill it.
-  //   if(_cache_all_clusters_from_particle.count(truthparticle)==0){
-  if (_cache_all_clusters_from_particle.empty())
+
+  // fill association tables if needed
+  if (!_associations_built)
   {
-    FillRecoClusterFromG4HitCache();
+    build_association_tables();
   }
 
-  if (_do_cache)
+  std::set<TrkrDefs::cluskey> clusters;
+  const auto range = std::equal_range(
+      _assoc_clusters_from_particle.begin(), _assoc_clusters_from_particle.end(),
+      std::make_pair(truthparticle, TrkrDefs::cluskey(0)),
+      [](const std::pair<PHG4Particle*, TrkrDefs::cluskey>& lhs, const std::pair<PHG4Particle*, TrkrDefs::cluskey>& rhs)
+      { return lhs.first < rhs.first; });
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    std::map<PHG4Particle*, std::set<TrkrDefs::cluskey>>::iterator iter =
-        _cache_all_clusters_from_particle.find(truthparticle);
-    if (iter != _cache_all_clusters_from_particle.end())
-    {
-      return iter->second;
-    }
+    clusters.insert(clusters.end(), iter->second);
   }
-  std::set<TrkrDefs::cluskey> clusters;
   return clusters;
 }
 
 void SvtxClusterEval::FillRecoClusterFromG4HitCache()
 {
-  auto Mytimer = std::make_unique<PHTimer>("ReCl_timer");
-  Mytimer->stop();
-  Mytimer->restart();
-
-  std::multimap<PHG4Particle*, TrkrDefs::cluskey> temp_clusters_from_particles;
-  // loop over all the clusters
-  for (const auto& hitsetkey : _clustermap->getHitSetKeys())
-  {
-    auto range = _clustermap->getClusters(hitsetkey);
-    for (auto iter = range.first; iter != range.second; ++iter)
-    {
-      TrkrDefs::cluskey cluster_key = iter->first;
-
-      // loop over all truth particles connected to this cluster
-      std::set<PHG4Particle*> particles = all_truth_particles(cluster_key);
-      for (auto* candidate : particles)
-      {
-        temp_clusters_from_particles.insert(std::make_pair(candidate, cluster_key));
-      }
-    }
-  }
-  // Loop over particles and fill cache
-  PHG4TruthInfoContainer::ConstRange range = _truthinfo->GetParticleRange();
-  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
-       iter != range.second; ++iter)
-  {
-    PHG4Particle* g4particle = iter->second;
-    std::set<TrkrDefs::cluskey> clusters;
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator lower_bound = temp_clusters_from_particles.lower_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator upper_bound = temp_clusters_from_particles.upper_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator cfp_iter;
-    for (cfp_iter = lower_bound; cfp_iter != upper_bound; ++cfp_iter)
-    {
-      TrkrDefs::cluskey cluster_key = cfp_iter->second;
-      clusters.insert(cluster_key);
-    }
-    _cache_all_clusters_from_particle.insert(std::make_pair(g4particle, clusters));
-  }
-
-  Mytimer->stop();
+  build_association_tables();
 }
 
 std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit)
@@ -1019,110 +1128,25 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit
     return std::set<TrkrDefs::cluskey>();
   }
 
-  // one time, fill cache of g4hit/cluster pairs
-  if (_cache_all_clusters_from_g4hit.empty())
+  // fill association tables if needed
+  if (!_associations_built)
   {
-    // make a map of truthhit, cluster_key inside this loop
-    std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey> truth_cluster_map;
-    std::set<PHG4HitDefs::keytype> all_g4hits_set;
-    std::map<PHG4HitDefs::keytype, PHG4Hit*> all_g4hits_map;
-
-    // get all reco clusters
-    if (_verbosity > 1)
-    {
-      std::cout << "all_clusters_from_g4hit: list all reco clusters " << std::endl;
-    }
-
-    for (const auto& hitsetkey : _clustermap->getHitSetKeys())
-    {
-      auto range = _clustermap->getClusters(hitsetkey);
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        TrkrDefs::cluskey cluster_key = iter->first;
-        int layer = TrkrDefs::getLayer(cluster_key);
-        TrkrCluster* clus = iter->second;
-        if (_verbosity > 1)
-        {
-          std::cout << " layer " << layer << " cluster_key " << cluster_key << " adc " << clus->getAdc()
-                    << " localx " << clus->getLocalX()
-                    << " localy " << clus->getLocalY()
-                    << std::endl;
-          std::cout << "  associated hits:";
-          std::pair<std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator, std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator>
-              hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
-          for (std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator
-                   clushititer = hitrange.first;
-               clushititer != hitrange.second; ++clushititer)
-          {
-            TrkrDefs::hitkey hitkey = clushititer->second;
-            std::cout << " " << hitkey;
-          }
-          std::cout << std::endl;
-        }
-
-        // the returned truth hits were obtained from TrkrAssoc maps
-        std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
-        for (auto* candidate : hits)
-        {
-          PHG4HitDefs::keytype g4hit_key = candidate->get_hit_id();
-
-          if (_verbosity > 5)
-          {
-            int gtrackID = candidate->get_trkid();
-            std::cout << "   adding cluster with cluster_key " << cluster_key << " g4hit with g4hit_key " << g4hit_key
-                      << " gtrackID " << gtrackID
-                      << std::endl;
-          }
-
-          all_g4hits_set.insert(g4hit_key);
-          all_g4hits_map.insert(std::make_pair(g4hit_key, candidate));
-
-          truth_cluster_map.insert(std::make_pair(g4hit_key, cluster_key));
-        }
-      }
-    }
-
-    // now fill the cache
-    // loop over all entries in all_g4hits
-    for (unsigned long long g4hit_key : all_g4hits_set)
-    {
-      if (_verbosity > 5)
-      {
-        std::cout << " associations for g4hit_key " << g4hit_key << std::endl;
-      }
-
-      std::map<PHG4HitDefs::keytype, PHG4Hit*>::iterator it = all_g4hits_map.find(g4hit_key);
-      PHG4Hit* g4hit = it->second;
-
-      std::set<TrkrDefs::cluskey> assoc_clusters;
-
-      std::pair<std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator,
-                std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator>
-          ret = truth_cluster_map.equal_range(g4hit_key);
-      for (std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator jter = ret.first; jter != ret.second; ++jter)
-      {
-        assoc_clusters.insert(jter->second);
-
-        if (_verbosity > 5)
-        {
-          std::cout << "             g4hit_key " << g4hit_key << " associated with cluster_key " << jter->second << std::endl;
-        }
-      }
-      // done with this g4hit
-      _cache_all_clusters_from_g4hit.insert(std::make_pair(g4hit, assoc_clusters));
-    }
+    build_association_tables();
   }
 
   // get the clusters
   std::set<TrkrDefs::cluskey> clusters;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>>::iterator iter =
-      _cache_all_clusters_from_g4hit.find(truthhit);
-  if (iter != _cache_all_clusters_from_g4hit.end())
+  const auto range = std::equal_range(
+      _assoc_clusters_from_g4hit.begin(), _assoc_clusters_from_g4hit.end(),
+      std::make_pair(truthhit, TrkrDefs::cluskey(0)),
+      [](const std::pair<PHG4Hit*, TrkrDefs::cluskey>& lhs, const std::pair<PHG4Hit*, TrkrDefs::cluskey>& rhs)
+      { return lhs.first < rhs.first; });
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    return iter->second;
+    clusters.insert(clusters.end(), iter->second);
   }
 
-  if (_clusters_per_layer.empty())
+  if (clusters.empty() && _clusters_per_layer.empty())
   {
     fill_cluster_layer_map();
   }
@@ -1278,18 +1302,9 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     return std::numeric_limits<float>::quiet_NaN();
   }
 
-  if (_do_cache)
-  {
-    std::map<std::pair<TrkrDefs::cluskey, PHG4Particle*>, float>::iterator iter =
-        _cache_get_energy_contribution_g4particle.find(std::make_pair(cluster_key, particle));
-    if (iter != _cache_get_energy_contribution_g4particle.end())
-    {
-      return iter->second;
-    }
-  }
-
   float energy = 0.0;
-  std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
+  std::vector<PHG4Hit*> hits;
+  get_truth_hits(cluster_key, hits);
   for (auto* hit : hits)
   {
     if (get_truth_eval()->is_g4hit_from_particle(hit, particle))
@@ -1298,11 +1313,6 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4particle.insert(std::make_pair(std::make_pair(cluster_key, particle), energy));
-  }
-
   return energy;
 }
 
@@ -1325,17 +1335,12 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     return std::numeric_limits<float>::quiet_NaN();
   }
 
-  if ((_do_cache) &&
-      (_cache_get_energy_contribution_g4hit.contains(std::make_pair(cluster_key, g4hit))))
-  {
-    return _cache_get_energy_contribution_g4hit[std::make_pair(cluster_key, g4hit)];
-  }
-
   // this is a fairly simple existance check right now, but might be more
   // complex in the future, so this is here mostly as future-proofing.
 
   float energy = 0.0;
-  std::set<PHG4Hit*> g4hits = all_truth_hits(cluster_key);
+  std::vector<PHG4Hit*> g4hits;
+  get_truth_hits(cluster_key, g4hits);
   for (auto* candidate : g4hits)
   {
     if (candidate->get_hit_id() != g4hit->get_hit_id())
@@ -1345,11 +1350,6 @@ float SvtxClusterEval::get_energy_contribution(TrkrDefs::cluskey cluster_key, PH
     energy += candidate->get_edep();
   }
 
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4hit.insert(std::make_pair(std::make_pair(cluster_key, g4hit), energy));
-  }
-
   return energy;
 }
 
@@ -10,6 +10,7 @@
 #include <memory>  // for shared_ptr, less
 #include <set>
 #include <utility>
+#include <vector>
 
 class PHCompositeNode;
 
@@ -87,6 +88,21 @@ class SvtxClusterEval
  private:
   void get_node_pointers(PHCompositeNode* topNode);
   void fill_cluster_layer_map();
+
+  //! build the flat cluster/g4hit/particle association tables for the current event
+  void build_association_tables();
+
+  //! index of a cluster in the association tables, -1 if not found
+  int association_index(TrkrDefs::cluskey cluster_key);
+
+  //! unique g4hits associated to a cluster, sorted by address. Uses the association tables when caching
+  void get_truth_hits(TrkrDefs::cluskey cluster_key, std::vector<PHG4Hit*>& g4hits);
+
+  //! append all g4hits associated to a cluster to the output vector, possibly with duplicates
+  void collect_truth_hits(TrkrDefs::cluskey cluster_key, std::vector<PHG4Hit*>& g4hits) const;
+
+  //! g4hit container matching a given hitset
+  PHG4HitContainer* get_g4hit_container(TrkrDefs::hitsetkey hitsetkey) const;
   //  void fill_g4hit_layer_map();
   bool has_node_pointers();
 
@@ -113,19 +129,31 @@ class SvtxClusterEval
   Acts::Vector3 getGlobalPosition(TrkrDefs::cluskey cluster_key, TrkrCluster* cluster);
 
   bool _do_cache = true;
-  std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>> _cache_all_truth_hits;
   std::map<TrkrDefs::cluskey, std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_all_truth_clusters;
-  std::map<TrkrDefs::cluskey, PHG4Hit*> _cache_max_truth_hit_by_energy;
   std::map<TrkrDefs::cluskey, std::pair<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_max_truth_cluster_by_energy;
   std::map<TrkrDefs::cluskey, std::set<PHG4Particle*>> _cache_all_truth_particles;
   std::map<TrkrDefs::cluskey, PHG4Particle*> _cache_max_truth_particle_by_energy;
   std::map<TrkrDefs::cluskey, PHG4Particle*> _cache_max_truth_particle_by_cluster_energy;
-  std::map<PHG4Particle*, std::set<TrkrDefs::cluskey>> _cache_all_clusters_from_particle;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>> _cache_all_clusters_from_g4hit;
   std::map<PHG4Hit*, TrkrDefs::cluskey> _cache_best_cluster_from_g4hit;
   std::map<std::pair<int, int>, TrkrDefs::cluskey> _cache_best_cluster_from_gtrackid_layer;
-  std::map<std::pair<TrkrDefs::cluskey, PHG4Particle*>, float> _cache_get_energy_contribution_g4particle;
-  std::map<std::pair<TrkrDefs::cluskey, PHG4Hit*>, float> _cache_get_energy_contribution_g4hit;
+
+  //! per event association tables, filled once by build_association_tables
+  bool _associations_built = false;
+
+  //! sorted cluster keys found in the cluster map
+  std::vector<TrkrDefs::cluskey> _assoc_cluskeys;
+
+  //! offsets of each cluster's g4hits in _assoc_g4hits (size is number of clusters + 1)
+  std::vector<unsigned int> _assoc_offsets;
+
+  //! g4hits associated to each cluster, unique and sorted by address within a cluster
+  std::vector<PHG4Hit*> _assoc_g4hits;
+
+  //! reverse g4hit to cluster association, sorted
+  std::vector<std::pair<PHG4Hit*, TrkrDefs::cluskey>> _assoc_clusters_from_g4hit;
+
+  //! reverse particle to cluster association, sorted
+  std::vector<std::pair<PHG4Particle*, TrkrDefs::cluskey>> _assoc_clusters_from_particle;
   std::map<std::shared_ptr<TrkrCluster>, std::pair<TrkrDefs::cluskey, TrkrCluster*>> _cache_reco_cluster_from_truth_cluster;
 
   // measured for low occupancy events, all in cm
@@ -1,5 +1,6 @@
 #include "SvtxHitEval.h"
 
+#include <trackbase/MvtxDefs.h>
 #include <trackbase/TrkrClusterContainer.h>
 #include <trackbase/TrkrDefs.h>
 #include <trackbase/TrkrHitSet.h>
@@ -12,15 +13,19 @@
 #include <g4main/PHG4Particle.h>
 #include <g4main/PHG4TruthInfoContainer.h>
 
+#include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
 #include <iostream>  // for operator<<, endl, basic_...
+#include <limits>
 #include <map>
 #include <set>
+#include <vector>
 
 class TrkrHit;
 
@@ -43,15 +48,7 @@ SvtxHitEval::~SvtxHitEval()
 
 void SvtxHitEval::next_event(PHCompositeNode* topNode)
 {
-  _cache_all_truth_hits.clear();
-  _cache_max_truth_hit_by_energy.clear();
-  _cache_all_truth_particles.clear();
-  _cache_max_truth_particle_by_energy.clear();
-  _cache_all_hits_from_particle.clear();
-  _cache_all_hits_from_g4hit.clear();
-  _cache_best_hit_from_g4hit.clear();
-  _cache_get_energy_contribution_g4particle.clear();
-  _cache_get_energy_contribution_g4hit.clear();
+  _associations_built = false;
 
   _trutheval.next_event(topNode);
 
@@ -126,18 +123,110 @@ std::set<PHG4Hit*> SvtxHitEval::all_truth_hits(TrkrDefs::hitkey hit_key)
     return std::set<PHG4Hit*>();
   }
 
+  std::vector<PHG4Hit*> g4hits;
+  get_truth_hits(hit_key, g4hits);
+
+  // g4hits are already unique and sorted by address
+  return std::set<PHG4Hit*>(g4hits.begin(), g4hits.end());
+}
+
+std::set<PHG4Hit*> SvtxHitEval::all_truth_hits(TrkrDefs::hitkey hit_key, const TrkrDefs::TrkrId trkrid)
+{
+  if (!has_node_pointers())
+  {
+    ++_errors;
+    if (_verbosity > 0)
+    {
+      std::cout << PHWHERE << " nerr: " << _errors << std::endl;
+    }
+    return std::set<PHG4Hit*>();
+  }
+
+  if (_strict)
+  {
+    assert(hit_key);
+  }
+  else if (!hit_key)
+  {
+    ++_errors;
+    if (_verbosity > 0)
+    {
+      std::cout << PHWHERE << " nerr: " << _errors << std::endl;
+    }
+    return std::set<PHG4Hit*>();
+  }
+
+  std::vector<PHG4Hit*> g4hits;
+  get_truth_hits(hit_key, trkrid, g4hits);
+
+  // g4hits are already unique and sorted by address
+  return std::set<PHG4Hit*>(g4hits.begin(), g4hits.end());
+}
+
+void SvtxHitEval::get_truth_hits(TrkrDefs::hitkey hit_key, std::vector<PHG4Hit*>& g4hits)
+{
+  g4hits.clear();
   if (_do_cache)
   {
-    std::map<TrkrDefs::hitkey, std::set<PHG4Hit*> >::iterator iter =
-        _cache_all_truth_hits.find(hit_key);
-    if (iter != _cache_all_truth_hits.end())
+    if (!_associations_built)
+    {
+      build_association_tables();
+    }
+
+    // the same hit key can be found in several hitsets, of one or more trackers
+    const auto range = std::equal_range(
+        _assoc_hitkeys.begin(), _assoc_hitkeys.end(), std::make_pair(hit_key, 0U),
+        [](const std::pair<TrkrDefs::hitkey, unsigned int>& lhs, const std::pair<TrkrDefs::hitkey, unsigned int>& rhs)
+        { return lhs.first < rhs.first; });
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      const unsigned int index = iter - _assoc_hitkeys.begin();
+      g4hits.insert(g4hits.end(), _assoc_g4hits.begin() + _assoc_offsets[index], _assoc_g4hits.begin() + _assoc_offsets[index + 1]);
+    }
+    // g4hits of a single (hit key, tracker id) are already unique and sorted
+    if (range.second - range.first < 2)
     {
-      return iter->second;
+      return;
     }
   }
+  else
+  {
+    // get all of the g4hits for this hit_key
+    // have to start with all hitsets, unfortunately
+    collect_truth_hits(hit_key, _hitmap->getHitSets(), g4hits);
+  }
+
+  std::sort(g4hits.begin(), g4hits.end());
+  g4hits.erase(std::unique(g4hits.begin(), g4hits.end()), g4hits.end());
+}
 
-  std::set<PHG4Hit*> truth_hits;
+void SvtxHitEval::get_truth_hits(TrkrDefs::hitkey hit_key, const TrkrDefs::TrkrId trkrid, std::vector<PHG4Hit*>& g4hits)
+{
+  g4hits.clear();
+  if (_do_cache)
+  {
+    if (!_associations_built)
+    {
+      build_association_tables();
+    }
 
+    const auto key = std::make_pair(hit_key, static_cast<unsigned int>(trkrid));
+    const auto iter = std::lower_bound(_assoc_hitkeys.begin(), _assoc_hitkeys.end(), key);
+    if (iter != _assoc_hitkeys.end() && *iter == key)
+    {
+      const unsigned int index = iter - _assoc_hitkeys.begin();
+      g4hits.assign(_assoc_g4hits.begin() + _assoc_offsets[index], _assoc_g4hits.begin() + _assoc_offsets[index + 1]);
+    }
+    return;
+  }
+
+  collect_truth_hits(hit_key, _hitmap->getHitSets(trkrid), g4hits);
+  std::sort(g4hits.begin(), g4hits.end());
+  g4hits.erase(std::unique(g4hits.begin(), g4hits.end()), g4hits.end());
+}
+
+void SvtxHitEval::collect_truth_hits(TrkrDefs::hitkey hit_key, const TrkrHitSetContainer::ConstRange& hitsets, std::vector<PHG4Hit*>& g4hits) const
+{
   /*
   // hop from reco hit to g4cell
   PHG4Cell* cell = nullptr;
@@ -177,155 +266,172 @@ std::set<PHG4Hit*> SvtxHitEval::all_truth_hits(TrkrDefs::hitkey hit_key)
     }
   */
 
-  // get all of the g4hits for this hit_key
-  // have to start with all hitsets, unfortunately
-  TrkrHitSetContainer::ConstRange all_hitsets = _hitmap->getHitSets();
-  for (TrkrHitSetContainer::ConstIterator iter = all_hitsets.first; iter != all_hitsets.second; ++iter)
+  for (TrkrHitSetContainer::ConstIterator iter = hitsets.first; iter != hitsets.second; ++iter)
   {
     TrkrDefs::hitsetkey hitset_key = iter->first;
-    unsigned int trkrid = TrkrDefs::getTrkrId(hitset_key);
     TrkrHitSet* hitset = iter->second;
+    PHG4HitContainer* g4hitcontainer = get_g4hit_container(TrkrDefs::getTrkrId(hitset_key));
 
     // does this hitset contain our hitkey?
-    TrkrHit* hit = nullptr;
-    hit = hitset->getHit(hit_key);
-    if (hit)
+    TrkrHit* hit = hitset->getHit(hit_key);
+    if (hit && g4hitcontainer)
     {
       // get g4hits for this hit
-
       std::multimap<TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype> > temp_map;
       _hit_truth_map->getG4Hits(hitset_key, hit_key, temp_map);  // returns pairs (hitsetkey, std::pair(hitkey, g4hitkey)) for this hitkey only
       for (auto& htiter : temp_map)
       {
-        // extract the g4 hit key here and add the g4hit to the set
-        PHG4HitDefs::keytype g4hitkey = htiter.second.second;
-        // std::cout << "           hitkey " << hitkey <<  " g4hitkey " << g4hitkey << std::endl;
-        PHG4Hit* g4hit = nullptr;
-        switch (trkrid)
-        {
-        case TrkrDefs::tpcId:
-          g4hit = _g4hits_tpc->findHit(g4hitkey);
-          break;
-        case TrkrDefs::inttId:
-          g4hit = _g4hits_intt->findHit(g4hitkey);
-          break;
-        case TrkrDefs::mvtxId:
-          g4hit = _g4hits_mvtx->findHit(g4hitkey);
-          break;
-        case TrkrDefs::micromegasId:
-          g4hit = _g4hits_mms->findHit(g4hitkey);
-          break;
-        default:
-          break;
-        }
-        // fill output set
+        // extract the g4 hit key here and add the g4hit to the output
+        PHG4Hit* g4hit = g4hitcontainer->findHit(htiter.second.second);
         if (g4hit)
         {
-          truth_hits.insert(g4hit);
+          g4hits.push_back(g4hit);
         }
       }
     }
   }
+}
 
-  if (_do_cache)
-  {
-    _cache_all_truth_hits.insert(std::make_pair(hit_key, truth_hits));
+PHG4HitContainer* SvtxHitEval::get_g4hit_container(unsigned int trkrid) const
+{
+  switch (trkrid)
+  {
+  case TrkrDefs::tpcId:
+    return _g4hits_tpc;
+  case TrkrDefs::inttId:
+    return _g4hits_intt;
+  case TrkrDefs::mvtxId:
+    return _g4hits_mvtx;
+  case TrkrDefs::micromegasId:
+    return _g4hits_mms;
+  default:
+    return nullptr;
   }
-
-  return truth_hits;
 }
 
-std::set<PHG4Hit*> SvtxHitEval::all_truth_hits(TrkrDefs::hitkey hit_key, const TrkrDefs::TrkrId trkrid)
+void SvtxHitEval::build_association_tables()
 {
-  if (!has_node_pointers())
-  {
-    ++_errors;
-    if (_verbosity > 0)
-    {
-      std::cout << PHWHERE << " nerr: " << _errors << std::endl;
-    }
-    return std::set<PHG4Hit*>();
-  }
+  PHTimer timer("SvtxHitEval_assoc");
+  timer.restart();
 
-  if (_strict)
-  {
-    assert(hit_key);
-  }
-  else if (!hit_key)
+  _associations_built = true;
+  _assoc_hitkeys.clear();
+  _assoc_offsets.assign(1, 0);
+  _assoc_g4hits.clear();
+  _assoc_hits_from_g4hit.clear();
+  _assoc_hits_from_particle.clear();
+
+  if (!_hitmap || !_hit_truth_map)
   {
-    ++_errors;
-    if (_verbosity > 0)
-    {
-      std::cout << PHWHERE << " nerr: " << _errors << std::endl;
-    }
-    return std::set<PHG4Hit*>();
+    return;
   }
 
-  if (_do_cache)
+  // (hitkey, g4hitkey) pairs for the current hitset, sorted by hitkey.
+  // This replaces one scan of all hitsets per hit key by one scan per hitset
+  using HitAssoc = std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype>;
+  const auto fill_hit_assocs = [this](TrkrDefs::hitsetkey hitsetkey, std::vector<HitAssoc>& hit_assocs)
   {
-    std::map<TrkrDefs::hitkey, std::set<PHG4Hit*> >::iterator iter =
-        _cache_all_truth_hits.find(hit_key);
-    if (iter != _cache_all_truth_hits.end())
+    hit_assocs.clear();
+    const auto range = _hit_truth_map->getG4Hits(hitsetkey);
+    for (auto iter = range.first; iter != range.second; ++iter)
     {
-      return iter->second;
+      hit_assocs.push_back(iter->second);
     }
-  }
+    std::sort(hit_assocs.begin(), hit_assocs.end());
+  };
+
+  const auto hitkey_less = [](const HitAssoc& lhs, const HitAssoc& rhs)
+  { return lhs.first < rhs.first; };
 
-  std::set<PHG4Hit*> truth_hits;
-  TrkrHitSetContainer::ConstRange all_hitsets = _hitmap->getHitSets(trkrid);
+  // ((hitkey, trkrid), g4hit) links of all hitsets
+  using HitLink = std::pair<std::pair<TrkrDefs::hitkey, unsigned int>, PHG4Hit*>;
+  std::vector<HitLink> links;
 
+  std::vector<HitAssoc> hit_assocs;
+  std::vector<HitAssoc> bare_hit_assocs;
+  TrkrHitSetContainer::ConstRange all_hitsets = _hitmap->getHitSets();
   for (TrkrHitSetContainer::ConstIterator iter = all_hitsets.first; iter != all_hitsets.second; ++iter)
   {
-    TrkrDefs::hitsetkey hitset_key = iter->first;
-    TrkrHitSet* hitset = iter->second;
-
-    // does this hitset contain our hitkey?
-    TrkrHit* hit = nullptr;
-    hit = hitset->getHit(hit_key);
-    if (hit)
+    const TrkrDefs::hitsetkey hitsetkey = iter->first;
+    const unsigned int trkrid = TrkrDefs::getTrkrId(hitsetkey);
+    PHG4HitContainer* g4hitcontainer = get_g4hit_container(trkrid);
+    if (!g4hitcontainer)
     {
-      // get g4hits for this hit
+      continue;
+    }
+    fill_hit_assocs(hitsetkey, hit_assocs);
 
-      std::multimap<TrkrDefs::hitsetkey, std::pair<TrkrDefs::hitkey, PHG4HitDefs::keytype> > temp_map;
-      _hit_truth_map->getG4Hits(hitset_key, hit_key, temp_map);  // returns pairs (hitsetkey, std::pair(hitkey, g4hitkey)) for this hitkey only
-      for (auto& htiter : temp_map)
+    // mvtx special case: hits with no association are looked up in the bare hitsetkey, as in TrkrHitTruthAssoc::getG4Hits
+    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+    bool has_bare_hit_assocs = false;
+
+    TrkrHitSet::ConstRange range = iter->second->getHits();
+    for (TrkrHitSet::ConstIterator hitr = range.first; hitr != range.second; ++hitr)
+    {
+      const HitAssoc key(hitr->first, 0);
+      auto assocs = std::equal_range(hit_assocs.begin(), hit_assocs.end(), key, hitkey_less);
+      if (assocs.first == assocs.second && layer < 3)
       {
-        // extract the g4 hit key here and add the g4hit to the set
-        PHG4HitDefs::keytype g4hitkey = htiter.second.second;
-        // std::cout << "           hitkey " << hitkey <<  " g4hitkey " << g4hitkey << std::endl;
-        PHG4Hit* g4hit = nullptr;
-        switch (trkrid)
+        if (!has_bare_hit_assocs)
         {
-        case TrkrDefs::tpcId:
-          g4hit = _g4hits_tpc->findHit(g4hitkey);
-          break;
-        case TrkrDefs::inttId:
-          g4hit = _g4hits_intt->findHit(g4hitkey);
-          break;
-        case TrkrDefs::mvtxId:
-          g4hit = _g4hits_mvtx->findHit(g4hitkey);
-          break;
-        case TrkrDefs::micromegasId:
-          g4hit = _g4hits_mms->findHit(g4hitkey);
-          break;
-        default:
-          break;
+          const TrkrDefs::hitsetkey bare_hitsetkey = MvtxDefs::genHitSetKey(layer, MvtxDefs::getStaveId(hitsetkey), MvtxDefs::getChipId(hitsetkey), 0);
+          fill_hit_assocs(bare_hitsetkey, bare_hit_assocs);
+          has_bare_hit_assocs = true;
         }
-        // fill output set
+        assocs = std::equal_range(bare_hit_assocs.begin(), bare_hit_assocs.end(), key, hitkey_less);
+      }
+
+      for (auto assoc = assocs.first; assoc != assocs.second; ++assoc)
+      {
+        PHG4Hit* g4hit = g4hitcontainer->findHit(assoc->second);
         if (g4hit)
         {
-          truth_hits.insert(g4hit);
+          links.emplace_back(std::make_pair(hitr->first, trkrid), g4hit);
         }
       }
     }
   }
 
-  if (_do_cache)
+  // unique g4hits for each (hit key, tracker id), sorted by address to match the std::set ordering of all_truth_hits
+  std::sort(links.begin(), links.end());
+  links.erase(std::unique(links.begin(), links.end()), links.end());
+
+  _assoc_g4hits.reserve(links.size());
+  _assoc_hits_from_g4hit.reserve(links.size());
+  _assoc_hits_from_particle.reserve(links.size());
+  for (const auto& [hitkey_trkrid, g4hit] : links)
+  {
+    if (_assoc_hitkeys.empty() || _assoc_hitkeys.back() != hitkey_trkrid)
+    {
+      if (!_assoc_hitkeys.empty())
+      {
+        _assoc_offsets.push_back(_assoc_g4hits.size());
+      }
+      _assoc_hitkeys.push_back(hitkey_trkrid);
+    }
+    _assoc_g4hits.push_back(g4hit);
+    _assoc_hits_from_g4hit.emplace_back(g4hit->get_hit_id(), hitkey_trkrid.first);
+    _assoc_hits_from_particle.emplace_back(g4hit->get_trkid(), hitkey_trkrid.first);
+  }
+  if (!_assoc_hitkeys.empty())
   {
-    _cache_all_truth_hits.insert(std::make_pair(hit_key, truth_hits));
+    _assoc_offsets.push_back(_assoc_g4hits.size());
   }
 
-  return truth_hits;
+  std::sort(_assoc_hits_from_g4hit.begin(), _assoc_hits_from_g4hit.end());
+  _assoc_hits_from_g4hit.erase(std::unique(_assoc_hits_from_g4hit.begin(), _assoc_hits_from_g4hit.end()), _assoc_hits_from_g4hit.end());
+  std::sort(_assoc_hits_from_particle.begin(), _assoc_hits_from_particle.end());
+  _assoc_hits_from_particle.erase(std::unique(_assoc_hits_from_particle.begin(), _assoc_hits_from_particle.end()), _assoc_hits_from_particle.end());
+
+  timer.stop();
+  if (_verbosity > 0)
+  {
+    std::cout << "SvtxHitEval::build_association_tables -"
+              << " hit keys: " << _assoc_hitkeys.size()
+              << " g4hit links: " << _assoc_g4hits.size()
+              << " particle links: " << _assoc_hits_from_particle.size()
+              << " time: " << timer.get_accumulated_time() << " ms" << std::endl;
+  }
 }
 
 PHG4Hit* SvtxHitEval::max_truth_hit_by_energy(TrkrDefs::hitkey hit_key)
@@ -354,17 +460,8 @@ PHG4Hit* SvtxHitEval::max_truth_hit_by_energy(TrkrDefs::hitkey hit_key)
     return nullptr;
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::hitkey, PHG4Hit*>::iterator iter =
-        _cache_max_truth_hit_by_energy.find(hit_key);
-    if (iter != _cache_max_truth_hit_by_energy.end())
-    {
-      return iter->second;
-    }
-  }
-
-  std::set<PHG4Hit*> hits = all_truth_hits(hit_key);
+  std::vector<PHG4Hit*> hits;
+  get_truth_hits(hit_key, hits);
   PHG4Hit* max_hit = nullptr;
   float max_e = std::numeric_limits<float>::min();
   for (auto *hit : hits)
@@ -376,11 +473,6 @@ PHG4Hit* SvtxHitEval::max_truth_hit_by_energy(TrkrDefs::hitkey hit_key)
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_max_truth_hit_by_energy.insert(std::make_pair(hit_key, max_hit));
-  }
-
   return max_hit;
 }
 
@@ -410,17 +502,8 @@ PHG4Hit* SvtxHitEval::max_truth_hit_by_energy(TrkrDefs::hitkey hit_key, const Tr
     return nullptr;
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::hitkey, PHG4Hit*>::iterator iter =
-        _cache_max_truth_hit_by_energy.find(hit_key);
-    if (iter != _cache_max_truth_hit_by_energy.end())
-    {
-      return iter->second;
-    }
-  }
-
-  std::set<PHG4Hit*> hits = all_truth_hits(hit_key, trkrid);
+  std::vector<PHG4Hit*> hits;
+  get_truth_hits(hit_key, trkrid, hits);
   PHG4Hit* max_hit = nullptr;
   float max_e = std::numeric_limits<float>::min();
   for (auto *hit : hits)
@@ -432,11 +515,6 @@ PHG4Hit* SvtxHitEval::max_truth_hit_by_energy(TrkrDefs::hitkey hit_key, const Tr
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_max_truth_hit_by_energy.insert(std::make_pair(hit_key, max_hit));
-  }
-
   return max_hit;
 }
 
@@ -466,19 +544,10 @@ std::set<PHG4Particle*> SvtxHitEval::all_truth_particles(TrkrDefs::hitkey hit_ke
     return std::set<PHG4Particle*>();
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::hitkey, std::set<PHG4Particle*> >::iterator iter =
-        _cache_all_truth_particles.find(hit_key);
-    if (iter != _cache_all_truth_particles.end())
-    {
-      return iter->second;
-    }
-  }
-
   std::set<PHG4Particle*> truth_particles;
 
-  std::set<PHG4Hit*> g4hits = all_truth_hits(hit_key);
+  std::vector<PHG4Hit*> g4hits;
+  get_truth_hits(hit_key, g4hits);
 
   for (auto *g4hit : g4hits)
   {
@@ -501,11 +570,6 @@ std::set<PHG4Particle*> SvtxHitEval::all_truth_particles(TrkrDefs::hitkey hit_ke
     truth_particles.insert(particle);
   }
 
-  if (_do_cache)
-  {
-    _cache_all_truth_particles.insert(std::make_pair(hit_key, truth_particles));
-  }
-
   return truth_particles;
 }
 
@@ -535,19 +599,10 @@ std::set<PHG4Particle*> SvtxHitEval::all_truth_particles(TrkrDefs::hitkey hit_ke
     return std::set<PHG4Particle*>();
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::hitkey, std::set<PHG4Particle*> >::iterator iter =
-        _cache_all_truth_particles.find(hit_key);
-    if (iter != _cache_all_truth_particles.end())
-    {
-      return iter->second;
-    }
-  }
-
   std::set<PHG4Particle*> truth_particles;
 
-  std::set<PHG4Hit*> g4hits = all_truth_hits(hit_key, trkrid);
+  std::vector<PHG4Hit*> g4hits;
+  get_truth_hits(hit_key, trkrid, g4hits);
 
   for (auto *g4hit : g4hits)
   {
@@ -570,11 +625,6 @@ std::set<PHG4Particle*> SvtxHitEval::all_truth_particles(TrkrDefs::hitkey hit_ke
     truth_particles.insert(particle);
   }
 
-  if (_do_cache)
-  {
-    _cache_all_truth_particles.insert(std::make_pair(hit_key, truth_particles));
-  }
-
   return truth_particles;
 }
 
@@ -604,16 +654,6 @@ PHG4Particle* SvtxHitEval::max_truth_particle_by_energy(TrkrDefs::hitkey hit_key
     return nullptr;
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::hitkey, PHG4Particle*>::iterator iter =
-        _cache_max_truth_particle_by_energy.find(hit_key);
-    if (iter != _cache_max_truth_particle_by_energy.end())
-    {
-      return iter->second;
-    }
-  }
-
   // loop over all particles associated with this hit and
   // get the energy contribution for each one, record the max
   PHG4Particle* max_particle = nullptr;
@@ -629,11 +669,6 @@ PHG4Particle* SvtxHitEval::max_truth_particle_by_energy(TrkrDefs::hitkey hit_key
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_max_truth_particle_by_energy.insert(std::make_pair(hit_key, max_particle));
-  }
-
   return max_particle;
 }
 
@@ -663,16 +698,6 @@ PHG4Particle* SvtxHitEval::max_truth_particle_by_energy(TrkrDefs::hitkey hit_key
     return nullptr;
   }
 
-  if (_do_cache)
-  {
-    std::map<TrkrDefs::hitkey, PHG4Particle*>::iterator iter =
-        _cache_max_truth_particle_by_energy.find(hit_key);
-    if (iter != _cache_max_truth_particle_by_energy.end())
-    {
-      return iter->second;
-    }
-  }
-
   // loop over all particles associated with this hit and
   // get the energy contribution for each one, record the max
   PHG4Particle* max_particle = nullptr;
@@ -688,11 +713,6 @@ PHG4Particle* SvtxHitEval::max_truth_particle_by_energy(TrkrDefs::hitkey hit_key
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_max_truth_particle_by_energy.insert(std::make_pair(hit_key, max_particle));
-  }
-
   return max_particle;
 }
 
@@ -722,45 +742,22 @@ std::set<TrkrDefs::hitkey> SvtxHitEval::all_hits_from(PHG4Particle* g4particle)
     return std::set<TrkrDefs::hitkey>();
   }
 
-  if (_do_cache)
+  // the table is rebuilt on every call when not caching
+  if (!_associations_built || !_do_cache)
   {
-    std::map<PHG4Particle*, std::set<TrkrDefs::hitkey> >::iterator iter =
-        _cache_all_hits_from_particle.find(g4particle);
-    if (iter != _cache_all_hits_from_particle.end())
-    {
-      return iter->second;
-    }
+    build_association_tables();
   }
 
+  // hits with at least one g4hit from this particle
   std::set<TrkrDefs::hitkey> hits;
-
-  // loop over all the hits
-  TrkrHitSetContainer::ConstRange all_hitsets = _hitmap->getHitSets();
-  for (TrkrHitSetContainer::ConstIterator iter = all_hitsets.first;
-       iter != all_hitsets.second;
-       ++iter)
+  const auto range = std::equal_range(
+      _assoc_hits_from_particle.begin(), _assoc_hits_from_particle.end(),
+      std::make_pair(g4particle->get_track_id(), TrkrDefs::hitkey(0)),
+      [](const std::pair<int, TrkrDefs::hitkey>& lhs, const std::pair<int, TrkrDefs::hitkey>& rhs)
+      { return lhs.first < rhs.first; });
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    TrkrHitSet::ConstRange range = iter->second->getHits();
-    for (TrkrHitSet::ConstIterator hitr = range.first; hitr != range.second; ++hitr)
-    {
-      TrkrDefs::hitkey hit_key = hitr->first;
-
-      // loop over all truth hits connected to this hit
-      std::set<PHG4Hit*> g4hits = all_truth_hits(hit_key);
-      for (auto *candidate : g4hits)
-      {
-        PHG4Particle* particle = _truthinfo->GetParticle(candidate->get_trkid());
-        if (g4particle->get_track_id() == particle->get_track_id())
-        {
-          hits.insert(hit_key);
-        }
-      }
-    }
-  }
-
-  if (_do_cache)
-  {
-    _cache_all_hits_from_particle.insert(std::make_pair(g4particle, hits));
+    hits.insert(hits.end(), iter->second);
   }
 
   return hits;
@@ -792,53 +789,30 @@ std::set<TrkrDefs::hitkey> SvtxHitEval::all_hits_from(PHG4Hit* g4hit)
     return std::set<TrkrDefs::hitkey>();
   }
 
-  if (_do_cache)
+  // the table is rebuilt on every call when not caching
+  if (!_associations_built || !_do_cache)
   {
-    std::map<PHG4Hit*, std::set<TrkrDefs::hitkey> >::iterator iter =
-        _cache_all_hits_from_g4hit.find(g4hit);
-    if (iter != _cache_all_hits_from_g4hit.end())
-    {
-      return iter->second;
-    }
+    build_association_tables();
   }
 
   std::set<TrkrDefs::hitkey> hits;
 
   unsigned int hit_layer = g4hit->get_layer();
 
-  // loop over all the hits
-  TrkrHitSetContainer::ConstRange all_hitsets = _hitmap->getHitSets();
-  for (TrkrHitSetContainer::ConstIterator iter = all_hitsets.first;
-       iter != all_hitsets.second;
-       ++iter)
+  // hits in the g4hit layer with a g4hit of the same id
+  const auto range = std::equal_range(
+      _assoc_hits_from_g4hit.begin(), _assoc_hits_from_g4hit.end(),
+      std::make_pair(g4hit->get_hit_id(), TrkrDefs::hitkey(0)),
+      [](const std::pair<PHG4HitDefs::keytype, TrkrDefs::hitkey>& lhs, const std::pair<PHG4HitDefs::keytype, TrkrDefs::hitkey>& rhs)
+      { return lhs.first < rhs.first; });
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    TrkrHitSet::ConstRange range = iter->second->getHits();
-    for (TrkrHitSet::ConstIterator hitr = range.first; hitr != range.second; ++hitr)
+    if (TrkrDefs::getLayer(iter->second) == hit_layer)
     {
-      TrkrDefs::hitkey hit_key = hitr->first;
-
-      if (TrkrDefs::getLayer(hit_key) != hit_layer)
-      {
-        continue;
-      }
-
-      // loop over all truth hits connected to this hit
-      std::set<PHG4Hit*> g4hits = all_truth_hits(hit_key);
-      for (auto *candidate : g4hits)
-      {
-        if (candidate->get_hit_id() == g4hit->get_hit_id())
-        {
-          hits.insert(hit_key);
-        }
-      }
+      hits.insert(hits.end(), iter->second);
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_all_hits_from_g4hit.insert(std::make_pair(g4hit, hits));
-  }
-
   return hits;
 }
 
@@ -868,16 +842,6 @@ TrkrDefs::hitkey SvtxHitEval::best_hit_from(PHG4Hit* g4hit)
     return 0;
   }
 
-  if (_do_cache)
-  {
-    std::map<PHG4Hit*, TrkrDefs::hitkey>::iterator iter =
-        _cache_best_hit_from_g4hit.find(g4hit);
-    if (iter != _cache_best_hit_from_g4hit.end())
-    {
-      return iter->second;
-    }
-  }
-
   TrkrDefs::hitkey best_hit = 0;
   float best_energy = 0.0;
   std::set<TrkrDefs::hitkey> hits = all_hits_from(g4hit);
@@ -891,11 +855,6 @@ TrkrDefs::hitkey SvtxHitEval::best_hit_from(PHG4Hit* g4hit)
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_best_hit_from_g4hit.insert(std::make_pair(g4hit, best_hit));
-  }
-
   return best_hit;
 }
 
@@ -927,18 +886,9 @@ float SvtxHitEval::get_energy_contribution(TrkrDefs::hitkey hit_key, PHG4Particl
     return std::numeric_limits<float>::quiet_NaN();
   }
 
-  if (_do_cache)
-  {
-    std::map<std::pair<TrkrDefs::hitkey, PHG4Particle*>, float>::iterator iter =
-        _cache_get_energy_contribution_g4particle.find(std::make_pair(hit_key, particle));
-    if (iter != _cache_get_energy_contribution_g4particle.end())
-    {
-      return iter->second;
-    }
-  }
-
   float energy = 0.0;
-  std::set<PHG4Hit*> g4hits = all_truth_hits(hit_key);
+  std::vector<PHG4Hit*> g4hits;
+  get_truth_hits(hit_key, g4hits);
   for (auto *g4hit : g4hits)
   {
     if (get_truth_eval()->is_g4hit_from_particle(g4hit, particle))
@@ -947,11 +897,6 @@ float SvtxHitEval::get_energy_contribution(TrkrDefs::hitkey hit_key, PHG4Particl
     }
   }
 
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4particle.insert(std::make_pair(std::make_pair(hit_key, particle), energy));
-  }
-
   return energy;
 }
 
@@ -982,21 +927,12 @@ float SvtxHitEval::get_energy_contribution(TrkrDefs::hitkey hit_key, PHG4Hit* g4
     return std::numeric_limits<float>::quiet_NaN();
   }
 
-  if (_do_cache)
-  {
-    std::map<std::pair<TrkrDefs::hitkey, PHG4Hit*>, float>::iterator iter =
-        _cache_get_energy_contribution_g4hit.find(std::make_pair(hit_key, g4hit));
-    if (iter != _cache_get_energy_contribution_g4hit.end())
-    {
-      return iter->second;
-    }
-  }
-
   // this is a fairly simple existance check right now, but might be more
   // complex in the future, so this is here mostly as future-proofing.
 
   float energy = 0.0;
-  std::set<PHG4Hit*> g4hits = all_truth_hits(hit_key);
+  std::vector<PHG4Hit*> g4hits;
+  get_truth_hits(hit_key, g4hits);
   for (auto *candidate : g4hits)
   {
     if (candidate->get_hit_id() != g4hit->get_hit_id())
@@ -1006,11 +942,6 @@ float SvtxHitEval::get_energy_contribution(TrkrDefs::hitkey hit_key, PHG4Hit* g4
     energy += candidate->get_edep();
   }
 
-  if (_do_cache)
-  {
-    _cache_get_energy_contribution_g4hit.insert(std::make_pair(std::make_pair(hit_key, g4hit), energy));
-  }
-
   return energy;
 }
 
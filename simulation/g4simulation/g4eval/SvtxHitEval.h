@@ -4,10 +4,13 @@
 #include "SvtxTruthEval.h"
 
 #include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrHitSetContainer.h>
+
+#include <g4main/PHG4HitDefs.h>
 
-#include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 class PHCompositeNode;
 
@@ -16,7 +19,6 @@ class PHG4HitContainer;
 class PHG4Particle;
 class PHG4TruthInfoContainer;
 
-class TrkrHitSetContainer;
 class TrkrClusterContainer;
 class TrkrHitTruthAssoc;
 
@@ -79,6 +81,19 @@ class SvtxHitEval
   void get_node_pointers(PHCompositeNode* topNode);
   bool has_node_pointers();
 
+  //! build the flat hit/g4hit association tables for the current event
+  void build_association_tables();
+
+  //! unique g4hits associated to a hit key in all hitsets, or in the hitsets of one tracker, sorted by address
+  void get_truth_hits(TrkrDefs::hitkey hit_key, std::vector<PHG4Hit*>& g4hits);
+  void get_truth_hits(TrkrDefs::hitkey hit_key, const TrkrDefs::TrkrId trkrid, std::vector<PHG4Hit*>& g4hits);
+
+  //! append the g4hits associated to a hit key in the hitsets of the given range, possibly with duplicates
+  void collect_truth_hits(TrkrDefs::hitkey hit_key, const TrkrHitSetContainer::ConstRange& hitsets, std::vector<PHG4Hit*>& g4hits) const;
+
+  //! g4hit container matching a given tracker
+  PHG4HitContainer* get_g4hit_container(unsigned int trkrid) const;
+
   SvtxTruthEval _trutheval;
   TrkrHitSetContainer* _hitmap = nullptr;
   TrkrClusterContainer* _clustermap{};
@@ -96,15 +111,24 @@ class SvtxHitEval
   unsigned int _errors = 0;
 
   bool _do_cache = true;
-  std::map<TrkrDefs::hitkey, std::set<PHG4Hit*> > _cache_all_truth_hits;
-  std::map<TrkrDefs::hitkey, PHG4Hit*> _cache_max_truth_hit_by_energy;
-  std::map<TrkrDefs::hitkey, std::set<PHG4Particle*> > _cache_all_truth_particles;
-  std::map<TrkrDefs::hitkey, PHG4Particle*> _cache_max_truth_particle_by_energy;
-  std::map<PHG4Particle*, std::set<TrkrDefs::hitkey> > _cache_all_hits_from_particle;
-  std::map<PHG4Hit*, std::set<TrkrDefs::hitkey> > _cache_all_hits_from_g4hit;
-  std::map<PHG4Hit*, TrkrDefs::hitkey> _cache_best_hit_from_g4hit;
-  std::map<std::pair<TrkrDefs::hitkey, PHG4Particle*>, float> _cache_get_energy_contribution_g4particle;
-  std::map<std::pair<TrkrDefs::hitkey, PHG4Hit*>, float> _cache_get_energy_contribution_g4hit;
+
+  //! per event association tables, filled once by build_association_tables
+  bool _associations_built = false;
+
+  //! sorted (hit key, tracker id) pairs found in the hitsets
+  std::vector<std::pair<TrkrDefs::hitkey, unsigned int>> _assoc_hitkeys;
+
+  //! offsets of each (hit key, tracker id) g4hits in _assoc_g4hits (size is number of hit keys + 1)
+  std::vector<unsigned int> _assoc_offsets;
+
+  //! g4hits associated to each (hit key, tracker id), unique and sorted by address
+  std::vector<PHG4Hit*> _assoc_g4hits;
+
+  //! reverse g4hit id to hit key association, sorted
+  std::vector<std::pair<PHG4HitDefs::keytype, TrkrDefs::hitkey>> _assoc_hits_from_g4hit;
+
+  //! reverse particle track id to hit key association, sorted
+  std::vector<std::pair<int, TrkrDefs::hitkey>> _assoc_hits_from_particle;
 };
 
 #endif  // G4EVAL_SVTXHITEVAL_H
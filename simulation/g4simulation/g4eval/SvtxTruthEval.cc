@@ -29,6 +29,7 @@
 #include <intt/CylinderGeomInttHelper.h>
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -66,12 +67,10 @@ SvtxTruthEval::~SvtxTruthEval()
 
 void SvtxTruthEval::next_event(PHCompositeNode* topNode)
 {
-  _cache_all_truth_hits.clear();
-  _cache_all_truth_hits_g4particle.clear();
-  _cache_all_truth_clusters_g4particle.clear();
-  _cache_get_innermost_truth_hit.clear();
-  _cache_get_outermost_truth_hit.clear();
-  _cache_get_primary_particle_g4hit.clear();
+  _truth_hits_built = false;
+  _truth_hits.clear();
+  _truth_hits_from_trackid.clear();
+  _truth_clusters_from_particle.clear();
 
   _basetrutheval.next_event(topNode);
 
@@ -87,73 +86,14 @@ std::set<PHG4Hit*> SvtxTruthEval::all_truth_hits()
     return std::set<PHG4Hit*>();
   }
 
-  if (_do_cache)
+  // the flat table is rebuilt on every call when not caching
+  if (!_truth_hits_built || !_do_cache)
   {
-    if (!_cache_all_truth_hits.empty())
-    {
-      return _cache_all_truth_hits;
-    }
-  }
-
-  // since the SVTX can be composed of two different trackers this is a
-  // handy function to spill out all the g4hits from both "detectors"
-
-  std::set<PHG4Hit*> truth_hits;
-
-  // loop over all the g4hits in the cylinder layers
-  if (_g4hits_svtx)
-  {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_svtx->getHits().first;
-         g4iter != _g4hits_svtx->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      truth_hits.insert(g4hit);
-    }
-  }
-
-  // loop over all the g4hits in the ladder layers
-  if (_g4hits_tracker)
-  {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_tracker->getHits().first;
-         g4iter != _g4hits_tracker->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      truth_hits.insert(g4hit);
-    }
-  }
-
-  // loop over all the g4hits in the maps layers
-  if (_g4hits_maps)
-  {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_maps->getHits().first;
-         g4iter != _g4hits_maps->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      truth_hits.insert(g4hit);
-    }
-  }
-
-  // loop over all the g4hits in the maicromegas layers
-  if (_g4hits_mms)
-  {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_mms->getHits().first;
-         g4iter != _g4hits_mms->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      truth_hits.insert(g4hit);
-    }
-  }
-
-  if (_do_cache)
-  {
-    _cache_all_truth_hits = truth_hits;
+    FillTruthHitsFromParticleCache();
   }
 
-  return truth_hits;
+  // g4hits are already unique and sorted by address
+  return std::set<PHG4Hit*>(_truth_hits.begin(), _truth_hits.end());
 }
 
 std::set<PHG4Hit*> SvtxTruthEval::all_truth_hits(PHG4Particle* particle)
@@ -173,93 +113,77 @@ std::set<PHG4Hit*> SvtxTruthEval::all_truth_hits(PHG4Particle* particle)
     ++_errors;
     return std::set<PHG4Hit*>();
   }
-  //  if( _cache_all_truth_hits_g4particle.count(particle)==0){
-  if (_cache_all_truth_hits_g4particle.empty())
-  {
-    FillTruthHitsFromParticleCache();
-  }
 
-  if (_do_cache)
+  std::set<PHG4Hit*> truth_hits;
+  const auto range = truth_hit_range(particle);
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    std::map<PHG4Particle*, std::set<PHG4Hit*>>::iterator iter =
-        _cache_all_truth_hits_g4particle.find(particle);
-    if (iter != _cache_all_truth_hits_g4particle.end())
-    {
-      return iter->second;
-    }
+    truth_hits.insert(truth_hits.end(), iter->second);
   }
-  // return empty if we dont find anything int he cache
-
-  std::set<PHG4Hit*> truth_hits;
   return truth_hits;
 }
 
-void SvtxTruthEval::FillTruthHitsFromParticleCache()
+std::pair<SvtxTruthEval::TruthHitTable::const_iterator, SvtxTruthEval::TruthHitTable::const_iterator> SvtxTruthEval::truth_hit_range(PHG4Particle* particle)
 {
-  std::multimap<const int, PHG4Hit*> temp_clusters_from_particles;
-  // loop over all the g4hits in the cylinder layers
-  if (_g4hits_svtx)
+  // the particle table is always filled once per event, as was the map it replaces
+  if (!_truth_hits_built)
   {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_svtx->getHits().first;
-         g4iter != _g4hits_svtx->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
-    }
+    FillTruthHitsFromParticleCache();
   }
 
-  // loop over all the g4hits in the ladder layers
-  if (_g4hits_tracker)
+  // only particles known to the truth container have g4hits
+  const int trackid = particle->get_track_id();
+  if (_truthinfo->GetParticle(trackid) != particle)
   {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_tracker->getHits().first;
-         g4iter != _g4hits_tracker->getHits().second;
-         ++g4iter)
-    {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
-    }
+    return std::make_pair(_truth_hits_from_trackid.cend(), _truth_hits_from_trackid.cend());
   }
 
-  // loop over all the g4hits in the maps ladder layers
-  if (_g4hits_maps)
+  return std::equal_range(
+      _truth_hits_from_trackid.cbegin(), _truth_hits_from_trackid.cend(),
+      std::make_pair(trackid, static_cast<PHG4Hit*>(nullptr)),
+      [](const std::pair<int, PHG4Hit*>& lhs, const std::pair<int, PHG4Hit*>& rhs)
+      { return lhs.first < rhs.first; });
+}
+
+void SvtxTruthEval::FillTruthHitsFromParticleCache()
+{
+  PHTimer timer("SvtxTruthEval_hits");
+  timer.restart();
+
+  _truth_hits_built = true;
+  _truth_hits.clear();
+  _truth_hits_from_trackid.clear();
+
+  // since the SVTX can be composed of several trackers, collect the g4hits of all of them:
+  // cylinder layers, ladder layers, maps layers and micromegas layers
+  for (PHG4HitContainer* g4hits : {_g4hits_svtx, _g4hits_tracker, _g4hits_maps, _g4hits_mms})
   {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_maps->getHits().first;
-         g4iter != _g4hits_maps->getHits().second;
-         ++g4iter)
+    if (!g4hits)
     {
-      PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
+      continue;
     }
-  }
-
-  // loop over all the g4hits in the micromegas layers
-  if (_g4hits_mms)
-  {
-    for (PHG4HitContainer::ConstIterator g4iter = _g4hits_mms->getHits().first;
-         g4iter != _g4hits_mms->getHits().second;
+    for (PHG4HitContainer::ConstIterator g4iter = g4hits->getHits().first;
+         g4iter != g4hits->getHits().second;
          ++g4iter)
     {
       PHG4Hit* g4hit = g4iter->second;
-      temp_clusters_from_particles.insert(std::make_pair(g4hit->get_trkid(), g4hit));
+      _truth_hits.push_back(g4hit);
+      _truth_hits_from_trackid.emplace_back(g4hit->get_trkid(), g4hit);
     }
   }
 
-  PHG4TruthInfoContainer::ConstRange range = _truthinfo->GetParticleRange();
-  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
-       iter != range.second; ++iter)
+  // sorted by address, to match the std::set ordering of the returned g4hits
+  std::sort(_truth_hits.begin(), _truth_hits.end());
+  _truth_hits.erase(std::unique(_truth_hits.begin(), _truth_hits.end()), _truth_hits.end());
+  std::sort(_truth_hits_from_trackid.begin(), _truth_hits_from_trackid.end());
+  _truth_hits_from_trackid.erase(std::unique(_truth_hits_from_trackid.begin(), _truth_hits_from_trackid.end()), _truth_hits_from_trackid.end());
+
+  timer.stop();
+  if (_verbosity > 0)
   {
-    PHG4Particle* g4particle = iter->second;
-    std::set<PHG4Hit*> truth_hits;
-    std::multimap<const int, PHG4Hit*>::const_iterator lower_bound = temp_clusters_from_particles.lower_bound(g4particle->get_track_id());
-    std::multimap<const int, PHG4Hit*>::const_iterator upper_bound = temp_clusters_from_particles.upper_bound(g4particle->get_track_id());
-    std::multimap<const int, PHG4Hit*>::const_iterator cfp_iter;
-    for (cfp_iter = lower_bound; cfp_iter != upper_bound; ++cfp_iter)
-    {
-      PHG4Hit* g4hit = cfp_iter->second;
-      truth_hits.insert(g4hit);
-    }
-    _cache_all_truth_hits_g4particle.insert(std::make_pair(g4particle, truth_hits));
+    std::cout << "SvtxTruthEval::FillTruthHitsFromParticleCache -"
+              << " g4hits: " << _truth_hits.size()
+              << " time: " << timer.get_accumulated_time() << " ms" << std::endl;
   }
 }
 
@@ -282,10 +206,13 @@ std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>> SvtxTruthEval::all_tru
     return output_type_t();
   }
 
+  const auto particle_less = [](const std::pair<PHG4Particle*, output_type_t>& lhs, PHG4Particle* rhs)
+  { return lhs.first < rhs; };
+
   if (_do_cache)
   {
-    const auto iter = _cache_all_truth_clusters_g4particle.find(particle);
-    if (iter != _cache_all_truth_clusters_g4particle.end())
+    const auto iter = std::lower_bound(_truth_clusters_from_particle.begin(), _truth_clusters_from_particle.end(), particle, particle_less);
+    if (iter != _truth_clusters_from_particle.end() && iter->first == particle)
     {
       return iter->second;
     }
@@ -416,7 +343,8 @@ std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>> SvtxTruthEval::all_tru
 
   if (_do_cache)
   {
-    _cache_all_truth_clusters_g4particle.insert(std::make_pair(particle, truth_clusters));
+    const auto iter = std::lower_bound(_truth_clusters_from_particle.begin(), _truth_clusters_from_particle.end(), particle, particle_less);
+    _truth_clusters_from_particle.emplace(iter, particle, truth_clusters);
   }
 
   return truth_clusters;
@@ -995,9 +923,11 @@ PHG4Hit* SvtxTruthEval::get_innermost_truth_hit(PHG4Particle* particle)
   PHG4Hit* innermost_hit = nullptr;
   float innermost_radius = std::numeric_limits<float>::max();
 
-  std::set<PHG4Hit*> truth_hits = all_truth_hits(particle);
-  for (auto *candidate : truth_hits)
+  // g4hits of a particle are sorted by address in the table, as they were in the std::set
+  const auto range = truth_hit_range(particle);
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
+    PHG4Hit* candidate = iter->second;
     float x = candidate->get_x(0);  // use entry points
     float y = candidate->get_y(0);  // use entry points
     float r = std::sqrt(x * x + y * y);
@@ -1032,19 +962,10 @@ PHG4Hit* SvtxTruthEval::get_outermost_truth_hit(PHG4Particle* particle)
   PHG4Hit* outermost_hit = nullptr;
   float outermost_radius = std::numeric_limits<float>::min();
 
-  if (_do_cache)
-  {
-    std::map<PHG4Particle*, PHG4Hit*>::iterator iter =
-        _cache_get_outermost_truth_hit.find(particle);
-    if (iter != _cache_get_outermost_truth_hit.end())
-    {
-      return iter->second;
-    }
-  }
-
-  std::set<PHG4Hit*> truth_hits = all_truth_hits(particle);
-  for (auto *candidate : truth_hits)
+  const auto range = truth_hit_range(particle);
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
+    PHG4Hit* candidate = iter->second;
     float x = candidate->get_x(1);  // use exit points
     float y = candidate->get_y(1);  // use exit points
     float r = std::sqrt(x * x + y * y);
@@ -1054,10 +975,6 @@ PHG4Hit* SvtxTruthEval::get_outermost_truth_hit(PHG4Particle* particle)
       outermost_hit = candidate;
     }
   }
-  if (_do_cache)
-  {
-    _cache_get_outermost_truth_hit.insert(std::make_pair(particle, outermost_hit));
-  }
 
   return outermost_hit;
 }
@@ -1100,23 +1017,9 @@ PHG4Particle* SvtxTruthEval::get_primary_particle(PHG4Hit* g4hit)
     return nullptr;
   }
 
-  if (_do_cache)
-  {
-    std::map<PHG4Hit*, PHG4Particle*>::iterator iter =
-        _cache_get_primary_particle_g4hit.find(g4hit);
-    if (iter != _cache_get_primary_particle_g4hit.end())
-    {
-      return iter->second;
-    }
-  }
-
+  // two lookups in the truth container, no cheaper than the map that used to cache them
   PHG4Particle* primary = _basetrutheval.get_primary_particle(g4hit);
 
-  if (_do_cache)
-  {
-    _cache_get_primary_particle_g4hit.insert(std::make_pair(g4hit, primary));
-  }
-
   if (_strict)
   {
     assert(primary);
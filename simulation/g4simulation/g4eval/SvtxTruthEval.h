@@ -21,6 +21,7 @@ class PHParametersContainer;
 #include <map>
 #include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 class SvtxTruthEval
@@ -67,9 +68,15 @@ class SvtxTruthEval
   void FillTruthHitsFromParticleCache();
 
  private:
+  //! (track id, g4hit) pairs, sorted by track id then g4hit address
+  using TruthHitTable = std::vector<std::pair<int, PHG4Hit*>>;
+
   void get_node_pointers(PHCompositeNode* topNode);
   bool has_node_pointers();
 
+  //! range of the (track id, g4hit) table matching a given particle
+  std::pair<TruthHitTable::const_iterator, TruthHitTable::const_iterator> truth_hit_range(PHG4Particle* particle);
+
   void LayerClusterG4Hits(const std::set<PHG4Hit*>& truth_hits, std::vector<PHG4Hit*>& contributing_hits, std::vector<double>& contributing_hits_energy, std::vector<std::vector<double>>& contributing_hits_entry, std::vector<std::vector<double>>& contributing_hits_exit, float layer, float& x, float& y, float& z, float& t, float& e);
 
   float line_circle_intersection(float x[], float y[], float z[], float radius);
@@ -105,12 +112,18 @@ class SvtxTruthEval
   std::multimap<TrkrDefs::cluskey, PHG4Hit*> _truth_cluster_truth_hit_map;
 
   bool _do_cache = true;
-  std::set<PHG4Hit*> _cache_all_truth_hits;
-  std::map<PHG4Particle*, std::set<PHG4Hit*>> _cache_all_truth_hits_g4particle;
-  std::map<PHG4Particle*, std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_all_truth_clusters_g4particle;
-  std::map<PHG4Particle*, PHG4Hit*> _cache_get_innermost_truth_hit;
-  std::map<PHG4Particle*, PHG4Hit*> _cache_get_outermost_truth_hit;
-  std::map<PHG4Hit*, PHG4Particle*> _cache_get_primary_particle_g4hit;
+
+  //! per event g4hit tables, filled once by FillTruthHitsFromParticleCache
+  bool _truth_hits_built = false;
+
+  //! all tracking g4hits, sorted by address
+  std::vector<PHG4Hit*> _truth_hits;
+
+  //! track id of all tracking g4hits
+  TruthHitTable _truth_hits_from_trackid;
+
+  //! truth clusters of the particles clustered so far, sorted by particle
+  std::vector<std::pair<PHG4Particle*, std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>>> _truth_clusters_from_particle;
 };
 
 #endif  // G4EVAL_SVTXTRUTHEVAL_H
@@ -170,6 +170,16 @@ int Fun4AllDstPileupInputManager::run(const int nevents)
   merger.copyDetectorActiveCrossings(m_DetectorTiming);
   merger.load_nodes(m_dstNode);
 
+  // preload background pool
+  if (m_pool_size > 0 && m_pool.empty())
+  {
+    const auto result = fill_pool(merger);
+    if (result != 0)
+    {
+      return result;
+    }
+  }
+
   // generate background collisions
   const double mu = m_collision_rate * m_time_between_crossings * 1e-9;
 
@@ -181,8 +191,24 @@ int Fun4AllDstPileupInputManager::run(const int nevents)
     const int ncollisions = gsl_ran_poisson(m_rng.get(), mu);
     for (int icollision = 0; icollision < ncollisions; ++icollision)
     {
+      if (!m_pool.empty())
+      {
+        // sample from pool and merge
+        const auto ievent = gsl_rng_uniform_int(m_rng.get(), m_pool.size());
+        if (Verbosity() > 0)
+        {
+          std::cout << "Fun4AllDstPileupInputManager::run - merged pooled background event " << ievent << " time: " << crossing_time << std::endl;
+        }
+        m_timer_merge.restart();
+        merger.copy_background_event(m_pool[ievent], crossing_time);
+        m_timer_merge.stop();
+        continue;
+      }
+
       // read one event
+      m_timer_io.restart();
       const auto result = runOne(1);
+      m_timer_io.stop();
       if (result != 0)
       {
         return result;
@@ -193,10 +219,63 @@ int Fun4AllDstPileupInputManager::run(const int nevents)
       {
         std::cout << "Fun4AllDstPileupInputManager::run - merged background event " << m_ievent_thisfile << " time: " << crossing_time << std::endl;
       }
+      m_timer_merge.restart();
       merger.copy_background_event(m_dstNodeInternal.get(), crossing_time);
+      m_timer_merge.stop();
+    }
+  }
+
+  return 0;
+}
+
+//_____________________________________________________________________________
+int Fun4AllDstPileupInputManager::fill_pool(const Fun4AllDstPileupMerger &merger)
+{
+  m_pool.reserve(m_pool_size);
+  while (m_pool.size() < m_pool_size)
+  {
+    m_timer_io.restart();
+    const auto result = runOne(1);
+    m_timer_io.stop();
+    if (result != 0)
+    {
+      // out of input: use whatever was loaded
+      break;
     }
+
+    m_pool.emplace_back();
+    merger.load_background_event(m_dstNodeInternal.get(), m_pool.back());
   }
 
+  if (m_pool.empty())
+  {
+    std::cout << PHWHERE << " " << Name() << ": could not load any background event in pool" << std::endl;
+    return -1;
+  }
+
+  if (m_pool.size() < m_pool_size || Verbosity() > 0)
+  {
+    std::cout << "Fun4AllDstPileupInputManager::fill_pool - " << Name() << ": loaded " << m_pool.size()
+              << " background events (requested " << m_pool_size << ")" << std::endl;
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+int Fun4AllDstPileupInputManager::End()
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllDstPileupInputManager::End - " << Name() << std::endl;
+    if (!m_pool.empty())
+    {
+      std::cout << "  background pool size: " << m_pool.size() << std::endl;
+    }
+    std::cout << "  background io:    " << m_timer_io.get_ncycle() << " reads, "
+              << m_timer_io.get_accumulated_time() << " ms" << std::endl;
+    std::cout << "  background merge: " << m_timer_merge.get_ncycle() << " events, "
+              << m_timer_merge.get_accumulated_time() << " ms" << std::endl;
+  }
   return 0;
 }
 
@@ -11,8 +11,11 @@
 #include <fun4all/Fun4AllInputManager.h>
 #include <fun4all/Fun4AllReturnCodes.h>  // for SYNC_NOOBJECT, SYNC_OK
 
+#include "Fun4AllDstPileupMerger.h"
+
 #include <phool/PHCompositeNode.h>  // for PHCompositeNode
 #include <phool/PHNodeIOManager.h>  // for PHNodeIOManager
+#include <phool/PHTimer.h>
 #include <phool/sphenix_constants.h>
 
 #include <gsl/gsl_rng.h>
@@ -21,6 +24,7 @@
 #include <memory>
 #include <string>
 #include <utility>  // for pair
+#include <vector>
 
 /*!
  * dedicated input manager that merges single events into "merged" events, containing a trigger event
@@ -37,6 +41,7 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
   int setBranches() override;
   void Print(const std::string &what = "ALL") const override;
   int PushBackEvents(const int i) override;
+  int End() override;
 
   // Effectivly turn off the synchronization checking (copy from Fun4AllNoSyncDstInputManager)
   int SyncIt(const SyncObject * /*mastersync*/) override { return Fun4AllReturnCodes::SYNC_OK; }
@@ -66,10 +71,24 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
 
   void setDetectorActiveCrossings(const std::string &name, const int min, const int max);
 
+  /*!
+   * preload this many background events in memory, once, and merge collisions
+   * sampled randomly from this pool instead of reading each of them from file.
+   * Events are reused, so the pool must be large compared to the number of
+   * collisions per trigger event to keep correlations small. 0 (default) disables
+   */
+  void setBackgroundPoolSize(unsigned int n)
+  {
+    m_pool_size = n;
+  }
+
  private:
   //! loads one event on internal DST node
   int runOne(const int nevents = 0);
 
+  //! reads background events from file into the pool
+  int fill_pool(const Fun4AllDstPileupMerger &merger);
+
   //!@name event counters
   //@{
   bool m_ReadRunTTree = true;
@@ -122,6 +141,18 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
   std::unique_ptr<gsl_rng, Deleter> m_rng;
 
   std::map<std::string, std::pair<double, double>> m_DetectorTiming;
+
+  //! background pool size
+  unsigned int m_pool_size{0};
+
+  //! background pool
+  std::vector<Fun4AllDstPileupMerger::BackgroundEvent> m_pool;
+
+  //!@name timers for reading and merging background events
+  //@{
+  PHTimer m_timer_io{"background_io"};
+  PHTimer m_timer_merge{"background_merge"};
+  //@}
 };
 
 #endif /* G4MAIN_FUN4ALLDSTPILEUPINPUTMANAGER_H_ */
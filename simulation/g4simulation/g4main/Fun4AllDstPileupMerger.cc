@@ -371,3 +371,315 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
     }
   }
 }
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::load_background_event(PHCompositeNode *dstNode, BackgroundEvent &event) const
+{
+  event = BackgroundEvent();
+
+  // copy PHHepMCGenEventMap
+  auto *const map = findNode::getClass<PHHepMCGenEventMap>(dstNode, "PHHepMCGenEventMap");
+  if (map)
+  {
+    if (map->size() != 1)
+    {
+      std::cout << "Fun4AllDstPileupMerger::load_background_event - cannot merge events that contain more than one PHHepMCGenEventMap" << std::endl;
+      return;
+    }
+
+    auto *genevent = map->get_map().begin()->second;
+    event.genevent.reset(static_cast<PHHepMCGenEvent *>(genevent->CloneMe()));
+
+    // same as in copy_background_event: keep the original content in the pooled copy
+    event.genevent->getEvent()->swap(*genevent->getEvent());
+  }
+
+  // copy truth container, converting vertex and track ids to local ids
+  using ConversionMap = std::map<int, int>;
+  ConversionMap vtxid_map;
+  ConversionMap trkid_map;
+
+  auto *const container_truth = findNode::getClass<PHG4TruthInfoContainer>(dstNode, "G4TruthInfo");
+  if (container_truth)
+  {
+    {
+      // primary vertices
+      int key = 0;
+      const auto range = container_truth->GetPrimaryVtxRange();
+      for (auto iter = range.first; iter != range.second; ++iter)
+      {
+        const auto &sourceVertex = iter->second;
+        event.primary_vertices.emplace_back(sourceVertex);
+        event.primary_vertices.back().set_id(++key);
+        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+      }
+    }
+
+    {
+      // secondary vertices, from last to first as in copy_background_event
+      int key = 0;
+      const auto range = container_truth->GetSecondaryVtxRange();
+      for (
+          auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstVtxIterator>(range.second);
+          iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstVtxIterator>(range.first);
+          ++iter)
+      {
+        const auto &sourceVertex = iter->second;
+        event.secondary_vertices.emplace_back(sourceVertex);
+        event.secondary_vertices.back().set_id(--key);
+        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+      }
+    }
+
+    {
+      // primary particles
+      int key = 0;
+      const auto range = container_truth->GetPrimaryParticleRange();
+      for (auto iter = range.first; iter != range.second; ++iter)
+      {
+        const auto &source = iter->second;
+        BackgroundEvent::Particle pooled{PHG4Particle_t(source)};
+        auto &dest = pooled.particle;
+        dest.set_track_id(++key);
+        dest.set_parent_id(0);
+        dest.set_primary_id(key);
+
+        const auto keyiter = vtxid_map.find(source->get_vtx_id());
+        if (keyiter != vtxid_map.end())
+        {
+          dest.set_vtx_id(keyiter->second);
+        }
+        else
+        {
+          std::cout << "Fun4AllDstPileupMerger::load_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
+          pooled.local_vtx = false;
+        }
+
+        trkid_map.insert(std::make_pair(source->get_track_id(), key));
+        event.primary_particles.push_back(std::move(pooled));
+      }
+    }
+
+    {
+      // secondary particles, from last to first so that parents are converted first
+      int key = 0;
+      const auto range = container_truth->GetSecondaryParticleRange();
+      for (
+          auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.second);
+          iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.first);
+          ++iter)
+      {
+        const auto &source = iter->second;
+        BackgroundEvent::Particle pooled{PHG4Particle_t(source)};
+        auto &dest = pooled.particle;
+        dest.set_track_id(--key);
+
+        auto keyiter = trkid_map.find(source->get_parent_id());
+        if (keyiter != trkid_map.end())
+        {
+          dest.set_parent_id(keyiter->second);
+        }
+        else
+        {
+          std::cout << "Fun4AllDstPileupMerger::load_background_event - track id " << source->get_parent_id() << " not found in map" << std::endl;
+          pooled.local_parent = false;
+        }
+
+        keyiter = trkid_map.find(source->get_primary_id());
+        if (keyiter != trkid_map.end())
+        {
+          dest.set_primary_id(keyiter->second);
+        }
+        else
+        {
+          std::cout << "Fun4AllDstPileupMerger::load_background_event - track id " << source->get_primary_id() << " not found in map" << std::endl;
+          pooled.local_primary = false;
+        }
+
+        keyiter = vtxid_map.find(source->get_vtx_id());
+        if (keyiter != vtxid_map.end())
+        {
+          dest.set_vtx_id(keyiter->second);
+        }
+        else
+        {
+          std::cout << "Fun4AllDstPileupMerger::load_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
+          pooled.local_vtx = false;
+        }
+
+        trkid_map.insert(std::make_pair(source->get_track_id(), key));
+        event.secondary_particles.push_back(std::move(pooled));
+      }
+    }
+
+    // embed flags, only for primary vertices and tracks
+    for (const auto &pair : vtxid_map)
+    {
+      if (pair.first > 0)
+      {
+        event.embedded_vtx_ids.push_back(pair.second);
+      }
+    }
+    for (const auto &pair : trkid_map)
+    {
+      if (pair.first > 0)
+      {
+        event.embedded_trk_ids.push_back(pair.second);
+      }
+    }
+  }
+
+  // copy all g4hit containers found in source
+  FindG4HitContainer nodeFinder;
+  PHNodeIterator(dstNode).forEach(nodeFinder);
+  for (const auto &pair : nodeFinder.containers())
+  {
+    auto &pooled_container = event.hitcontainers[pair.first];
+
+    const auto range = pair.second->getHits();
+    pooled_container.hits.reserve(pair.second->size());
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      const auto &sourceHit = iter->second;
+      BackgroundEvent::Hit pooled{PHG4Hit_t(sourceHit)};
+
+      const auto keyiter = trkid_map.find(sourceHit->get_trkid());
+      if (keyiter != trkid_map.end())
+      {
+        pooled.hit.set_trkid(keyiter->second);
+      }
+      else
+      {
+        std::cout << "Fun4AllDstPileupMerger::load_background_event - track id " << sourceHit->get_trkid() << " not found in map" << std::endl;
+        pooled.local_trkid = false;
+      }
+
+      // showers from background events are not copied
+      pooled.hit.set_shower_id(std::numeric_limits<int>::min());
+      pooled_container.hits.push_back(std::move(pooled));
+    }
+
+    const auto layers = pair.second->getLayers();
+    pooled_container.layers.assign(layers.first, layers.second);
+  }
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_background_event(const BackgroundEvent &event, double delta_t) const
+{
+  // keep track of new embed id, after insertion as background event
+  int new_embed_id = -1;
+  if (event.genevent && m_geneventmap)
+  {
+    auto *newevent = m_geneventmap->insert_background_event(event.genevent.get());
+    newevent->moveVertex(0, 0, 0, delta_t);
+    new_embed_id = newevent->get_embedding_id();
+  }
+
+  // local ids are converted by offsetting with the current destination range,
+  // which is what copy_background_event does one insertion at a time
+  int maxtrk = 0;
+  int mintrk = 0;
+  if (m_g4truthinfo)
+  {
+    maxtrk = m_g4truthinfo->maxtrkindex();
+    mintrk = m_g4truthinfo->mintrkindex();
+  }
+  const auto trk_id = [maxtrk, mintrk](int local)
+  { return local > 0 ? maxtrk + local : (local < 0 ? mintrk + local : 0); };
+
+  if (m_g4truthinfo)
+  {
+    const int maxvtx = m_g4truthinfo->maxvtxindex();
+    const int minvtx = m_g4truthinfo->minvtxindex();
+    const auto vtx_id = [maxvtx, minvtx](int local)
+    { return local > 0 ? maxvtx + local : (local < 0 ? minvtx + local : 0); };
+
+    for (const auto *vertices : {&event.primary_vertices, &event.secondary_vertices})
+    {
+      for (const auto &sourceVertex : *vertices)
+      {
+        auto *newVertex = new PHG4VtxPoint_t(&sourceVertex);
+        newVertex->set_t(sourceVertex.get_t() + delta_t);
+        m_g4truthinfo->AddVertex(vtx_id(sourceVertex.get_id()), newVertex);
+      }
+    }
+
+    for (const auto *particles : {&event.primary_particles, &event.secondary_particles})
+    {
+      for (const auto &pooled : *particles)
+      {
+        const auto &source = pooled.particle;
+        auto *dest = new PHG4Particle_t(source);
+        const int key = trk_id(source.get_track_id());
+        m_g4truthinfo->AddParticle(key, dest);
+        dest->set_track_id(key);
+        if (pooled.local_parent)
+        {
+          dest->set_parent_id(trk_id(source.get_parent_id()));
+        }
+        if (pooled.local_primary)
+        {
+          dest->set_primary_id(trk_id(source.get_primary_id()));
+        }
+        if (pooled.local_vtx)
+        {
+          dest->set_vtx_id(vtx_id(source.get_vtx_id()));
+        }
+      }
+    }
+
+    for (const auto &id : event.embedded_vtx_ids)
+    {
+      m_g4truthinfo->AddEmbededVtxId(vtx_id(id), new_embed_id);
+    }
+    for (const auto &id : event.embedded_trk_ids)
+    {
+      m_g4truthinfo->AddEmbededTrkId(trk_id(id), new_embed_id);
+    }
+  }
+
+  // copy g4hits
+  for (const auto &pair : m_g4hitscontainers)
+  {
+    if (!pair.second)
+    {
+      std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid destination container " << pair.first << std::endl;
+      continue;
+    }
+
+    const auto source = event.hitcontainers.find(pair.first);
+    if (source == event.hitcontainers.end())
+    {
+      std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid source container " << pair.first << std::endl;
+      continue;
+    }
+
+    auto detiter = m_DetectorTiming.find(pair.first);
+    if (detiter != m_DetectorTiming.end())
+    {
+      if (delta_t < detiter->second.first || delta_t > detiter->second.second)
+      {
+        continue;
+      }
+    }
+
+    for (const auto &pooled : source->second.hits)
+    {
+      const auto &sourceHit = pooled.hit;
+      auto *newHit = new PHG4Hit_t(sourceHit);
+      newHit->set_t(0, sourceHit.get_t(0) + delta_t);
+      newHit->set_t(1, sourceHit.get_t(1) + delta_t);
+      if (pooled.local_trkid)
+      {
+        newHit->set_trkid(trk_id(sourceHit.get_trkid()));
+      }
+      pair.second->AddHit(newHit->get_detid(), newHit);
+    }
+
+    for (const auto &layer : source->second.layers)
+    {
+      pair.second->AddLayer(layer);
+    }
+  }
+}
@@ -8,13 +8,20 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include "PHG4Hitv1.h"
+#include "PHG4Particlev3.h"
+#include "PHG4VtxPointv1.h"
+
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>  // for pair
+#include <vector>
 
 class PHCompositeNode;
 class PHG4HitContainer;
 class PHG4TruthInfoContainer;
+class PHHepMCGenEvent;
 class PHHepMCGenEventMap;
 
 /*!
@@ -37,6 +44,64 @@ class Fun4AllDstPileupMerger final
   //! time-shift and copy content of source nodes to destination
   void copy_background_event(PHCompositeNode *, double delta_t) const;
 
+  /*!
+   * compact in-memory copy of one background event, used for the background pool.
+   * Vertex and track ids are stored relative to the event: local id k > 0 is the k-th
+   * primary, k < 0 the |k|-th secondary, so that the event can be appended any number of
+   * times by offsetting ids, without the map lookups needed for events read from file
+   */
+  class BackgroundEvent
+  {
+   public:
+    //! pooled particle. The flags are false if the corresponding id could not be converted
+    struct Particle
+    {
+      PHG4Particlev3 particle;
+      bool local_parent{true};
+      bool local_primary{true};
+      bool local_vtx{true};
+    };
+
+    //! pooled hit. local_trkid is false if its track id could not be converted
+    struct Hit
+    {
+      PHG4Hitv1 hit;
+      bool local_trkid{true};
+    };
+
+    //! pooled hits and layers of one g4hit container
+    struct HitContainer
+    {
+      std::vector<Hit> hits;
+      std::vector<unsigned int> layers;
+    };
+
+    std::unique_ptr<PHHepMCGenEvent> genevent;
+
+    //!@name truth information, secondaries are stored in insertion order
+    //@{
+    std::vector<PHG4VtxPointv1> primary_vertices;
+    std::vector<PHG4VtxPointv1> secondary_vertices;
+    std::vector<Particle> primary_particles;
+    std::vector<Particle> secondary_particles;
+    //@}
+
+    //!@name local ids of the primary vertices and tracks to be flagged as embedded
+    //@{
+    std::vector<int> embedded_vtx_ids;
+    std::vector<int> embedded_trk_ids;
+    //@}
+
+    //! hit containers, indexed by node name
+    std::map<std::string, HitContainer> hitcontainers;
+  };
+
+  //! convert content of source nodes into a compact background event
+  void load_background_event(PHCompositeNode *, BackgroundEvent &) const;
+
+  //! time-shift and copy a compact background event to destination
+  void copy_background_event(const BackgroundEvent &, double delta_t) const;
+
   void copyDetectorActiveCrossings(const std::map<std::string, std::pair<double, double>> &dmap) { m_DetectorTiming = dmap; }
 
  private:
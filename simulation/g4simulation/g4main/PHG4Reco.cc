@@ -658,7 +658,16 @@ int PHG4Reco::InitUImanager()
 //_________________________________________________________________
 int PHG4Reco::process_event(PHCompositeNode *topNode)
 {
-  if (PHRandomSeed::Verbosity() >= 2)
+  if (m_SeedPerEvent)
+  {
+    unsigned int iseed = PHRandomSeed();
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHG4Reco::process_event - seeding Geant4 with " << iseed << std::endl;
+    }
+    G4Seed(iseed);
+  }
+  else if (PHRandomSeed::Verbosity() >= 2)
   {
     G4Random::showEngineStatus();
   }
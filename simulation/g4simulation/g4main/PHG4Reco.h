@@ -129,6 +129,10 @@ class PHG4Reco : public SubsysReco
 
   static void G4Seed(const unsigned int i);
 
+  //! reseed Geant4 from PHRandomSeed() at the start of every event, so the random
+  //! state of an event does not depend on the events simulated before it
+  void set_seed_per_event(bool b = true) { m_SeedPerEvent = b; }
+
   PHG4Subsystem *getSubsystem(const std::string &name);
   PHG4DisplayAction *GetDisplayAction() { return m_DisplayAction; }
   void Dump_GDML(const std::string &filename);
@@ -220,6 +224,7 @@ class PHG4Reco : public SubsysReco
 
   bool m_SaveDstGeometryFlag{true};
   bool m_disableUserActions{false};
+  bool m_SeedPerEvent{false};
 };
 
 #endif
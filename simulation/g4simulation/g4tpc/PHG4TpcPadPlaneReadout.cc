@@ -107,6 +107,8 @@ int PHG4TpcPadPlaneReadout::InitRun(PHCompositeNode *topNode)
   const std::string seggeonodename = "TPCGEOMCONTAINER";
   GeomContainer = findNode::getClass<PHG4TpcGeomContainer>(topNode, seggeonodename);
   assert(GeomContainer);
+  // pad centers and time bins are looked up per electron
+  GeomContainer->build_tables();
   
   PHG4TpcGeom *layergeom =  GeomContainer->GetLayerCellGeom(20);  // z geometry is the same for all layers
   double tpc_adc_clock = layergeom->get_adc_clock();
@@ -363,6 +365,7 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
       LayerGeom = layeriter->second;
 
       layernum = LayerGeom->get_layer();
+      PadTable = GeomContainer->get_layer_table(layernum);
       /* pass_data.layerGeom = LayerGeom; */
       /* pass_data.layer = layernum; */
       if (Verbosity() > 1000)
@@ -385,8 +388,6 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
 
   const auto tbins = LayerGeom->get_zbins();
 
-  sector_min_Phi = LayerGeom->get_sector_min_phi();
-  sector_max_Phi = LayerGeom->get_sector_max_phi();
   phi_bin_width = LayerGeom->get_phistep();
 
   phi = check_phi(side, phi, rad_gem);
@@ -596,8 +597,8 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
       // collect information to do simple clustering. Checks operation of PHG4CylinderCellTpcReco, and
       // is also useful for comparison with PHG4TpcClusterizer result when running single track events.
       // The only information written to the cell other than neffelectrons is tbin and pad number, so get those from geometry
-      double tcenter = LayerGeom->get_zcenter(tbin_num);
-      double phicenter = LayerGeom->get_phicenter(pad_num, side);
+      double tcenter = PadTable->t_center[tbin_num];
+      double phicenter = PadTable->phi_center[side][pad_num];
       phi_integral += phicenter * neffelectrons;
       t_integral += tcenter * neffelectrons;
       weight += neffelectrons;
@@ -717,6 +718,8 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
 }
 double PHG4TpcPadPlaneReadout::check_phi(const unsigned int side, const double phi, const double radius)
 {
+  const auto &sector_min_Phi = PadTable->sector_min_phi;
+  const auto &sector_max_Phi = PadTable->sector_max_phi;
   double new_phi = phi;
   int p_region = -1;
   for (int iregion = 0; iregion < 3; ++iregion)
@@ -827,7 +830,7 @@ void PHG4TpcPadPlaneReadout::populate_zigzag_phibins(const unsigned int side, co
     {
       pad_now -= phibins;
     }
-    pads_phi[ipad] = LayerGeom->get_phicenter(pad_now, side);
+    pads_phi[ipad] = PadTable->phi_center[side][pad_now];
     sum_of_pads_phi += pads_phi[ipad];
     sum_of_pads_absphi += fabs(pads_phi[ipad]);
   }
@@ -1038,9 +1041,14 @@ void PHG4TpcPadPlaneReadout::sampaTimeDistribution(double tzero,  std::vector<in
 
   double tstepsize = LayerGeom->get_zstep();
   int tbinzero = LayerGeom->get_zbin(tzero);
+  if (tbinzero < 0)
+  {
+    // outside of the readout window, the time bin table has no entry for it
+    return;
+  }
 
   // the first clock bin is a special case
-  double tfirst_end = LayerGeom->get_zcenter(tbinzero) + tstepsize/2.0;
+  double tfirst_end = PadTable->t_center[tbinzero] + tstepsize/2.0;
   double vfirst_end =  sampaShapingResponseFunction(tzero, tfirst_end); 
   double first_integral = (vfirst_end / 2.0) * (tfirst_end - tzero);
     
@@ -1068,7 +1076,7 @@ void PHG4TpcPadPlaneReadout::sampaTimeDistribution(double tzero,  std::vector<in
 	}
 
       // get the beginning and end of this clock bin
-      double tcenter = LayerGeom->get_zcenter(tbin);
+      double tcenter = PadTable->t_center[tbin];
       double tlow = tcenter - tstepsize/2.0;
 
       // sample the voltage in this bin at nsamples-1 locations
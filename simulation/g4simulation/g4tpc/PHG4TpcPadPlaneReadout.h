@@ -4,6 +4,8 @@
 #include "PHG4TpcPadPlane.h"
 #include "TpcClusterBuilder.h"
 
+#include <g4detectors/PHG4TpcGeomContainer.h>
+
 #include <g4main/PHG4HitContainer.h>
 
 #include <gsl/gsl_rng.h>
@@ -18,7 +20,6 @@
 typedef std::map<TrkrDefs::hitsetkey, std::vector<TrkrDefs::hitkey>> hitMaskTpc;
 
 class PHCompositeNode;
-class PHG4TpcGeomContainer;
 class PHG4TpcGeom;
 class TH2;
 class TF1;
@@ -79,6 +80,7 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   PHG4TpcGeomContainer *GeomContainer = nullptr;
   PHG4TpcGeom *LayerGeom = nullptr;
+  const PHG4TpcGeomContainer::LayerTable *PadTable = nullptr;
 
   double neffelectrons_threshold {std::numeric_limits<double>::quiet_NaN()};
 
@@ -111,9 +113,6 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
   double averageGEMGain {std::numeric_limits<double>::quiet_NaN()};
   double polyaTheta {std::numeric_limits<double>::quiet_NaN()};
 
-  std::array<std::vector<double>, NSides> sector_min_Phi;
-  std::array<std::vector<double>, NSides> sector_max_Phi;
-
   // return random distribution of number of electrons after amplification of GEM for each initial ionizing electron
   double getSingleEGEMAmplification();
   double getSingleEGEMAmplification(double weight);
@@ -36,6 +36,7 @@
 #include <TTree.h>
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <sstream>
 #include <string>
 
@@ -45,6 +46,91 @@ double CaloWaveformSim::template_function(double *x, double *par)
   return v1;
 }
 
+void CaloWaveformSim::build_template_table()
+{
+  // TProfile::Interpolate is linear between bin centers and flat outside of them,
+  // a table on a grid through the bin centers reproduces it exactly for uniform binning
+  int nbins = h_template->GetNbinsX();
+  m_template_x0 = h_template->GetBinCenter(1);
+  int npoints = 1;
+  m_template_step = 1.;
+  if (nbins > 1 && m_template_oversampling > 0)
+  {
+    npoints = (nbins - 1) * m_template_oversampling + 1;
+    m_template_step = (h_template->GetBinCenter(nbins) - m_template_x0) / (npoints - 1);
+  }
+  m_template_table.resize(npoints);
+  for (int i = 0; i < npoints; i++)
+  {
+    m_template_table[i] = h_template->Interpolate(m_template_x0 + i * m_template_step);
+  }
+
+  // the peak position does not change from event to event
+  TF1 f_fit(
+      "f_fit", [this](double *x, double *par)
+      { return this->template_function(x, par); },
+      0, m_nsamples, 3);
+  f_fit.SetParameters(1.0, 0.0, 0.0);
+  m_template_peak = f_fit.GetMaximumX();
+
+  if (Verbosity() > 0)
+  {
+    double maxdiff = 0;
+    double xlow = m_template_x0 - 1;
+    double xhigh = m_template_x0 + (npoints - 1) * m_template_step + 1;
+    for (int i = 0; i <= 10 * npoints; i++)
+    {
+      double x = xlow + i * (xhigh - xlow) / (10 * npoints);
+      maxdiff = std::max(maxdiff, std::abs(template_value(x) - h_template->Interpolate(x)));
+    }
+    std::cout << "CaloWaveformSim::InitRun template table with " << npoints << " points, peak at " << m_template_peak
+              << ", max deviation from the template " << maxdiff << std::endl;
+  }
+}
+
+float CaloWaveformSim::template_value(double x) const
+{
+  double u = (x - m_template_x0) / m_template_step;
+  if (u <= 0)
+  {
+    return m_template_table.front();
+  }
+  int last = m_template_table.size() - 1;
+  if (u >= last)
+  {
+    return m_template_table.back();
+  }
+  int k = static_cast<int>(u);
+  float frac = u - k;
+  return m_template_table[k] + frac * (m_template_table[k + 1] - m_template_table[k]);
+}
+
+void CaloWaveformSim::render_deposits()
+{
+  // merge deposits of the same tower and pulse time, then render every pulse once
+  std::sort(m_deposits.begin(), m_deposits.end(), [](const PulseDeposit &lhs, const PulseDeposit &rhs)
+            { return (lhs.tower != rhs.tower) ? lhs.tower < rhs.tower : lhs.tbin < rhs.tbin; });
+  size_t ndeposit = m_deposits.size();
+  for (size_t idep = 0; idep < ndeposit;)
+  {
+    const PulseDeposit &first = m_deposits[idep];
+    float amplitude = 0;
+    size_t jdep = idep;
+    for (; jdep < ndeposit && m_deposits[jdep].tower == first.tower && m_deposits[jdep].tbin == first.tbin; jdep++)
+    {
+      amplitude += m_deposits[jdep].amplitude;
+    }
+    double shift = first.tbin * m_template_step;
+    float *waveform = &m_waveforms[static_cast<size_t>(first.tower) * m_nsamples];
+    for (int i = 0; i < m_nsamples; i++)
+    {
+      waveform[i] += amplitude * template_value(i - shift);
+    }
+    idep = jdep;
+  }
+  m_deposits.clear();
+}
+
 CaloWaveformSim::CaloWaveformSim(const std::string &name)
   : SubsysReco(name)
 {
@@ -73,6 +159,7 @@ int CaloWaveformSim::InitRun(PHCompositeNode *topNode)
   TFile *ft = TFile::Open(templatefilename.c_str());
   assert(ft && ft->IsOpen());
   h_template = static_cast<TProfile *>(ft->Get("hpwaveform"));
+  build_template_table();
 
   // Determine run number
   EventHeader *evtHeader = findNode::getClass<EventHeader>(topNode, "EventHeader");
@@ -221,7 +308,8 @@ int CaloWaveformSim::InitRun(PHCompositeNode *topNode)
   }
 
   // Prepare waveform buffers
-  m_waveforms.assign(m_nchannels, std::vector<float>(m_nsamples));
+  m_waveforms.assign(static_cast<size_t>(m_nchannels) * m_nsamples, 0.);
+  m_waveform_pedestal.resize(m_nsamples);
 
   // Create node tree and finish
   CreateNodeTree(topNode);
@@ -263,27 +351,12 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
   }
 
   // initialize the waveform
-  for (auto &waveform : m_waveforms)
-  {
-    for (auto &sample : waveform)
-    {
-      sample = 0.;
-    }
-  }
-  // waveform TH1
-  TF1 *f_fit = new TF1(
-      "f_fit", [this](double *x, double *par)
-      { return this->template_function(x, par); },
-      0, m_nsamples, 3);
-  f_fit->SetParameter(0, 1.0);
-  f_fit->SetParameter(1, 0.0);
-  float template_peak = f_fit->GetMaximumX();
+  std::fill(m_waveforms.begin(), m_waveforms.end(), 0.);
+  float template_peak = m_template_peak;
   float shift_of_shift = m_timeshiftwidth * gsl_rng_uniform(m_RandomGenerator);
 
   float _shiftval = m_peakpos + shift_of_shift - template_peak;
 
-  f_fit->SetParameters(1, _shiftval, 0);
-
   // get G4Hits
   std::string nodename = "G4HIT_" + m_detector;
   PHG4HitContainer *hits = findNode::getClass<PHG4HitContainer>(topNode, nodename);
@@ -364,12 +437,18 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
     edepMap[hit->get_hit_id()] += hitEdep;
     showerMap[showerID] += hitEdep;
 
-    f_fit->SetParameters(ADC, _shiftval + t0, 0.);
-    for (int i = 0; i < m_nsamples; i++)
+    if (tower_index >= static_cast<unsigned int>(m_nchannels))
     {
-      m_waveforms.at(tower_index).at(i) += f_fit->Eval(i);
+      std::cout << PHWHERE << " tower index " << tower_index << " out of range, dropping hit" << std::endl;
+      continue;
     }
+    PulseDeposit deposit;
+    deposit.tower = tower_index;
+    deposit.tbin = std::lround((_shiftval + t0) / m_template_step);
+    deposit.amplitude = ADC;
+    m_deposits.push_back(deposit);
   }
+  render_deposits();
 
   // do noise here and add to waveform
 
@@ -388,8 +467,7 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
 
   for (int i = 0; i < m_nchannels; i++)
   {
-    std::vector<float> m_waveform_pedestal;
-    m_waveform_pedestal.resize(m_nsamples);
+    float *waveform = &m_waveforms[static_cast<size_t>(i) * m_nsamples];
     if (m_noiseType == NoiseType::NOISE_TREE)
     {
       TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
@@ -405,30 +483,29 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
         m_waveform_pedestal.at(j) = (m_waveform_pedestal.at(j) - pedestal_mean) * m_pedestal_scale + pedestal_mean;
       }
     }
+    TowerInfo *tower = m_CaloWaveformContainer->get_tower_at_channel(i);
     for (int j = 0; j < m_nsamples; j++)
     {
       if (m_noiseType == NoiseType::NOISE_TREE)
       {
-        // TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
-        // m_waveforms.at(i).at(j) += (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
-        m_waveforms.at(i).at(j) += m_waveform_pedestal.at(j);
+        waveform[j] += m_waveform_pedestal[j];
       }
       if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
       {
-        m_waveforms.at(i).at(j) += gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
+        // ziggurat: same normal distribution as gsl_ran_gaussian at a fraction of the cost
+        waveform[j] += gsl_ran_gaussian_ziggurat(m_RandomGenerator, m_gaussian_noise);
       }
       if (m_noiseType == NoiseType::NOISE_NONE)
       {
-        m_waveforms.at(i).at(j) += m_fixpedestal;
+        waveform[j] += m_fixpedestal;
       }
       // saturate at 2^14 - 1
-      m_waveforms.at(i).at(j) = std::min<__gnu_cxx::__alloc_traits<class std::allocator<float> >::value_type>(m_waveforms.at(i).at(j), 16383);
-      m_waveforms.at(i).at(j) = std::max<__gnu_cxx::__alloc_traits<class std::allocator<float> >::value_type>(m_waveforms.at(i).at(j), 0);
+      waveform[j] = std::min(waveform[j], 16383.F);
+      waveform[j] = std::max(waveform[j], 0.F);
 
-      m_CaloWaveformContainer->get_tower_at_channel(i)->set_waveform_value(j, m_waveforms.at(i).at(j));
+      tower->set_waveform_value(j, waveform[j]);
     }
   }
-  delete f_fit;
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -126,6 +126,8 @@ class CaloWaveformSim : public SubsysReco
 
   // Waveform template & sampling
   void set_templatefile(const std::string &templatefile) { m_templatefile = templatefile; }
+  // template table points per template bin, pulse times are rounded to the table step
+  void set_template_oversampling(int oversampling) { m_template_oversampling = oversampling; }
   void set_nsamples(int nsamples) { m_nsamples = nsamples; }
   void set_pedestalsamples(int pedestalsamples) { m_pedestalsamples = pedestalsamples; }
   void set_sampletime(float sampletime) { m_sampletime = sampletime; }
@@ -217,7 +219,9 @@ class CaloWaveformSim : public SubsysReco
   gsl_rng *m_RandomGenerator{nullptr};
   PHG4CylinderCellGeom_Spacalv1 *geo{nullptr};
   const PHG4CylinderGeom_Spacalv3 *layergeom{nullptr};
-  std::vector<std::vector<float>> m_waveforms;
+  // all waveforms in one buffer, [channel * m_nsamples + sample]
+  std::vector<float> m_waveforms;
+  std::vector<float> m_waveform_pedestal;
   int m_runNumber{0};
 
   unsigned int (*encode_tower)(unsigned int, unsigned int){TowerInfoDefs::encode_emcal};
@@ -226,6 +230,22 @@ class CaloWaveformSim : public SubsysReco
   CDBTTree *cdbttree{nullptr}, *cdbttree_MC{nullptr};
   CDBTTree *cdbttree_time{nullptr}, *cdbttree_MC_time{nullptr};
   TProfile *h_template{nullptr};
+
+  // pulse template tabulated on a fine grid starting at the first bin center
+  std::vector<float> m_template_table;
+  double m_template_x0{0.};
+  double m_template_step{1.};
+  float m_template_peak{0.};
+  int m_template_oversampling{10};
+
+  // hit amplitude at a pulse time (in template table steps), merged per tower before rendering
+  struct PulseDeposit
+  {
+    unsigned int tower{0};
+    int tbin{0};
+    float amplitude{0.};
+  };
+  std::vector<PulseDeposit> m_deposits;
   LightCollectionModel light_collection_model;
 
   NoiseType m_noiseType{NOISE_TREE};
@@ -236,6 +256,9 @@ class CaloWaveformSim : public SubsysReco
                     unsigned short &phibin,
                     float &correction);
   double template_function(double *x, double *par);
+  void build_template_table();
+  float template_value(double x) const;
+  void render_deposits();
 };
 
 #endif  // G4WAVEFORMSIM_CALOWAVEFORMSIM_H